@@ -0,0 +1,200 @@
+#include "benchmark.h"
+
+#include <octoon/vmd_loader.h>
+#include <octoon/io/mstream.h>
+#include <octoon/animation/animation_clip.h>
+#include <octoon/animation/baked_animation_clip.h>
+#include <octoon/animation/path_interpolator.h>
+
+#include <cstring>
+#include <random>
+
+namespace octoon::benchmark
+{
+	namespace
+	{
+		constexpr std::size_t NumKeyframes = 4096;
+		constexpr std::size_t NumEvaluations = 10000;
+
+		constexpr std::size_t NumMotionBones = 200;
+		constexpr std::size_t NumMotionFrames = 300;
+		constexpr std::size_t NumMorphs = 50;
+
+		// A curve shaped like a VMD channel: one keyframe every few frames, each with a bezier easing drawn
+		// from a small set of control points.
+		animation::AnimationCurve<float> makeCurve(std::uint32_t seed)
+		{
+			std::mt19937 random(seed);
+			std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+			std::uniform_int_distribution<int> step(1, 8);
+			std::uniform_int_distribution<int> shape(0, 7);
+
+			animation::AnimationCurve<float>::Keyframes keyframes;
+			keyframes.reserve(NumKeyframes);
+
+			float time = 0;
+			for (std::size_t i = 0; i < NumKeyframes; i++)
+			{
+				auto s = shape(random) * 12 / 127.0f;
+				keyframes.emplace_back(time, value(random), animation::PathInterpolator<float>::create(0.2f + s * 0.5f, 0.8f - s * 0.5f, s, 1.0f - s));
+				time += step(random);
+			}
+
+			return animation::AnimationCurve<float>(std::move(keyframes));
+		}
+
+		std::vector<std::uint8_t> makeMotion()
+		{
+			std::vector<std::uint8_t> data;
+
+			auto append = [&](const void* ptr, std::size_t size)
+			{
+				auto bytes = static_cast<const std::uint8_t*>(ptr);
+				data.insert(data.end(), bytes, bytes + size);
+			};
+
+			auto appendUInt32 = [&](std::uint32_t value)
+			{
+				append(&value, sizeof(value));
+			};
+
+			char header[50] = {};
+			std::memcpy(header, "Vocaloid Motion Data 0002", 25);
+			std::memcpy(header + 30, "benchmark", 9);
+			append(header, sizeof(header));
+
+			appendUInt32(NumMotionBones * NumMotionFrames);
+
+			for (std::uint32_t frame = 0; frame < NumMotionFrames; frame++)
+			{
+				for (std::uint32_t bone = 0; bone < NumMotionBones; bone++)
+				{
+					char name[15] = {};
+					std::snprintf(name, sizeof(name), "bone%03u", bone);
+					append(name, sizeof(name));
+
+					appendUInt32(frame * 3);
+
+					float location[3] = { 0.01f * bone, 0.02f * frame, 0.0f };
+					float rotation[4] = { 0.0f, std::sin(frame * 0.01f), 0.0f, std::cos(frame * 0.01f) };
+					append(location, sizeof(location));
+					append(rotation, sizeof(rotation));
+
+					std::uint8_t interpolation[64];
+					for (std::size_t i = 0; i < 64; i++)
+						interpolation[i] = static_cast<std::uint8_t>((i / 4) % 4 < 2 ? 20 + (frame % 8) * 4 : 107 - (frame % 8) * 4);
+					append(interpolation, sizeof(interpolation));
+				}
+			}
+
+			appendUInt32(NumMorphs * NumMotionFrames);
+
+			for (std::uint32_t frame = 0; frame < NumMotionFrames; frame++)
+			{
+				for (std::uint32_t morph = 0; morph < NumMorphs; morph++)
+				{
+					char name[15] = {};
+					std::snprintf(name, sizeof(name), "morph%02u", morph);
+					append(name, sizeof(name));
+
+					appendUInt32(frame * 3);
+
+					float weight = (frame + morph) % 10 / 10.0f;
+					append(&weight, sizeof(weight));
+				}
+			}
+
+			appendUInt32(0); // cameras
+			appendUInt32(0); // lights
+			appendUInt32(0); // self shadows
+
+			return data;
+		}
+	}
+
+	void registerAnimationBenchmarks(Benchmarks& benchmarks, const std::string& /*assetPath*/)
+	{
+		benchmarks.push_back({ "animation/curve/evaluate_forward", [](State& state)
+		{
+			auto curve = makeCurve(1);
+
+			while (state.keepRunning())
+			{
+				for (std::size_t i = 0; i < NumEvaluations; i++)
+				{
+					if (curve.finish)
+						curve.setTime(0);
+
+					doNotOptimize(curve.evaluate(1.0f / 30.0f));
+				}
+			}
+
+			state.setItemsProcessed(NumEvaluations);
+		}});
+
+		benchmarks.push_back({ "animation/curve/evaluate_random", [](State& state)
+		{
+			auto curve = makeCurve(2);
+
+			std::mt19937 random(3);
+			std::uniform_real_distribution<float> time(0.0f, curve.timeLength);
+
+			std::vector<float> times(NumEvaluations);
+			for (auto& it : times)
+				it = time(random);
+
+			while (state.keepRunning())
+			{
+				for (auto& it : times)
+				{
+					curve.setTime(it);
+					doNotOptimize(curve.value);
+				}
+			}
+
+			state.setItemsProcessed(NumEvaluations);
+		}});
+
+		benchmarks.push_back({ "animation/baked_clip/evaluate", [](State& state)
+		{
+			animation::AnimationClip<float> clip("benchmark");
+			for (std::uint32_t i = 0; i < 64; i++)
+				clip.setCurve("bone" + std::to_string(i) + ".Position.X", makeCurve(100 + i));
+
+			animation::BakedAnimationClip baked(clip, 30.0f);
+			std::vector<float> values(baked.getNumValues());
+
+			float time = 0;
+
+			while (state.keepRunning())
+			{
+				for (std::size_t i = 0; i < 1000; i++)
+				{
+					baked.evaluate(time, values.data());
+					time = time + 1.0f / 30.0f < baked.timeLength ? time + 1.0f / 30.0f : 0.0f;
+				}
+
+				doNotOptimize(values.front());
+			}
+
+			state.setItemsProcessed(1000 * values.size());
+		}});
+
+		benchmarks.push_back({ "animation/vmd/parse", [](State& state)
+		{
+			auto data = makeMotion();
+
+			while (state.keepRunning())
+			{
+				state.pauseTiming();
+				io::imstream stream(data);
+				state.resumeTiming();
+
+				auto animation = VMDLoader::load(stream);
+				doNotOptimize(animation.clips.size());
+			}
+
+			state.setBytesProcessed(data.size());
+		}});
+	}
+}
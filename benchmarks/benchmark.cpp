@@ -0,0 +1,168 @@
+#include "benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace octoon::benchmark
+{
+	State::State(double minTime, std::size_t maxIterations) noexcept
+		: started_(false)
+		, warmedUp_(false)
+		, paused_(false)
+		, skipped_(false)
+		, minTime_(minTime)
+		, maxIterations_(std::max<std::size_t>(1, maxIterations))
+		, items_(0)
+		, bytes_(0)
+		, pausedTime_(clock::duration::zero())
+		, total_(clock::duration::zero())
+		, cpuStart_(0)
+		, cpuEnd_(0)
+	{
+	}
+
+	bool
+	State::keepRunning() noexcept
+	{
+		auto now = clock::now();
+
+		if (skipped_)
+			return false;
+
+		if (!started_)
+		{
+			started_ = true;
+			last_ = now;
+			return true;
+		}
+
+		if (paused_)
+		{
+			paused_ = false;
+			pausedTime_ += now - pauseStart_;
+		}
+
+		auto elapsed = now - last_ - pausedTime_;
+		pausedTime_ = clock::duration::zero();
+
+		if (!warmedUp_)
+		{
+			warmedUp_ = true;
+			cpuStart_ = std::clock();
+			last_ = clock::now();
+			return true;
+		}
+
+		samples_.push_back(std::chrono::duration<double, std::nano>(elapsed).count());
+		total_ += elapsed;
+
+		if (samples_.size() >= maxIterations_ || std::chrono::duration<double>(total_).count() >= minTime_)
+		{
+			cpuEnd_ = std::clock();
+			return false;
+		}
+
+		last_ = clock::now();
+		return true;
+	}
+
+	void
+	State::pauseTiming() noexcept
+	{
+		if (!paused_)
+		{
+			paused_ = true;
+			pauseStart_ = clock::now();
+		}
+	}
+
+	void
+	State::resumeTiming() noexcept
+	{
+		if (paused_)
+		{
+			paused_ = false;
+			pausedTime_ += clock::now() - pauseStart_;
+		}
+	}
+
+	void
+	State::setItemsProcessed(std::uint64_t itemsPerIteration) noexcept
+	{
+		items_ = itemsPerIteration;
+	}
+
+	void
+	State::setBytesProcessed(std::uint64_t bytesPerIteration) noexcept
+	{
+		bytes_ = bytesPerIteration;
+	}
+
+	void
+	State::setLabel(std::string_view label) noexcept
+	{
+		label_ = label;
+	}
+
+	void
+	State::skip(std::string_view reason) noexcept
+	{
+		skipped_ = true;
+		label_ = reason;
+	}
+
+	bool
+	State::skipped() const noexcept
+	{
+		return skipped_;
+	}
+
+	runtime::json
+	State::result(std::string_view name) const noexcept
+	{
+		runtime::json result;
+		result["name"] = std::string(name);
+		result["run_name"] = std::string(name);
+		result["run_type"] = "iteration";
+		result["time_unit"] = "ns";
+
+		if (!label_.empty())
+			result["label"] = label_;
+
+		if (skipped_ || samples_.empty())
+		{
+			result["error_occurred"] = true;
+			result["error_message"] = label_.empty() ? "no iterations were run" : label_;
+			return result;
+		}
+
+		auto sorted = samples_;
+		std::sort(sorted.begin(), sorted.end());
+
+		auto count = static_cast<double>(sorted.size());
+		auto mean = std::accumulate(sorted.begin(), sorted.end(), 0.0) / count;
+		auto median = sorted.size() % 2 ? sorted[sorted.size() / 2] : (sorted[sorted.size() / 2 - 1] + sorted[sorted.size() / 2]) * 0.5;
+
+		double variance = 0;
+		for (auto& it : sorted)
+			variance += (it - mean) * (it - mean);
+
+		auto cpu = static_cast<double>(cpuEnd_ - cpuStart_) / CLOCKS_PER_SEC * 1e9 / count;
+
+		result["iterations"] = sorted.size();
+		result["real_time"] = mean;
+		result["cpu_time"] = cpu;
+		result["median_time"] = median;
+		result["min_time"] = sorted.front();
+		result["max_time"] = sorted.back();
+		result["stddev_time"] = sorted.size() > 1 ? std::sqrt(variance / (count - 1)) : 0.0;
+
+		if (items_ > 0)
+			result["items_per_second"] = items_ / (mean * 1e-9);
+		if (bytes_ > 0)
+			result["bytes_per_second"] = bytes_ / (mean * 1e-9);
+
+		return result;
+	}
+}
@@ -0,0 +1,95 @@
+#ifndef OCTOON_BENCHMARK_H_
+#define OCTOON_BENCHMARK_H_
+
+#include <octoon/runtime/json.h>
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace octoon::benchmark
+{
+	// Drives the timed loop of one benchmark. Work before the first keepRunning() call is setup and is not
+	// measured; every loop body is one iteration. The first iteration warms caches and lazily built data and
+	// is excluded from the statistics.
+	class State final
+	{
+	public:
+		State(double minTime, std::size_t maxIterations) noexcept;
+
+		bool keepRunning() noexcept;
+
+		// Brackets per-iteration work that must not be measured, such as restoring mutated input.
+		void pauseTiming() noexcept;
+		void resumeTiming() noexcept;
+
+		void setItemsProcessed(std::uint64_t itemsPerIteration) noexcept;
+		void setBytesProcessed(std::uint64_t bytesPerIteration) noexcept;
+		void setLabel(std::string_view label) noexcept;
+
+		void skip(std::string_view reason) noexcept;
+
+		bool skipped() const noexcept;
+
+		runtime::json result(std::string_view name) const noexcept;
+
+	private:
+		using clock = std::chrono::steady_clock;
+
+		bool started_;
+		bool warmedUp_;
+		bool paused_;
+		bool skipped_;
+
+		double minTime_;
+		std::size_t maxIterations_;
+
+		std::uint64_t items_;
+		std::uint64_t bytes_;
+
+		std::string label_;
+
+		clock::time_point last_;
+		clock::time_point pauseStart_;
+		clock::duration pausedTime_;
+		clock::duration total_;
+
+		std::clock_t cpuStart_;
+		std::clock_t cpuEnd_;
+
+		std::vector<double> samples_;
+	};
+
+	struct Benchmark
+	{
+		std::string name;
+		std::function<void(State&)> func;
+	};
+
+	using Benchmarks = std::vector<Benchmark>;
+
+	void registerAnimationBenchmarks(Benchmarks& benchmarks, const std::string& assetPath);
+	void registerMeshBenchmarks(Benchmarks& benchmarks, const std::string& assetPath);
+	void registerModelBenchmarks(Benchmarks& benchmarks, const std::string& assetPath);
+	void registerImageBenchmarks(Benchmarks& benchmarks, const std::string& assetPath);
+	void registerPackageBenchmarks(Benchmarks& benchmarks, const std::string& assetPath);
+	void registerLightmapBenchmarks(Benchmarks& benchmarks, const std::string& assetPath);
+	void registerRenderBenchmarks(Benchmarks& benchmarks, const std::string& assetPath);
+
+	// Keeps the optimizer from discarding a result that is otherwise unused.
+	template<typename T>
+	inline void doNotOptimize(const T& value) noexcept
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static volatile const T* sink;
+		sink = &value;
+#endif
+	}
+}
+
+#endif
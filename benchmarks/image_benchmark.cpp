@@ -0,0 +1,139 @@
+#include "benchmark.h"
+
+#include <octoon/image/image.h>
+#include <octoon/io/mstream.h>
+
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace octoon::benchmark
+{
+	namespace
+	{
+		constexpr std::uint32_t ImageSize = 1024;
+
+		std::vector<std::uint8_t> readFile(const std::string& path)
+		{
+			std::ifstream stream(path, std::ios::in | std::ios::binary);
+			if (!stream)
+				return std::vector<std::uint8_t>();
+
+			return std::vector<std::uint8_t>(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+		}
+
+		// A smooth gradient with some high frequency detail, so the png encoder cannot collapse it.
+		image::Image makeImage(image::Format format)
+		{
+			image::Image image(format, ImageSize, ImageSize);
+
+			auto data = (std::uint8_t*)image.data();
+			auto channel = image.format().channel();
+
+			for (std::uint32_t y = 0; y < ImageSize; y++)
+			{
+				for (std::uint32_t x = 0; x < ImageSize; x++)
+				{
+					auto pixel = data + (y * ImageSize + x) * channel;
+					pixel[0] = static_cast<std::uint8_t>(x * 255 / ImageSize);
+					pixel[1] = static_cast<std::uint8_t>(y * 255 / ImageSize);
+					pixel[2] = static_cast<std::uint8_t>((x ^ y) & 0xFF);
+					if (channel > 3)
+						pixel[3] = 255;
+				}
+			}
+
+			return image;
+		}
+
+		std::vector<std::uint8_t> makeTarga()
+		{
+			std::uint8_t header[18] = {};
+			header[2] = 2; // uncompressed true color
+			header[12] = ImageSize & 0xFF;
+			header[13] = ImageSize >> 8;
+			header[14] = ImageSize & 0xFF;
+			header[15] = ImageSize >> 8;
+			header[16] = 32;
+			header[17] = 8; // alpha bits
+
+			auto image = makeImage(image::Format::R8G8B8A8UNorm);
+
+			std::vector<std::uint8_t> data(header, header + sizeof(header));
+			data.insert(data.end(), image.data(), image.data() + image.size());
+
+			return data;
+		}
+
+		std::vector<std::uint8_t> makePng()
+		{
+			auto path = (std::filesystem::temp_directory_path() / "octoon-benchmark.png").string();
+
+			auto image = makeImage(image::Format::R8G8B8A8UNorm);
+			if (!image.save(path, "png"))
+				return std::vector<std::uint8_t>();
+
+			auto data = readFile(path);
+			std::filesystem::remove(path);
+
+			return data;
+		}
+
+		void registerDecode(Benchmarks& benchmarks, const char* name, const char* type, std::function<std::vector<std::uint8_t>()> make)
+		{
+			benchmarks.push_back({ name, [type, make](State& state)
+			{
+				auto data = make();
+				if (data.empty())
+				{
+					state.skip("cannot create the source image");
+					return;
+				}
+
+				while (state.keepRunning())
+				{
+					state.pauseTiming();
+					io::imstream stream(data);
+					state.resumeTiming();
+
+					image::Image image;
+					if (!image.load(stream, type))
+					{
+						state.skip("cannot decode the source image");
+						break;
+					}
+
+					doNotOptimize(image.data());
+				}
+
+				state.setBytesProcessed(data.size());
+			}});
+		}
+	}
+
+	void registerImageBenchmarks(Benchmarks& benchmarks, const std::string& assetPath)
+	{
+		// The bundled sprite is a bitmap despite its extension, so its type is left to the handler probe.
+		registerDecode(benchmarks, "image/probe/decode_asset", nullptr, [assetPath]() { return readFile(assetPath + "/sprite/square.png"); });
+		registerDecode(benchmarks, "image/png/decode_1024", "png", makePng);
+		registerDecode(benchmarks, "image/tga/decode_1024", "tga", makeTarga);
+
+		benchmarks.push_back({ "image/convert/rgba32f_to_rgba8", [](State& state)
+		{
+			image::Image source(image::Format::R32G32B32A32SFloat, ImageSize, ImageSize);
+
+			auto pixels = (float*)source.data();
+			for (std::size_t i = 0; i < ImageSize * ImageSize * 4; i++)
+				pixels[i] = std::fmod(i * 0.001f, 1.0f);
+
+			while (state.keepRunning())
+			{
+				image::Image image(image::Format::R8G8B8A8UInt, source);
+				doNotOptimize(image.data());
+			}
+
+			state.setItemsProcessed(ImageSize * ImageSize);
+		}});
+	}
+}
@@ -0,0 +1,113 @@
+#include "benchmark.h"
+
+#include <octoon/lightmap/lightmap.h>
+#include <octoon/mesh/sphere_mesh.h>
+#include <octoon/camera/perspective_camera.h>
+#include <octoon/material/mesh_standard_material.h>
+
+namespace octoon::benchmark
+{
+	namespace
+	{
+		constexpr std::uint32_t LightmapSize = 128;
+
+		std::shared_ptr<mesh::Mesh> makeMesh()
+		{
+			auto mesh = std::make_shared<mesh::SphereMesh>(1.0f, 24, 16);
+			mesh->computeVertexNormals();
+			return mesh;
+		}
+
+		std::shared_ptr<geometry::Geometry> makeGeometry()
+		{
+			auto mesh = makeMesh();
+			mesh->computeLightMap(LightmapSize, LightmapSize);
+
+			auto material = std::make_shared<material::MeshStandardMaterial>();
+			material->setColor(math::float3(0.8f, 0.8f, 0.8f));
+
+			auto geometry = std::make_shared<geometry::Geometry>();
+			geometry->setMesh(std::move(mesh));
+			geometry->setMaterial(std::move(material));
+
+			return geometry;
+		}
+
+		std::shared_ptr<light::DirectionalLight> makeLight()
+		{
+			auto light = std::make_shared<light::DirectionalLight>();
+			light->setColor(math::float3::One);
+			light->setIntensity(1.0f);
+			light->setTransform(math::float4x4().makeRotationX(-math::PI / 4));
+			return light;
+		}
+	}
+
+	void registerLightmapBenchmarks(Benchmarks& benchmarks, const std::string& /*assetPath*/)
+	{
+		benchmarks.push_back({ "lightmap/unwrap", [](State& state)
+		{
+			auto mesh = makeMesh();
+
+			while (state.keepRunning())
+			{
+				state.pauseTiming();
+				auto copy = mesh->clone();
+				state.resumeTiming();
+
+				copy->computeLightMap(LightmapSize, LightmapSize);
+				doNotOptimize(copy->getTexcoordArray(1).data());
+			}
+
+			state.setItemsProcessed(mesh->getIndicesArray().size() / 3);
+		}});
+
+		benchmarks.push_back({ "lightmap/rasterize_patches", [](State& state)
+		{
+			auto geometry = makeGeometry();
+
+			while (state.keepRunning())
+			{
+				bake::Lightmap lightmap;
+				lightmap.setGeometry(*geometry);
+				doNotOptimize(lightmap.fronBuffer().data());
+			}
+
+			state.setItemsProcessed(geometry->getMesh()->getIndicesArray().size() / 3);
+		}});
+
+		benchmarks.push_back({ "lightmap/direct_light", [](State& state)
+		{
+			auto geometry = makeGeometry();
+			auto light = makeLight();
+
+			bake::Lightmap lightmap;
+			lightmap.setGeometry(*geometry);
+
+			while (state.keepRunning())
+				lightmap.computeDirectLight(*light);
+
+			state.setItemsProcessed(LightmapSize * LightmapSize);
+		}});
+
+		benchmarks.push_back({ "lightmap/indirect_bounce", [](State& state)
+		{
+			auto geometry = makeGeometry();
+			auto light = makeLight();
+
+			camera::PerspectiveCamera camera(60.0f, 0.1f, 100.0f);
+
+			bake::Lightmap lightmap;
+			lightmap.setGeometry(*geometry);
+			lightmap.computeDirectLight(*light);
+
+			while (state.keepRunning())
+			{
+				lightmap.render(camera);
+				doNotOptimize(lightmap.fronBuffer().data());
+			}
+
+			state.setItemsProcessed(LightmapSize * LightmapSize);
+		}});
+	}
+}
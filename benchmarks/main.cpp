@@ -0,0 +1,136 @@
+#include "benchmark.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#ifndef OCTOON_BENCHMARK_ASSET_PATH
+#	define OCTOON_BENCHMARK_ASSET_PATH "../../system"
+#endif
+
+namespace
+{
+	void usage(const char* program)
+	{
+		std::cerr
+			<< "usage: " << program << " [options]\n"
+			<< "  --filter=<text>      run only benchmarks whose name contains <text>\n"
+			<< "  --min-time=<sec>     measure each benchmark for at least <sec> seconds (default 0.5)\n"
+			<< "  --max-iterations=<n> stop each benchmark after <n> iterations (default 1000000)\n"
+			<< "  --out=<file>         write the JSON report to <file> instead of stdout\n"
+			<< "  --assets=<dir>       directory of the bundled assets (default " OCTOON_BENCHMARK_ASSET_PATH ")\n"
+			<< "  --list               print the benchmark names and exit\n";
+	}
+
+	bool option(const char* arg, const char* name, std::string& value)
+	{
+		auto length = std::strlen(name);
+		if (std::strncmp(arg, name, length) == 0 && arg[length] == '=')
+		{
+			value = arg + length + 1;
+			return true;
+		}
+
+		return false;
+	}
+}
+
+int main(int argc, const char* argv[])
+{
+	using namespace octoon;
+
+	std::string filter;
+	std::string output;
+	std::string assetPath = OCTOON_BENCHMARK_ASSET_PATH;
+	std::string value;
+
+	double minTime = 0.5;
+	std::size_t maxIterations = 1000000;
+	bool list = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (option(argv[i], "--filter", value))
+			filter = value;
+		else if (option(argv[i], "--min-time", value))
+			minTime = std::stod(value);
+		else if (option(argv[i], "--max-iterations", value))
+			maxIterations = std::stoull(value);
+		else if (option(argv[i], "--out", value))
+			output = value;
+		else if (option(argv[i], "--assets", value))
+			assetPath = value;
+		else if (std::strcmp(argv[i], "--list") == 0)
+			list = true;
+		else
+		{
+			usage(argv[0]);
+			return std::strcmp(argv[i], "--help") == 0 ? 0 : 1;
+		}
+	}
+
+	benchmark::Benchmarks benchmarks;
+	benchmark::registerAnimationBenchmarks(benchmarks, assetPath);
+	benchmark::registerMeshBenchmarks(benchmarks, assetPath);
+	benchmark::registerModelBenchmarks(benchmarks, assetPath);
+	benchmark::registerImageBenchmarks(benchmarks, assetPath);
+	benchmark::registerPackageBenchmarks(benchmarks, assetPath);
+	benchmark::registerLightmapBenchmarks(benchmarks, assetPath);
+	benchmark::registerRenderBenchmarks(benchmarks, assetPath);
+
+	if (list)
+	{
+		for (auto& it : benchmarks)
+			std::cout << it.name << std::endl;
+		return 0;
+	}
+
+	runtime::json report;
+	report["context"]["executable"] = argv[0];
+	report["context"]["num_cpus"] = std::thread::hardware_concurrency();
+	report["context"]["min_time"] = minTime;
+#if defined(NDEBUG)
+	report["context"]["library_build_type"] = "release";
+#else
+	report["context"]["library_build_type"] = "debug";
+#endif
+	report["benchmarks"] = runtime::json::array();
+
+	for (auto& it : benchmarks)
+	{
+		if (!filter.empty() && it.name.find(filter) == std::string::npos)
+			continue;
+
+		benchmark::State state(minTime, maxIterations);
+		it.func(state);
+
+		auto result = state.result(it.name);
+
+		if (state.skipped())
+			std::fprintf(stderr, "%-48s skipped: %s\n", it.name.c_str(), result["error_message"].get<std::string>().c_str());
+		else if (result.count("real_time"))
+			std::fprintf(stderr, "%-48s %14.0f ns %10zu iterations\n", it.name.c_str(), result["real_time"].get<double>(), result["iterations"].get<std::size_t>());
+
+		report["benchmarks"].push_back(std::move(result));
+	}
+
+	if (output.empty())
+	{
+		std::cout << report.dump(2) << std::endl;
+	}
+	else
+	{
+		std::ofstream stream(output, std::ios::out | std::ios::trunc);
+		if (!stream)
+		{
+			std::cerr << "cannot open " << output << std::endl;
+			return 1;
+		}
+
+		stream << report.dump(2) << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,330 @@
+#include "benchmark.h"
+
+#include <octoon/mesh/sphere_mesh.h>
+#include <octoon/mesh/mesh_skinning.h>
+#include <octoon/mesh/mesh_morphing.h>
+
+#include <random>
+#include <thread>
+
+namespace octoon::benchmark
+{
+	namespace
+	{
+		constexpr std::uint32_t NumJoints = 64;
+		constexpr std::size_t NumMorphs = 16;
+		constexpr std::size_t NumRays = 1000;
+
+		// About 50k vertices, close to a typical PMX character body.
+		std::shared_ptr<mesh::Mesh> makeMesh()
+		{
+			auto mesh = std::make_shared<mesh::SphereMesh>(1.0f, 256, 192);
+			mesh->computeVertexNormals();
+			return mesh;
+		}
+
+		// Splits the sphere into horizontal bands, one joint each, and blends every vertex between the
+		// joints of the two nearest bands the way a character limb is weighted.
+		std::shared_ptr<mesh::Mesh> makeSkinnedMesh()
+		{
+			auto mesh = makeMesh();
+
+			skelecton::VertexWeights weights;
+			weights.reserve(mesh->getNumVertices());
+
+			for (auto& v : mesh->getVertexArray())
+			{
+				auto band = (v.y * 0.5f + 0.5f) * (NumJoints - 1);
+				auto bone = std::min<std::uint32_t>(static_cast<std::uint32_t>(band), NumJoints - 2);
+				auto blend = band - bone;
+
+				skelecton::VertexWeight weight;
+				weight.weight1 = 1.0f - blend;
+				weight.weight2 = blend * 0.75f;
+				weight.weight3 = blend * 0.25f;
+				weight.weight4 = 0.0f;
+				weight.bone1 = static_cast<std::uint16_t>(bone);
+				weight.bone2 = static_cast<std::uint16_t>(bone + 1);
+				weight.bone3 = static_cast<std::uint16_t>(bone > 0 ? bone - 1 : bone);
+				weight.bone4 = 0;
+
+				weights.push_back(weight);
+			}
+
+			mesh->setWeightArray(std::move(weights));
+			mesh->setBindposes(math::float4x4s(NumJoints, math::float4x4::One));
+
+			return mesh;
+		}
+
+		math::float4x4s makeJoints(float time)
+		{
+			math::float4x4s joints(NumJoints);
+			for (std::uint32_t i = 0; i < NumJoints; i++)
+				joints[i].makeRotationY(std::sin(time + i * 0.1f) * 0.5f);
+			return joints;
+		}
+
+		void registerSkinning(Benchmarks& benchmarks, const char* name, mesh::SkinningInstructionSet instructionSet, std::uint32_t numThreads, mesh::SkinningMode mode = mesh::SkinningMode::Linear)
+		{
+			benchmarks.push_back({ name, [instructionSet, numThreads, mode](State& state)
+			{
+				if (static_cast<std::uint8_t>(instructionSet) > static_cast<std::uint8_t>(mesh::MeshSkinning::getSupportedInstructionSet()))
+				{
+					state.skip("instruction set is not supported by this cpu");
+					return;
+				}
+
+				auto mesh = makeSkinnedMesh();
+
+				mesh::MeshSkinning skinning;
+				skinning.setMesh(*mesh);
+				skinning.setMode(mode);
+				skinning.setInstructionSet(instructionSet);
+				skinning.setNumThreads(numThreads);
+
+				auto vertices = mesh->getVertexArray();
+				auto normals = mesh->getNormalArray();
+
+				float time = 0;
+
+				while (state.keepRunning())
+				{
+					state.pauseTiming();
+					skinning.setJoints(makeJoints(time += 1.0f / 60.0f));
+					state.resumeTiming();
+
+					skinning.skinning(vertices, normals);
+					doNotOptimize(vertices.front());
+				}
+
+				state.setItemsProcessed(mesh->getNumVertices());
+			}});
+		}
+
+		// Each morph moves a contiguous region of about a tenth of the vertices, like a facial expression,
+		// and every frame the weights of the first numAnimated morphs change.
+		void registerMorphBlend(Benchmarks& benchmarks, const char* name, std::size_t numAnimated)
+		{
+			benchmarks.push_back({ name, [numAnimated](State& state)
+			{
+				auto mesh = makeSkinnedMesh();
+
+				mesh::MeshSkinning skinning;
+				skinning.setMesh(*mesh);
+
+				mesh::MeshMorphing morphing;
+				morphing.setNumVertices(mesh->getNumVertices());
+
+				std::mt19937 random(11);
+				std::uniform_int_distribution<std::size_t> start(0, mesh->getNumVertices() * 9 / 10);
+				std::uniform_real_distribution<float> offset(-0.01f, 0.01f);
+
+				std::size_t numOffsets = 0;
+
+				for (std::size_t i = 0; i < NumMorphs; i++)
+				{
+					math::uint1s indices;
+					math::float3s offsets;
+
+					auto first = start(random);
+					for (std::size_t n = first; n < first + mesh->getNumVertices() / 10; n++)
+					{
+						indices.push_back(static_cast<std::uint32_t>(n));
+						offsets.emplace_back(offset(random), offset(random), offset(random));
+					}
+
+					if (i < numAnimated)
+						numOffsets += indices.size();
+
+					morphing.addMorph(indices, offsets);
+				}
+
+				float time = 0;
+
+				while (state.keepRunning())
+				{
+					time += 1.0f / 60.0f;
+
+					skinning.resetVertices();
+
+					for (std::size_t i = 0; i < numAnimated; i++)
+						morphing.setWeight(i, std::sin(time + i) * 0.5f + 0.5f);
+
+					morphing.update(skinning);
+					doNotOptimize(skinning.getVertex(0));
+				}
+
+				state.setItemsProcessed(numOffsets);
+			}});
+		}
+	}
+
+	void registerMeshBenchmarks(Benchmarks& benchmarks, const std::string& /*assetPath*/)
+	{
+		benchmarks.push_back({ "mesh/compute_vertex_normals", [](State& state)
+		{
+			auto mesh = makeMesh();
+
+			while (state.keepRunning())
+				mesh->computeVertexNormals();
+
+			state.setItemsProcessed(mesh->getIndicesArray().size() / 3);
+		}});
+
+		benchmarks.push_back({ "mesh/compute_vertex_normals/animated_frame", [](State& state)
+		{
+			// About 500k vertices, the size of a dense Alembic cache whose positions change every frame.
+			auto mesh = std::make_shared<mesh::SphereMesh>(1.0f, 1024, 512);
+			auto vertices = mesh->getVertexArray();
+
+			float time = 0.0f;
+
+			while (state.keepRunning())
+			{
+				state.pauseTiming();
+				time += 0.01f;
+				auto& positions = mesh->getVertexArray();
+				for (std::size_t i = 0; i < positions.size(); i++)
+					positions[i] = vertices[i] * (1.0f + 0.1f * std::sin(time + vertices[i].y * 8.0f));
+				state.resumeTiming();
+
+				mesh->computeVertexNormals();
+				doNotOptimize(mesh->getNormalArray().data());
+			}
+
+			state.setItemsProcessed(mesh->getNumVertices());
+		}});
+
+		benchmarks.push_back({ "mesh/compute_tangents", [](State& state)
+		{
+			auto mesh = makeMesh();
+
+			while (state.keepRunning())
+				mesh->computeTangents(0);
+
+			state.setItemsProcessed(mesh->getIndicesArray().size() / 3);
+		}});
+
+		benchmarks.push_back({ "mesh/merge_vertices", [](State& state)
+		{
+			auto mesh = makeMesh();
+
+			while (state.keepRunning())
+			{
+				state.pauseTiming();
+				auto copy = mesh->clone();
+				state.resumeTiming();
+
+				copy->mergeVertices();
+				doNotOptimize(copy->getNumVertices());
+			}
+
+			state.setItemsProcessed(mesh->getNumVertices());
+		}});
+
+		benchmarks.push_back({ "mesh/merge_vertices/triangle_soup", [](State& state)
+		{
+			// Every corner owns its vertex, the way scanned and Alembic meshes often arrive.
+			auto mesh = makeMesh();
+			auto& indices = mesh->getIndicesArray();
+
+			math::float3s vertices;
+			math::float3s normals;
+			math::float2s texcoords;
+
+			for (auto index : indices)
+			{
+				vertices.push_back(mesh->getVertexArray()[index]);
+				normals.push_back(mesh->getNormalArray()[index]);
+				texcoords.push_back(mesh->getTexcoordArray()[index]);
+			}
+
+			auto soup = std::make_shared<mesh::Mesh>();
+			soup->setVertexArray(std::move(vertices));
+			soup->setNormalArray(std::move(normals));
+			soup->setTexcoordArray(std::move(texcoords));
+
+			math::uint1s remap;
+
+			while (state.keepRunning())
+			{
+				state.pauseTiming();
+				auto copy = soup->clone();
+				state.resumeTiming();
+
+				copy->mergeVertices(remap, 1e-5f);
+				doNotOptimize(remap.data());
+			}
+
+			state.setItemsProcessed(soup->getNumVertices());
+		}});
+
+		benchmarks.push_back({ "mesh/raycast", [](State& state)
+		{
+			auto mesh = makeMesh();
+
+			std::mt19937 random(7);
+			std::uniform_real_distribution<float> offset(-1.2f, 1.2f);
+
+			std::vector<math::Raycast> rays(NumRays);
+			for (auto& it : rays)
+				it = math::Raycast(math::float3(offset(random), offset(random), -10.0f), math::float3(offset(random), offset(random), 10.0f));
+
+			mesh::RaycastHit hit;
+			mesh->raycast(rays.front(), hit);
+
+			while (state.keepRunning())
+			{
+				for (auto& it : rays)
+					doNotOptimize(mesh->raycast(it, hit));
+			}
+
+			state.setItemsProcessed(NumRays);
+		}});
+
+		auto numThreads = std::max(1u, std::thread::hardware_concurrency());
+
+		registerSkinning(benchmarks, "skinning/scalar/1_thread", mesh::SkinningInstructionSet::Scalar, 1);
+		registerSkinning(benchmarks, "skinning/sse/1_thread", mesh::SkinningInstructionSet::SSE, 1);
+		registerSkinning(benchmarks, "skinning/avx/1_thread", mesh::SkinningInstructionSet::AVX, 1);
+		registerSkinning(benchmarks, "skinning/best/all_threads", mesh::MeshSkinning::getSupportedInstructionSet(), numThreads);
+		registerSkinning(benchmarks, "skinning/dual_quaternion/1_thread", mesh::SkinningInstructionSet::Scalar, 1, mesh::SkinningMode::DualQuaternion);
+
+		benchmarks.push_back({ "skinning/incremental/partial_bones", [](State& state)
+		{
+			auto mesh = makeSkinnedMesh();
+
+			mesh::MeshSkinning skinning;
+			skinning.setMesh(*mesh);
+
+			auto vertices = mesh->getVertexArray();
+			auto normals = mesh->getNormalArray();
+			auto joints = makeJoints(0.0f);
+
+			skinning.setJoints(joints);
+			skinning.update(vertices, normals);
+
+			float time = 0;
+
+			// Only the upper eighth of the joints moves, like a head turning on an idle body.
+			while (state.keepRunning())
+			{
+				state.pauseTiming();
+				time += 1.0f / 60.0f;
+				for (std::uint32_t i = NumJoints - NumJoints / 8; i < NumJoints; i++)
+					joints[i].makeRotationY(std::sin(time + i * 0.1f) * 0.5f);
+				skinning.setJoints(joints);
+				state.resumeTiming();
+
+				skinning.update(vertices, normals);
+				doNotOptimize(vertices.front());
+			}
+
+			state.setItemsProcessed(mesh->getNumVertices());
+		}});
+
+		registerMorphBlend(benchmarks, "skinning/morph_blend/all_morphs", NumMorphs);
+		registerMorphBlend(benchmarks, "skinning/morph_blend/two_morphs", 2);
+	}
+}
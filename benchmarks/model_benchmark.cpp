@@ -0,0 +1,218 @@
+#include "benchmark.h"
+
+#include <octoon/pmx_loader.h>
+#include <octoon/io/fstream.h>
+
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+
+namespace octoon::benchmark
+{
+	namespace
+	{
+		constexpr std::uint32_t GridSize = 180;
+		constexpr std::uint32_t NumBones = 100;
+		constexpr std::uint32_t NumMorphs = 20;
+		constexpr std::uint32_t NumMorphVertices = 2000;
+
+		// A character sized model: a 180x180 vertex grid weighted across a bone chain, one material
+		// without textures, and a set of vertex morphs. Texture indices are left unset so that the
+		// parse is not dominated by the image decoders.
+		PMX makeModel()
+		{
+			PMX pmx = {};
+
+			std::memcpy(pmx.header.magic, "PMX", 3);
+			pmx.header.offset = 0x20;
+			pmx.header.version = PMX_VERSION_2_0;
+			pmx.header.dataSize = 8;
+			pmx.header.encode = 0;
+			pmx.header.addUVCount = 0;
+			pmx.header.sizeOfIndices = 4;
+			pmx.header.sizeOfTexture = 2;
+			pmx.header.sizeOfMaterial = 1;
+			pmx.header.sizeOfBone = 2;
+			pmx.header.sizeOfMorph = 1;
+			pmx.header.sizeOfBody = 1;
+
+			pmx.numVertices = GridSize * GridSize;
+			pmx.vertices.resize(pmx.numVertices);
+
+			for (std::uint32_t y = 0; y < GridSize; y++)
+			{
+				for (std::uint32_t x = 0; x < GridSize; x++)
+				{
+					auto& vertex = pmx.vertices[y * GridSize + x];
+					vertex.position = { x / float(GridSize), y / float(GridSize), std::sin(x * 0.1f) * 0.05f };
+					vertex.normal = { 0.0f, 0.0f, 1.0f };
+					vertex.coord = { x / float(GridSize - 1), y / float(GridSize - 1) };
+					vertex.edge = 1.0f;
+
+					auto band = y * (NumBones - 1) / float(GridSize);
+					auto bone = static_cast<PmxUInt16>(band);
+					auto blend = band - bone;
+
+					if (x % 2)
+					{
+						vertex.type = PMX_BDEF2;
+						vertex.weight.bone1 = bone;
+						vertex.weight.bone2 = bone + 1;
+						vertex.weight.weight1 = 1.0f - blend;
+					}
+					else
+					{
+						vertex.type = PMX_BDEF4;
+						vertex.weight.bone1 = bone;
+						vertex.weight.bone2 = bone + 1;
+						vertex.weight.bone3 = bone > 0 ? bone - 1 : bone;
+						vertex.weight.bone4 = 0;
+						vertex.weight.weight1 = (1.0f - blend) * 0.8f;
+						vertex.weight.weight2 = blend * 0.8f;
+						vertex.weight.weight3 = 0.15f;
+						vertex.weight.weight4 = 0.05f;
+					}
+				}
+			}
+
+			std::vector<std::uint32_t> indices;
+			indices.reserve((GridSize - 1) * (GridSize - 1) * 6);
+
+			for (std::uint32_t y = 0; y < GridSize - 1; y++)
+			{
+				for (std::uint32_t x = 0; x < GridSize - 1; x++)
+				{
+					auto v = y * GridSize + x;
+					indices.insert(indices.end(), { v, v + GridSize, v + 1, v + 1, v + GridSize, v + GridSize + 1 });
+				}
+			}
+
+			pmx.numIndices = static_cast<PmxUInt32>(indices.size());
+			pmx.indices.resize(indices.size() * sizeof(std::uint32_t));
+			std::memcpy(pmx.indices.data(), indices.data(), pmx.indices.size());
+
+			PmxMaterial material = {};
+			material.Diffuse = { 0.8f, 0.8f, 0.8f };
+			material.Opacity = 1.0f;
+			material.Shininess = 5.0f;
+			material.Ambient = { 0.4f, 0.4f, 0.4f };
+			material.TextureIndex = 0xFFFF;
+			material.SphereTextureIndex = 0xFFFF;
+			material.ToonTexture = 0xFFFF;
+			material.FaceCount = pmx.numIndices;
+
+			pmx.numMaterials = 1;
+			pmx.materials.push_back(material);
+
+			pmx.numBones = NumBones;
+			pmx.bones.resize(NumBones);
+
+			for (std::uint32_t i = 0; i < NumBones; i++)
+			{
+				auto& bone = pmx.bones[i];
+				bone.position = { 0.5f, i / float(NumBones), 0.0f };
+				bone.Parent = i > 0 ? static_cast<PmxUInt16>(i - 1) : 0xFFFF;
+				bone.Flag = PMX_BONE_ROTATION | PMX_BONE_MOVE;
+				bone.Offset = { 0.0f, 1.0f / NumBones, 0.0f };
+			}
+
+			pmx.numMorphs = NumMorphs;
+			pmx.morphs.resize(NumMorphs);
+
+			for (std::uint32_t i = 0; i < NumMorphs; i++)
+			{
+				auto& morph = pmx.morphs[i];
+				morph.name.name[0] = L'm';
+				morph.name.name[1] = static_cast<PmxChar>(L'a' + i);
+				morph.name.length = sizeof(PmxChar) * 2;
+				morph.control = 1;
+				morph.morphType = PMX_MorphTypeVertex;
+				morph.morphCount = NumMorphVertices;
+
+				for (std::uint32_t n = 0; n < NumMorphVertices; n++)
+				{
+					PmxMorphVertex vertex;
+					vertex.index = (i * 1543 + n) % pmx.numVertices;
+					vertex.offset = { 0.0f, 0.0f, 0.01f * (n % 7) };
+					morph.vertices.push_back(vertex);
+				}
+			}
+
+			return pmx;
+		}
+
+		std::string writeModel()
+		{
+			auto path = (std::filesystem::temp_directory_path() / "octoon-benchmark.pmx").string();
+
+			io::ofstream stream(path, io::ios_base::in | io::ios_base::out | io::ios_base::trunc);
+			if (!stream.is_open())
+				return std::string();
+
+			PmxLoader loader;
+			if (!loader.doSave(stream, makeModel()))
+				return std::string();
+
+			return path;
+		}
+	}
+
+	void registerModelBenchmarks(Benchmarks& benchmarks, const std::string& /*assetPath*/)
+	{
+		benchmarks.push_back({ "model/pmx/parse", [](State& state)
+		{
+			auto path = writeModel();
+			if (path.empty())
+			{
+				state.skip("cannot write the temporary model");
+				return;
+			}
+
+			auto size = std::filesystem::file_size(path);
+
+			while (state.keepRunning())
+			{
+				PMX pmx;
+				PmxLoader loader;
+				if (!loader.doLoad(path, pmx))
+				{
+					state.skip("cannot parse the temporary model");
+					break;
+				}
+
+				doNotOptimize(pmx.numVertices);
+			}
+
+			state.setBytesProcessed(size);
+			std::filesystem::remove(path);
+		}});
+
+		benchmarks.push_back({ "model/pmx/load_model", [](State& state)
+		{
+			auto path = writeModel();
+			if (path.empty())
+			{
+				state.skip("cannot write the temporary model");
+				return;
+			}
+
+			auto size = std::filesystem::file_size(path);
+
+			while (state.keepRunning())
+			{
+				model::Model model;
+				PmxLoader loader;
+				if (!loader.doLoad(path, model))
+				{
+					state.skip("cannot load the temporary model");
+					break;
+				}
+
+				doNotOptimize(model.meshes.size());
+			}
+
+			state.setBytesProcessed(size);
+			std::filesystem::remove(path);
+		}});
+	}
+}
@@ -0,0 +1,112 @@
+#include "benchmark.h"
+
+#include <octoon/io/zpackage.h>
+
+#include <zipper/zipper.h>
+
+#include <filesystem>
+#include <sstream>
+
+namespace octoon::benchmark
+{
+	namespace
+	{
+		constexpr std::size_t NumEntries = 256;
+		constexpr std::size_t EntrySize = 64 * 1024;
+
+		std::string entryName(std::size_t i)
+		{
+			return "textures/texture" + std::to_string(i) + ".bin";
+		}
+
+		// A package laid out like a scene bundle: a few hundred compressible entries in a sub directory.
+		std::string makePackage()
+		{
+			auto path = (std::filesystem::temp_directory_path() / "octoon-benchmark.zip").string();
+			std::filesystem::remove(path);
+
+			try
+			{
+				zipper::Zipper zipper(path);
+
+				for (std::size_t i = 0; i < NumEntries; i++)
+				{
+					std::string data(EntrySize, '\0');
+					for (std::size_t n = 0; n < EntrySize; n++)
+						data[n] = static_cast<char>((n * (i + 1)) >> 4);
+
+					std::istringstream stream(data);
+					if (!zipper.add(stream, entryName(i)))
+						return std::string();
+				}
+
+				zipper.close();
+			}
+			catch (...)
+			{
+				return std::string();
+			}
+
+			return path;
+		}
+	}
+
+	void registerPackageBenchmarks(Benchmarks& benchmarks, const std::string& assetPath)
+	{
+		benchmarks.push_back({ "package/zip/read_entry", [](State& state)
+		{
+			auto path = makePackage();
+			if (path.empty())
+			{
+				state.skip("cannot write the temporary package");
+				return;
+			}
+
+			{
+				io::zpackage package(path);
+
+				std::size_t i = 0;
+
+				while (state.keepRunning())
+				{
+					auto buffer = package.open(io::Orl("zip", entryName(i++ % NumEntries)), io::ios_base::in);
+					if (!buffer)
+					{
+						state.skip("cannot read the package entry");
+						break;
+					}
+
+					doNotOptimize(buffer.get());
+				}
+
+				state.setBytesProcessed(EntrySize);
+			}
+
+			std::filesystem::remove(path);
+		}});
+
+		benchmarks.push_back({ "package/zip/exists", [](State& state)
+		{
+			auto path = makePackage();
+			if (path.empty())
+			{
+				state.skip("cannot write the temporary package");
+				return;
+			}
+
+			{
+				io::zpackage package(path);
+
+				while (state.keepRunning())
+				{
+					for (std::size_t i = 0; i < NumEntries; i++)
+						doNotOptimize(package.exists(io::Orl("zip", entryName(i))));
+				}
+
+				state.setItemsProcessed(NumEntries);
+			}
+
+			std::filesystem::remove(path);
+		}});
+	}
+}
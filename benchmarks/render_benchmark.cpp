@@ -0,0 +1,125 @@
+#include "benchmark.h"
+
+#include <octoon/hal/graphics.h>
+#include <octoon/camera/perspective_camera.h>
+#include <octoon/light/directional_light.h>
+#include <octoon/geometry/geometry.h>
+#include <octoon/material/mesh_standard_material.h>
+#include <octoon/mesh/sphere_mesh.h>
+#include <octoon/video/renderer.h>
+#include <octoon/video/render_scene.h>
+
+#include <cstdio>
+
+namespace octoon::benchmark
+{
+	namespace
+	{
+		constexpr std::uint32_t FramebufferWidth = 1280;
+		constexpr std::uint32_t FramebufferHeight = 720;
+		constexpr std::size_t NumGeometries = 1024;
+
+		// The null backend keeps every resource on the CPU and never waits on a driver, so the loop measures
+		// the CPU cost of the forward path alone and the device statistics give the API work of one frame.
+		void registerForward(Benchmarks& benchmarks, const char* name, std::size_t numMaterials)
+		{
+			benchmarks.push_back({ name, [numMaterials](State& state)
+			{
+				hal::GraphicsDeviceDesc deviceDesc;
+				deviceDesc.setDeviceType(hal::GraphicsDeviceType::Null);
+
+				auto device = hal::GraphicsSystem::instance()->createDevice(deviceDesc);
+				if (!device)
+				{
+					state.skip("the null graphics backend is not built");
+					return;
+				}
+
+				hal::GraphicsSwapchainDesc swapchainDesc;
+				swapchainDesc.setWidth(FramebufferWidth);
+				swapchainDesc.setHeight(FramebufferHeight);
+				swapchainDesc.setColorFormat(hal::GraphicsFormat::B8G8R8A8UNorm);
+				swapchainDesc.setDepthStencilFormat(hal::GraphicsFormat::X8_D24UNormPack32);
+
+				hal::GraphicsContextDesc contextDesc;
+				contextDesc.setSwapchain(device->createSwapchain(swapchainDesc));
+
+				auto context = device->createDeviceContext(contextDesc);
+				if (!context)
+				{
+					state.skip("cannot create the null device context");
+					return;
+				}
+
+				auto renderer = video::Renderer::instance();
+				renderer->setup(context, FramebufferWidth, FramebufferHeight);
+
+				auto camera = std::make_shared<camera::PerspectiveCamera>(60.0f, 0.1f, 1000.0f);
+				auto view = math::makeLookatLH(math::float3(0, 0, -40), math::float3::Zero, math::float3::UnitY);
+				camera->setTransform(math::inverse(view), view);
+
+				auto light = std::make_shared<light::DirectionalLight>();
+				auto lightView = math::makeLookatLH(math::float3(10, 10, -10), math::float3::Zero, math::float3::UnitY);
+				light->setTransform(math::inverse(lightView), lightView);
+
+				std::vector<std::shared_ptr<material::Material>> materials;
+				for (std::size_t i = 0; i < numMaterials; i++)
+					materials.push_back(std::make_shared<material::MeshStandardMaterial>(math::float3(1.0f, float(i) / numMaterials, 0.5f)));
+
+				auto mesh = std::make_shared<mesh::SphereMesh>(0.5f, 16, 12);
+
+				auto scene = std::make_shared<video::RenderScene>();
+				scene->addRenderObject(camera.get());
+				scene->addRenderObject(light.get());
+
+				// a 32x32 grid filling the view, every geometry is visible so nothing is culled away
+				std::vector<std::shared_ptr<geometry::Geometry>> geometries;
+				for (std::size_t i = 0; i < NumGeometries; i++)
+				{
+					auto geometry = std::make_shared<geometry::Geometry>();
+					geometry->setMesh(mesh);
+					geometry->setMaterial(materials[i % numMaterials]);
+					math::float4x4 transform;
+					transform.makeTranslate(float(i % 32) - 15.5f, float(i / 32) - 15.5f, 0.0f);
+					geometry->setTransform(transform);
+
+					scene->addRenderObject(geometry.get());
+					geometries.push_back(std::move(geometry));
+				}
+
+				while (state.keepRunning())
+				{
+					context->resetStatistics();
+					context->renderBegin();
+					renderer->render(scene);
+					context->renderEnd();
+				}
+
+				auto& statistics = context->getStatistics();
+
+				char label[256];
+				std::snprintf(label, sizeof(label), "draws=%llu instances=%llu pipelines=%llu descriptor_sets=%llu uniforms=%llu uploaded=%llu",
+					static_cast<unsigned long long>(statistics.drawCalls),
+					static_cast<unsigned long long>(statistics.instances),
+					static_cast<unsigned long long>(statistics.pipelineBinds),
+					static_cast<unsigned long long>(statistics.descriptorSetBinds),
+					static_cast<unsigned long long>(statistics.uniformWrites),
+					static_cast<unsigned long long>(statistics.bytesUploaded));
+
+				state.setLabel(label);
+				state.setItemsProcessed(NumGeometries);
+
+				for (auto& geometry : geometries)
+					scene->removeRenderObject(geometry.get());
+
+				renderer->close();
+			}});
+		}
+	}
+
+	void registerRenderBenchmarks(Benchmarks& benchmarks, const std::string& /*assetPath*/)
+	{
+		registerForward(benchmarks, "render/forward/null_1024_shared_material", 1);
+		registerForward(benchmarks, "render/forward/null_1024_64_materials", 64);
+	}
+}
@@ -65,6 +65,21 @@ namespace octoon::animation
 				timeLength = std::max(it.second.timeLength, timeLength);
 		}
 
+		template<typename _Iterator>
+		void insert(const std::string& _name, _Iterator first, _Iterator last) noexcept
+		{
+			auto& curve = this->curves[_name];
+			curve.insert(first, last);
+			timeLength = std::max(curve.timeLength, timeLength);
+		}
+
+		void insert(const std::string& _name, typename AnimationCurve<_Elem, _Time>::Keyframes&& frames) noexcept
+		{
+			auto& curve = this->curves[_name];
+			curve.insert(std::move(frames));
+			timeLength = std::max(curve.timeLength, timeLength);
+		}
+
 		AnimationCurve<_Elem, _Time>& getCurve(const char* _name) noexcept
 		{
 			return this->curves[_name];
@@ -2,6 +2,8 @@
 #define OCTOON_ANIMATION_CURVE_H_
 
 #include <octoon/animation/keyframe.h>
+#include <algorithm>
+#include <iterator>
 
 namespace octoon::animation
 {
@@ -78,8 +80,8 @@ namespace octoon::animation
 
 		void insert(Keyframe<_Elem, _Time>&& frame_) noexcept
 		{
-			frames.emplace_back(std::move(frame_));
-			this->sort();
+			auto it = std::upper_bound(frames.begin(), frames.end(), frame_.time, [](const _Time& time, const Keyframe<_Elem, _Time>& a) { return time < a.time; });
+			frames.emplace(it, std::move(frame_));
 			this->time = frames.front().time;
 			this->timeLength = frames.back().time;
 			this->value = frames.front().value;
@@ -87,13 +89,45 @@ namespace octoon::animation
 
 		void insert(const Keyframe<_Elem, _Time>& frame_) noexcept
 		{
-			frames.emplace_back(frame_);				
-			this->sort();
+			auto it = std::upper_bound(frames.begin(), frames.end(), frame_.time, [](const _Time& time, const Keyframe<_Elem, _Time>& a) { return time < a.time; });
+			frames.emplace(it, frame_);
 			this->time = frames.front().time;
 			this->timeLength = frames.back().time;
 			this->value = frames.front().value;
 		}
 
+		// Appends a batch of keyframes in any order and sorts only the new ones before merging,
+		// so importing n keyframes costs O(n log n) instead of one full sort per keyframe.
+		template<typename _Iterator>
+		void insert(_Iterator first, _Iterator last) noexcept
+		{
+			if (first == last)
+				return;
+
+			auto count = frames.size();
+			frames.insert(frames.end(), first, last);
+			this->merge(count);
+		}
+
+		void insert(Keyframes&& frames_) noexcept
+		{
+			if (frames_.empty())
+				return;
+
+			auto count = frames.size();
+			if (frames.empty())
+				frames = std::move(frames_);
+			else
+				frames.insert(frames.end(), std::make_move_iterator(frames_.begin()), std::make_move_iterator(frames_.end()));
+
+			this->merge(count);
+		}
+
+		void reserve(std::size_t count) noexcept
+		{
+			frames.reserve(count);
+		}
+
 		void sort() noexcept
 		{
 			std::sort(frames.begin(), frames.end(), [](const Keyframe<_Elem, _Time>& a, const Keyframe<_Elem, _Time>& b) { return a.time < b.time; });
@@ -162,6 +196,22 @@ namespace octoon::animation
 			return this->value;
 		}
 	private:
+		void merge(std::size_t count) noexcept
+		{
+			auto compare = [](const Keyframe<_Elem, _Time>& a, const Keyframe<_Elem, _Time>& b) { return a.time < b.time; };
+
+			auto middle = frames.begin() + count;
+			if (!std::is_sorted(middle, frames.end(), compare))
+				std::stable_sort(middle, frames.end(), compare);
+
+			if (middle != frames.begin() && compare(*middle, *(middle - 1)))
+				std::inplace_merge(frames.begin(), middle, frames.end(), compare);
+
+			this->time = frames.front().time;
+			this->timeLength = frames.back().time;
+			this->value = frames.front().value;
+		}
+
 		void updateAnimationMode(AnimationMode mode) noexcept
 		{
 			switch (mode)
@@ -0,0 +1,515 @@
+#ifndef OCTOON_BAKED_ANIMATION_CLIP_H_
+#define OCTOON_BAKED_ANIMATION_CLIP_H_
+
+#include <octoon/animation/animation_clip.h>
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <cctype>
+#include <cassert>
+
+namespace octoon::animation
+{
+	enum class BakedTrackType : std::uint8_t
+	{
+		Constant,
+		Quantized,
+		Float,
+		Quaternion,
+		ConstantQuaternion
+	};
+
+	// One output of a baked clip. Quaternion tracks drive four consecutive values.
+	// Animated tracks own `stride` 16-bit words at `offset` in every frame; constant tracks own none.
+	struct BakedTrack
+	{
+		BakedTrackType type;
+		std::uint8_t stride;
+		std::uint16_t offset;
+		std::uint32_t value;
+		float minimum;
+		float extent;
+		float constant[4];
+	};
+
+	// Clip resampled at a fixed rate into quantized frame-major tracks.
+	// Scalars are stored as a constant, 16-bit range-quantized or raw float, whichever is the smallest
+	// representation that stays within the error budget; rotations named *Rotation.x/y/z/w are stored as
+	// 48-bit smallest-three quaternions. Evaluating a time reads two adjacent frames front to back.
+	class BakedAnimationClip final
+	{
+	public:
+		static constexpr std::uint32_t QuaternionBits = 15;
+		static constexpr float QuaternionStepError = 0.70710678f / ((1 << QuaternionBits) - 1);
+
+		// Curve times are in seconds and motions are keyed at 30 frames per second.
+		static constexpr float DefaultSampleRate = 30.0f;
+		static constexpr float MaxSampleRate = 240.0f;
+		static constexpr float DefaultTolerance = 1e-4f;
+
+		std::string name;
+		float sampleRate;
+		float timeLength;
+		float maxError;
+		std::uint32_t numFrames;
+		std::uint32_t frameStride;
+		std::vector<std::string> curveNames;
+		std::vector<BakedTrack> tracks;
+		std::vector<std::uint16_t> samples;
+
+		BakedAnimationClip() noexcept
+			: sampleRate(0)
+			, timeLength(0)
+			, maxError(0)
+			, numFrames(0)
+			, frameStride(0)
+		{
+		}
+
+		explicit BakedAnimationClip(const AnimationClip<float>& clip, float rate = DefaultSampleRate, float tolerance = DefaultTolerance) noexcept
+			: BakedAnimationClip()
+		{
+			this->bake(clip, rate, tolerance);
+		}
+
+		// Resamples every curve at `rate` samples per second or more, keeping each track within `tolerance`.
+		// The budget covers both the linear interpolation between samples and the quantization: the rate is
+		// doubled up to MaxSampleRate until the curves stay within half the budget halfway between samples,
+		// and each track is then stored in the smallest form that fits what is left. maxError records the
+		// worst error reached, which only exceeds the budget when MaxSampleRate is not enough.
+		void bake(const AnimationClip<float>& clip, float rate = DefaultSampleRate, float tolerance = DefaultTolerance) noexcept
+		{
+			assert(rate > 0.0f && tolerance > 0.0f);
+
+			std::vector<std::pair<std::string, AnimationCurve<float>>> curves;
+			curves.reserve(clip.curves.size());
+
+			this->name = clip.name;
+			this->timeLength = 0;
+			this->maxError = 0;
+			this->curveNames.clear();
+			this->tracks.clear();
+			this->samples.clear();
+
+			for (auto& it : clip.curves)
+			{
+				if (!it.second.empty())
+				{
+					curves.emplace_back(it.first, it.second);
+					this->timeLength = std::max(this->timeLength, it.second.frames.back().time);
+				}
+			}
+
+			std::sort(curves.begin(), curves.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+			std::vector<std::array<std::size_t, 4>> groups;
+			std::vector<bool> used(curves.size(), false);
+
+			for (std::size_t i = 0; i < curves.size(); i++)
+			{
+				if (used[i])
+					continue;
+
+				std::array<std::size_t, 4> components = { i, i, i, i };
+				if (findQuaternion(curves, i, components.data()))
+				{
+					for (std::size_t n = 0; n < 4; n++)
+					{
+						used[components[n]] = true;
+						this->curveNames.push_back(curves[components[n]].first);
+					}
+				}
+				else
+				{
+					used[i] = true;
+					this->curveNames.push_back(curves[i].first);
+				}
+
+				groups.push_back(components);
+			}
+
+			std::vector<std::vector<float>> values(groups.size());
+			std::vector<float> errors(groups.size());
+
+			for (;;)
+			{
+				this->sampleRate = rate;
+				this->numFrames = static_cast<std::uint32_t>(std::ceil(this->timeLength * rate)) + 1;
+
+				float worst = 0;
+
+				for (std::size_t i = 0; i < groups.size(); i++)
+				{
+					if (groups[i][0] != groups[i][1])
+						errors[i] = this->resampleQuaternion(curves, groups[i].data(), values[i]);
+					else
+						errors[i] = this->resample(curves[groups[i][0]].second, values[i]);
+
+					worst = std::max(worst, errors[i]);
+				}
+
+				if (worst <= tolerance * 0.5f || rate * 2.0f > MaxSampleRate)
+					break;
+
+				rate *= 2.0f;
+			}
+
+			for (std::size_t i = 0, value = 0; i < groups.size(); i++)
+			{
+				auto budget = std::max(0.0f, tolerance - errors[i]);
+				auto& channel = values[i];
+
+				BakedTrack track = {};
+				track.value = static_cast<std::uint32_t>(value);
+
+				if (groups[i][0] != groups[i][1])
+				{
+					float deviation = 0;
+					for (std::uint32_t f = 1; f < this->numFrames; f++)
+					{
+						float sign = dot(&channel[0], &channel[f * 4]) < 0.0f ? -1.0f : 1.0f;
+						for (std::size_t n = 0; n < 4; n++)
+							deviation = std::max(deviation, std::fabs(channel[f * 4 + n] * sign - channel[n]));
+					}
+
+					if (deviation <= budget)
+					{
+						track.type = BakedTrackType::ConstantQuaternion;
+						std::memcpy(track.constant, &channel[0], sizeof(track.constant));
+						errors[i] += deviation;
+					}
+					else
+					{
+						track.type = BakedTrackType::Quaternion;
+						track.stride = 3;
+						errors[i] += QuaternionStepError;
+					}
+
+					value += 4;
+				}
+				else
+				{
+					auto range = std::minmax_element(channel.begin(), channel.end());
+
+					track.minimum = *range.first;
+					track.extent = *range.second - *range.first;
+
+					if (track.extent * 0.5f <= budget)
+					{
+						track.type = BakedTrackType::Constant;
+						track.constant[0] = track.minimum + track.extent * 0.5f;
+						errors[i] += track.extent * 0.5f;
+					}
+					else if (track.extent / 65535.0f * 0.5f <= budget)
+					{
+						track.type = BakedTrackType::Quantized;
+						track.stride = 1;
+						errors[i] += track.extent / 65535.0f * 0.5f;
+					}
+					else
+					{
+						track.type = BakedTrackType::Float;
+						track.stride = 2;
+					}
+
+					value += 1;
+				}
+
+				this->maxError = std::max(this->maxError, errors[i]);
+				this->tracks.push_back(track);
+			}
+
+			this->frameStride = 0;
+			for (auto& track : this->tracks)
+			{
+				track.offset = static_cast<std::uint16_t>(this->frameStride);
+				this->frameStride += track.stride;
+			}
+
+			this->samples.resize(static_cast<std::size_t>(this->frameStride) * this->numFrames);
+
+			for (std::uint32_t f = 0; f < this->numFrames; f++)
+			{
+				auto frame = this->samples.data() + static_cast<std::size_t>(f) * this->frameStride;
+
+				for (std::size_t i = 0; i < this->tracks.size(); i++)
+				{
+					auto& track = this->tracks[i];
+					auto words = frame + track.offset;
+
+					switch (track.type)
+					{
+					case BakedTrackType::Quantized:
+						words[0] = static_cast<std::uint16_t>(std::lround((values[i][f] - track.minimum) / track.extent * 65535.0f));
+						break;
+					case BakedTrackType::Float:
+						std::memcpy(words, &values[i][f], sizeof(float));
+						break;
+					case BakedTrackType::Quaternion:
+						encodeQuaternion(&values[i][f * 4], words);
+						break;
+					default:
+						break;
+					}
+				}
+			}
+		}
+
+		bool empty() const noexcept
+		{
+			return this->tracks.empty();
+		}
+
+		std::size_t getNumValues() const noexcept
+		{
+			return this->curveNames.size();
+		}
+
+		std::size_t getMemorySize() const noexcept
+		{
+			return this->samples.size() * sizeof(std::uint16_t) + this->tracks.size() * sizeof(BakedTrack);
+		}
+
+		// Writes one value per entry of curveNames.
+		void evaluate(float time, float values[]) const noexcept
+		{
+			if (this->numFrames == 0)
+				return;
+
+			float position = std::clamp(time * this->sampleRate, 0.0f, static_cast<float>(this->numFrames - 1));
+			std::uint32_t index = std::min(static_cast<std::uint32_t>(position), this->numFrames > 1 ? this->numFrames - 2 : 0);
+			float t = this->numFrames > 1 ? position - index : 0.0f;
+
+			auto a = this->samples.data() + static_cast<std::size_t>(index) * this->frameStride;
+			auto b = this->numFrames > 1 ? a + this->frameStride : a;
+
+			for (auto& track : this->tracks)
+			{
+				auto out = values + track.value;
+
+				switch (track.type)
+				{
+				case BakedTrackType::Constant:
+				{
+					out[0] = track.constant[0];
+				}
+				break;
+				case BakedTrackType::Quantized:
+				{
+					float scale = track.extent / 65535.0f;
+					float va = track.minimum + a[track.offset] * scale;
+					float vb = track.minimum + b[track.offset] * scale;
+					out[0] = va + (vb - va) * t;
+				}
+				break;
+				case BakedTrackType::Float:
+				{
+					float va, vb;
+					std::memcpy(&va, a + track.offset, sizeof(float));
+					std::memcpy(&vb, b + track.offset, sizeof(float));
+					out[0] = va + (vb - va) * t;
+				}
+				break;
+				case BakedTrackType::Quaternion:
+				{
+					float qa[4], qb[4];
+					decodeQuaternion(a + track.offset, qa);
+					decodeQuaternion(b + track.offset, qb);
+
+					float sign = dot(qa, qb) < 0.0f ? -1.0f : 1.0f;
+					for (std::size_t n = 0; n < 4; n++)
+						out[n] = qa[n] + (qb[n] * sign - qa[n]) * t;
+
+					normalize(out);
+				}
+				break;
+				case BakedTrackType::ConstantQuaternion:
+				{
+					std::memcpy(out, track.constant, sizeof(track.constant));
+				}
+				break;
+				}
+			}
+		}
+
+	private:
+		// Samples the curve at every frame and returns how far it strays from the linear interpolation
+		// of the samples halfway between them.
+		float resample(const AnimationCurve<float>& source, std::vector<float>& channel) const noexcept
+		{
+			auto curve = source;
+			channel.resize(this->numFrames);
+
+			float error = 0;
+
+			for (std::uint32_t f = 0; f < this->numFrames; f++)
+			{
+				curve.setTime(f / this->sampleRate);
+				channel[f] = curve.value;
+
+				if (f > 0)
+				{
+					curve.setTime((f - 0.5f) / this->sampleRate);
+					error = std::max(error, std::fabs(curve.value - (channel[f - 1] + channel[f]) * 0.5f));
+				}
+			}
+
+			return error;
+		}
+
+		float resampleQuaternion(const std::vector<std::pair<std::string, AnimationCurve<float>>>& curves, const std::size_t components[4], std::vector<float>& packed) const noexcept
+		{
+			std::vector<float> channels[4];
+			std::vector<float> midpoints[4];
+
+			for (std::size_t n = 0; n < 4; n++)
+			{
+				auto curve = curves[components[n]].second;
+				channels[n].resize(this->numFrames);
+				midpoints[n].resize(this->numFrames);
+
+				for (std::uint32_t f = 0; f < this->numFrames; f++)
+				{
+					curve.setTime(f / this->sampleRate);
+					channels[n][f] = curve.value;
+
+					if (f > 0)
+					{
+						curve.setTime((f - 0.5f) / this->sampleRate);
+						midpoints[n][f] = curve.value;
+					}
+				}
+			}
+
+			packed.resize(this->numFrames * 4);
+
+			float error = 0;
+
+			for (std::uint32_t f = 0; f < this->numFrames; f++)
+			{
+				auto q = &packed[f * 4];
+				for (std::size_t n = 0; n < 4; n++)
+					q[n] = channels[n][f];
+
+				normalize(q);
+
+				if (f > 0)
+				{
+					float middle[4] = { midpoints[0][f], midpoints[1][f], midpoints[2][f], midpoints[3][f] };
+					normalize(middle);
+
+					auto last = q - 4;
+					float sign = dot(last, q) < 0.0f ? -1.0f : 1.0f;
+
+					float blend[4];
+					for (std::size_t n = 0; n < 4; n++)
+						blend[n] = last[n] + q[n] * sign;
+
+					normalize(blend);
+
+					sign = dot(blend, middle) < 0.0f ? -1.0f : 1.0f;
+					for (std::size_t n = 0; n < 4; n++)
+						error = std::max(error, std::fabs(blend[n] - middle[n] * sign));
+				}
+			}
+
+			return error;
+		}
+
+		static bool findQuaternion(const std::vector<std::pair<std::string, AnimationCurve<float>>>& curves, std::size_t i, std::size_t components[4]) noexcept
+		{
+			auto& name = curves[i].first;
+			if (name.size() < 2 || name[name.size() - 2] != '.' || name.find("Rotation") == std::string::npos)
+				return false;
+
+			auto prefix = name.substr(0, name.size() - 1);
+			bool upper = std::isupper(static_cast<unsigned char>(name.back()));
+
+			const char* axis = upper ? "XYZW" : "xyzw";
+			for (std::size_t n = 0; n < 4; n++)
+			{
+				auto it = std::lower_bound(curves.begin(), curves.end(), prefix + axis[n], [](const auto& a, const std::string& b) { return a.first < b; });
+				if (it == curves.end() || it->first != prefix + axis[n])
+					return false;
+
+				components[n] = static_cast<std::size_t>(it - curves.begin());
+			}
+
+			return true;
+		}
+
+		static float dot(const float a[4], const float b[4]) noexcept
+		{
+			return a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+		}
+
+		static void normalize(float q[4]) noexcept
+		{
+			float length = std::sqrt(dot(q, q));
+			if (length > 0.0f)
+			{
+				for (std::size_t n = 0; n < 4; n++)
+					q[n] /= length;
+			}
+			else
+			{
+				q[0] = q[1] = q[2] = 0.0f;
+				q[3] = 1.0f;
+			}
+		}
+
+		// Drops the largest component, which is recovered from the unit length, and stores the other three
+		// in [-1/sqrt(2), 1/sqrt(2)] with 15 bits each. The two index bits live in the spare high bits.
+		static void encodeQuaternion(const float q[4], std::uint16_t words[3]) noexcept
+		{
+			std::uint16_t largest = 0;
+			for (std::uint16_t n = 1; n < 4; n++)
+			{
+				if (std::fabs(q[n]) > std::fabs(q[largest]))
+					largest = n;
+			}
+
+			float sign = q[largest] < 0.0f ? -1.0f : 1.0f;
+			constexpr float scale = (1 << QuaternionBits) - 1;
+
+			for (std::uint16_t n = 0, k = 0; n < 4; n++)
+			{
+				if (n == largest)
+					continue;
+
+				float v = std::clamp(q[n] * sign * 0.70710678f + 0.5f, 0.0f, 1.0f);
+				words[k++] = static_cast<std::uint16_t>(std::lround(v * scale));
+			}
+
+			words[0] |= (largest & 1) << QuaternionBits;
+			words[1] |= (largest >> 1) << QuaternionBits;
+		}
+
+		static void decodeQuaternion(const std::uint16_t words[3], float q[4]) noexcept
+		{
+			constexpr std::uint16_t mask = (1 << QuaternionBits) - 1;
+			constexpr float scale = 1.0f / mask;
+
+			std::uint16_t largest = (words[0] >> QuaternionBits) | ((words[1] >> QuaternionBits) << 1);
+
+			float sum = 0.0f;
+			for (std::uint16_t n = 0, k = 0; n < 4; n++)
+			{
+				if (n == largest)
+					continue;
+
+				float v = ((words[k++] & mask) * scale - 0.5f) * 1.41421356f;
+				q[n] = v;
+				sum += v * v;
+			}
+
+			q[largest] = std::sqrt(std::max(0.0f, 1.0f - sum));
+		}
+	};
+
+	using BakedAnimationClips = std::vector<BakedAnimationClip>;
+}
+
+#endif
@@ -2,18 +2,51 @@
 #define OCTOON_PATH_ITERPOLATOR_H_
 
 #include <octoon/animation/interpolator.h>
+#include <octoon/math/mathutil.h>
+
+#include <array>
+#include <map>
+#include <mutex>
+#include <memory>
+#include <algorithm>
+#include <cmath>
 
 namespace octoon::animation
 {
+	// Cubic bezier easing from (0,0) to (1,1) with the control points (xa,ya) and (xb,yb).
+	// The curve parameter is tabulated against uniform x once per control-point set, so an evaluation
+	// starts from a lerp of the table and usually converges after one bracketed Newton step.
 	template<typename T = float>
 	class PathInterpolator final : public Interpolator<T>
 	{
 	public:
-		PathInterpolator() noexcept = default;
-		PathInterpolator(T ip[4]) noexcept : xa(ip[0]), xb(ip[1]), ya(ip[2]), yb(ip[3]) {};
-		PathInterpolator(T xa_, T xb_, T ya_, T yb_) noexcept : xa(xa_), xb(xb_), ya(ya_), yb(yb_) {};
+		static constexpr std::size_t Samples = 32;
+
+		PathInterpolator() noexcept : PathInterpolator(0.0f, 1.0f, 0.0f, 1.0f) {};
+		PathInterpolator(T ip[4]) noexcept : PathInterpolator(ip[0], ip[1], ip[2], ip[3]) {};
+		PathInterpolator(T xa_, T xb_, T ya_, T yb_) noexcept : xa(xa_), xb(xb_), ya(ya_), yb(yb_) { this->build(); };
 		virtual ~PathInterpolator() noexcept = default;
 
+		// Returns the interpolator shared by every caller asking for the same control points,
+		// motion files reuse a handful of curve shapes across thousands of keyframes.
+		static std::shared_ptr<PathInterpolator> create(T xa_, T xb_, T ya_, T yb_) noexcept
+		{
+			static std::mutex mutex;
+			static std::map<std::array<T, 4>, std::weak_ptr<PathInterpolator>> interpolators;
+
+			std::lock_guard<std::mutex> guard(mutex);
+
+			auto& entry = interpolators[std::array<T, 4>{ xa_, xb_, ya_, yb_ }];
+			auto interpolator = entry.lock();
+			if (!interpolator)
+			{
+				interpolator = std::make_shared<PathInterpolator>(xa_, xb_, ya_, yb_);
+				entry = interpolator;
+			}
+
+			return interpolator;
+		}
+
 		T evalX(T t) const noexcept
 		{
 			T x11 = xa * t;
@@ -38,31 +71,66 @@ namespace octoon::animation
 			return y21 + (y22 - y21) * t;
 		}
 
+		T evalDerivativeX(T t) const noexcept
+		{
+			T s = 1.0f - t;
+			return 3.0f * (s * s * xa + 2.0f * s * t * (xb - xa) + t * t * (1.0f - xb));
+		}
+
 		T interpolator(T time) const noexcept override
 		{
-			T min = 0.0f;
-			T max = 1.0f;
+			T x = std::clamp<T>(time, 0.0f, 1.0f) * Samples;
+			std::size_t i = std::min(static_cast<std::size_t>(x), Samples - 1);
 
-			T t = 0.5f;
-			T x = this->evalX(t);
+			T min = table[i];
+			T max = table[i + 1];
+			T t = min + (max - min) * (x - i);
 
-			while (std::fabs(x - time) > math::EPSILON_E4)
+			for (std::size_t n = 0; n < 4; n++)
 			{
-				if (x < time)
+				T error = this->evalX(t) - time;
+				if (std::fabs(error) < math::EPSILON_E5)
+					break;
+
+				if (error < 0.0f)
 					min = t;
 				else
 					max = t;
 
-				t = (min + max) * 0.5f;
-				x = evalX(t);
+				T dx = this->evalDerivativeX(t);
+				T next = dx > math::EPSILON_E5 ? t - error / dx : min;
+				t = (next > min && next < max) ? next : (min + max) * 0.5f;
 			}
 
 			return this->evalY(t);
 		}
 
+	private:
+		void build() noexcept
+		{
+			for (std::size_t i = 0; i <= Samples; i++)
+			{
+				T x = static_cast<T>(i) / Samples;
+				T min = 0.0f;
+				T max = 1.0f;
+
+				for (std::size_t n = 0; n < 24; n++)
+				{
+					T t = (min + max) * 0.5f;
+					if (this->evalX(t) < x)
+						min = t;
+					else
+						max = t;
+				}
+
+				table[i] = (min + max) * 0.5f;
+			}
+		}
+
 	private:
 		T xa, xb, ya, yb;
+		std::array<T, Samples + 1> table;
 	};
 }
 
-#endif
\ No newline at end of file
+#endif
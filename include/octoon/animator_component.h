@@ -2,6 +2,8 @@
 #define OCTOON_ANIMATOR_COMPONENT_H_
 
 #include <octoon/animation_component.h>
+#include <octoon/animation/baked_animation_clip.h>
+#include <octoon/transform_hierarchy.h>
 
 namespace octoon
 {
@@ -38,10 +40,20 @@ namespace octoon
 		void setAnimation(const animation::Animation<float>& animation) noexcept;
 		
 		const animation::Animation<float>& getAnimation() const noexcept;
+
+		// Plays clips baked at a fixed rate instead of the keyframe curves, clip i drives avatar bone i.
+		void setBakedAnimation(animation::BakedAnimationClips&& clips) noexcept;
+		void setBakedAnimation(const animation::BakedAnimationClips& clips) noexcept;
+		const animation::BakedAnimationClips& getBakedAnimation() const noexcept;
+
+		// Bakes the current animation and switches playback to the baked clips, keeping the current time.
+		void bakeAnimation(float rate = animation::BakedAnimationClip::DefaultSampleRate, float tolerance = animation::BakedAnimationClip::DefaultTolerance) noexcept;
 		const animation::AnimatorStateInfo<float>& getCurrentAnimatorStateInfo() const noexcept override;
 
 		GameComponentPtr clone() const noexcept;
 
+		bool getUpdateFootprint(GameUpdateFootprint& footprint) const noexcept override;
+
 	private:
 		void onActivate() except;
 		void onDeactivate() noexcept;
@@ -51,17 +63,65 @@ namespace octoon
 	private:
 		void updateAvatar(float delta = 0.0f) noexcept;
 		void updateAnimation(float delta = 0.0f) noexcept;
+		void updateBakedAnimation() noexcept;
+
+		void advance(float delta) noexcept;
+		bool isClipFinished(std::size_t index) const noexcept;
 
 	private:
 		void onAttachAvatar(const GameObjects& avatar) noexcept;
 
+		bool hasRigidbodies() const noexcept;
+		void onAttachAnimation() noexcept;
+		void onAttachBinding(const std::string& name, const float* value) noexcept;
+
 	private:
+		enum class CurveChannel : std::uint8_t
+		{
+			LocalPositionX,
+			LocalPositionY,
+			LocalPositionZ,
+			LocalScaleX,
+			LocalScaleY,
+			LocalScaleZ,
+			LocalRotationX,
+			LocalRotationY,
+			LocalRotationZ,
+			LocalRotationW,
+			LocalEulerAnglesRawX,
+			LocalEulerAnglesRawY,
+			LocalEulerAnglesRawZ,
+			TransformMove,
+			Message,
+		};
+
+		// A curve resolved to the channel it drives when the animation is assigned,
+		// so the per-frame update never hashes or compares curve names. The value is
+		// either the curve's own or a slot in bakedValues_ filled by updateBakedAnimation.
+		struct CurveBinding
+		{
+			CurveChannel channel;
+			const float* value;
+			const std::string* name;
+		};
+
 		bool enableAnimation_;
 		bool enableAnimOnVisableOnly_;
 
 		animation::Animation<float> animation_;
+		animation::BakedAnimationClips baked_;
+		std::vector<float> bakedValues_;
 		math::float3s bindpose_;
 
+		std::vector<CurveBinding> bindings_;
+		std::vector<std::size_t> clipBindings_;
+		std::vector<std::shared_ptr<class TransformComponent>> transforms_;
+
+		TransformHierarchy hierarchy_;
+
+		mutable bool drivesRigidbodies_;
+		mutable std::size_t footprintVersion_;
+
 		GameObjects avatar_;
 	};
 }
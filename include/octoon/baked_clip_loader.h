@@ -0,0 +1,29 @@
+#ifndef OCTOON_BAKED_CLIP_LOADER_H_
+#define OCTOON_BAKED_CLIP_LOADER_H_
+
+#include <octoon/io/iostream.h>
+#include <octoon/animation/baked_animation_clip.h>
+
+namespace octoon
+{
+	// Binary container for baked clips. A fixed-size header records the offset of every block and
+	// each block starts 64-byte aligned, so the track table and the sample words can be mapped from disk.
+	class BakedClipLoader final
+	{
+	public:
+		BakedClipLoader() noexcept;
+		~BakedClipLoader() noexcept;
+
+		static bool doCanRead(io::istream& stream) noexcept;
+		static bool doCanRead(const char* type) noexcept;
+
+		static animation::BakedAnimationClip load(io::istream& stream) noexcept(false);
+		static void save(io::ostream& stream, const animation::BakedAnimationClip& clip) noexcept(false);
+
+	private:
+		BakedClipLoader(const BakedClipLoader&) = delete;
+		BakedClipLoader& operator=(const BakedClipLoader&) = delete;
+	};
+}
+
+#endif
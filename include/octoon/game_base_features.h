@@ -24,7 +24,7 @@ namespace octoon
 		void onFrameEnd() noexcept override;
 
 		void onInputEvent(const std::any& data) noexcept;
-		void onFixedUpdate(const std::any& data) noexcept;
+		void onFixedUpdate(const float& delta) noexcept;
 	};
 }
 
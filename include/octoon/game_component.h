@@ -25,7 +25,7 @@ namespace octoon
 		const GameScene* getGameScene() const noexcept;
 
 		template<typename T, typename = std::enable_if_t<std::is_base_of<GameComponent, T>::value>>
-		std::shared_ptr<T> getComponent() const noexcept { return std::dynamic_pointer_cast<T>(this->getComponent(T::RTTI)); }
+		std::shared_ptr<T> getComponent() const noexcept { return std::static_pointer_cast<T>(this->getComponent(T::RTTI)); }
 		GameComponentPtr getComponent(const runtime::Rtti* type) const noexcept;
 		GameComponentPtr getComponent(const runtime::Rtti& type) const noexcept;
 
@@ -35,7 +35,7 @@ namespace octoon
 		void getComponents(const runtime::Rtti& type, GameComponents& components) const noexcept;
 
 		template<typename T, typename = std::enable_if_t<std::is_base_of<GameComponent, T>::value>>
-		std::shared_ptr<T> getComponentInChildren() const noexcept { return std::dynamic_pointer_cast<T>(this->getComponentInChildren(T::RTTI)); }
+		std::shared_ptr<T> getComponentInChildren() const noexcept { return std::static_pointer_cast<T>(this->getComponentInChildren(T::RTTI)); }
 		GameComponentPtr getComponentInChildren(const runtime::Rtti* type) const noexcept;
 		GameComponentPtr getComponentInChildren(const runtime::Rtti& type) const noexcept;
 
@@ -57,6 +57,17 @@ namespace octoon
 		void addMessageListener(std::string_view event, std::function<void(const std::any&)> listener) noexcept;
 		void removeMessageListener(std::string_view event, std::function<void(const std::any&)> listener) noexcept;
 
+		void sendMessage(GameMessageId event, const std::any& data = std::any()) noexcept;
+		void sendMessageUpwards(GameMessageId event, const std::any& data = std::any()) noexcept;
+		void sendMessageDownwards(GameMessageId event, const std::any& data = std::any()) noexcept;
+
+		// Typed listeners are owned by this component and removed together by removeMessageListener(event).
+		template<typename T>
+		void sendMessage(GameMessageId event, const T& data) noexcept { assert(gameObject_); gameObject_->sendMessage(event, data); }
+		template<typename T>
+		void addMessageListener(GameMessageId event, std::function<void(const T&)> listener) noexcept { assert(gameObject_); gameObject_->addMessageListener<T>(event, this, std::move(listener)); }
+		void removeMessageListener(GameMessageId event) noexcept;
+
 		template<typename T, typename = std::enable_if_t<std::is_base_of<GameFeature, T>::value>>
 		T* tryGetFeature() const noexcept { return dynamic_cast<T*>(this->tryGetFeature(T::RTTI)); }
 		GameFeature* tryGetFeature(const runtime::Rtti* rtti) const noexcept;
@@ -76,6 +87,10 @@ namespace octoon
 
 		virtual GameComponentPtr clone() const noexcept = 0;
 
+		// Components that fill in a footprint opt into the parallel update phase, where they run concurrently
+		// with every component whose footprint does not overlap. Returning false keeps the serial update.
+		virtual bool getUpdateFootprint(GameUpdateFootprint& footprint) const noexcept;
+
 	protected:
 		void addComponentDispatch(GameDispatchTypes type) noexcept;
 		void removeComponentDispatch(GameDispatchTypes type) noexcept;
@@ -109,6 +124,7 @@ namespace octoon
 
 	private:
 		friend GameObject;
+		friend GameObjectManager;
 		void _setGameObject(GameObject* gameobj) noexcept;
 
 	private:
@@ -2,6 +2,7 @@
 #define OCTOON_GAME_FEATURE_H_
 
 #include <octoon/game_types.h>
+#include <octoon/game_message.h>
 
 #include <any>
 #include <functional>
@@ -30,6 +31,17 @@ namespace octoon
 		void addMessageListener(std::string_view event, std::function<void(const std::any&)> listener) noexcept;
 		void removeMessageListener(std::string_view event, std::function<void(const std::any&)> listener) noexcept;
 
+		void sendMessage(GameMessageId event, const std::any& data = std::any()) noexcept;
+		void addMessageListener(GameMessageId event, std::function<void(const std::any&)> listener) noexcept;
+		void removeMessageListener(GameMessageId event, std::function<void(const std::any&)> listener) noexcept;
+
+		// Typed listeners are owned by this feature and removed together by removeMessageListener(event).
+		template<typename T>
+		void sendMessage(GameMessageId event, const T& data) noexcept { this->getMessageDispatcher().send(event, data); }
+		template<typename T>
+		void addMessageListener(GameMessageId event, std::function<void(const T&)> listener) noexcept { this->getMessageDispatcher().connect<T>(event, this, std::move(listener)); }
+		void removeMessageListener(GameMessageId event) noexcept;
+
 		GameServer* getGameServer() noexcept;
 
 	protected:
@@ -49,6 +61,8 @@ namespace octoon
 		friend GameServer;
 		void _setGameServer(GameServer* server) noexcept;
 
+		GameMessageDispatcher& getMessageDispatcher() const noexcept;
+
 	private:
 		GameFeature(const GameFeature&) noexcept = delete;
 		GameFeature& operator=(const GameFeature&) noexcept = delete;
@@ -0,0 +1,107 @@
+#ifndef OCTOON_GAME_MESSAGE_H_
+#define OCTOON_GAME_MESSAGE_H_
+
+#include <octoon/game_types.h>
+#include <octoon/runtime/sigslot.h>
+
+#include <any>
+#include <typeinfo>
+#include <functional>
+
+namespace octoon
+{
+	typedef std::uint32_t GameMessageId;
+
+	// Process-wide table of message names. Ids are dense, handed out on first registration and never reused,
+	// so callers on hot paths can resolve a name once and dispatch by index afterwards.
+	class OCTOON_EXPORT GameMessage final
+	{
+	public:
+		static constexpr GameMessageId InvalidId = ~0u;
+
+		static GameMessageId id(std::string_view name) noexcept;
+		static GameMessageId find(std::string_view name) noexcept;
+		static const std::string& name(GameMessageId id) noexcept;
+
+	private:
+		GameMessage() = delete;
+	};
+
+	// Listeners indexed by message id. Untyped listeners receive the payload boxed in std::any,
+	// typed listeners receive it by reference and are never boxed when sent through a typed send.
+	class OCTOON_EXPORT GameMessageDispatcher final
+	{
+	public:
+		GameMessageDispatcher() noexcept;
+		~GameMessageDispatcher() noexcept;
+
+		void send(GameMessageId id, const std::any& data) noexcept;
+
+		template<typename T>
+		void send(GameMessageId id, const T& data) noexcept
+		{
+			auto channel = this->getChannel(id);
+			if (channel)
+			{
+				this->invoke(*channel, typeid(T), &data, nullptr);
+
+				if (channel->boxed)
+					channel->listeners.call_all_slots(std::any(data));
+			}
+		}
+
+		void connect(GameMessageId id, std::function<void(const std::any&)> listener) noexcept;
+		void disconnect(GameMessageId id, std::function<void(const std::any&)> listener) noexcept;
+
+		template<typename T>
+		void connect(GameMessageId id, const void* owner, std::function<void(const T&)> listener) noexcept
+		{
+			auto slot = std::make_shared<Slot>();
+			slot->owner = owner;
+			slot->type = &typeid(T);
+			slot->invoke = [listener = std::move(listener)](const void* data, const std::any* boxed)
+			{
+				if (data)
+					listener(*static_cast<const T*>(data));
+				else if (auto value = std::any_cast<T>(boxed))
+					listener(*value);
+			};
+
+			this->connect(id, std::move(slot));
+		}
+
+		void disconnect(GameMessageId id, const void* owner) noexcept;
+
+		void clear() noexcept;
+
+	private:
+		struct Slot
+		{
+			const void* owner;
+			const std::type_info* type;
+			std::function<void(const void* data, const std::any* boxed)> invoke;
+		};
+
+		struct Channel
+		{
+			bool boxed;
+			std::vector<std::shared_ptr<Slot>> slots;
+			runtime::signal<void(const std::any&)> listeners;
+		};
+
+		Channel* getChannel(GameMessageId id) const noexcept;
+		Channel& createChannel(GameMessageId id) noexcept;
+
+		void connect(GameMessageId id, std::shared_ptr<Slot>&& slot) noexcept;
+		void invoke(Channel& channel, const std::type_info& type, const void* data, const std::any* boxed) noexcept;
+
+	private:
+		GameMessageDispatcher(const GameMessageDispatcher&) = delete;
+		GameMessageDispatcher& operator=(const GameMessageDispatcher&) = delete;
+
+	private:
+		std::vector<std::unique_ptr<Channel>> channels_;
+	};
+}
+
+#endif
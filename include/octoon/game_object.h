@@ -2,11 +2,12 @@
 #define OCTOON_GAME_OBJECT_H_
 
 #include <octoon/game_types.h>
-#include <octoon/runtime/sigslot.h>
+#include <octoon/game_message.h>
 #include <octoon/io/iarchive.h>
 
 #include <any>
 #include <functional>
+#include <unordered_map>
 
 namespace octoon
 {
@@ -44,6 +45,10 @@ namespace octoon
 		GameObjectPtr findChild(std::string_view name, bool recurse = true) noexcept;
 
 		std::size_t getChildCount() const noexcept;
+
+		// Changes whenever any object is reparented or destroyed or gains or loses a component,
+		// so flattened views of the scene graph can tell when they have to be rebuilt.
+		static std::size_t getHierarchyVersion() noexcept;
 		GameObjects& getChildren() noexcept;
 		const GameObjects& getChildren() const noexcept;
 
@@ -54,7 +59,7 @@ namespace octoon
 		void addComponent(GameComponents&& component) except;
 
 		template<typename T, typename = std::enable_if_t<std::is_base_of<GameComponent, T>::value>>
-		std::shared_ptr<T> getComponent() const noexcept { return std::dynamic_pointer_cast<T>(this->getComponent(T::RTTI)); }
+		std::shared_ptr<T> getComponent() const noexcept { return std::static_pointer_cast<T>(this->getComponent(T::RTTI)); }
 		GameComponentPtr getComponent(const runtime::Rtti* type) const noexcept;
 		GameComponentPtr getComponent(const runtime::Rtti& type) const noexcept;
 
@@ -64,7 +69,7 @@ namespace octoon
 		void getComponents(const runtime::Rtti& type, GameComponents& components) const noexcept;
 
 		template<typename T, typename = std::enable_if_t<std::is_base_of<GameComponent, T>::value>>
-		std::shared_ptr<T> getComponentInChildren() const noexcept { return std::dynamic_pointer_cast<T>(this->getComponentInChildren(T::RTTI)); }
+		std::shared_ptr<T> getComponentInChildren() const noexcept { return std::static_pointer_cast<T>(this->getComponentInChildren(T::RTTI)); }
 		GameComponentPtr getComponentInChildren(const runtime::Rtti* type) const noexcept;
 		GameComponentPtr getComponentInChildren(const runtime::Rtti& type) const noexcept;
 
@@ -90,6 +95,18 @@ namespace octoon
 		void addMessageListener(std::string_view event, std::function<void(const std::any&)> listener) noexcept;
 		void removeMessageListener(std::string_view event, std::function<void(const std::any&)> listener) noexcept;
 
+		void sendMessage(GameMessageId event, const std::any& data = std::any()) noexcept;
+		void sendMessageUpwards(GameMessageId event, const std::any& data = std::any()) noexcept;
+		void sendMessageDownwards(GameMessageId event, const std::any& data = std::any()) noexcept;
+		void addMessageListener(GameMessageId event, std::function<void(const std::any&)> listener) noexcept;
+		void removeMessageListener(GameMessageId event, std::function<void(const std::any&)> listener) noexcept;
+
+		template<typename T>
+		void sendMessage(GameMessageId event, const T& data) noexcept { dispatchEvents_.send(event, data); }
+		template<typename T>
+		void addMessageListener(GameMessageId event, const void* owner, std::function<void(const T&)> listener) noexcept { dispatchEvents_.connect<T>(event, owner, std::move(listener)); }
+		void removeMessageListener(GameMessageId event, const void* owner) noexcept;
+
 		virtual GameScene* getGameScene() noexcept;
 		virtual const GameScene* getGameScene() const noexcept;
 
@@ -109,6 +126,8 @@ namespace octoon
 		void removeComponentDispatch(GameDispatchTypes type, const GameComponent* component) noexcept;
 		void removeComponentDispatchs(const GameComponent* component) noexcept;
 
+		void updateComponentLookup() noexcept;
+
 	private:
 		friend class GameObjectManager;
 		friend class TransformComponent;
@@ -144,8 +163,9 @@ namespace octoon
 		GameObjectWeakPtr parent_;
 
 		GameComponents components_;
+		std::unordered_map<const runtime::Rtti*, GameComponentPtr> componentLookup_;
 		std::vector<GameComponentRaws> dispatchComponents_;
-		std::map<std::string, runtime::signal<void(const std::any&)>, std::less<>> dispatchEvents_;
+		GameMessageDispatcher dispatchEvents_;
 	};
 }
 
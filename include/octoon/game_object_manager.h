@@ -3,8 +3,10 @@
 
 #include <stack>
 #include <shared_mutex>
+#include <unordered_map>
 #include <octoon/game_object.h>
 #include <octoon/runtime/singleton.h>
+#include <octoon/runtime/job_system.h>
 
 namespace octoon
 {
@@ -19,16 +21,44 @@ namespace octoon
 
 		const GameObjectRaws& instances() const noexcept;
 
+		// Components of exactly this type, packed in one array across every game object.
+		const GameComponentRaws& getComponentsOfType(const runtime::Rtti* type) const noexcept;
+		const GameComponentRaws& getComponentsOfType(const runtime::Rtti& type) const noexcept;
+
+		// Visits every component derived from T, one contiguous array per concrete type.
+		template<typename T, typename Function, typename = std::enable_if_t<std::is_base_of<GameComponent, T>::value>>
+		void forEachComponent(Function&& func) const
+		{
+			for (auto& it : componentTypes_)
+			{
+				if (it.first->isDerivedFrom(T::getRtti()))
+				{
+					for (auto& component : it.second)
+						func(static_cast<T*>(component));
+				}
+			}
+		}
+
 		void onFixedUpdate() except;
 		void onUpdate() except;
 		void onLateUpdate() except;
 
 		void onGui() except;
 
+		// Worker threads used by the parallel update phase, zero keeps every update on the calling thread.
+		void setNumThreads(std::uint32_t numThreads) noexcept;
+		std::uint32_t getNumThreads() const noexcept;
+
+		runtime::JobSystem& getJobSystem() noexcept;
+
 		void sendMessage(std::string_view event, const std::any& data = std::any()) noexcept;
 		void addMessageListener(std::string_view event, std::function<void(const std::any&)> listener) noexcept;
 		void removeMessageListener(std::string_view event, std::function<void(const std::any&)> listener) noexcept;
 
+		void sendMessage(GameMessageId event, const std::any& data = std::any()) noexcept;
+		void addMessageListener(GameMessageId event, std::function<void(const std::any&)> listener) noexcept;
+		void removeMessageListener(GameMessageId event, std::function<void(const std::any&)> listener) noexcept;
+
 	private:
 		friend GameObject;
 
@@ -36,6 +66,14 @@ namespace octoon
 		void _unsetObject(GameObject* entity) noexcept;
 		void _activeObject(GameObject* entity, bool active) noexcept;
 
+		void _addComponent(GameComponent* component) noexcept;
+		void _removeComponent(GameComponent* component) noexcept;
+
+	private:
+		void dispatchParallel(GameDispatchTypes type) except;
+		void dispatchWaves(GameDispatchTypes type) except;
+		static void dispatchComponent(GameComponent* component, GameDispatchTypes type) except;
+
 	private:
 		bool hasEmptyActors_;
 
@@ -45,8 +83,16 @@ namespace octoon
 		std::shared_mutex lock_;
 		std::stack<std::size_t> emptyLists_;
 
+		std::unordered_map<const runtime::Rtti*, GameComponentRaws> componentTypes_;
+
 		std::vector<GameComponentRaws> dispatchComponents_;
-		std::map<std::string, runtime::signal<void(const std::any&)>, std::less<>> dispatchEvents_;
+		GameMessageDispatcher dispatchEvents_;
+
+		runtime::JobSystem jobSystem_;
+
+		GameUpdateFootprint footprint_;
+		std::vector<std::pair<std::uint32_t, GameComponent*>> parallelComponents_;
+		std::unordered_map<const void*, std::pair<std::uint32_t, std::uint32_t>> footprints_;
 	};
 }
 
@@ -2,7 +2,7 @@
 #define OCTOON_GAME_SERVER_H_
 
 #include <octoon/game_types.h>
-#include <octoon/runtime/sigslot.h>
+#include <octoon/game_message.h>
 
 #include <any>
 #include <map>
@@ -59,6 +59,16 @@ namespace octoon
 		void addMessageListener(std::string_view event, std::function<void(const std::any&)> listener) noexcept;
 		void removeMessageListener(std::string_view event, std::function<void(const std::any&)> listener) noexcept;
 
+		void sendMessage(GameMessageId event, const std::any& data = std::any()) noexcept;
+		void addMessageListener(GameMessageId event, std::function<void(const std::any&)> listener) noexcept;
+		void removeMessageListener(GameMessageId event, std::function<void(const std::any&)> listener) noexcept;
+
+		template<typename T>
+		void sendMessage(GameMessageId event, const T& data) noexcept { dispatchEvents_.send(event, data); }
+		template<typename T>
+		void addMessageListener(GameMessageId event, const void* owner, std::function<void(const T&)> listener) noexcept { dispatchEvents_.connect<T>(event, owner, std::move(listener)); }
+		void removeMessageListener(GameMessageId event, const void* owner) noexcept;
+
 		GameApp* getGameApp() noexcept;
 
 		void update() noexcept(false);
@@ -69,6 +79,7 @@ namespace octoon
 
 	private:
 		friend GameApp;
+		friend GameFeature;
 		void setGameApp(GameApp* app) noexcept;
 
 	private:
@@ -84,7 +95,7 @@ namespace octoon
 
 		GameApp* gameApp_;
 		GameListenerPtr listener_;
-		std::map<std::string, runtime::signal<void(const std::any&)>> dispatchEvents_;
+		GameMessageDispatcher dispatchEvents_;
 	};
 }
 
@@ -61,6 +61,14 @@ namespace octoon
 	};
 
 	typedef std::uint8_t GameDispatchTypes;
+
+	// Data a component touches while it is updated. Any address can serve as a key as long as every
+	// component uses the same one for the same data, typically the game objects it reads or moves.
+	struct GameUpdateFootprint
+	{
+		std::vector<const void*> reads;
+		std::vector<const void*> writes;
+	};
 }
 
 #endif
\ No newline at end of file
@@ -21,6 +21,21 @@ namespace octoon
 			GraphicsSwapchainPtr _swapchain;
 		};
 
+		// Commands recorded by a device, for backends that count them.
+		struct GraphicsStatistics
+		{
+			std::uint64_t pipelineBinds = 0;
+			std::uint64_t descriptorSetBinds = 0;
+			std::uint64_t vertexBufferBinds = 0;
+			std::uint64_t indexBufferBinds = 0;
+			std::uint64_t framebufferBinds = 0;
+			std::uint64_t uniformWrites = 0;
+			std::uint64_t drawCalls = 0;
+			std::uint64_t instances = 0;
+			std::uint64_t vertices = 0;
+			std::uint64_t bytesUploaded = 0;
+		};
+
 		class OCTOON_EXPORT GraphicsContext : public GraphicsChild
 		{
 			OctoonDeclareSubInterface(GraphicsContext, GraphicsChild)
@@ -68,6 +83,14 @@ namespace octoon
 			virtual void readFramebufferToCube(std::uint32_t i, std::uint32_t face, const GraphicsTexturePtr& texture, std::uint32_t miplevel, std::uint32_t x, std::uint32_t y, std::uint32_t width, std::uint32_t height) noexcept = 0;
 			virtual GraphicsFramebufferPtr getFramebuffer() const noexcept = 0;
 
+			// Queues a copy of a color attachment into a pixel buffer and returns a ticket, or 0 when unsupported.
+			// The pixels keep the native format of the attachment and are tightly packed; poll the ticket
+			// a frame later and map it once ready to avoid stalling on the GPU queue.
+			virtual std::uint64_t readFramebufferAsync(const GraphicsFramebufferPtr& src, std::uint32_t i, std::uint32_t x, std::uint32_t y, std::uint32_t width, std::uint32_t height) noexcept;
+			virtual bool isReadbackReady(std::uint64_t ticket) noexcept;
+			virtual bool mapReadback(std::uint64_t ticket, void** data, bool wait = true) noexcept;
+			virtual void unmapReadback(std::uint64_t ticket) noexcept;
+
 			virtual void draw(std::uint32_t numVertices, std::uint32_t numInstances, std::uint32_t startVertice, std::uint32_t startInstances) noexcept = 0;
 			virtual void drawIndexed(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t startIndice, std::uint32_t startVertice, std::uint32_t startInstances) noexcept = 0;
 			virtual void drawIndirect(const GraphicsDataPtr& data, std::size_t offset, std::uint32_t drawCount, std::uint32_t stride) noexcept = 0;
@@ -75,6 +98,9 @@ namespace octoon
 
 			virtual void present() noexcept = 0;
 
+			virtual const GraphicsStatistics& getStatistics() const noexcept;
+			virtual void resetStatistics() noexcept;
+
 		private:
 			GraphicsContext(const GraphicsContext&) noexcept = delete;
 			GraphicsContext& operator=(const GraphicsContext&) noexcept = delete;
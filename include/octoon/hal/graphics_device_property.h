@@ -128,6 +128,9 @@ namespace octoon
 			std::uint64_t         optimalBufferCopyOffsetAlignment;
 			std::uint64_t         optimalBufferCopyRowPitchAlignment;
 			std::uint64_t         nonCoherentAtomSize;
+			std::string           vendorName;
+			std::string           deviceName;
+			std::string           driverVersion;
 			std::vector<GraphicsFormat> supportTextures;
 			std::vector<GraphicsTextureDim> supportTextureDims;
 			std::vector<GraphicsFormat> supportAttribute;
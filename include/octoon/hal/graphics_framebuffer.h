@@ -123,7 +123,7 @@ namespace octoon
 			GraphicsFramebuffer() noexcept = default;
 			virtual ~GraphicsFramebuffer() = default;
 
-			virtual const std::uint64_t handle() const noexcept = 0;
+			virtual std::uint64_t handle() const noexcept = 0;
 			virtual const GraphicsFramebufferDesc& getFramebufferDesc() const noexcept = 0;
 
 		private:
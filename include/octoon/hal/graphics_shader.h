@@ -43,7 +43,7 @@ namespace octoon
 		class OCTOON_EXPORT GraphicsProgramDesc final
 		{
 		public:
-			GraphicsProgramDesc() noexcept = default;
+			GraphicsProgramDesc() noexcept;
 			~GraphicsProgramDesc() = default;
 
 			bool addShader(GraphicsShaderPtr shader) noexcept;
@@ -51,8 +51,16 @@ namespace octoon
 
 			const GraphicsShaders& getShaders() const noexcept;
 
+			// A program binary returned by GraphicsProgram::getProgramBinary, used instead of the shaders.
+			void setProgramBinary(std::uint32_t format, std::vector<std::uint8_t>&& binary) noexcept;
+			std::uint32_t getProgramBinaryFormat() const noexcept;
+			const std::vector<std::uint8_t>& getProgramBinary() const noexcept;
+
 		private:
 			GraphicsShaders _shaders;
+
+			std::uint32_t _binaryFormat;
+			std::vector<std::uint8_t> _binary;
 		};
 
 		class OCTOON_EXPORT GraphicsAttribute : public runtime::RttiInterface
@@ -144,6 +152,8 @@ namespace octoon
 
 			virtual const GraphicsProgramDesc& getProgramDesc() const noexcept = 0;
 
+			virtual bool getProgramBinary(std::uint32_t& format, std::vector<std::uint8_t>& binary) const noexcept;
+
 		private:
 			GraphicsProgram(const GraphicsProgram&) noexcept = delete;
 			GraphicsProgram& operator=(const GraphicsProgram&) noexcept = delete;
@@ -91,7 +91,7 @@ namespace octoon
 			virtual bool map(std::uint32_t x, std::uint32_t y, std::uint32_t w, std::uint32_t h, std::uint32_t mipLevel, void** data) noexcept = 0;
 			virtual void unmap() noexcept = 0;
 
-			virtual const std::uint64_t handle() const noexcept = 0;
+			virtual std::uint64_t handle() const noexcept = 0;
 			virtual const GraphicsTextureDesc& getTextureDesc() const noexcept = 0;
 
 		private:
@@ -208,6 +208,7 @@ namespace octoon
 			D3D9 = 6,
 			D3D11 = 7,
 			D3D12 = 8,
+			Null = 9,
 		};
 
 		enum class GraphicsSwapInterval : std::uint8_t
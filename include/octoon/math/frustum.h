@@ -0,0 +1,102 @@
+#ifndef OCTOON_MATH_FRUSTUM_H_
+#define OCTOON_MATH_FRUSTUM_H_
+
+#include <octoon/math/mat4.h>
+#include <octoon/math/box3.h>
+#include <octoon/math/sphere.h>
+
+namespace octoon
+{
+	namespace math
+	{
+		namespace detail
+		{
+			template<typename T>
+			class Frustum final
+			{
+			public:
+				enum Side
+				{
+					Left,
+					Right,
+					Bottom,
+					Top,
+					Near,
+					Far,
+					NumSides
+				};
+
+				Vector4<T> planes[NumSides];
+
+				Frustum() noexcept = default;
+				explicit Frustum(const Matrix4x4<T>& viewProject) noexcept { this->extract(viewProject); }
+				~Frustum() = default;
+
+				// Planes are taken from the rows of the clip matrix and point inwards. The near plane
+				// uses the -w <= z bound, which is conservative for depth ranges of [0, w] as well.
+				void extract(const Matrix4x4<T>& m) noexcept
+				{
+					Vector4<T> x(m.a1, m.b1, m.c1, m.d1);
+					Vector4<T> y(m.a2, m.b2, m.c2, m.d2);
+					Vector4<T> z(m.a3, m.b3, m.c3, m.d3);
+					Vector4<T> w(m.a4, m.b4, m.c4, m.d4);
+
+					planes[Left] = w + x;
+					planes[Right] = w - x;
+					planes[Bottom] = w + y;
+					planes[Top] = w - y;
+					planes[Near] = w + z;
+					planes[Far] = w - z;
+
+					for (auto& plane : planes)
+					{
+						T len = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+						if (len > 0)
+							plane /= len;
+					}
+				}
+
+				bool contains(const Vector3<T>& pt) const noexcept
+				{
+					for (auto& plane : planes)
+					{
+						if (plane.x * pt.x + plane.y * pt.y + plane.z * pt.z + plane.w < 0)
+							return false;
+					}
+
+					return true;
+				}
+
+				bool intersects(const Sphere<T>& sphere) const noexcept
+				{
+					for (auto& plane : planes)
+					{
+						if (plane.x * sphere.center.x + plane.y * sphere.center.y + plane.z * sphere.center.z + plane.w < -sphere.radius)
+							return false;
+					}
+
+					return true;
+				}
+
+				// Only tests the corner furthest along each plane normal, so boxes near the frustum edges
+				// may be reported as visible, but a visible box is never rejected.
+				bool intersects(const Box3<T>& aabb) const noexcept
+				{
+					for (auto& plane : planes)
+					{
+						T x = plane.x > 0 ? aabb.max.x : aabb.min.x;
+						T y = plane.y > 0 ? aabb.max.y : aabb.min.y;
+						T z = plane.z > 0 ? aabb.max.z : aabb.min.z;
+
+						if (plane.x * x + plane.y * y + plane.z * z + plane.w < 0)
+							return false;
+					}
+
+					return true;
+				}
+			};
+		}
+	}
+}
+
+#endif
@@ -50,6 +50,9 @@ namespace octoon
 			template<typename T = float>
 			class BoundingBox;
 
+			template<typename T = float>
+			class Frustum;
+
 			template<typename T, std::uint8_t N>
 			class SH;
 		}
@@ -68,6 +71,7 @@ namespace octoon
 		using Triangle = detail::Triangle<float>;
 		using Raycast = detail::Raycast<float>;
 		using BoundingBox = detail::BoundingBox<float>;
+		using Frustum = detail::Frustum<float>;
 
 		// float
 		using float2x2 = detail::Matrix2x2<float>;
@@ -79,6 +83,7 @@ namespace octoon
 		using Spheref = detail::Sphere<float>;
 		using Raycastf = detail::Raycast<float>;
 		using BoundingBoxf = detail::BoundingBox<float>;
+		using Frustumf = detail::Frustum<float>;
 
 		// double
 		using double2x2 = detail::Matrix2x2<double>;
@@ -90,6 +95,7 @@ namespace octoon
 		using Sphered = detail::Sphere<double>;
 		using Raycastd = detail::Raycast<double>;
 		using BoundingBoxd = detail::BoundingBox<double>;
+		using Frustumd = detail::Frustum<double>;
 
 		using H4 = detail::SH<float, 4>;
 		using H6 = detail::SH<float, 6>;
@@ -19,13 +19,18 @@ namespace octoon::mesh
 		math::float3 point;
 	};
 
+	class MeshBVH;
+
 	class OCTOON_EXPORT Mesh : public runtime::RttiInterface
 	{
 		OctoonDeclareSubClass(Mesh, runtime::RttiInterface)
 	public:
 		Mesh() noexcept;
+		Mesh(const Mesh& mesh) noexcept;
 		virtual ~Mesh() noexcept;
 
+		Mesh& operator=(const Mesh& mesh) noexcept;
+
 		void setName(std::string_view name) noexcept;
 		const std::string& getName() const noexcept;
 
@@ -35,6 +40,7 @@ namespace octoon::mesh
 		void setTangentArray(const math::float4s& array) noexcept;
 		void setTexcoordArray(const math::float2s& array, std::uint8_t n = 0) noexcept;
 		void setWeightArray(const skelecton::VertexWeights& array) noexcept;
+		void setSdefArray(const skelecton::VertexSdefs& array) noexcept;
 		void setIndicesArray(const math::uint1s& array, std::size_t n = 0) noexcept;
 		void setBindposes(const math::float4x4s& array) noexcept;
 
@@ -44,6 +50,7 @@ namespace octoon::mesh
 		void setTangentArray(math::float4s&& array) noexcept;
 		void setTexcoordArray(math::float2s&& array, std::uint8_t n = 0) noexcept;
 		void setWeightArray(skelecton::VertexWeights&& array) noexcept;
+		void setSdefArray(skelecton::VertexSdefs&& array) noexcept;
 		void setIndicesArray(math::uint1s&& array, std::size_t n = 0) noexcept;
 		void setBindposes(math::float4x4s&& array) noexcept;
 
@@ -53,6 +60,7 @@ namespace octoon::mesh
 		math::float4s& getColorArray() noexcept;
 		math::float2s& getTexcoordArray(std::uint8_t n = 0) noexcept;
 		skelecton::VertexWeights& getWeightArray() noexcept;
+		skelecton::VertexSdefs& getSdefArray() noexcept;
 		math::uint1s& getIndicesArray(std::size_t n = 0) noexcept;
 		math::float4x4s& getBindposes() noexcept;
 
@@ -62,6 +70,7 @@ namespace octoon::mesh
 		const math::float4s& getColorArray() const noexcept;
 		const math::float2s& getTexcoordArray(std::uint8_t n = 0) const noexcept;
 		const skelecton::VertexWeights& getWeightArray() const noexcept;
+		const skelecton::VertexSdefs& getSdefArray() const noexcept;
 		const math::uint1s& getIndicesArray(std::size_t n = 0) const noexcept;
 
 		const skelecton::Bones& getBoneArray(const skelecton::Bones& array) const noexcept;
@@ -71,13 +80,22 @@ namespace octoon::mesh
 		std::size_t getNumSubsets() const noexcept;
 		std::size_t getTexcoordNums() const noexcept;
 
+		// Welds every vertex whose position, normal, texcoords and skin weights all lie within epsilon of
+		// a vertex kept before it, or match exactly when epsilon is zero. Bones of influences without
+		// weight are ignored. The other vertex arrays keep the first vertex of every group. remap receives
+		// the new index of every old vertex, so morph targets and other data addressing them can follow.
 		void mergeVertices() noexcept;
+		void mergeVertices(math::uint1s& remap, float epsilon = 0.0f) noexcept;
 
 		bool mergeMeshes(const Mesh& mesh, bool force = false) noexcept;
 		bool mergeMeshes(const mesh::CombineMesh instances[], std::size_t numInstance, bool merge) noexcept;
 		bool mergeMeshes(const std::vector<CombineMesh>& instances, bool merge) noexcept;
 
 		void computeFaceNormals(std::vector<math::float3s>& faceNormals) noexcept;
+
+		// Gathers the face normals around every vertex in parallel. The vertex to face adjacency is
+		// cached against the topology version, so indices edited in place need setTopologyDirty().
+		// Marking the mesh dirty after moving vertices keeps it.
 		void computeVertexNormals() noexcept;
 		void computeVertexNormals(std::size_t i) noexcept;
 		void computeVertexNormals(const math::float3s& faceNormals) noexcept;
@@ -85,6 +103,7 @@ namespace octoon::mesh
 		void computeTangents(std::uint8_t texSlot = 0) noexcept;
 		void computeTangentQuats(math::float4s& tangentQuat) const noexcept;
 		void computeBoundingBox() noexcept;
+		void setBoundingBoxes(const std::vector<math::BoundingBox>& boundingBoxes) noexcept;
 		void computeLightMap(std::uint32_t width, std::uint32_t height) noexcept;
 
 		const math::BoundingBox& getBoundingBoxAll() const noexcept;
@@ -93,15 +112,32 @@ namespace octoon::mesh
 		void setDirty(bool dirty) noexcept;
 		bool isDirty() const noexcept;
 
+		// Advances whenever the indices or texture coordinates are replaced by a setter, a merge or a
+		// weld. Code editing the indices in place through the mutable accessors calls setTopologyDirty().
+		void setTopologyDirty() noexcept;
+		std::uint32_t getTopologyVersion() const noexcept;
+
+		// Advances when texture coordinates are edited in place without changing their count, such as
+		// a UV morph. Renderers rewrite the texcoord stream of their existing buffers for it.
+		void setTexcoordDirty() noexcept;
+		std::uint32_t getTexcoordVersion() const noexcept;
+
 		bool raycast(const math::Raycast& ray, RaycastHit& hit) noexcept;
 		bool raycastAll(const math::Raycast& ray, std::vector<RaycastHit>& hits) noexcept;
+		bool raycastAll(const math::Raycast rays[], std::size_t numRays, std::vector<RaycastHit>& hits) noexcept;
+		bool raycastAll(const std::vector<math::Raycast>& rays, std::vector<RaycastHit>& hits) noexcept;
 
 		void clear() noexcept;
 		std::shared_ptr<Mesh> clone() const noexcept;
 
+	private:
+		void updateAdjacency() noexcept;
+
 	private:
 		std::string _name;
 		bool _dirty;
+		std::uint32_t _topologyVersion;
+		std::uint32_t _texcoordVersion;
 
 		math::float3s _vertices;
 		math::float3s _normals;
@@ -113,9 +149,21 @@ namespace octoon::mesh
 
 		std::vector<skelecton::Bone> _bones;
 		std::vector<skelecton::VertexWeight> _weights;
+		std::vector<skelecton::VertexSdef> _sdefs;
 
 		std::vector<math::uint1s> _indices;
 		std::vector<math::BoundingBox> _boundingBoxs;
+
+		std::shared_ptr<MeshBVH> _bvh;
+
+		// the faces around every vertex in ascending order, and the topology version and sizes they were built for
+		std::uint32_t _adjacencyVersion;
+		std::vector<std::size_t> _adjacencySizes;
+		std::vector<std::uint32_t> _adjacencyOffsets;
+		std::vector<std::uint32_t> _adjacencyFaces;
+
+		// per face scratch of the normal and tangent generation
+		math::float3s _faceVectors;
 	};
 
 	using MeshPtr = std::shared_ptr<Mesh>;
@@ -0,0 +1,77 @@
+#ifndef OCTOON_MESH_BVH_H_
+#define OCTOON_MESH_BVH_H_
+
+#include <octoon/math/math.h>
+#include <octoon/runtime/platform.h>
+
+#include <mutex>
+#include <atomic>
+
+namespace octoon::mesh
+{
+	class Mesh;
+	struct RaycastHit;
+
+	// Bounding volume hierarchy over the triangles of every subset of a mesh.
+	// Nodes are stored depth-first in a flat array, so the left child of an inner node
+	// is always the next node and every node knows where to continue when its subtree is skipped.
+	class OCTOON_EXPORT MeshBVH final
+	{
+	public:
+		struct Node
+		{
+			math::float3 min;
+			std::uint32_t escape; // next node when this subtree is missed or finished
+			math::float3 max;
+			std::uint32_t first;  // first primitive for a leaf, right child for an inner node
+			std::uint32_t count;  // zero for an inner node
+		};
+
+		struct Primitive
+		{
+			std::uint32_t subset;
+			std::uint32_t v0, v1, v2;
+		};
+
+		static constexpr std::uint32_t MaxLeafPrimitives = 4;
+		static constexpr std::uint32_t PacketSize = 8;
+
+	public:
+		MeshBVH() noexcept;
+		~MeshBVH() noexcept;
+
+		void build(const Mesh& mesh) noexcept;
+		void refit(const Mesh& mesh) noexcept;
+
+		void invalidate(bool rebuild = false) noexcept;
+		void update(const Mesh& mesh) noexcept;
+
+		bool empty() const noexcept;
+
+		const std::vector<Node>& getNodes() const noexcept;
+		const std::vector<Primitive>& getPrimitives() const noexcept;
+
+		bool raycast(const Mesh& mesh, const math::Raycast& ray, RaycastHit& hit) const noexcept;
+		bool raycastAll(const Mesh& mesh, const math::Raycast& ray, std::vector<RaycastHit>& hits) const noexcept;
+		std::size_t raycastPacket(const Mesh& mesh, const math::Raycast rays[], std::size_t numRays, RaycastHit hits[]) const noexcept;
+
+	private:
+		std::uint32_t buildNode(const std::vector<math::AABB>& bounds, const math::float3s& centers, std::vector<std::uint32_t>& order, std::uint32_t begin, std::uint32_t end, std::uint32_t depth) noexcept;
+
+	private:
+		MeshBVH(const MeshBVH&) = delete;
+		MeshBVH& operator=(const MeshBVH&) = delete;
+
+	private:
+		std::mutex mutex_;
+		std::atomic<bool> dirty_;
+		std::atomic<bool> rebuild_;
+
+		std::size_t numVertices_;
+
+		std::vector<Node> nodes_;
+		std::vector<Primitive> primitives_;
+	};
+}
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef OCTOON_MESH_MORPHING_H_
+#define OCTOON_MESH_MORPHING_H_
+
+#include <octoon/mesh/mesh_skinning.h>
+
+namespace octoon::mesh
+{
+	// Sparse blending of vertex morph targets into the rest positions of a MeshSkinning.
+	// Each morph is stored with its vertex indices sorted and grouped into runs of consecutive
+	// vertices, and its offsets as separate x/y/z delta streams, so every run is blended with
+	// plain SIMD loads and stores. update() only visits the morphs whose weight changed and adds
+	// (weight - previous weight) * delta to the running totals. With enough work the changed morphs
+	// are spread over threads that accumulate into their own buffers before the totals are reduced.
+	class OCTOON_EXPORT MeshMorphing final
+	{
+	public:
+		MeshMorphing() noexcept;
+		~MeshMorphing() noexcept;
+
+		// Removes every morph, the next update() moves all vertices back to their sources.
+		void setNumVertices(std::size_t numVertices) noexcept;
+		std::size_t getNumVertices() const noexcept;
+
+		std::size_t addMorph(const math::uint1s& indices, const math::float3s& offsets) noexcept;
+		std::size_t getNumMorphs() const noexcept;
+
+		void setWeight(std::size_t n, float weight) noexcept;
+		float getWeight(std::size_t n) const noexcept;
+
+		void setInstructionSet(SkinningInstructionSet instructionSet) noexcept;
+		SkinningInstructionSet getInstructionSet() const noexcept;
+
+		void setNumThreads(std::uint32_t numThreads) noexcept;
+		std::uint32_t getNumThreads() const noexcept;
+
+		// Moves the rest positions of the skinning by the weight changes since the previous update.
+		// Returns false when no weight changed.
+		bool update(MeshSkinning& skinning) noexcept;
+
+	private:
+		MeshMorphing(const MeshMorphing&) = delete;
+		MeshMorphing& operator=(const MeshMorphing&) = delete;
+
+	private:
+		struct Morph
+		{
+			float weight;
+			float applied;
+
+			// pairs of the first vertex and the length of each run
+			std::vector<std::uint32_t> runs;
+			std::vector<std::uint32_t> blocks;
+			std::vector<float> deltas[3];
+		};
+
+		struct Accumulator
+		{
+			std::vector<float> totals[3];
+			std::vector<std::uint8_t> blocks;
+		};
+
+	private:
+		bool invalidated_;
+
+		std::size_t numVertices_;
+		std::uint32_t numThreads_;
+
+		SkinningInstructionSet instructionSet_;
+
+		std::vector<Morph> morphs_;
+		std::vector<std::size_t> changed_;
+
+		std::vector<float> totals_[3];
+		std::vector<std::uint8_t> dirtyBlocks_;
+		std::vector<std::uint8_t> morphBlocks_;
+		std::vector<Accumulator> accumulators_;
+	};
+}
+
+#endif
@@ -0,0 +1,138 @@
+#ifndef OCTOON_MESH_SKINNING_H_
+#define OCTOON_MESH_SKINNING_H_
+
+#include <octoon/mesh/mesh.h>
+
+namespace octoon::mesh
+{
+	enum class SkinningInstructionSet : std::uint8_t
+	{
+		Scalar,
+		SSE,
+		AVX,
+	};
+
+	enum class SkinningMode : std::uint8_t
+	{
+		Linear,
+		DualQuaternion,
+		Sdef,
+	};
+
+	struct SkinningStreams;
+
+	// Linear blend skinning of a mesh with up to four bones per vertex.
+	// Source positions and normals are kept as separate x/y/z streams and the joints as 3x4 palettes,
+	// so the SIMD kernels can process several vertices per instruction. Every kernel evaluates the
+	// same operations in the same order as the scalar path, so the results are bit-identical.
+	//
+	// Linear mode blends the joint matrices for every vertex. DualQuaternion mode blends the joints as
+	// dual quaternions for every vertex with more than one bone. Sdef mode runs the spherical deformation
+	// of the mesh's SDEF vertices and blends the others linearly. Inside a cluster the vertices are
+	// stored sorted by deform type (one bone, two bones, four bones, SDEF), so each bucket runs a kernel
+	// without per vertex branches, and the one and two bone kernels skip the unused influences.
+	//
+	// Vertices are grouped into fixed size clusters that know which joints influence them. setJoints()
+	// stamps the joints whose matrix actually changed and setVertex() marks the cluster it writes to, so
+	// update() only re-skins the clusters that can produce a different result. Each cluster also keeps
+	// the bind space bounds of its vertices per joint, from which the skinned bounds are derived.
+	class OCTOON_EXPORT MeshSkinning final
+	{
+	public:
+		MeshSkinning() noexcept;
+		~MeshSkinning() noexcept;
+
+		void setMesh(const Mesh& mesh) noexcept;
+		void setJoints(const math::float4x4s& joints) noexcept;
+
+		void setMode(SkinningMode mode) noexcept;
+		SkinningMode getMode() const noexcept;
+
+		void setInstructionSet(SkinningInstructionSet instructionSet) noexcept;
+		SkinningInstructionSet getInstructionSet() const noexcept;
+
+		void setNumThreads(std::uint32_t numThreads) noexcept;
+		std::uint32_t getNumThreads() const noexcept;
+
+		std::size_t getNumVertices() const noexcept;
+
+		void setVertex(std::size_t n, const math::float3& vertex) noexcept;
+		math::float3 getVertex(std::size_t n) const noexcept;
+
+		void resetVertices() noexcept;
+
+		// Offsets added to the rest positions of the vertices in [begin, end), kept across resetVertices().
+		// The arrays hold the offsets of vertex begin onwards.
+		void setVertexOffsets(std::size_t begin, std::size_t end, const float* x, const float* y, const float* z) noexcept;
+
+		// Skins every vertex into the given arrays.
+		void skinning(math::float3s& vertices, math::float3s& normals) const noexcept;
+
+		// Skins only the clusters that changed since the previous update, so the arrays must hold the
+		// result of that update. Returns false when nothing had to be skinned.
+		bool update(math::float3s& vertices, math::float3s& normals) noexcept;
+		void invalidate() noexcept;
+
+		// Bounds of the vertices referenced by each subset, as of the last update.
+		void computeBoundingBoxes(std::vector<math::BoundingBox>& boundingBoxes) const noexcept;
+
+		static SkinningInstructionSet getSupportedInstructionSet() noexcept;
+
+	private:
+		MeshSkinning(const MeshSkinning&) = delete;
+		MeshSkinning& operator=(const MeshSkinning&) = delete;
+
+	private:
+		void initStreams(SkinningStreams& streams, math::float3s& vertices, math::float3s& normals) const noexcept;
+		void updateClusterBounds(std::size_t cluster, bool refresh, const math::float3* vertices) noexcept;
+
+	private:
+		bool hasWeights_;
+		bool invalidated_;
+
+		std::size_t numVertices_;
+		std::size_t numJoints_;
+		std::uint32_t numThreads_;
+
+		SkinningMode mode_;
+		SkinningInstructionSet instructionSet_;
+
+		// vertex stored in each slot and slot of each vertex, the slots of a cluster stay inside the cluster
+		std::vector<std::uint32_t> order_;
+		std::vector<std::uint32_t> slots_;
+
+		std::vector<float> sources_[3];
+		std::vector<float> offsets_[3];
+		std::vector<float> positions_[3];
+		std::vector<float> normals_[3];
+		std::vector<float> weights_[4];
+		std::vector<std::int32_t> bones_[4];
+
+		std::vector<float> palette_;
+		std::vector<float> dualQuats_;
+
+		// center and the two blended rotation centers of each SDEF slot
+		std::vector<float> sdef_[9];
+
+		std::uint32_t frame_;
+		std::vector<std::uint32_t> jointStamps_;
+
+		std::vector<std::uint32_t> clusterStamps_;
+		std::vector<std::uint8_t> clusterModified_;
+		std::vector<std::uint8_t> clusterTouched_;
+		std::vector<std::uint8_t> clusterExact_;
+		std::vector<std::uint32_t> clusterBuckets_;
+		std::vector<std::size_t> dirtyClusters_;
+
+		// joints of cluster c and their bind space bounds are [clusterJointOffsets_[c], clusterJointOffsets_[c + 1])
+		std::vector<std::uint32_t> clusterJointOffsets_;
+		std::vector<std::uint32_t> clusterJoints_;
+		std::vector<math::AABB> clusterJointBounds_;
+		std::vector<math::AABB> clusterBounds_;
+
+		std::vector<std::uint32_t> subsetClusterOffsets_;
+		std::vector<std::uint32_t> subsetClusters_;
+	};
+}
+
+#endif
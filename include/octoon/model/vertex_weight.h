@@ -37,10 +37,25 @@ namespace octoon::skelecton
 				};
 			};
 		};
+
+		// Spherical deformation parameters of a two bone vertex, in the space of the bind pose.
+		template<typename _Float>
+		class VertexSdef final
+		{
+		public:
+			bool enable;
+
+			_Float c[3];
+			_Float r0[3];
+			_Float r1[3];
+		};
 	}
 
 	using VertexWeight = detail::VertexWeight<std::uint16_t, float>;
 	using VertexWeights = std::vector<VertexWeight>;
+
+	using VertexSdef = detail::VertexSdef<float>;
+	using VertexSdefs = std::vector<VertexSdef>;
 }
 
 #endif
\ No newline at end of file
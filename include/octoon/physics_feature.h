@@ -26,7 +26,7 @@ namespace octoon
         void onFrame() except;
 		void onFrameEnd() noexcept override;
 
-		void onFixedUpdate(const std::any& data) noexcept;
+		void onFixedUpdate(const float& delta) noexcept;
 
 	public:
 		std::shared_ptr<physics::PhysicsContext> getContext();
@@ -0,0 +1,115 @@
+#ifndef OCTOON_JOB_SYSTEM_H_
+#define OCTOON_JOB_SYSTEM_H_
+
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+#include <octoon/runtime/platform.h>
+
+namespace octoon
+{
+	namespace runtime
+	{
+		class Job;
+		class JobSystem;
+
+		typedef std::shared_ptr<Job> JobHandle;
+		typedef std::vector<JobHandle> JobHandles;
+
+		class OCTOON_EXPORT Job final
+		{
+		public:
+			Job(std::function<void()>&& task) noexcept;
+			~Job() noexcept;
+
+			bool done() const noexcept;
+
+			// The exception the task threw, if any. The job is still marked done and its continuations run.
+			const std::exception_ptr& exception() const noexcept;
+
+		private:
+			friend class JobSystem;
+
+			Job(const Job&) = delete;
+			Job& operator=(const Job&) = delete;
+
+		private:
+			std::function<void()> task_;
+			std::atomic<std::uint32_t> dependencies_;
+			std::atomic<bool> done_;
+			std::exception_ptr exception_;
+
+			std::mutex mutex_;
+			JobHandles continuations_;
+		};
+
+		// Work-stealing scheduler. Every worker owns a deque: it pushes and pops at the back, idle workers steal
+		// from the front of the others. Threads outside of the pool share one extra deque and help run jobs while
+		// they wait, so a system without workers still completes everything on the waiting thread.
+		class OCTOON_EXPORT JobSystem final
+		{
+		public:
+			JobSystem() noexcept;
+			explicit JobSystem(std::uint32_t num_threads) noexcept;
+			~JobSystem() noexcept;
+
+			// Restarts the pool with `num_threads` background workers, zero runs every job on the waiting thread.
+			void set_num_threads(std::uint32_t num_threads) noexcept;
+			std::uint32_t num_threads() const noexcept;
+
+			// Runs `task` once every job in `dependencies` is done.
+			JobHandle schedule(std::function<void()> task, const JobHandles& dependencies = JobHandles()) noexcept;
+
+			void wait(const JobHandle& job) noexcept;
+			void wait(const JobHandles& jobs) noexcept;
+
+			// Splits [0, count) into blocks of at most `grain` and returns once every block has run. The first
+			// exception thrown by a block is rethrown on the calling thread after all of them have finished.
+			void parallel_for(std::size_t count, std::size_t grain, const std::function<void(std::size_t begin, std::size_t end)>& func) noexcept(false);
+
+			static std::uint32_t hardware_threads() noexcept;
+
+		private:
+			struct Queue
+			{
+				std::mutex mutex;
+				std::deque<JobHandle> jobs;
+			};
+
+			void start(std::uint32_t num_threads) noexcept;
+			void stop() noexcept;
+
+			void submit(const JobHandle& job) noexcept;
+			void execute(const JobHandle& job) noexcept;
+
+			bool run_one(std::size_t index) noexcept;
+			JobHandle pop(std::size_t index) noexcept;
+
+			void worker(std::size_t index) noexcept;
+			std::size_t queue_index() const noexcept;
+
+		private:
+			JobSystem(const JobSystem&) = delete;
+			JobSystem& operator=(const JobSystem&) = delete;
+
+		private:
+			bool stop_;
+
+			std::atomic<std::size_t> pending_;
+
+			std::mutex sleep_mutex_;
+			std::condition_variable sleep_;
+
+			std::vector<std::thread> threads_;
+			std::vector<std::unique_ptr<Queue>> queues_;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef OCTOON_PROFILER_H_
+#define OCTOON_PROFILER_H_
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <ostream>
+#include <string_view>
+#include <octoon/runtime/platform.h>
+
+namespace octoon
+{
+	namespace runtime
+	{
+		// CPU zone profiler. Zones are recorded into a buffer owned by the calling thread, so recording only
+		// touches an uncontended lock; buffers outlive their threads until the profiler is cleared.
+		// Zone names and categories are kept by pointer and must outlive the profile (string literals, rtti names).
+		class OCTOON_EXPORT Profiler final
+		{
+		public:
+			struct Zone
+			{
+				const char* name;
+				const char* category;
+				std::int64_t start;
+				std::int64_t duration;
+				std::uint32_t depth;
+			};
+
+			static Profiler* instance() noexcept;
+
+			// Recording is off by default; a disabled profiler costs one atomic load per zone.
+			void set_enable(bool enable) noexcept;
+			bool enable() const noexcept;
+
+			void begin(const char* name, const char* category = "") noexcept;
+			void end() noexcept;
+
+			// Names the calling thread in the exported trace.
+			void set_thread_name(std::string_view name) noexcept;
+
+			// Drops every finished zone; zones still open on some thread are dropped when they end.
+			void clear() noexcept;
+
+			std::size_t num_zones() const noexcept;
+
+			// Writes the chrome://tracing / Perfetto trace-event format, timestamps in microseconds.
+			bool save_chrome_trace(std::ostream& stream) const noexcept;
+			bool save_chrome_trace(const std::string& path) const noexcept;
+
+		private:
+			struct ThreadBuffer
+			{
+				mutable std::mutex mutex;
+				std::uint32_t id;
+				std::string name;
+				std::vector<Zone> zones;
+				std::vector<std::size_t> stack;
+			};
+
+			Profiler() noexcept;
+			~Profiler() noexcept;
+
+			ThreadBuffer& local() noexcept;
+			std::int64_t now() const noexcept;
+
+		private:
+			Profiler(const Profiler&) = delete;
+			Profiler& operator=(const Profiler&) = delete;
+
+		private:
+			std::atomic<bool> enable_;
+			std::chrono::steady_clock::time_point epoch_;
+
+			mutable std::mutex mutex_;
+			std::vector<std::shared_ptr<ThreadBuffer>> threads_;
+		};
+
+		class ProfileScope final
+		{
+		public:
+			ProfileScope(const char* name, const char* category = "") noexcept
+				: active_(Profiler::instance()->enable())
+			{
+				if (active_)
+					Profiler::instance()->begin(name, category);
+			}
+
+			~ProfileScope() noexcept
+			{
+				if (active_)
+					Profiler::instance()->end();
+			}
+
+		private:
+			ProfileScope(const ProfileScope&) = delete;
+			ProfileScope& operator=(const ProfileScope&) = delete;
+
+		private:
+			bool active_;
+		};
+	}
+}
+
+#define OCTOON_PROFILE_CONCAT_(a, b) a##b
+#define OCTOON_PROFILE_CONCAT(a, b) OCTOON_PROFILE_CONCAT_(a, b)
+
+#if defined(OCTOON_DISABLE_PROFILER)
+#	define OCTOON_PROFILE_SCOPE(name)
+#	define OCTOON_PROFILE_CATEGORY(name, category)
+#	define OCTOON_PROFILE_FUNCTION()
+#else
+#	define OCTOON_PROFILE_SCOPE(name) octoon::runtime::ProfileScope OCTOON_PROFILE_CONCAT(profile_scope_, __LINE__)(name)
+#	define OCTOON_PROFILE_CATEGORY(name, category) octoon::runtime::ProfileScope OCTOON_PROFILE_CONCAT(profile_scope_, __LINE__)(name, category)
+#	define OCTOON_PROFILE_FUNCTION() OCTOON_PROFILE_SCOPE(__func__)
+#endif
+
+#endif
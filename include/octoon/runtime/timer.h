@@ -2,6 +2,7 @@
 #define OCTOON_TIMER_H_
 
 #include <ctime>
+#include <chrono>
 #include <memory>
 #include <octoon/runtime/platform.h>
 
@@ -44,7 +45,7 @@ namespace octoon
 
 			float app_time_;
 			float startTime_;
-			float last_time_;
+			double last_time_;
 			float frame_time_;
 			float accumulate_time_;
 			float accumulate_fps_;
@@ -53,6 +54,8 @@ namespace octoon
 			std::uint8_t current_fps_index_;
 
 			float fps_array_[10];
+
+			std::chrono::steady_clock::time_point start_;
 		};
 	}
 }
@@ -5,6 +5,8 @@
 #include <octoon/mesh_renderer_component.h>
 #include <octoon/skinned_component.h>
 #include <octoon/cloth_component.h>
+#include <octoon/mesh/mesh_skinning.h>
+#include <octoon/mesh/mesh_morphing.h>
 
 namespace octoon
 {
@@ -32,6 +34,9 @@ namespace octoon
 		void setTextureBlendEnable(bool enable) noexcept;
 		bool getTextureBlendEnable() const noexcept;
 
+		void setSkinningMode(mesh::SkinningMode mode) noexcept;
+		mesh::SkinningMode getSkinningMode() const noexcept;
+
 		const mesh::MeshPtr& getSkinnedMesh() const noexcept;
 
 		void uploadMeshData(const mesh::MeshPtr& mesh) noexcept override;
@@ -55,10 +60,10 @@ namespace octoon
 	private:
 		void updateMeshData() noexcept;
 		void updateJointData() noexcept;
-		void updateBoneData() noexcept;
+		bool updateBoneData() noexcept;
 		void updateClothBlendData() noexcept;
 		void updateMorphBlendData() noexcept;
-		void updateTextureBlendData() noexcept;
+		bool updateTextureBlendData() noexcept;
 
 	private:
 		SkinnedMeshRendererComponent(const SkinnedMeshRendererComponent&) = delete;
@@ -66,9 +71,11 @@ namespace octoon
 
 	private:
 		bool needUpdate_;
+		bool needUpdateMorph_;
 		bool clothEnable_;
 		bool morphEnable_;
 		bool textureEnable_;
+		bool textureBlended_;
 
 		GameObjects transforms_;
 
@@ -77,11 +84,15 @@ namespace octoon
 
 		mesh::MeshPtr mesh_;
 		mesh::MeshPtr skinnedMesh_;
+		mesh::MeshSkinning skinning_;
+		mesh::MeshMorphing morphing_;
 
 		std::vector<math::Quaternion> quaternions_;
+		std::vector<math::BoundingBox> boundingBoxes_;
 		std::vector<class ClothComponent*> clothComponents_;
 		std::vector<class SkinnedMorphComponent*> morphComponents_;
 		std::vector<class SkinnedTextureComponent*> textureComponents_;
+		std::vector<float> textureControls_;
 	};
 }
 
@@ -79,10 +79,12 @@ namespace octoon
 
 	private:
 		friend GameObject;
+		friend class TransformHierarchy;
 		void updateLocalChildren() const noexcept;
 		void updateWorldChildren() const noexcept;
 		void updateLocalTransform() const noexcept;
 		void updateWorldTransform() const noexcept;
+		void updateWorldTransform(const math::float4x4& baseTransform) const noexcept;
 		void updateParentTransform() const noexcept;
 
 	private:
@@ -0,0 +1,56 @@
+#ifndef OCTOON_TRANSFORM_HIERARCHY_H_
+#define OCTOON_TRANSFORM_HIERARCHY_H_
+
+#include <octoon/game_object.h>
+
+namespace octoon
+{
+	class TransformComponent;
+
+	// Flattened view of one or more game object subtrees. Transforms are stored parent-before-child
+	// in contiguous arrays, so update() resolves every dirty world matrix in one linear sweep instead of
+	// walking parents recursively from each getter. The subtrees are held weakly and flattened again on
+	// the next update() after any object is reparented or destroyed, so the arrays never outlive them.
+	class OCTOON_EXPORT TransformHierarchy final
+	{
+	public:
+		TransformHierarchy() noexcept;
+		explicit TransformHierarchy(const GameObjects& objects) noexcept;
+		~TransformHierarchy() noexcept;
+
+		void build(const GameObjects& objects) noexcept;
+		void clear() noexcept;
+
+		bool empty() const noexcept;
+		std::size_t size() const noexcept;
+		std::size_t getNumRoots() const noexcept;
+
+		void setParallel(bool enable) noexcept;
+		bool getParallel() const noexcept;
+
+		// Returns the number of world transforms that were recomputed.
+		std::size_t update() noexcept;
+
+	private:
+		void rebuild() noexcept;
+		void flatten(const GameObject* object, std::int32_t parent) noexcept;
+		void updateRange(std::size_t begin, std::size_t end) noexcept;
+
+	private:
+		TransformHierarchy(const TransformHierarchy&) = delete;
+		TransformHierarchy& operator=(const TransformHierarchy&) = delete;
+
+	private:
+		bool parallel_;
+
+		std::size_t version_;
+		std::vector<GameObjectWeakPtr> objects_;
+
+		std::vector<const TransformComponent*> transforms_;
+		std::vector<std::int32_t> parents_;
+		std::vector<std::uint8_t> dirty_;
+		std::vector<std::size_t> roots_;
+	};
+}
+
+#endif
@@ -8,6 +8,11 @@ namespace octoon::video
 {
 	class OCTOON_EXPORT ForwardBuffer final
 	{
+	public:
+		// Number of vertex buffers cycled through by a deforming mesh, so a rewrite never
+		// touches a buffer that a frame still in flight may be reading.
+		static constexpr std::size_t NumDynamicBuffers = 3;
+
 	public:
 		ForwardBuffer() noexcept;
 		ForwardBuffer(const std::shared_ptr<mesh::Mesh>& mesh) noexcept(false);
@@ -16,6 +21,10 @@ namespace octoon::video
 		void setMesh(const std::shared_ptr<mesh::Mesh>& mesh) noexcept(false);
 		const std::shared_ptr<mesh::Mesh>& getMesh() const noexcept;
 
+		void update() noexcept(false);
+
+		bool isDynamic() const noexcept;
+
 		std::size_t getNumVertices() const noexcept;
 		std::size_t getNumIndices(std::size_t n) const noexcept;
 		std::size_t getStartIndices(std::size_t n) const noexcept;
@@ -23,19 +32,29 @@ namespace octoon::video
 		const hal::GraphicsDataPtr& getVertexBuffer() const noexcept;
 		const hal::GraphicsDataPtr& getIndexBuffer() const noexcept;
 
-
 	private:
+		bool isLayoutChanged(const mesh::Mesh& mesh) const noexcept;
+
 		void updateData(const std::shared_ptr<mesh::Mesh>& mesh) noexcept(false);
+		void updateVertices(const mesh::Mesh& mesh) noexcept(false);
+
+		std::vector<float> createVertexData(const mesh::Mesh& mesh) const noexcept;
 
 	private:
 		ForwardBuffer(const ForwardBuffer&) = delete;
 		ForwardBuffer& operator=(const ForwardBuffer&) = delete;
 
 	private:
-		std::uint32_t numVertices_;
-		std::uint32_t numIndices_;
+		std::size_t numVertices_;
+		std::size_t numIndices_;
+		std::size_t numTexcoords_[2];
+		std::uint32_t topologyVersion_;
 		std::vector<std::size_t> startIndice_;
 
+		std::size_t dynamicIndex_;
+		std::vector<hal::GraphicsDataPtr> dynamicBuffers_;
+		std::vector<std::uint32_t> dynamicTexcoordVersions_;
+
 		hal::GraphicsDataPtr vertices_;
 		hal::GraphicsDataPtr indices_;
 
@@ -43,4 +62,4 @@ namespace octoon::video
 	};
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,46 @@
+#ifndef OCTOON_VIDEO_FORWARD_CULLING_H_
+#define OCTOON_VIDEO_FORWARD_CULLING_H_
+
+#include <octoon/math/frustum.h>
+#include <octoon/camera/camera.h>
+#include <octoon/geometry/geometry.h>
+
+namespace octoon::video
+{
+	struct CullingStatistics
+	{
+		std::size_t numTested;
+		std::size_t numVisible;
+		std::size_t numCulled;
+	};
+
+	// Tests the world-space bounds of every geometry against one or more frustums.
+	// The bounds are transformed once per call, so all six faces of a cube shadow
+	// share the same work, and the output lists keep the submission order.
+	class OCTOON_EXPORT ForwardCulling final
+	{
+	public:
+		static constexpr std::size_t MaxFrustums = 8;
+
+	public:
+		ForwardCulling() noexcept;
+		~ForwardCulling() noexcept;
+
+		void cull(const std::vector<geometry::Geometry*>& geometries, const camera::Camera& camera, std::vector<geometry::Geometry*>& visible) noexcept;
+		void cull(const std::vector<geometry::Geometry*>& geometries, std::uint8_t layer, const math::Frustum frustums[], std::size_t numFrustums, std::vector<geometry::Geometry*> visible[]) noexcept;
+
+		void resetStatistics() noexcept;
+		const CullingStatistics& getStatistics() const noexcept;
+
+	private:
+		ForwardCulling(const ForwardCulling&) = delete;
+		ForwardCulling& operator=(const ForwardCulling&) = delete;
+
+	private:
+		std::vector<std::uint8_t> masks_;
+
+		CullingStatistics statistics_;
+	};
+}
+
+#endif
@@ -21,7 +21,12 @@ namespace octoon::video
 		const hal::GraphicsPipelinePtr& getPipeline() const noexcept;
 		const hal::GraphicsDescriptorSetPtr& getDescriptorSet() const noexcept;
 
-		void update(const ForwardScene& context, const camera::Camera& camera, const geometry::Geometry& geometry) noexcept;
+		void update(const ForwardScene& context, const camera::Camera& camera, const geometry::Geometry& geometry, const hal::GraphicsDataPtr& cameraBuffer) noexcept;
+		void updateCamera(const ForwardScene& context, const hal::GraphicsDataPtr& cameraBuffer) noexcept;
+		void updateTransform(const camera::Camera& camera, const geometry::Geometry& geometry) noexcept;
+
+		bool isInstancing() const noexcept;
+		bool isTransparent() const noexcept;
 
 	private:
 		void updateParameters(bool force = false) noexcept;
@@ -38,6 +43,8 @@ namespace octoon::video
 		ForwardMaterial& operator=(const ForwardMaterial&) = delete;
 
 	private:
+		bool instancing_;
+
 		material::MaterialPtr material_;
 
 		hal::GraphicsProgramPtr program_;
@@ -45,7 +52,7 @@ namespace octoon::video
 		hal::GraphicsStatePtr renderState_;
 		hal::GraphicsDescriptorSetPtr descriptorSet_;
 
-		hal::GraphicsUniformSetPtr ambientLightColor_;
+		hal::GraphicsUniformSetPtr camera_;
 		hal::GraphicsUniformSetPtr directionalLights_;
 		hal::GraphicsUniformSetPtr pointLights_;
 		hal::GraphicsUniformSetPtr spotLights_;
@@ -55,12 +62,9 @@ namespace octoon::video
 		hal::GraphicsUniformSetPtr envMap_;
 		hal::GraphicsUniformSetPtr envMapIntensity_;
 
-		hal::GraphicsUniformSetPtr viewMatrix_;
-		hal::GraphicsUniformSetPtr viewProjMatrix_;
 		hal::GraphicsUniformSetPtr normalMatrix_;
 		hal::GraphicsUniformSetPtr modelMatrix_;
 		hal::GraphicsUniformSetPtr modelViewMatrix_;
-		hal::GraphicsUniformSetPtr projectionMatrix_;
 
 		std::vector<hal::GraphicsUniformSetPtr> directionalShadowMaps_;
 		std::vector<hal::GraphicsUniformSetPtr> directionalShadowMatrixs_;
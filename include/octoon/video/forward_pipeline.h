@@ -5,7 +5,9 @@
 #include <octoon/light/light.h>
 #include <octoon/geometry/geometry.h>
 #include <octoon/video/forward_buffer.h>
+#include <octoon/video/forward_culling.h>
 #include <octoon/video/forward_material.h>
+#include <octoon/video/forward_render_queue.h>
 
 #include "output.h"
 #include "pipeline.h"
@@ -15,6 +17,9 @@ namespace octoon::video
 {
 	class ForwardPipeline : public Pipeline
 	{
+	public:
+		static constexpr std::size_t NumPassBuffers = 8;
+
 	public:
 		ForwardPipeline(const hal::GraphicsContextPtr& context) noexcept;
 		virtual ~ForwardPipeline() noexcept;
@@ -28,14 +33,18 @@ namespace octoon::video
 
 		const hal::GraphicsFramebufferPtr& getFramebuffer() const noexcept;
 
-	private:
-		void setMaterial(const ForwardScene& scene, const std::shared_ptr<material::Material>& material, const camera::Camera& camera, const geometry::Geometry& geometry);
+		void resetCullingStatistics() noexcept;
+		const CullingStatistics& getCullingStatistics() const noexcept;
 
-		void renderBuffer(const ForwardScene& scene, const std::shared_ptr<mesh::Mesh>& mesh, std::size_t subset);
-		void renderObject(const ForwardScene& scene, const geometry::Geometry& geometry, const camera::Camera& camera, const std::shared_ptr<material::Material>& overrideMaterial = nullptr) noexcept;
+	private:
+		void renderBuffer(const ForwardBuffer& buffer, std::size_t subset, std::uint32_t numInstances = 1) noexcept;
+		void renderItems(const ForwardScene& scene, const std::vector<ForwardRenderItem>& items, const camera::Camera& camera, const hal::GraphicsDataPtr& cameraBuffer, const hal::GraphicsDataPtr& instances) noexcept;
 		void renderObjects(const ForwardScene& scene, const std::vector<geometry::Geometry*>& objects, const camera::Camera& camera, const std::shared_ptr<material::Material>& overrideMaterial = nullptr) noexcept;
 		void renderShadowMaps(const ForwardScene& scene, const std::vector<light::Light*>& lights, const std::vector<geometry::Geometry*>& geometries) noexcept;
 
+		hal::GraphicsDataPtr updateCamera(const ForwardScene& scene, const camera::Camera& camera) noexcept;
+		hal::GraphicsDataPtr updateInstances(const std::vector<math::float4x4>& transforms) noexcept;
+
 	private:
 		ForwardPipeline(const ForwardPipeline&) = delete;
 		ForwardPipeline& operator=(const ForwardPipeline&) = delete;
@@ -53,6 +62,15 @@ namespace octoon::video
 		std::shared_ptr<geometry::Geometry> screenGeometry_;
 		std::shared_ptr<material::Material> overrideMaterial_;
 
+		ForwardCulling culling_;
+		ForwardRenderQueue renderQueue_;
+
+		std::size_t passIndex_;
+		hal::GraphicsDataPtr cameraBuffers_[NumPassBuffers];
+		hal::GraphicsDataPtr instanceBuffers_[NumPassBuffers];
+		std::vector<geometry::Geometry*> visibleGeometries_;
+		std::vector<geometry::Geometry*> shadowGeometries_;
+
 		std::unordered_map<std::intptr_t, std::shared_ptr<hal::GraphicsTexture>> lightTextures_;
 	};
 }
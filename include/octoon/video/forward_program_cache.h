@@ -0,0 +1,59 @@
+#ifndef OCTOON_VIDEO_FORWARD_PROGRAM_CACHE_H_
+#define OCTOON_VIDEO_FORWARD_PROGRAM_CACHE_H_
+
+#include <octoon/hal/graphics_device.h>
+#include <octoon/hal/graphics_shader.h>
+
+#include <unordered_map>
+
+namespace octoon::video
+{
+	// Linked programs keyed by the hash of their preprocessed sources.
+	// A program that is not in memory is first looked up as a driver binary under the cache path
+	// and only compiled from source when the binary is missing or rejected by the driver.
+	// Binaries are keyed on the driver identity too, so a driver update never loads a stale binary.
+	// Once more than the capacity is held, programs no longer referenced outside the cache are released.
+	class OCTOON_EXPORT ForwardProgramCache final
+	{
+	public:
+		ForwardProgramCache() noexcept;
+		~ForwardProgramCache() noexcept;
+
+		void setDevice(const hal::GraphicsDevicePtr& device) noexcept;
+		const hal::GraphicsDevicePtr& getDevice() const noexcept;
+
+		void setCachePath(std::string_view path) noexcept;
+		const std::string& getCachePath() const noexcept;
+
+		void setCapacity(std::size_t capacity) noexcept;
+		std::size_t getCapacity() const noexcept;
+
+		void clear() noexcept;
+
+		hal::GraphicsProgramPtr createProgram(const std::string& vertex, const std::string& fragment) noexcept;
+
+	private:
+		ForwardProgramCache(const ForwardProgramCache&) = delete;
+		ForwardProgramCache& operator=(const ForwardProgramCache&) = delete;
+
+	private:
+		struct Entry
+		{
+			std::string vertex;
+			std::string fragment;
+			hal::GraphicsProgramPtr program;
+		};
+
+		void evict() noexcept;
+
+	private:
+		std::string cachePath_;
+		std::size_t capacity_;
+		std::uint64_t driverHash_;
+		hal::GraphicsDevicePtr device_;
+
+		std::unordered_multimap<std::uint64_t, Entry> programs_;
+	};
+}
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef OCTOON_VIDEO_FORWARD_RENDER_QUEUE_H_
+#define OCTOON_VIDEO_FORWARD_RENDER_QUEUE_H_
+
+#include <octoon/video/forward_buffer.h>
+#include <octoon/video/forward_material.h>
+
+namespace octoon::video
+{
+	class ForwardScene;
+
+	struct ForwardRenderItem
+	{
+		std::uint64_t key;
+		std::uint32_t subset;
+		std::uint32_t instance;
+
+		const geometry::Geometry* geometry;
+		ForwardMaterial* material;
+		ForwardBuffer* buffer;
+	};
+
+	// Collects one item per drawable subset and sorts them by a 64-bit key.
+	// Opaque keys are ordered by render order, pipeline, vertex buffer, subset and then front to back,
+	// so subsets that share a material end up next to each other. Transparent keys are ordered by
+	// render order and then back to front, ties keep the submission order of the subsets.
+	// After sorting every item gets the index of its model matrix in getTransforms(), so consecutive
+	// items that draw the same subset of the same buffer can be submitted as one instanced draw.
+	class OCTOON_EXPORT ForwardRenderQueue final
+	{
+	public:
+		ForwardRenderQueue() noexcept;
+		~ForwardRenderQueue() noexcept;
+
+		void clear() noexcept;
+		void build(const ForwardScene& scene, const std::vector<geometry::Geometry*>& geometries, const camera::Camera& camera, const std::shared_ptr<material::Material>& overrideMaterial = nullptr) noexcept;
+
+		const std::vector<ForwardRenderItem>& getOpaques() const noexcept;
+		const std::vector<ForwardRenderItem>& getTransparents() const noexcept;
+		const std::vector<math::float4x4>& getTransforms() const noexcept;
+
+	private:
+		std::uint32_t getResourceId(const void* resource) noexcept;
+
+	private:
+		ForwardRenderQueue(const ForwardRenderQueue&) = delete;
+		ForwardRenderQueue& operator=(const ForwardRenderQueue&) = delete;
+
+	private:
+		std::vector<std::int32_t> renderOrders_;
+		std::vector<ForwardRenderItem> opaques_;
+		std::vector<ForwardRenderItem> transparents_;
+		std::vector<math::float4x4> transforms_;
+		std::unordered_map<const void*, std::uint32_t> resourceIds_;
+	};
+}
+
+#endif
@@ -21,6 +21,9 @@ namespace octoon::video
 
 		const hal::GraphicsFramebufferPtr& getFramebuffer() const noexcept;
 
+		void resetCullingStatistics() noexcept;
+		const CullingStatistics& getCullingStatistics() const noexcept;
+
 		void render(const std::shared_ptr<RenderScene>& scene) noexcept;
 
 	private:
@@ -16,6 +16,16 @@ namespace octoon::video
 	public:
 		ForwardScene() noexcept;
 
+		// std140 layout of the Camera uniform block, written once per pass
+		struct CameraConstants
+		{
+			math::float4x4 viewMatrix;
+			math::float4x4 projectionMatrix;
+			math::float4x4 viewProjMatrix;
+			math::float4 cameraPosition;
+			math::float4 ambientLightColor;
+		};
+
 		struct HemisphereLight
 		{
 			math::float3 direction;
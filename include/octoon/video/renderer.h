@@ -12,7 +12,9 @@
 #include <octoon/video/render_object.h>
 #include <octoon/video/render_scene.h>
 #include <octoon/video/forward_buffer.h>
+#include <octoon/video/forward_culling.h>
 #include <octoon/video/forward_material.h>
+#include <octoon/video/forward_program_cache.h>
 #include <octoon/video/forward_scene.h>
 
 #include <octoon/lightmap/lightmap.h>
@@ -43,6 +45,13 @@ namespace octoon::video
 		ShadowQualityRangeSize = (ShadowQualityEndRange - ShadowQualityBeginRange + 1),
 	};
 
+	enum class ReadbackStatus : std::uint8_t
+	{
+		ReadbackStatusReady,
+		ReadbackStatusPending,
+		ReadbackStatusFailed,
+	};
+
 	class OCTOON_EXPORT Renderer final
 	{
 		OctoonDeclareSingleton(Renderer)
@@ -62,12 +71,22 @@ namespace octoon::video
 		void setOverrideMaterial(const std::shared_ptr<material::Material>& material) noexcept;
 		const std::shared_ptr<material::Material>& getOverrideMaterial() const noexcept;
 
+		void setProgramCachePath(std::string_view path) noexcept;
+		const std::string& getProgramCachePath() const noexcept;
+
+		// The ticket variants read the framebuffer of the active renderer through a pixel buffer,
+		// a ticket issued one frame is read the next one without stalling the GPU queue. A ticket is read
+		// once, a stale one reports failure, and none is issued for formats that cannot be converted.
 		void readColorBuffer(math::float3 data[]);
+		ReadbackStatus readColorBuffer(std::uint64_t ticket, math::float3 data[], bool wait = true);
+		std::uint64_t readColorBufferAsync();
 		void readAlbedoBuffer(math::float3 data[]);
 		void readNormalBuffer(math::float3 data[]);
 
 		const hal::GraphicsFramebufferPtr& getFramebuffer() const noexcept;
 
+		const CullingStatistics& getCullingStatistics() const noexcept;
+
 		hal::GraphicsInputLayoutPtr createInputLayout(const hal::GraphicsInputLayoutDesc& desc) noexcept;
 		hal::GraphicsDataPtr createGraphicsData(const hal::GraphicsDataDesc& desc) noexcept;
 		hal::GraphicsTexturePtr createTexture(const hal::GraphicsTextureDesc& desc) noexcept;
@@ -76,6 +95,7 @@ namespace octoon::video
 		hal::GraphicsFramebufferLayoutPtr createFramebufferLayout(const hal::GraphicsFramebufferLayoutDesc& desc) noexcept;
 		hal::GraphicsShaderPtr createShader(const hal::GraphicsShaderDesc& desc) noexcept;
 		hal::GraphicsProgramPtr createProgram(const hal::GraphicsProgramDesc& desc) noexcept;
+		hal::GraphicsProgramPtr createProgram(const std::string& vertex, const std::string& fragment) noexcept;
 		hal::GraphicsStatePtr createRenderState(const hal::GraphicsStateDesc& desc) noexcept;
 		hal::GraphicsPipelinePtr createRenderPipeline(const hal::GraphicsPipelineDesc& desc) noexcept;
 		hal::GraphicsDescriptorSetPtr createDescriptorSet(const hal::GraphicsDescriptorSetDesc& desc) noexcept;
@@ -95,12 +115,18 @@ namespace octoon::video
 
 		std::uint32_t width_, height_;
 
+		std::uint64_t readbackTicket_;
+		std::uint32_t readbackWidth_, readbackHeight_;
+		hal::GraphicsFormat readbackFormat_;
+
 		hal::GraphicsContextPtr context_;
 
 		std::unique_ptr<class RtxManager> rtxManager_;
 		std::unique_ptr<class ForwardRenderer> forwardRenderer_;
 
 		std::shared_ptr<material::Material> overrideMaterial_;
+
+		ForwardProgramCache programCache_;
 	};
 }
 
@@ -33,6 +33,8 @@ namespace octoon
 		bool getGlobalIllumination() const noexcept;
 
 		void readColorBuffer(math::float3 data[]);
+		video::ReadbackStatus readColorBuffer(std::uint64_t ticket, math::float3 data[], bool wait = true);
+		std::uint64_t readColorBufferAsync();
 		void readAlbedoBuffer(math::float3 data[]);
 		void readNormalBuffer(math::float3 data[]);
 
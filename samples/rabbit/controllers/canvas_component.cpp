@@ -9,6 +9,7 @@ namespace rabbit
 {
 	CanvasComponent::CanvasComponent() noexcept
 		: active_(false)
+		, colorTicket_(0)
 	{
 	}
 
@@ -42,16 +43,45 @@ namespace rabbit
 	CanvasComponent::onPostProcess() noexcept
 	{
 		auto& context = this->getContext();
+		auto videoFeature = this->getFeature<octoon::VideoFeature>();
 
 		if (this->getContext()->profile->offlineModule->offlineEnable)
 		{
-			auto videoFeature = this->getFeature<octoon::VideoFeature>();
-			videoFeature->readColorBuffer(this->getModel()->colorBuffer.data());
+			// offline frames are saved one by one, so the readback of this frame is waited on
+			auto ticket = videoFeature->readColorBufferAsync();
+			if (videoFeature->readColorBuffer(ticket, this->getModel()->colorBuffer.data(), true) != octoon::video::ReadbackStatus::ReadbackStatusReady)
+				videoFeature->readColorBuffer(this->getModel()->colorBuffer.data());
+
 			videoFeature->readNormalBuffer(this->getModel()->normalBuffer.data());
 			videoFeature->readAlbedoBuffer(this->getModel()->albedoBuffer.data());
+
+			colorTicket_ = 0;
 		}
 		else
 		{
+			// the preview shows the frame read back one frame earlier, so it never waits on the GPU
+			if (colorTicket_)
+			{
+				auto status = videoFeature->readColorBuffer(colorTicket_, this->getModel()->colorBuffer.data(), false);
+				if (status == octoon::video::ReadbackStatus::ReadbackStatusPending)
+					return;
+
+				colorTicket_ = 0;
+
+				if (status == octoon::video::ReadbackStatus::ReadbackStatusReady)
+				{
+					colorTicket_ = videoFeature->readColorBufferAsync();
+					return;
+				}
+			}
+			else
+			{
+				colorTicket_ = videoFeature->readColorBufferAsync();
+				if (colorTicket_)
+					return;
+			}
+
+			// backends without pixel buffer readback map the attachment directly
 			auto camera = context->profile->entitiesModule->camera->getComponent<octoon::CameraComponent>();
 			auto colorTexture = camera->getFramebuffer()->getFramebufferDesc().getColorAttachments().front().getBindingTexture();
 			if (colorTexture)
@@ -30,6 +30,7 @@ namespace rabbit
 
 	private:
 		bool active_;
+		std::uint64_t colorTicket_;
 	};
 }
 
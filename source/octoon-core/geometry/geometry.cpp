@@ -59,7 +59,9 @@ namespace octoon::geometry
 	{
 		this->setDirty(true);
 		this->mesh_ = std::move(mesh);
-		this->setBoundingBox(mesh ? mesh->getBoundingBoxAll() : math::BoundingBox::Empty);
+		this->setBoundingBox(this->mesh_ ? this->mesh_->getBoundingBoxAll() : math::BoundingBox::Empty);
+		if (this->mesh_)
+			this->mesh_->setDirty(true);
 	}
 
 	void
@@ -68,6 +70,8 @@ namespace octoon::geometry
 		this->setDirty(true);
 		this->mesh_ = mesh;
 		this->setBoundingBox(mesh ? mesh->getBoundingBoxAll() : math::BoundingBox::Empty);
+		if (mesh)
+			mesh->setDirty(true);
 	}
 
 	const std::shared_ptr<mesh::Mesh>&
@@ -0,0 +1,962 @@
+#include "null_descriptor_set.h"
+#include "null_texture.h"
+#include "null_shader.h"
+#include "null_sampler.h"
+#include "null_graphics_data.h"
+
+namespace octoon
+{
+	namespace hal
+	{
+		OctoonImplementSubClass(NullDescriptorSet, GraphicsDescriptorSet, "NullDescriptorSet")
+		OctoonImplementSubClass(NullGraphicsUniformSet, GraphicsUniformSet, "NullGraphicsUniformSet")
+		OctoonImplementSubClass(NullDescriptorSetLayout, GraphicsDescriptorSetLayout, "NullDescriptorSetLayout")
+		OctoonImplementSubClass(NullDescriptorPool, GraphicsDescriptorPool, "NullDescriptorPool")
+
+		NullGraphicsUniformSet::NullGraphicsUniformSet() noexcept
+		{
+		}
+
+		NullGraphicsUniformSet::~NullGraphicsUniformSet() noexcept
+		{
+		}
+
+		const std::string&
+		NullGraphicsUniformSet::getName() const noexcept
+		{
+			assert(_param);
+			return _param->getName();
+		}
+
+		void
+		NullGraphicsUniformSet::uniform1b(bool value) noexcept
+		{
+			_variant.uniform1b(value);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform1i(std::int32_t i1) noexcept
+		{
+			_variant.uniform1i(i1);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform2i(const int2& value) noexcept
+		{
+			_variant.uniform2i(value);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform2i(std::int32_t i1, std::int32_t i2) noexcept
+		{
+			_variant.uniform2i(i1, i2);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform3i(const int3& value) noexcept
+		{
+			_variant.uniform3i(value);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform3i(std::int32_t i1, std::int32_t i2, std::int32_t i3) noexcept
+		{
+			_variant.uniform3i(i1, i2, i3);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform4i(const int4& value) noexcept
+		{
+			_variant.uniform4i(value);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform4i(std::int32_t i1, std::int32_t i2, std::int32_t i3, std::int32_t i4) noexcept
+		{
+			_variant.uniform4i(i1, i2, i3, i4);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform1ui(std::uint32_t ui1) noexcept
+		{
+			_variant.uniform1ui(ui1);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform2ui(const uint2& value) noexcept
+		{
+			_variant.uniform2ui(value);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform2ui(std::uint32_t ui1, std::uint32_t ui2) noexcept
+		{
+			_variant.uniform2ui(ui1, ui2);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform3ui(const uint3& value) noexcept
+		{
+			_variant.uniform3ui(value);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform3ui(std::uint32_t ui1, std::uint32_t ui2, std::uint32_t ui3) noexcept
+		{
+			_variant.uniform3ui(ui1, ui2, ui3);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform4ui(const uint4& value) noexcept
+		{
+			_variant.uniform4ui(value);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform4ui(std::uint32_t ui1, std::uint32_t ui2, std::uint32_t ui3, std::uint32_t ui4) noexcept
+		{
+			_variant.uniform4ui(ui1, ui2, ui3, ui4);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform1f(float f1) noexcept
+		{
+			_variant.uniform1f(f1);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform2f(const float2& value) noexcept
+		{
+			_variant.uniform2f(value);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform2f(float f1, float f2) noexcept
+		{
+			_variant.uniform2f(f1, f2);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform3f(const float3& value) noexcept
+		{
+			_variant.uniform3f(value);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform3f(float f1, float f2, float f3) noexcept
+		{
+			_variant.uniform3f(f1, f2, f3);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform4f(const float4& value) noexcept
+		{
+			_variant.uniform4f(value);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform4f(float f1, float f2, float f3, float f4) noexcept
+		{
+			_variant.uniform4f(f1, f2, f3, f4);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform2fmat(const float2x2& value) noexcept
+		{
+			_variant.uniform2fmat(value);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform2fmat(const float* mat2) noexcept
+		{
+			_variant.uniform2fmat(mat2);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform3fmat(const float3x3& value) noexcept
+		{
+			_variant.uniform3fmat(value);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform3fmat(const float* mat3) noexcept
+		{
+			_variant.uniform3fmat(mat3);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform4fmat(const float4x4& value) noexcept
+		{
+			_variant.uniform4fmat(value);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform4fmat(const float* mat4) noexcept
+		{
+			_variant.uniform4fmat(mat4);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform1iv(const std::vector<int1>& value) noexcept
+		{
+			_variant.uniform1iv(value);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform1iv(std::size_t num, const std::int32_t* i1v) noexcept
+		{
+			_variant.uniform1iv(num, i1v);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform2iv(const std::vector<int2>& value) noexcept
+		{
+			_variant.uniform2iv(value);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform2iv(std::size_t num, const std::int32_t* i2v) noexcept
+		{
+			_variant.uniform2iv(num, i2v);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform3iv(const std::vector<int3>& value) noexcept
+		{
+			_variant.uniform3iv(value);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform3iv(std::size_t num, const std::int32_t* i3v) noexcept
+		{
+			_variant.uniform3iv(num, i3v);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform4iv(const std::vector<int4>& value) noexcept
+		{
+			_variant.uniform4iv(value);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform4iv(std::size_t num, const std::int32_t* i4v) noexcept
+		{
+			_variant.uniform4iv(num, i4v);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform1uiv(const std::vector<uint1>& value) noexcept
+		{
+			_variant.uniform1uiv(value);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform1uiv(std::size_t num, const std::uint32_t* ui1v) noexcept
+		{
+			_variant.uniform1uiv(num, ui1v);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform2uiv(const std::vector<uint2>& value) noexcept
+		{
+			_variant.uniform2uiv(value);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform2uiv(std::size_t num, const std::uint32_t* ui2v) noexcept
+		{
+			_variant.uniform2uiv(num, ui2v);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform3uiv(const std::vector<uint3>& value) noexcept
+		{
+			_variant.uniform3uiv(value);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform3uiv(std::size_t num, const std::uint32_t* ui3v) noexcept
+		{
+			_variant.uniform3uiv(num, ui3v);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform4uiv(const std::vector<uint4>& value) noexcept
+		{
+			_variant.uniform4uiv(value);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform4uiv(std::size_t num, const std::uint32_t* ui4v) noexcept
+		{
+			_variant.uniform4uiv(num, ui4v);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform1fv(const std::vector<float1>& value) noexcept
+		{
+			_variant.uniform1fv(value);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform1fv(std::size_t num, const float* f1v) noexcept
+		{
+			_variant.uniform1fv(num, f1v);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform2fv(const std::vector<float2>& value) noexcept
+		{
+			_variant.uniform2fv(value);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform2fv(std::size_t num, const float* f2v) noexcept
+		{
+			_variant.uniform2fv(num, f2v);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform3fv(const std::vector<float3>& value) noexcept
+		{
+			_variant.uniform3fv(value);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform3fv(std::size_t num, const float* f3v) noexcept
+		{
+			_variant.uniform3fv(num, f3v);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform4fv(const std::vector<float4>& value) noexcept
+		{
+			_variant.uniform4fv(value);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform4fv(std::size_t num, const float* f4v) noexcept
+		{
+			_variant.uniform4fv(num, f4v);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform2fmatv(const std::vector<float2x2>& value) noexcept
+		{
+			_variant.uniform2fmatv(value);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform2fmatv(std::size_t num, const float* mat2) noexcept
+		{
+			_variant.uniform2fmatv(num, mat2);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform3fmatv(const std::vector<float3x3>& value) noexcept
+		{
+			_variant.uniform3fmatv(value);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform3fmatv(std::size_t num, const float* mat3) noexcept
+		{
+			_variant.uniform3fmatv(num, mat3);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform4fmatv(const std::vector<float4x4>& value) noexcept
+		{
+			_variant.uniform4fmatv(value);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniform4fmatv(std::size_t num, const float* mat4) noexcept
+		{
+			_variant.uniform4fmatv(num, mat4);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniformTexture(GraphicsTexturePtr texture, GraphicsSamplerPtr sampler) noexcept
+		{
+			_variant.uniformTexture(texture, sampler);
+			_statistics->uniformWrites++;
+		}
+
+		void
+		NullGraphicsUniformSet::uniformBuffer(GraphicsDataPtr ubo) noexcept
+		{
+			_variant.uniformBuffer(ubo);
+			_statistics->uniformWrites++;
+		}
+
+		bool
+		NullGraphicsUniformSet::getBool() const noexcept
+		{
+			return _variant.getBool();
+		}
+
+		int
+		NullGraphicsUniformSet::getInt() const noexcept
+		{
+			return _variant.getInt();
+		}
+
+		const int2&
+		NullGraphicsUniformSet::getInt2() const noexcept
+		{
+			return _variant.getInt2();
+		}
+
+		const int3&
+		NullGraphicsUniformSet::getInt3() const noexcept
+		{
+			return _variant.getInt3();
+		}
+
+		const int4&
+		NullGraphicsUniformSet::getInt4() const noexcept
+		{
+			return _variant.getInt4();
+		}
+
+		uint1
+		NullGraphicsUniformSet::getUInt() const noexcept
+		{
+			return _variant.getUInt();
+		}
+
+		const uint2&
+		NullGraphicsUniformSet::getUInt2() const noexcept
+		{
+			return _variant.getUInt2();
+		}
+
+		const uint3&
+		NullGraphicsUniformSet::getUInt3() const noexcept
+		{
+			return _variant.getUInt3();
+		}
+
+		const uint4&
+		NullGraphicsUniformSet::getUInt4() const noexcept
+		{
+			return _variant.getUInt4();
+		}
+
+		float
+		NullGraphicsUniformSet::getFloat() const noexcept
+		{
+			return _variant.getFloat();
+		}
+
+		const float2&
+		NullGraphicsUniformSet::getFloat2() const noexcept
+		{
+			return _variant.getFloat2();
+		}
+
+		const float3&
+		NullGraphicsUniformSet::getFloat3() const noexcept
+		{
+			return _variant.getFloat3();
+		}
+
+		const float4&
+		NullGraphicsUniformSet::getFloat4() const noexcept
+		{
+			return _variant.getFloat4();
+		}
+
+		const float2x2&
+		NullGraphicsUniformSet::getFloat2x2() const noexcept
+		{
+			return _variant.getFloat2x2();
+		}
+
+		const float3x3&
+		NullGraphicsUniformSet::getFloat3x3() const noexcept
+		{
+			return _variant.getFloat3x3();
+		}
+
+		const float4x4&
+		NullGraphicsUniformSet::getFloat4x4() const noexcept
+		{
+			return _variant.getFloat4x4();
+		}
+
+		const std::vector<int1>&
+		NullGraphicsUniformSet::getIntArray() const noexcept
+		{
+			return _variant.getIntArray();
+		}
+
+		const std::vector<int2>&
+		NullGraphicsUniformSet::getInt2Array() const noexcept
+		{
+			return _variant.getInt2Array();
+		}
+
+		const std::vector<int3>&
+		NullGraphicsUniformSet::getInt3Array() const noexcept
+		{
+			return _variant.getInt3Array();
+		}
+
+		const std::vector<int4>&
+		NullGraphicsUniformSet::getInt4Array() const noexcept
+		{
+			return _variant.getInt4Array();
+		}
+
+		const std::vector<uint1>&
+		NullGraphicsUniformSet::getUIntArray() const noexcept
+		{
+			return _variant.getUIntArray();
+		}
+
+		const std::vector<uint2>&
+		NullGraphicsUniformSet::getUInt2Array() const noexcept
+		{
+			return _variant.getUInt2Array();
+		}
+
+		const std::vector<uint3>&
+		NullGraphicsUniformSet::getUInt3Array() const noexcept
+		{
+			return _variant.getUInt3Array();
+		}
+
+		const std::vector<uint4>&
+		NullGraphicsUniformSet::getUInt4Array() const noexcept
+		{
+			return _variant.getUInt4Array();
+		}
+
+		const std::vector<float1>&
+		NullGraphicsUniformSet::getFloatArray() const noexcept
+		{
+			return _variant.getFloatArray();
+		}
+
+		const std::vector<float2>&
+		NullGraphicsUniformSet::getFloat2Array() const noexcept
+		{
+			return _variant.getFloat2Array();
+		}
+
+		const std::vector<float3>&
+		NullGraphicsUniformSet::getFloat3Array() const noexcept
+		{
+			return _variant.getFloat3Array();
+		}
+
+		const std::vector<float4>&
+		NullGraphicsUniformSet::getFloat4Array() const noexcept
+		{
+			return _variant.getFloat4Array();
+		}
+
+		const std::vector<float2x2>&
+		NullGraphicsUniformSet::getFloat2x2Array() const noexcept
+		{
+			return _variant.getFloat2x2Array();
+		}
+
+		const std::vector<float3x3>&
+		NullGraphicsUniformSet::getFloat3x3Array() const noexcept
+		{
+			return _variant.getFloat3x3Array();
+		}
+
+		const std::vector<float4x4>&
+		NullGraphicsUniformSet::getFloat4x4Array() const noexcept
+		{
+			return _variant.getFloat4x4Array();
+		}
+
+		const GraphicsTexturePtr&
+		NullGraphicsUniformSet::getTexture() const noexcept
+		{
+			return _variant.getTexture();
+		}
+
+		const GraphicsSamplerPtr&
+		NullGraphicsUniformSet::getTextureSampler() const noexcept
+		{
+			return _variant.getTextureSampler();
+		}
+
+		const GraphicsDataPtr&
+		NullGraphicsUniformSet::getBuffer() const noexcept
+		{
+			return _variant.getBuffer();
+		}
+
+		void
+		NullGraphicsUniformSet::setGraphicsParam(GraphicsParamPtr param) noexcept
+		{
+			assert(param);
+			_param = param;
+			_variant.setType(param->getType());
+		}
+
+		const GraphicsParamPtr&
+		NullGraphicsUniformSet::getGraphicsParam() const noexcept
+		{
+			return _param;
+		}
+
+		void
+		NullGraphicsUniformSet::setStatistics(const GraphicsStatisticsPtr& statistics) noexcept
+		{
+			_statistics = statistics;
+		}
+
+		NullDescriptorPool::NullDescriptorPool() noexcept
+		{
+		}
+
+		NullDescriptorPool::~NullDescriptorPool() noexcept
+		{
+			this->close();
+		}
+
+		bool
+		NullDescriptorPool::setup(const GraphicsDescriptorPoolDesc& /*desc*/) noexcept
+		{
+			return true;
+		}
+
+		void
+		NullDescriptorPool::close() noexcept
+		{
+		}
+
+		const GraphicsDescriptorPoolDesc&
+		NullDescriptorPool::getDescriptorPoolDesc() const noexcept
+		{
+			return _descriptorPoolDesc;
+		}
+
+		void
+		NullDescriptorPool::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullDescriptorPool::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+
+		NullDescriptorSetLayout::NullDescriptorSetLayout() noexcept
+		{
+		}
+
+		NullDescriptorSetLayout::~NullDescriptorSetLayout() noexcept
+		{
+			this->close();
+		}
+
+		bool
+		NullDescriptorSetLayout::setup(const GraphicsDescriptorSetLayoutDesc& descriptorSetLayoutDesc) noexcept
+		{
+			_descripotrSetLayoutDesc = descriptorSetLayoutDesc;
+			return true;
+		}
+
+		void
+		NullDescriptorSetLayout::close() noexcept
+		{
+		}
+
+		const GraphicsDescriptorSetLayoutDesc&
+		NullDescriptorSetLayout::getDescriptorSetLayoutDesc() const noexcept
+		{
+			return _descripotrSetLayoutDesc;
+		}
+
+		void
+		NullDescriptorSetLayout::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullDescriptorSetLayout::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+
+		NullDescriptorSet::NullDescriptorSet() noexcept
+		{
+		}
+
+		NullDescriptorSet::~NullDescriptorSet() noexcept
+		{
+			this->close();
+		}
+
+		bool
+		NullDescriptorSet::setup(const GraphicsDescriptorSetDesc& descriptorSetDesc) noexcept
+		{
+			assert(descriptorSetDesc.getDescriptorSetLayout());
+
+			auto& descriptorSetLayoutDesc = descriptorSetDesc.getDescriptorSetLayout()->getDescriptorSetLayoutDesc();
+
+			auto& params = descriptorSetLayoutDesc.getUniformComponents();
+			for (auto& uniform : params)
+			{
+				auto uniformSet = std::make_shared<NullGraphicsUniformSet>();
+				uniformSet->setGraphicsParam(uniform);
+				uniformSet->setStatistics(_statistics);
+				_activeUniformSets.push_back(uniformSet);
+			}
+
+			_descriptorSetDesc = descriptorSetDesc;
+			return true;
+		}
+
+		void
+		NullDescriptorSet::close() noexcept
+		{
+			_activeUniformSets.clear();
+		}
+
+		void
+		NullDescriptorSet::copy(std::uint32_t descriptorCopyCount, const GraphicsDescriptorSetPtr descriptorCopies[]) noexcept
+		{
+			for (std::size_t i = 0; i < descriptorCopyCount; i++)
+			{
+				if (!descriptorCopies[i])
+					continue;
+
+				auto descriptorCope = descriptorCopies[i]->downcast<NullDescriptorSet>();
+				for (auto& activeUniformSet : descriptorCope->_activeUniformSets)
+				{
+					auto it = std::find_if(_activeUniformSets.begin(), _activeUniformSets.end(), [&](GraphicsUniformSetPtr& it) { return it->getGraphicsParam() == activeUniformSet->getGraphicsParam(); });
+					if (it == _activeUniformSets.end())
+						continue;
+
+					auto type = activeUniformSet->getGraphicsParam()->getType();
+					switch (type)
+					{
+					case GraphicsUniformType::Boolean:
+						(*it)->uniform1b(activeUniformSet->getBool());
+						break;
+					case GraphicsUniformType::Int:
+						(*it)->uniform1i(activeUniformSet->getInt());
+						break;
+					case GraphicsUniformType::Int2:
+						(*it)->uniform2i(activeUniformSet->getInt2());
+						break;
+					case GraphicsUniformType::Int3:
+						(*it)->uniform3i(activeUniformSet->getInt3());
+						break;
+					case GraphicsUniformType::Int4:
+						(*it)->uniform4i(activeUniformSet->getInt4());
+						break;
+					case GraphicsUniformType::UInt:
+						(*it)->uniform1ui(activeUniformSet->getUInt());
+						break;
+					case GraphicsUniformType::UInt2:
+						(*it)->uniform2ui(activeUniformSet->getUInt2());
+						break;
+					case GraphicsUniformType::UInt3:
+						(*it)->uniform3ui(activeUniformSet->getUInt3());
+						break;
+					case GraphicsUniformType::UInt4:
+						(*it)->uniform4ui(activeUniformSet->getUInt4());
+						break;
+					case GraphicsUniformType::Float:
+						(*it)->uniform1f(activeUniformSet->getFloat());
+						break;
+					case GraphicsUniformType::Float2:
+						(*it)->uniform2f(activeUniformSet->getFloat2());
+						break;
+					case GraphicsUniformType::Float3:
+						(*it)->uniform3f(activeUniformSet->getFloat3());
+						break;
+					case GraphicsUniformType::Float4:
+						(*it)->uniform4f(activeUniformSet->getFloat4());
+						break;
+					case GraphicsUniformType::Float2x2:
+						(*it)->uniform2fmat(activeUniformSet->getFloat2x2());
+						break;
+					case GraphicsUniformType::Float3x3:
+						(*it)->uniform3fmat(activeUniformSet->getFloat3x3());
+						break;
+					case GraphicsUniformType::Float4x4:
+						(*it)->uniform4fmat(activeUniformSet->getFloat4x4());
+						break;
+					case GraphicsUniformType::IntArray:
+						(*it)->uniform1iv(activeUniformSet->getIntArray());
+						break;
+					case GraphicsUniformType::Int2Array:
+						(*it)->uniform2iv(activeUniformSet->getInt2Array());
+						break;
+					case GraphicsUniformType::Int3Array:
+						(*it)->uniform3iv(activeUniformSet->getInt3Array());
+						break;
+					case GraphicsUniformType::Int4Array:
+						(*it)->uniform4iv(activeUniformSet->getInt4Array());
+						break;
+					case GraphicsUniformType::UIntArray:
+						(*it)->uniform1uiv(activeUniformSet->getUIntArray());
+						break;
+					case GraphicsUniformType::UInt2Array:
+						(*it)->uniform2uiv(activeUniformSet->getUInt2Array());
+						break;
+					case GraphicsUniformType::UInt3Array:
+						(*it)->uniform3uiv(activeUniformSet->getUInt3Array());
+						break;
+					case GraphicsUniformType::UInt4Array:
+						(*it)->uniform4uiv(activeUniformSet->getUInt4Array());
+						break;
+					case GraphicsUniformType::FloatArray:
+						(*it)->uniform1fv(activeUniformSet->getFloatArray());
+						break;
+					case GraphicsUniformType::Float2Array:
+						(*it)->uniform2fv(activeUniformSet->getFloat2Array());
+						break;
+					case GraphicsUniformType::Float3Array:
+						(*it)->uniform3fv(activeUniformSet->getFloat3Array());
+						break;
+					case GraphicsUniformType::Float4Array:
+						(*it)->uniform4fv(activeUniformSet->getFloat4Array());
+						break;
+					case GraphicsUniformType::Float2x2Array:
+						(*it)->uniform2fmatv(activeUniformSet->getFloat2x2Array());
+						break;
+					case GraphicsUniformType::Float3x3Array:
+						(*it)->uniform3fmatv(activeUniformSet->getFloat3x3Array());
+						break;
+					case GraphicsUniformType::Float4x4Array:
+						(*it)->uniform4fmatv(activeUniformSet->getFloat4x4Array());
+						break;
+					case GraphicsUniformType::Sampler:
+						(*it)->uniformTexture(activeUniformSet->getTexture(), activeUniformSet->getTextureSampler());
+						break;
+					case GraphicsUniformType::SamplerImage:
+						(*it)->uniformTexture(activeUniformSet->getTexture(), activeUniformSet->getTextureSampler());
+						break;
+					case GraphicsUniformType::CombinedImageSampler:
+						(*it)->uniformTexture(activeUniformSet->getTexture(), activeUniformSet->getTextureSampler());
+						break;
+					case GraphicsUniformType::StorageImage:
+						(*it)->uniformTexture(activeUniformSet->getTexture(), activeUniformSet->getTextureSampler());
+						break;
+					case GraphicsUniformType::StorageTexelBuffer:
+						break;
+					case GraphicsUniformType::StorageBuffer:
+						break;
+					case GraphicsUniformType::StorageBufferDynamic:
+						break;
+					case GraphicsUniformType::UniformTexelBuffer:
+						break;
+					case GraphicsUniformType::UniformBuffer:
+						(*it)->uniformBuffer(activeUniformSet->getBuffer());
+						break;
+					case GraphicsUniformType::UniformBufferDynamic:
+						break;
+					case GraphicsUniformType::InputAttachment:
+						break;
+					default:
+						break;
+					}
+				}
+			}
+		}
+
+		const GraphicsUniformSets&
+		NullDescriptorSet::getUniformSets() const noexcept
+		{
+			return _activeUniformSets;
+		}
+
+		const GraphicsDescriptorSetDesc&
+		NullDescriptorSet::getDescriptorSetDesc() const noexcept
+		{
+			return _descriptorSetDesc;
+		}
+
+		void
+		NullDescriptorSet::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullDescriptorSet::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+
+		void
+		NullDescriptorSet::setStatistics(const GraphicsStatisticsPtr& statistics) noexcept
+		{
+			_statistics = statistics;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,223 @@
+#include "null_device.h"
+#include "null_device_context.h"
+#include "null_device_property.h"
+#include "null_swapchain.h"
+#include "null_shader.h"
+#include "null_texture.h"
+#include "null_framebuffer.h"
+#include "null_input_layout.h"
+#include "null_descriptor_set.h"
+#include "null_graphics_data.h"
+#include "null_state.h"
+#include "null_sampler.h"
+#include "null_pipeline.h"
+
+namespace octoon
+{
+	namespace hal
+	{
+		OctoonImplementSubClass(NullDevice, GraphicsDevice, "NullDevice")
+
+		NullDevice::NullDevice() noexcept
+		{
+		}
+
+		NullDevice::~NullDevice() noexcept
+		{
+			this->close();
+		}
+
+		bool
+		NullDevice::setup(const GraphicsDeviceDesc& desc) noexcept
+		{
+			auto deviceProperty = std::make_shared<NullDeviceProperty>();
+			if (!deviceProperty->setup(desc))
+				return false;
+
+			_statistics = std::make_shared<GraphicsStatistics>();
+			_deviceProperty = deviceProperty;
+			_deviceDesc = desc;
+			return true;
+		}
+
+		void
+		NullDevice::close() noexcept
+		{
+			_statistics.reset();
+			_deviceProperty.reset();
+		}
+
+		GraphicsSwapchainPtr
+		NullDevice::createSwapchain(const GraphicsSwapchainDesc& desc) noexcept
+		{
+			auto swapchain = std::make_shared<NullSwapchain>();
+			swapchain->setDevice(this->downcast_pointer<NullDevice>());
+			if (swapchain->setup(desc))
+				return swapchain;
+			return nullptr;
+		}
+
+		GraphicsContextPtr
+		NullDevice::createDeviceContext(const GraphicsContextDesc& desc) noexcept
+		{
+			auto context = std::make_shared<NullDeviceContext>();
+			context->setDevice(this->downcast_pointer<NullDevice>());
+			context->setStatistics(_statistics);
+			if (context->setup(desc))
+				return context;
+			return nullptr;
+		}
+
+		GraphicsInputLayoutPtr
+		NullDevice::createInputLayout(const GraphicsInputLayoutDesc& desc) noexcept
+		{
+			auto inputLayout = std::make_shared<NullInputLayout>();
+			inputLayout->setDevice(this->downcast_pointer<NullDevice>());
+			if (inputLayout->setup(desc))
+				return inputLayout;
+			return nullptr;
+		}
+
+		GraphicsDataPtr
+		NullDevice::createGraphicsData(const GraphicsDataDesc& desc) noexcept
+		{
+			auto data = std::make_shared<NullGraphicsData>();
+			data->setDevice(this->downcast_pointer<NullDevice>());
+			data->setStatistics(_statistics);
+			if (data->setup(desc))
+				return data;
+			return nullptr;
+		}
+
+		GraphicsTexturePtr
+		NullDevice::createTexture(const GraphicsTextureDesc& desc) noexcept
+		{
+			auto texture = std::make_shared<NullTexture>();
+			texture->setDevice(this->downcast_pointer<NullDevice>());
+			texture->setStatistics(_statistics);
+			if (texture->setup(desc))
+				return texture;
+			return nullptr;
+		}
+
+		GraphicsSamplerPtr
+		NullDevice::createSampler(const GraphicsSamplerDesc& desc) noexcept
+		{
+			auto sampler = std::make_shared<NullSampler>();
+			sampler->setDevice(this->downcast_pointer<NullDevice>());
+			if (sampler->setup(desc))
+				return sampler;
+			return nullptr;
+		}
+
+		GraphicsFramebufferPtr
+		NullDevice::createFramebuffer(const GraphicsFramebufferDesc& desc) noexcept
+		{
+			auto framebuffer = std::make_shared<NullFramebuffer>();
+			framebuffer->setDevice(this->downcast_pointer<NullDevice>());
+			if (framebuffer->setup(desc))
+				return framebuffer;
+			return nullptr;
+		}
+
+		GraphicsFramebufferLayoutPtr
+		NullDevice::createFramebufferLayout(const GraphicsFramebufferLayoutDesc& desc) noexcept
+		{
+			auto framebufferLayout = std::make_shared<NullFramebufferLayout>();
+			framebufferLayout->setDevice(this->downcast_pointer<NullDevice>());
+			if (framebufferLayout->setup(desc))
+				return framebufferLayout;
+			return nullptr;
+		}
+
+		GraphicsStatePtr
+		NullDevice::createRenderState(const GraphicsStateDesc& desc) noexcept
+		{
+			auto state = std::make_shared<NullGraphicsState>();
+			state->setDevice(this->downcast_pointer<NullDevice>());
+			if (state->setup(desc))
+				return state;
+			return nullptr;
+		}
+
+		GraphicsShaderPtr
+		NullDevice::createShader(const GraphicsShaderDesc& desc) noexcept
+		{
+			auto shader = std::make_shared<NullShader>();
+			shader->setDevice(this->downcast_pointer<NullDevice>());
+			if (shader->setup(desc))
+				return shader;
+			return nullptr;
+		}
+
+		GraphicsProgramPtr
+		NullDevice::createProgram(const GraphicsProgramDesc& desc) noexcept
+		{
+			auto program = std::make_shared<NullProgram>();
+			program->setDevice(this->downcast_pointer<NullDevice>());
+			if (program->setup(desc))
+				return program;
+			return nullptr;
+		}
+
+		GraphicsPipelinePtr
+		NullDevice::createRenderPipeline(const GraphicsPipelineDesc& desc) noexcept
+		{
+			auto pipeline = std::make_shared<NullPipeline>();
+			pipeline->setDevice(this->downcast_pointer<NullDevice>());
+			if (pipeline->setup(desc))
+				return pipeline;
+			return nullptr;
+		}
+
+		GraphicsDescriptorSetPtr
+		NullDevice::createDescriptorSet(const GraphicsDescriptorSetDesc& desc) noexcept
+		{
+			auto descriptorSet = std::make_shared<NullDescriptorSet>();
+			descriptorSet->setDevice(this->downcast_pointer<NullDevice>());
+			descriptorSet->setStatistics(_statistics);
+			if (descriptorSet->setup(desc))
+				return descriptorSet;
+			return nullptr;
+		}
+
+		GraphicsDescriptorSetLayoutPtr
+		NullDevice::createDescriptorSetLayout(const GraphicsDescriptorSetLayoutDesc& desc) noexcept
+		{
+			auto descriptorSetLayout = std::make_shared<NullDescriptorSetLayout>();
+			descriptorSetLayout->setDevice(this->downcast_pointer<NullDevice>());
+			if (descriptorSetLayout->setup(desc))
+				return descriptorSetLayout;
+			return nullptr;
+		}
+
+		GraphicsDescriptorPoolPtr
+		NullDevice::createDescriptorPool(const GraphicsDescriptorPoolDesc& desc) noexcept
+		{
+			auto descriptorPool = std::make_shared<NullDescriptorPool>();
+			descriptorPool->setDevice(this->downcast_pointer<NullDevice>());
+			if (descriptorPool->setup(desc))
+				return descriptorPool;
+			return nullptr;
+		}
+
+		void
+		NullDevice::copyDescriptorSets(GraphicsDescriptorSetPtr& source, std::uint32_t descriptorCopyCount, const GraphicsDescriptorSetPtr descriptorCopies[]) noexcept
+		{
+			assert(source);
+			source->downcast<NullDescriptorSet>()->copy(descriptorCopyCount, descriptorCopies);
+		}
+
+		const GraphicsDeviceProperty&
+		NullDevice::getDeviceProperty() const noexcept
+		{
+			return *_deviceProperty;
+		}
+
+		const GraphicsDeviceDesc&
+		NullDevice::getDeviceDesc() const noexcept
+		{
+			return _deviceDesc;
+		}
+	}
+}
@@ -0,0 +1,56 @@
+#ifndef OCTOON_NULL_DEVICE_H_
+#define OCTOON_NULL_DEVICE_H_
+
+#include "null_types.h"
+
+namespace octoon
+{
+	namespace hal
+	{
+		// Device that records API calls without talking to a driver.
+		// Resources keep their memory on the CPU and every context created from this device shares
+		// the same statistics, so renderer-side costs can be measured without a GPU or a window.
+		class NullDevice final : public GraphicsDevice
+		{
+			OctoonDeclareSubClass(NullDevice, GraphicsDevice)
+		public:
+			NullDevice() noexcept;
+			virtual ~NullDevice() noexcept;
+
+			bool setup(const GraphicsDeviceDesc& desc) noexcept;
+			void close() noexcept;
+
+			GraphicsSwapchainPtr createSwapchain(const GraphicsSwapchainDesc& desc) noexcept override;
+			GraphicsContextPtr createDeviceContext(const GraphicsContextDesc& desc) noexcept override;
+			GraphicsInputLayoutPtr createInputLayout(const GraphicsInputLayoutDesc& desc) noexcept override;
+			GraphicsDataPtr createGraphicsData(const GraphicsDataDesc& desc) noexcept override;
+			GraphicsTexturePtr createTexture(const GraphicsTextureDesc& desc) noexcept override;
+			GraphicsSamplerPtr createSampler(const GraphicsSamplerDesc& desc) noexcept override;
+			GraphicsFramebufferPtr createFramebuffer(const GraphicsFramebufferDesc& desc) noexcept override;
+			GraphicsFramebufferLayoutPtr createFramebufferLayout(const GraphicsFramebufferLayoutDesc& desc) noexcept override;
+			GraphicsShaderPtr createShader(const GraphicsShaderDesc& desc) noexcept override;
+			GraphicsProgramPtr createProgram(const GraphicsProgramDesc& desc) noexcept override;
+			GraphicsStatePtr createRenderState(const GraphicsStateDesc& desc) noexcept override;
+			GraphicsPipelinePtr createRenderPipeline(const GraphicsPipelineDesc& desc) noexcept override;
+			GraphicsDescriptorSetPtr createDescriptorSet(const GraphicsDescriptorSetDesc& desc) noexcept override;
+			GraphicsDescriptorSetLayoutPtr createDescriptorSetLayout(const GraphicsDescriptorSetLayoutDesc& desc) noexcept override;
+			GraphicsDescriptorPoolPtr createDescriptorPool(const GraphicsDescriptorPoolDesc& desc) noexcept override;
+
+			void copyDescriptorSets(GraphicsDescriptorSetPtr& source, std::uint32_t descriptorCopyCount, const GraphicsDescriptorSetPtr descriptorCopies[]) noexcept override;
+
+			const GraphicsDeviceProperty& getDeviceProperty() const noexcept override;
+			const GraphicsDeviceDesc& getDeviceDesc() const noexcept override;
+
+		private:
+			NullDevice(const NullDevice&) noexcept = delete;
+			NullDevice& operator=(const NullDevice&) noexcept = delete;
+
+		private:
+			GraphicsDeviceDesc _deviceDesc;
+			GraphicsStatisticsPtr _statistics;
+			GraphicsDevicePropertyPtr _deviceProperty;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,354 @@
+#include "null_device_context.h"
+#include "null_pipeline.h"
+#include "null_descriptor_set.h"
+#include "null_framebuffer.h"
+#include "null_graphics_data.h"
+#include "null_swapchain.h"
+
+namespace octoon
+{
+	namespace hal
+	{
+		OctoonImplementSubClass(NullDeviceContext, GraphicsContext, "NullDeviceContext")
+
+		NullDeviceContext::NullDeviceContext() noexcept
+			: _stencilCompareMask{ 0xFFFFFFFF, 0xFFFFFFFF }
+			, _stencilReference{ 0, 0 }
+			, _stencilWriteMask{ 0xFFFFFFFF, 0xFFFFFFFF }
+		{
+		}
+
+		NullDeviceContext::~NullDeviceContext() noexcept
+		{
+			this->close();
+		}
+
+		bool
+		NullDeviceContext::setup(const GraphicsContextDesc& desc) noexcept
+		{
+			assert(desc.getSwapchain());
+			assert(desc.getSwapchain()->isInstanceOf<NullSwapchain>());
+			assert(_statistics);
+
+			_swapchain = desc.getSwapchain()->downcast_pointer<NullSwapchain>();
+
+			auto& deviceProperties = this->getDevice()->getDeviceProperty().getDeviceProperties();
+			_vertexBuffers.resize(deviceProperties.maxVertexInputBindings);
+			_vertexOffsets.resize(deviceProperties.maxVertexInputBindings, 0);
+			_viewports.resize(deviceProperties.maxViewports, float4(0, 0, 0, 0));
+			_scissors.resize(deviceProperties.maxViewports, uint4(0, 0, 0, 0));
+
+			return true;
+		}
+
+		void
+		NullDeviceContext::close() noexcept
+		{
+			_framebuffer = nullptr;
+			_pipeline = nullptr;
+			_descriptorSet = nullptr;
+			_swapchain = nullptr;
+			_indexBuffer.reset();
+			_vertexBuffers.clear();
+			_vertexOffsets.clear();
+		}
+
+		void
+		NullDeviceContext::renderBegin() noexcept
+		{
+			this->setRenderPipeline(nullptr);
+			this->setIndexBufferData(nullptr);
+		}
+
+		void
+		NullDeviceContext::renderEnd() noexcept
+		{
+		}
+
+		void
+		NullDeviceContext::setViewport(std::uint32_t i, const float4& viewport) noexcept
+		{
+			assert(_viewports.size() > i);
+			_viewports[i] = viewport;
+		}
+
+		const float4&
+		NullDeviceContext::getViewport(std::uint32_t i) const noexcept
+		{
+			return _viewports[i];
+		}
+
+		void
+		NullDeviceContext::setScissor(std::uint32_t i, const uint4& scissor) noexcept
+		{
+			assert(_scissors.size() > i);
+			_scissors[i] = scissor;
+		}
+
+		const uint4&
+		NullDeviceContext::getScissor(std::uint32_t i) const noexcept
+		{
+			return _scissors[i];
+		}
+
+		void
+		NullDeviceContext::setStencilCompareMask(GraphicsStencilFaceFlags face, std::uint32_t mask) noexcept
+		{
+			if (face & GraphicsStencilFaceFlagBits::FrontBit)
+				_stencilCompareMask[0] = mask;
+			if (face & GraphicsStencilFaceFlagBits::BackBit)
+				_stencilCompareMask[1] = mask;
+		}
+
+		std::uint32_t
+		NullDeviceContext::getStencilCompareMask(GraphicsStencilFaceFlags face) noexcept
+		{
+			assert(face == GraphicsStencilFaceFlagBits::FrontBit || face == GraphicsStencilFaceFlagBits::BackBit);
+			return face == GraphicsStencilFaceFlagBits::FrontBit ? _stencilCompareMask[0] : _stencilCompareMask[1];
+		}
+
+		void
+		NullDeviceContext::setStencilReference(GraphicsStencilFaceFlags face, std::uint32_t reference) noexcept
+		{
+			if (face & GraphicsStencilFaceFlagBits::FrontBit)
+				_stencilReference[0] = reference;
+			if (face & GraphicsStencilFaceFlagBits::BackBit)
+				_stencilReference[1] = reference;
+		}
+
+		std::uint32_t
+		NullDeviceContext::getStencilReference(GraphicsStencilFaceFlags face) noexcept
+		{
+			assert(face == GraphicsStencilFaceFlagBits::FrontBit || face == GraphicsStencilFaceFlagBits::BackBit);
+			return face == GraphicsStencilFaceFlagBits::FrontBit ? _stencilReference[0] : _stencilReference[1];
+		}
+
+		void
+		NullDeviceContext::setStencilWriteMask(GraphicsStencilFaceFlags face, std::uint32_t mask) noexcept
+		{
+			if (face & GraphicsStencilFaceFlagBits::FrontBit)
+				_stencilWriteMask[0] = mask;
+			if (face & GraphicsStencilFaceFlagBits::BackBit)
+				_stencilWriteMask[1] = mask;
+		}
+
+		std::uint32_t
+		NullDeviceContext::getStencilWriteMask(GraphicsStencilFaceFlags face) noexcept
+		{
+			assert(face == GraphicsStencilFaceFlagBits::FrontBit || face == GraphicsStencilFaceFlagBits::BackBit);
+			return face == GraphicsStencilFaceFlagBits::FrontBit ? _stencilWriteMask[0] : _stencilWriteMask[1];
+		}
+
+		void
+		NullDeviceContext::setRenderPipeline(const GraphicsPipelinePtr& pipeline) noexcept
+		{
+			assert(!pipeline || pipeline && pipeline->isInstanceOf<NullPipeline>());
+
+			auto nullPipeline = pipeline ? pipeline->downcast_pointer<NullPipeline>() : nullptr;
+			if (_pipeline != nullPipeline)
+			{
+				if (nullPipeline)
+					_statistics->pipelineBinds++;
+
+				_pipeline = nullPipeline;
+			}
+		}
+
+		GraphicsPipelinePtr
+		NullDeviceContext::getRenderPipeline() const noexcept
+		{
+			return _pipeline;
+		}
+
+		void
+		NullDeviceContext::setDescriptorSet(const GraphicsDescriptorSetPtr& descriptorSet) noexcept
+		{
+			assert(descriptorSet);
+			assert(descriptorSet->isInstanceOf<NullDescriptorSet>());
+
+			// The GL backends re-apply the descriptor set on every call, so every call is counted.
+			_descriptorSet = descriptorSet->downcast_pointer<NullDescriptorSet>();
+			_statistics->descriptorSetBinds++;
+		}
+
+		GraphicsDescriptorSetPtr
+		NullDeviceContext::getDescriptorSet() const noexcept
+		{
+			return _descriptorSet;
+		}
+
+		void
+		NullDeviceContext::setVertexBufferData(std::uint32_t i, const GraphicsDataPtr& data, std::intptr_t offset) noexcept
+		{
+			assert(data);
+			assert(data->isInstanceOf<NullGraphicsData>());
+			assert(data->getDataDesc().getType() == GraphicsDataType::StorageVertexBuffer);
+			assert(_vertexBuffers.size() > i);
+
+			auto vbo = data->downcast_pointer<NullGraphicsData>();
+			if (_vertexBuffers[i] != vbo || _vertexOffsets[i] != offset)
+			{
+				_vertexBuffers[i] = vbo;
+				_vertexOffsets[i] = offset;
+				_statistics->vertexBufferBinds++;
+			}
+		}
+
+		GraphicsDataPtr
+		NullDeviceContext::getVertexBufferData(std::uint32_t i) const noexcept
+		{
+			assert(_vertexBuffers.size() > i);
+			return _vertexBuffers[i];
+		}
+
+		void
+		NullDeviceContext::setIndexBufferData(const GraphicsDataPtr& data, std::intptr_t /*offset*/, GraphicsIndexType /*indexType*/) noexcept
+		{
+			if (data)
+			{
+				assert(data->isInstanceOf<NullGraphicsData>());
+				assert(data->getDataDesc().getType() == GraphicsDataType::StorageIndexBuffer);
+
+				auto ibo = data->downcast_pointer<NullGraphicsData>();
+				if (_indexBuffer != ibo)
+				{
+					_indexBuffer = ibo;
+					_statistics->indexBufferBinds++;
+				}
+			}
+			else
+			{
+				_indexBuffer = nullptr;
+			}
+		}
+
+		GraphicsDataPtr
+		NullDeviceContext::getIndexBufferData() const noexcept
+		{
+			return _indexBuffer;
+		}
+
+		void
+		NullDeviceContext::generateMipmap(const GraphicsTexturePtr& /*texture*/) noexcept
+		{
+			assert(texture);
+		}
+
+		void
+		NullDeviceContext::setFramebuffer(const GraphicsFramebufferPtr& target) noexcept
+		{
+			assert(!target || target->isInstanceOf<NullFramebuffer>());
+
+			auto framebuffer = target ? target->downcast_pointer<NullFramebuffer>() : nullptr;
+			if (_framebuffer != framebuffer)
+			{
+				_framebuffer = framebuffer;
+				_statistics->framebufferBinds++;
+			}
+		}
+
+		void
+		NullDeviceContext::clearFramebuffer(std::uint32_t /*i*/, GraphicsClearFlags /*flags*/, const float4& /*color*/, float /*depth*/, std::int32_t /*stencil*/) noexcept
+		{
+		}
+
+		void
+		NullDeviceContext::discardFramebuffer(const GraphicsFramebufferPtr& /*src*/, GraphicsClearFlags /*flags*/) noexcept
+		{
+		}
+
+		void
+		NullDeviceContext::blitFramebuffer(const GraphicsFramebufferPtr& /*src*/, const float4& /*v1*/, const GraphicsFramebufferPtr& /*dest*/, const float4& /*v2*/) noexcept
+		{
+		}
+
+		void
+		NullDeviceContext::readFramebuffer(std::uint32_t /*i*/, const GraphicsTexturePtr& /*texture*/, std::uint32_t /*miplevel*/, std::uint32_t /*x*/, std::uint32_t /*y*/, std::uint32_t /*width*/, std::uint32_t /*height*/) noexcept
+		{
+		}
+
+		void
+		NullDeviceContext::readFramebufferToCube(std::uint32_t /*i*/, std::uint32_t /*face*/, const GraphicsTexturePtr& /*texture*/, std::uint32_t /*miplevel*/, std::uint32_t /*x*/, std::uint32_t /*y*/, std::uint32_t /*width*/, std::uint32_t /*height*/) noexcept
+		{
+		}
+
+		GraphicsFramebufferPtr
+		NullDeviceContext::getFramebuffer() const noexcept
+		{
+			return _framebuffer;
+		}
+
+		void
+		NullDeviceContext::draw(std::uint32_t numVertices, std::uint32_t numInstances, std::uint32_t /*startVertice*/, std::uint32_t /*startInstances*/) noexcept
+		{
+			assert(_pipeline);
+			assert(numInstances > 0);
+
+			_statistics->drawCalls++;
+			_statistics->instances += numInstances;
+			_statistics->vertices += static_cast<std::uint64_t>(numVertices) * numInstances;
+		}
+
+		void
+		NullDeviceContext::drawIndexed(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t /*startIndice*/, std::uint32_t /*startVertice*/, std::uint32_t /*startInstances*/) noexcept
+		{
+			assert(_pipeline);
+			assert(_indexBuffer);
+			assert(numInstances > 0);
+
+			_statistics->drawCalls++;
+			_statistics->instances += numInstances;
+			_statistics->vertices += static_cast<std::uint64_t>(numIndices) * numInstances;
+		}
+
+		void
+		NullDeviceContext::drawIndirect(const GraphicsDataPtr& /*data*/, std::size_t /*offset*/, std::uint32_t drawCount, std::uint32_t /*stride*/) noexcept
+		{
+			assert(_pipeline);
+			_statistics->drawCalls += drawCount;
+		}
+
+		void
+		NullDeviceContext::drawIndexedIndirect(const GraphicsDataPtr& /*data*/, std::size_t /*offset*/, std::uint32_t drawCount, std::uint32_t /*stride*/) noexcept
+		{
+			assert(_pipeline);
+			assert(_indexBuffer);
+			_statistics->drawCalls += drawCount;
+		}
+
+		void
+		NullDeviceContext::present() noexcept
+		{
+		}
+
+		const GraphicsStatistics&
+		NullDeviceContext::getStatistics() const noexcept
+		{
+			return *_statistics;
+		}
+
+		void
+		NullDeviceContext::resetStatistics() noexcept
+		{
+			*_statistics = GraphicsStatistics();
+		}
+
+		void
+		NullDeviceContext::setStatistics(const GraphicsStatisticsPtr& statistics) noexcept
+		{
+			_statistics = statistics;
+		}
+
+		void
+		NullDeviceContext::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullDeviceContext::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+	}
+}
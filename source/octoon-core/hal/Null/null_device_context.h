@@ -0,0 +1,103 @@
+#ifndef OCTOON_NULL_DEVICE_CONTEXT_H_
+#define OCTOON_NULL_DEVICE_CONTEXT_H_
+
+#include "null_types.h"
+
+namespace octoon
+{
+	namespace hal
+	{
+		class NullDeviceContext final : public GraphicsContext
+		{
+			OctoonDeclareSubClass(NullDeviceContext, GraphicsContext)
+		public:
+			NullDeviceContext() noexcept;
+			~NullDeviceContext() noexcept;
+
+			bool setup(const GraphicsContextDesc& desc) noexcept;
+			void close() noexcept;
+
+			void renderBegin() noexcept;
+			void renderEnd() noexcept;
+
+			void setViewport(std::uint32_t i, const float4& viewport) noexcept;
+			const float4& getViewport(std::uint32_t i) const noexcept;
+
+			void setScissor(std::uint32_t i, const uint4& scissor) noexcept;
+			const uint4& getScissor(std::uint32_t i) const noexcept;
+
+			void setStencilCompareMask(GraphicsStencilFaceFlags face, std::uint32_t mask) noexcept;
+			std::uint32_t getStencilCompareMask(GraphicsStencilFaceFlags face) noexcept;
+
+			void setStencilReference(GraphicsStencilFaceFlags face, std::uint32_t reference) noexcept;
+			std::uint32_t getStencilReference(GraphicsStencilFaceFlags face) noexcept;
+
+			void setStencilWriteMask(GraphicsStencilFaceFlags face, std::uint32_t mask) noexcept;
+			std::uint32_t getStencilWriteMask(GraphicsStencilFaceFlags face) noexcept;
+
+			void setRenderPipeline(const GraphicsPipelinePtr& pipeline) noexcept;
+			GraphicsPipelinePtr getRenderPipeline() const noexcept;
+
+			void setDescriptorSet(const GraphicsDescriptorSetPtr& descriptorSet) noexcept;
+			GraphicsDescriptorSetPtr getDescriptorSet() const noexcept;
+
+			void setVertexBufferData(std::uint32_t i, const GraphicsDataPtr& data, std::intptr_t offset) noexcept;
+			GraphicsDataPtr getVertexBufferData(std::uint32_t i) const noexcept;
+
+			void setIndexBufferData(const GraphicsDataPtr& data, std::intptr_t offset = 0, GraphicsIndexType indexType = hal::GraphicsIndexType::UInt32) noexcept;
+			GraphicsDataPtr getIndexBufferData() const noexcept;
+
+			void generateMipmap(const GraphicsTexturePtr& texture) noexcept;
+
+			void setFramebuffer(const GraphicsFramebufferPtr& target) noexcept;
+			void clearFramebuffer(std::uint32_t i, GraphicsClearFlags flags, const float4& color, float depth, std::int32_t stencil) noexcept;
+			void discardFramebuffer(const GraphicsFramebufferPtr& src, GraphicsClearFlags flags) noexcept;
+			void blitFramebuffer(const GraphicsFramebufferPtr& src, const float4& v1, const GraphicsFramebufferPtr& dest, const float4& v2) noexcept;
+			void readFramebuffer(std::uint32_t i, const GraphicsTexturePtr& texture, std::uint32_t miplevel, std::uint32_t x, std::uint32_t y, std::uint32_t width, std::uint32_t height) noexcept;
+			void readFramebufferToCube(std::uint32_t i, std::uint32_t face, const GraphicsTexturePtr& texture, std::uint32_t miplevel, std::uint32_t x, std::uint32_t y, std::uint32_t width, std::uint32_t height) noexcept;
+			GraphicsFramebufferPtr getFramebuffer() const noexcept;
+
+			void draw(std::uint32_t numVertices, std::uint32_t numInstances, std::uint32_t startVertice, std::uint32_t startInstances) noexcept override;
+			void drawIndexed(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t startIndice, std::uint32_t startVertice, std::uint32_t startInstances) noexcept;
+			void drawIndirect(const GraphicsDataPtr& data, std::size_t offset, std::uint32_t drawCount, std::uint32_t stride) noexcept;
+			void drawIndexedIndirect(const GraphicsDataPtr& data, std::size_t offset, std::uint32_t drawCount, std::uint32_t stride) noexcept;
+
+			void present() noexcept;
+
+			const GraphicsStatistics& getStatistics() const noexcept override;
+			void resetStatistics() noexcept override;
+
+		private:
+			friend class NullDevice;
+			void setDevice(const GraphicsDevicePtr& device) noexcept;
+			GraphicsDevicePtr getDevice() noexcept override;
+
+			void setStatistics(const GraphicsStatisticsPtr& statistics) noexcept;
+
+		private:
+			NullDeviceContext(const NullDeviceContext&) noexcept = delete;
+			NullDeviceContext& operator=(const NullDeviceContext&) noexcept = delete;
+
+		private:
+			std::vector<float4> _viewports;
+			std::vector<uint4> _scissors;
+
+			std::uint32_t _stencilCompareMask[2];
+			std::uint32_t _stencilReference[2];
+			std::uint32_t _stencilWriteMask[2];
+
+			NullPipelinePtr _pipeline;
+			NullDescriptorSetPtr _descriptorSet;
+			NullFramebufferPtr _framebuffer;
+			NullSwapchainPtr _swapchain;
+			NullGraphicsDataPtr _indexBuffer;
+			std::vector<NullGraphicsDataPtr> _vertexBuffers;
+			std::vector<std::intptr_t> _vertexOffsets;
+
+			GraphicsStatisticsPtr _statistics;
+			GraphicsDeviceWeakPtr _device;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,72 @@
+#include "null_device_property.h"
+
+namespace octoon
+{
+	namespace hal
+	{
+		NullDeviceProperty::NullDeviceProperty() noexcept
+		{
+		}
+
+		NullDeviceProperty::~NullDeviceProperty() noexcept
+		{
+			this->close();
+		}
+
+		bool
+		NullDeviceProperty::setup(const GraphicsDeviceDesc& /*deviceDesc*/) noexcept
+		{
+			// Limits of a typical desktop GL 3.3 driver, so the renderer takes the same paths as on hardware.
+			_deviceProperties.maxImageDimension1D = 16384;
+			_deviceProperties.maxImageDimension2D = 16384;
+			_deviceProperties.maxImageDimension3D = 2048;
+			_deviceProperties.maxImageDimensionCube = 16384;
+			_deviceProperties.maxPerStageDescriptorSamplers = 16;
+			_deviceProperties.maxPerStageDescriptorUniformBuffers = 14;
+			_deviceProperties.maxDescriptorSetSamplers = 8;
+			_deviceProperties.maxDescriptorSetUniformBuffers = 84;
+			_deviceProperties.maxDescriptorSetInputAttachments = 192;
+			_deviceProperties.maxVertexInputAttributes = 16;
+			_deviceProperties.maxVertexInputBindings = 16;
+			_deviceProperties.maxVertexInputAttributeOffset = 2047;
+			_deviceProperties.maxVertexInputBindingStride = 2048;
+			_deviceProperties.maxVertexOutputComponents = 128;
+			_deviceProperties.maxFragmentInputComponents = 128;
+			_deviceProperties.maxFragmentOutputAttachments = 8;
+			_deviceProperties.maxViewports = 16;
+			_deviceProperties.maxViewportDimensionsW = 16384;
+			_deviceProperties.maxViewportDimensionsH = 16384;
+			_deviceProperties.maxFramebufferWidth = 16384;
+			_deviceProperties.maxFramebufferHeight = 16384;
+			_deviceProperties.maxFramebufferLayers = 2048;
+			_deviceProperties.maxFramebufferColorAttachments = 8;
+			_deviceProperties.minUniformBufferOffsetAlignment = 256;
+
+			for (std::uint8_t i = static_cast<std::uint8_t>(GraphicsFormat::R4G4UNormPack8); i <= static_cast<std::uint8_t>(GraphicsFormat::BC7SRGBBlock); i++)
+			{
+				_deviceProperties.supportTextures.push_back(static_cast<GraphicsFormat>(i));
+				_deviceProperties.supportAttribute.push_back(static_cast<GraphicsFormat>(i));
+			}
+
+			for (std::uint8_t i = static_cast<std::uint8_t>(GraphicsTextureDim::Texture2D); i <= static_cast<std::uint8_t>(GraphicsTextureDim::CubeArray); i++)
+				_deviceProperties.supportTextureDims.push_back(static_cast<GraphicsTextureDim>(i));
+
+			_deviceProperties.supportShaders.push_back(GraphicsShaderStageFlagBits::VertexBit);
+			_deviceProperties.supportShaders.push_back(GraphicsShaderStageFlagBits::FragmentBit);
+			_deviceProperties.supportShaders.push_back(GraphicsShaderStageFlagBits::GeometryBit);
+
+			return true;
+		}
+
+		void
+		NullDeviceProperty::close() noexcept
+		{
+		}
+
+		const GraphicsDeviceProperties&
+		NullDeviceProperty::getDeviceProperties() const noexcept
+		{
+			return _deviceProperties;
+		}
+	}
+}
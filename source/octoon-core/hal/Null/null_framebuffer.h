@@ -0,0 +1,66 @@
+#ifndef OCTOON_NULL_FRAMEBUFFER_H_
+#define OCTOON_NULL_FRAMEBUFFER_H_
+
+#include "null_types.h"
+
+namespace octoon
+{
+	namespace hal
+	{
+		class NullFramebufferLayout final : public GraphicsFramebufferLayout
+		{
+			OctoonDeclareSubClass(NullFramebufferLayout, GraphicsFramebufferLayout)
+		public:
+			NullFramebufferLayout() noexcept;
+			~NullFramebufferLayout() noexcept;
+
+			bool setup(const GraphicsFramebufferLayoutDesc& desc) noexcept;
+			void close() noexcept;
+
+			const GraphicsFramebufferLayoutDesc& getFramebufferLayoutDesc() const noexcept override;
+
+		private:
+			friend class NullDevice;
+			void setDevice(const GraphicsDevicePtr& device) noexcept;
+			GraphicsDevicePtr getDevice() noexcept override;
+
+		private:
+			NullFramebufferLayout(const NullFramebufferLayout&) noexcept = delete;
+			NullFramebufferLayout& operator=(const NullFramebufferLayout&) noexcept = delete;
+
+		private:
+			GraphicsFramebufferLayoutDesc _framebufferLayoutDesc;
+			GraphicsDeviceWeakPtr _device;
+		};
+
+		class NullFramebuffer final : public GraphicsFramebuffer
+		{
+			OctoonDeclareSubClass(NullFramebuffer, GraphicsFramebuffer)
+		public:
+			NullFramebuffer() noexcept;
+			~NullFramebuffer() noexcept;
+
+			bool setup(const GraphicsFramebufferDesc& desc) noexcept;
+			void close() noexcept;
+
+			std::uint64_t handle() const noexcept override;
+
+			const GraphicsFramebufferDesc& getFramebufferDesc() const noexcept override;
+
+		private:
+			friend class NullDevice;
+			void setDevice(const GraphicsDevicePtr& device) noexcept;
+			GraphicsDevicePtr getDevice() noexcept override;
+
+		private:
+			NullFramebuffer(const NullFramebuffer&) noexcept = delete;
+			NullFramebuffer& operator=(const NullFramebuffer&) noexcept = delete;
+
+		private:
+			GraphicsFramebufferDesc _framebufferDesc;
+			GraphicsDeviceWeakPtr _device;
+		};
+	}
+}
+
+#endif
\ No newline at end of file
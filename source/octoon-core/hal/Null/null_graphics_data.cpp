@@ -0,0 +1,91 @@
+#include "null_graphics_data.h"
+
+#include <cstring>
+
+namespace octoon
+{
+	namespace hal
+	{
+		OctoonImplementSubClass(NullGraphicsData, GraphicsData, "NullGraphicsData")
+
+		NullGraphicsData::NullGraphicsData() noexcept
+			: _mapped(false)
+		{
+		}
+
+		NullGraphicsData::~NullGraphicsData() noexcept
+		{
+			this->close();
+		}
+
+		bool
+		NullGraphicsData::setup(const GraphicsDataDesc& desc) noexcept
+		{
+			assert(desc.getStreamSize() > 0);
+
+			_data.resize(desc.getStreamSize());
+
+			if (desc.getStream())
+			{
+				std::memcpy(_data.data(), desc.getStream(), desc.getStreamSize());
+				_statistics->bytesUploaded += desc.getStreamSize();
+			}
+
+			_desc = desc;
+			_desc.setStream(nullptr);
+			return true;
+		}
+
+		void
+		NullGraphicsData::close() noexcept
+		{
+			_data.clear();
+			_mapped = false;
+		}
+
+		bool
+		NullGraphicsData::map(std::ptrdiff_t offset, std::ptrdiff_t count, void** data) noexcept
+		{
+			assert(data);
+			assert(!_mapped);
+			assert(offset >= 0 && offset + count <= (std::ptrdiff_t)_data.size());
+
+			if (_desc.getUsage() & GraphicsUsageFlagBits::WriteBit)
+				_statistics->bytesUploaded += count;
+
+			*data = _data.data() + offset;
+			_mapped = true;
+			return true;
+		}
+
+		void
+		NullGraphicsData::unmap() noexcept
+		{
+			_mapped = false;
+		}
+
+		const GraphicsDataDesc&
+		NullGraphicsData::getDataDesc() const noexcept
+		{
+			return _desc;
+		}
+
+		void
+		NullGraphicsData::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullGraphicsData::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+
+		void
+		NullGraphicsData::setStatistics(const GraphicsStatisticsPtr& statistics) noexcept
+		{
+			_statistics = statistics;
+		}
+	}
+}
@@ -0,0 +1,46 @@
+#ifndef OCTOON_NULL_GRAPHICS_DATA_H_
+#define OCTOON_NULL_GRAPHICS_DATA_H_
+
+#include "null_types.h"
+
+namespace octoon
+{
+	namespace hal
+	{
+		class NullGraphicsData final : public GraphicsData
+		{
+			OctoonDeclareSubClass(NullGraphicsData, GraphicsData)
+		public:
+			NullGraphicsData() noexcept;
+			~NullGraphicsData() noexcept;
+
+			bool setup(const GraphicsDataDesc& desc) noexcept;
+			void close() noexcept;
+
+			bool map(std::ptrdiff_t offset, std::ptrdiff_t count, void** data) noexcept override;
+			void unmap() noexcept override;
+
+			const GraphicsDataDesc& getDataDesc() const noexcept override;
+
+		private:
+			friend class NullDevice;
+			void setDevice(const GraphicsDevicePtr& device) noexcept;
+			GraphicsDevicePtr getDevice() noexcept override;
+
+			void setStatistics(const GraphicsStatisticsPtr& statistics) noexcept;
+
+		private:
+			NullGraphicsData(const NullGraphicsData&) noexcept = delete;
+			NullGraphicsData& operator=(const NullGraphicsData&) noexcept = delete;
+
+		private:
+			bool _mapped;
+			std::vector<std::uint8_t> _data;
+			GraphicsDataDesc _desc;
+			GraphicsStatisticsPtr _statistics;
+			GraphicsDeviceWeakPtr _device;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,48 @@
+#include "null_input_layout.h"
+
+namespace octoon
+{
+	namespace hal
+	{
+		OctoonImplementSubClass(NullInputLayout, GraphicsInputLayout, "NullInputLayout")
+
+		NullInputLayout::NullInputLayout() noexcept
+		{
+		}
+
+		NullInputLayout::~NullInputLayout() noexcept
+		{
+			this->close();
+		}
+
+		bool
+		NullInputLayout::setup(const GraphicsInputLayoutDesc& desc) noexcept
+		{
+			_inputLayoutDesc = desc;
+			return true;
+		}
+
+		void
+		NullInputLayout::close() noexcept
+		{
+		}
+
+		const GraphicsInputLayoutDesc&
+		NullInputLayout::getInputLayoutDesc() const noexcept
+		{
+			return _inputLayoutDesc;
+		}
+
+		void
+		NullInputLayout::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullInputLayout::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+	}
+}
\ No newline at end of file
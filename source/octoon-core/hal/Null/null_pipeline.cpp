@@ -0,0 +1,48 @@
+#include "null_pipeline.h"
+
+namespace octoon
+{
+	namespace hal
+	{
+		OctoonImplementSubClass(NullPipeline, GraphicsPipeline, "NullPipeline")
+
+		NullPipeline::NullPipeline() noexcept
+		{
+		}
+
+		NullPipeline::~NullPipeline() noexcept
+		{
+			this->close();
+		}
+
+		bool
+		NullPipeline::setup(const GraphicsPipelineDesc& desc) noexcept
+		{
+			_pipelineDesc = desc;
+			return true;
+		}
+
+		void
+		NullPipeline::close() noexcept
+		{
+		}
+
+		const GraphicsPipelineDesc&
+		NullPipeline::getPipelineDesc() const noexcept
+		{
+			return _pipelineDesc;
+		}
+
+		void
+		NullPipeline::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullPipeline::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+	}
+}
\ No newline at end of file
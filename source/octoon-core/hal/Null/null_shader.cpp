@@ -0,0 +1,709 @@
+#include "null_shader.h"
+
+#include <algorithm>
+#include <set>
+#include <cctype>
+#include <cstdlib>
+
+namespace octoon
+{
+	namespace hal
+	{
+		OctoonImplementSubClass(NullShader, GraphicsShader, "NullShader")
+		OctoonImplementSubClass(NullProgram, GraphicsProgram, "NullProgram")
+		OctoonImplementSubClass(NullGraphicsAttribute, GraphicsAttribute, "NullGraphicsAttribute")
+		OctoonImplementSubClass(NullGraphicsUniform, GraphicsUniform, "NullGraphicsUniform")
+		OctoonImplementSubClass(NullGraphicsUniformBlock, GraphicsUniformBlock, "NullGraphicsUniformBlock")
+
+		namespace
+		{
+			struct GLSLType
+			{
+				const char* name;
+				GraphicsUniformType type;
+				GraphicsFormat format;
+				std::uint32_t size;
+				std::uint32_t align;
+			};
+
+			const GLSLType GLSLTypes[] =
+			{
+				{ "bool", GraphicsUniformType::Boolean, GraphicsFormat::R8UInt, 4, 4 },
+				{ "int", GraphicsUniformType::Int, GraphicsFormat::R8SInt, 4, 4 },
+				{ "ivec2", GraphicsUniformType::Int2, GraphicsFormat::R8G8SInt, 8, 8 },
+				{ "ivec3", GraphicsUniformType::Int3, GraphicsFormat::R8G8B8SInt, 12, 16 },
+				{ "ivec4", GraphicsUniformType::Int4, GraphicsFormat::R8G8B8A8SInt, 16, 16 },
+				{ "uint", GraphicsUniformType::UInt, GraphicsFormat::R8UInt, 4, 4 },
+				{ "uvec2", GraphicsUniformType::UInt2, GraphicsFormat::R8G8UInt, 8, 8 },
+				{ "uvec3", GraphicsUniformType::UInt3, GraphicsFormat::R8G8B8UInt, 12, 16 },
+				{ "uvec4", GraphicsUniformType::UInt4, GraphicsFormat::R8G8B8A8UInt, 16, 16 },
+				{ "float", GraphicsUniformType::Float, GraphicsFormat::R32SFloat, 4, 4 },
+				{ "vec2", GraphicsUniformType::Float2, GraphicsFormat::R32G32SFloat, 8, 8 },
+				{ "vec3", GraphicsUniformType::Float3, GraphicsFormat::R32G32B32SFloat, 12, 16 },
+				{ "vec4", GraphicsUniformType::Float4, GraphicsFormat::R32G32B32A32SFloat, 16, 16 },
+				{ "mat2", GraphicsUniformType::Float2x2, GraphicsFormat::R32G32B32A32SFloat, 32, 16 },
+				{ "mat3", GraphicsUniformType::Float3x3, GraphicsFormat::R32G32B32A32SFloat, 48, 16 },
+				{ "mat4", GraphicsUniformType::Float4x4, GraphicsFormat::R32G32B32A32SFloat, 64, 16 },
+			};
+
+			const GLSLType* findType(std::string_view name) noexcept
+			{
+				for (auto& it : GLSLTypes)
+				{
+					if (name == it.name)
+						return &it;
+				}
+
+				return nullptr;
+			}
+
+			bool isSampler(std::string_view name) noexcept
+			{
+				return name.find("sampler") != std::string_view::npos;
+			}
+
+			bool isQualifier(std::string_view name) noexcept
+			{
+				return
+					name == "highp" || name == "mediump" || name == "lowp" ||
+					name == "flat" || name == "smooth" || name == "noperspective" ||
+					name == "centroid" || name == "const";
+			}
+
+			// Removes comments and the lines disabled by #ifdef, #ifndef and #else, then splits the rest into tokens.
+			// #if expressions are not evaluated and count as taken, so both sides of an #if/#else may be kept.
+			std::vector<std::string> tokenize(const std::string& source) noexcept
+			{
+				std::string code;
+				code.reserve(source.size());
+
+				for (std::size_t i = 0; i < source.size(); i++)
+				{
+					if (source[i] == '/' && i + 1 < source.size() && source[i + 1] == '/')
+					{
+						while (i < source.size() && source[i] != '\n')
+							i++;
+						code.push_back('\n');
+					}
+					else if (source[i] == '/' && i + 1 < source.size() && source[i + 1] == '*')
+					{
+						for (i += 2; i + 1 < source.size() && !(source[i] == '*' && source[i + 1] == '/'); i++)
+						{
+							if (source[i] == '\n')
+								code.push_back('\n');
+						}
+						i++;
+					}
+					else
+					{
+						code.push_back(source[i]);
+					}
+				}
+
+				struct Branch
+				{
+					bool active;
+					bool taken;
+				};
+
+				std::set<std::string> defines;
+				std::vector<Branch> branches;
+				std::vector<std::string> tokens;
+
+				auto isIdentifier = [](char ch) { return std::isalnum((unsigned char)ch) || ch == '_'; };
+				auto isActive = [&]() { return branches.empty() || branches.back().active; };
+
+				std::size_t pos = 0;
+				while (pos < code.size())
+				{
+					auto end = code.find('\n', pos);
+					if (end == std::string::npos)
+						end = code.size();
+
+					std::string_view line(code.data() + pos, end - pos);
+					pos = end + 1;
+
+					auto first = line.find_first_not_of(" \t\r");
+					if (first == std::string_view::npos)
+						continue;
+
+					if (line[first] == '#')
+					{
+						std::vector<std::string_view> words;
+						for (std::size_t i = first + 1; i < line.size();)
+						{
+							if (isIdentifier(line[i]))
+							{
+								auto start = i;
+								while (i < line.size() && isIdentifier(line[i]))
+									i++;
+								words.push_back(line.substr(start, i - start));
+							}
+							else
+							{
+								i++;
+							}
+						}
+
+						if (words.empty())
+							continue;
+
+						bool parent = branches.empty() || branches.back().active;
+						if (words[0] == "define" && words.size() > 1 && isActive())
+							defines.insert(std::string(words[1]));
+						else if (words[0] == "undef" && words.size() > 1 && isActive())
+							defines.erase(std::string(words[1]));
+						else if (words[0] == "ifdef" || words[0] == "ifndef")
+						{
+							bool defined = words.size() > 1 && defines.count(std::string(words[1])) > 0;
+							bool condition = words[0] == "ifdef" ? defined : !defined;
+							branches.push_back(Branch{ parent && condition, condition });
+						}
+						else if (words[0] == "if")
+						{
+							bool condition = !(words.size() == 2 && words[1] == "0");
+							branches.push_back(Branch{ parent && condition, condition });
+						}
+						else if ((words[0] == "elif" || words[0] == "else") && !branches.empty())
+						{
+							auto taken = branches.back().taken;
+							branches.pop_back();
+							parent = branches.empty() || branches.back().active;
+							branches.push_back(Branch{ parent && !taken, true });
+						}
+						else if (words[0] == "endif" && !branches.empty())
+						{
+							branches.pop_back();
+						}
+
+						continue;
+					}
+
+					if (!isActive())
+						continue;
+
+					for (std::size_t i = first; i < line.size();)
+					{
+						if (isIdentifier(line[i]))
+						{
+							auto start = i;
+							while (i < line.size() && isIdentifier(line[i]))
+								i++;
+							tokens.emplace_back(line.substr(start, i - start));
+						}
+						else if (line[i] == ' ' || line[i] == '\t' || line[i] == '\r')
+						{
+							i++;
+						}
+						else
+						{
+							tokens.emplace_back(1, line[i++]);
+						}
+					}
+				}
+
+				return tokens;
+			}
+		}
+
+		NullGraphicsAttribute::NullGraphicsAttribute() noexcept
+			: _semanticIndex(0)
+			, _bindingPoint(0xFFFFFFFF)
+			, _type(GraphicsFormat::Undefined)
+		{
+		}
+
+		NullGraphicsAttribute::~NullGraphicsAttribute() noexcept
+		{
+		}
+
+		void
+		NullGraphicsAttribute::setSemantic(std::string_view semantic) noexcept
+		{
+			_semantic = semantic;
+		}
+
+		const std::string&
+		NullGraphicsAttribute::getSemantic() const noexcept
+		{
+			return _semantic;
+		}
+
+		void
+		NullGraphicsAttribute::setSemanticIndex(std::uint32_t index) noexcept
+		{
+			_semanticIndex = index;
+		}
+
+		std::uint32_t
+		NullGraphicsAttribute::getSemanticIndex() const noexcept
+		{
+			return _semanticIndex;
+		}
+
+		void
+		NullGraphicsAttribute::setType(GraphicsFormat type) noexcept
+		{
+			_type = type;
+		}
+
+		GraphicsFormat
+		NullGraphicsAttribute::getType() const noexcept
+		{
+			return _type;
+		}
+
+		void
+		NullGraphicsAttribute::setBindingPoint(std::uint32_t bindingPoint) noexcept
+		{
+			_bindingPoint = bindingPoint;
+		}
+
+		std::uint32_t
+		NullGraphicsAttribute::getBindingPoint() const noexcept
+		{
+			return _bindingPoint;
+		}
+
+		NullGraphicsUniform::NullGraphicsUniform() noexcept
+			: _offset(0)
+			, _bindingPoint(0xFFFFFFFF)
+			, _type(GraphicsUniformType::Null)
+			, _stageFlags(0)
+		{
+		}
+
+		NullGraphicsUniform::~NullGraphicsUniform() noexcept
+		{
+		}
+
+		void
+		NullGraphicsUniform::setName(std::string_view name) noexcept
+		{
+			_name = name;
+		}
+
+		const std::string&
+		NullGraphicsUniform::getName() const noexcept
+		{
+			return _name;
+		}
+
+		void
+		NullGraphicsUniform::setSamplerName(std::string_view name) noexcept
+		{
+			_samplerName = name;
+		}
+
+		const std::string&
+		NullGraphicsUniform::getSamplerName() const noexcept
+		{
+			return _samplerName;
+		}
+
+		void
+		NullGraphicsUniform::setType(GraphicsUniformType type) noexcept
+		{
+			_type = type;
+		}
+
+		GraphicsUniformType
+		NullGraphicsUniform::getType() const noexcept
+		{
+			return _type;
+		}
+
+		void
+		NullGraphicsUniform::setOffset(std::uint32_t offset) noexcept
+		{
+			_offset = offset;
+		}
+
+		std::uint32_t
+		NullGraphicsUniform::getOffset() const noexcept
+		{
+			return _offset;
+		}
+
+		void
+		NullGraphicsUniform::setBindingPoint(std::uint32_t bindingPoint) noexcept
+		{
+			_bindingPoint = bindingPoint;
+		}
+
+		std::uint32_t
+		NullGraphicsUniform::getBindingPoint() const noexcept
+		{
+			return _bindingPoint;
+		}
+
+		void
+		NullGraphicsUniform::setShaderStageFlags(GraphicsShaderStageFlags flags) noexcept
+		{
+			_stageFlags = flags;
+		}
+
+		GraphicsShaderStageFlags
+		NullGraphicsUniform::getShaderStageFlags() const noexcept
+		{
+			return _stageFlags;
+		}
+
+		NullGraphicsUniformBlock::NullGraphicsUniformBlock() noexcept
+			: _size(0)
+			, _bindingPoint(0xFFFFFFFF)
+			, _type(GraphicsUniformType::UniformBuffer)
+			, _stageFlags(0)
+		{
+		}
+
+		NullGraphicsUniformBlock::~NullGraphicsUniformBlock() noexcept
+		{
+		}
+
+		void
+		NullGraphicsUniformBlock::setName(std::string_view name) noexcept
+		{
+			_name = name;
+		}
+
+		const std::string&
+		NullGraphicsUniformBlock::getName() const noexcept
+		{
+			return _name;
+		}
+
+		void
+		NullGraphicsUniformBlock::setType(GraphicsUniformType type) noexcept
+		{
+			_type = type;
+		}
+
+		GraphicsUniformType
+		NullGraphicsUniformBlock::getType() const noexcept
+		{
+			return _type;
+		}
+
+		void
+		NullGraphicsUniformBlock::setBlockSize(std::uint32_t size) noexcept
+		{
+			_size = size;
+		}
+
+		std::uint32_t
+		NullGraphicsUniformBlock::getBlockSize() const noexcept
+		{
+			return _size;
+		}
+
+		void
+		NullGraphicsUniformBlock::setShaderStageFlags(GraphicsShaderStageFlags flags) noexcept
+		{
+			_stageFlags = flags;
+		}
+
+		GraphicsShaderStageFlags
+		NullGraphicsUniformBlock::getShaderStageFlags() const noexcept
+		{
+			return _stageFlags;
+		}
+
+		void
+		NullGraphicsUniformBlock::addGraphicsUniform(GraphicsUniformPtr uniform) noexcept
+		{
+			_uniforms.push_back(uniform);
+		}
+
+		void
+		NullGraphicsUniformBlock::removeGraphicsUniform(GraphicsUniformPtr uniform) noexcept
+		{
+			auto it = std::find(_uniforms.begin(), _uniforms.end(), uniform);
+			if (it != _uniforms.end())
+				_uniforms.erase(it);
+		}
+
+		const GraphicsUniforms&
+		NullGraphicsUniformBlock::getGraphicsUniforms() const noexcept
+		{
+			return _uniforms;
+		}
+
+		void
+		NullGraphicsUniformBlock::setBindingPoint(std::uint32_t bindingPoint) noexcept
+		{
+			_bindingPoint = bindingPoint;
+		}
+
+		std::uint32_t
+		NullGraphicsUniformBlock::getBindingPoint() const noexcept
+		{
+			return _bindingPoint;
+		}
+
+		NullShader::NullShader() noexcept
+		{
+		}
+
+		NullShader::~NullShader() noexcept
+		{
+			this->close();
+		}
+
+		bool
+		NullShader::setup(const GraphicsShaderDesc& shaderDesc) noexcept
+		{
+			assert(!shaderDesc.getByteCodes().empty());
+
+			if (shaderDesc.getLanguage() != GraphicsShaderLang::GLSL)
+				return false;
+
+			_shaderDesc = shaderDesc;
+			return true;
+		}
+
+		void
+		NullShader::close() noexcept
+		{
+		}
+
+		const GraphicsShaderDesc&
+		NullShader::getShaderDesc() const noexcept
+		{
+			return _shaderDesc;
+		}
+
+		void
+		NullShader::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullShader::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+
+		NullProgram::NullProgram() noexcept
+			: _numTextureUnits(0)
+			, _numUniformBlocks(0)
+		{
+		}
+
+		NullProgram::~NullProgram() noexcept
+		{
+			this->close();
+		}
+
+		bool
+		NullProgram::setup(const GraphicsProgramDesc& programDesc) noexcept
+		{
+			if (programDesc.getShaders().empty())
+				return false;
+
+			for (auto& shader : programDesc.getShaders())
+				this->_initActiveParams(shader->getShaderDesc());
+
+			_programDesc = programDesc;
+			return true;
+		}
+
+		void
+		NullProgram::close() noexcept
+		{
+			_activeParams.clear();
+			_activeAttributes.clear();
+		}
+
+		const GraphicsAttributes&
+		NullProgram::getActiveAttributes() const noexcept
+		{
+			return _activeAttributes;
+		}
+
+		const GraphicsParams&
+		NullProgram::getActiveParams() const noexcept
+		{
+			return _activeParams;
+		}
+
+		void
+		NullProgram::_initActiveParams(const GraphicsShaderDesc& shaderDesc) noexcept
+		{
+			auto tokens = tokenize(shaderDesc.getByteCodes());
+			auto hasParam = [this](std::string_view name)
+			{
+				return std::any_of(_activeParams.begin(), _activeParams.end(), [&](const GraphicsParamPtr& param) { return param->getName() == name; });
+			};
+
+			std::int32_t depth = 0;
+			std::int32_t location = -1;
+
+			for (std::size_t i = 0; i < tokens.size(); i++)
+			{
+				auto& token = tokens[i];
+				if (token == "{" || token == "(")
+					depth++;
+				else if (token == "}" || token == ")")
+					depth--;
+				else if (token == ";")
+					location = -1;
+				else if (token == "location" && depth == 1 && i + 2 < tokens.size() && tokens[i + 1] == "=")
+					location = std::atoi(tokens[i + 2].c_str());
+
+				if (depth != 0)
+					continue;
+
+				bool isUniform = token == "uniform";
+				bool isAttribute = (token == "in" || token == "attribute") && shaderDesc.getStage() == GraphicsShaderStageFlagBits::VertexBit;
+				if (!isUniform && !isAttribute)
+					continue;
+
+				std::size_t n = i + 1;
+				while (n < tokens.size() && isQualifier(tokens[n]))
+					n++;
+
+				if (n + 1 >= tokens.size())
+					break;
+
+				auto& type = tokens[n];
+				if (isUniform && tokens[n + 1] == "{")
+				{
+					auto uniformBlock = std::make_shared<NullGraphicsUniformBlock>();
+					uniformBlock->setName(type);
+					uniformBlock->setType(GraphicsUniformType::UniformBuffer);
+					uniformBlock->setShaderStageFlags(GraphicsShaderStageFlagBits::All);
+
+					std::uint32_t offset = 0;
+					for (n += 2; n + 1 < tokens.size() && tokens[n] != "}"; n++)
+					{
+						while (n < tokens.size() && isQualifier(tokens[n]))
+							n++;
+
+						auto memberType = findType(tokens[n]);
+						auto& memberName = tokens[n + 1];
+
+						std::uint32_t count = 1;
+						if (n + 3 < tokens.size() && tokens[n + 2] == "[")
+							count = std::max(1, std::atoi(tokens[n + 3].c_str()));
+
+						if (memberType)
+						{
+							auto align = count > 1 ? 16 : memberType->align;
+							auto stride = count > 1 ? (memberType->size + 15) & ~15u : memberType->size;
+							offset = (offset + align - 1) & ~(align - 1);
+
+							auto uniform = std::make_shared<NullGraphicsUniform>();
+							uniform->setName(count > 1 ? memberName + "[0]" : memberName);
+							uniform->setBindingPoint((std::uint32_t)uniformBlock->getGraphicsUniforms().size());
+							uniform->setOffset(offset);
+							uniform->setType(memberType->type);
+							uniformBlock->addGraphicsUniform(uniform);
+
+							offset += stride * count;
+						}
+
+						while (n < tokens.size() && tokens[n] != ";" && tokens[n] != "}")
+							n++;
+					}
+
+					uniformBlock->setBlockSize((offset + 15) & ~15u);
+
+					if (!hasParam(type))
+					{
+						uniformBlock->setBindingPoint(_numUniformBlocks++);
+						_activeParams.push_back(uniformBlock);
+					}
+
+					depth++;
+					i = n - 1;
+					continue;
+				}
+
+				for (n++; n < tokens.size() && tokens[n] != ";"; n++)
+				{
+					auto& name = tokens[n];
+					bool isArray = n + 1 < tokens.size() && tokens[n + 1] == "[";
+
+					if (isAttribute)
+					{
+						auto glslType = findType(type);
+
+						std::string semantic;
+						std::uint32_t semanticIndex = 0;
+
+						auto it = std::find_if_not(name.rbegin(), name.rend(), [](char ch) { return ch >= '0' && ch <= '9'; });
+						semantic = name.substr(0, name.rend() - it);
+						if (it != name.rbegin())
+							semanticIndex = std::stoi(name.substr(name.rend() - it));
+
+						std::size_t off = semantic.find_last_of('_');
+						if (off != std::string::npos)
+							semantic = semantic.substr(off + 1);
+
+						auto attrib = std::make_shared<NullGraphicsAttribute>();
+						attrib->setSemantic(semantic);
+						attrib->setSemanticIndex(semanticIndex);
+						attrib->setBindingPoint(location >= 0 ? location : (std::uint32_t)_activeAttributes.size());
+						attrib->setType(glslType ? glslType->format : GraphicsFormat::Undefined);
+
+						_activeAttributes.push_back(attrib);
+					}
+					else
+					{
+						auto uniformName = isArray ? name + "[0]" : name;
+						auto glslType = findType(type);
+
+						if ((glslType || isSampler(type)) && !hasParam(uniformName))
+						{
+							auto uniform = std::make_shared<NullGraphicsUniform>();
+							uniform->setName(uniformName);
+							uniform->setShaderStageFlags(GraphicsShaderStageFlagBits::All);
+
+							if (glslType)
+							{
+								uniform->setType(glslType->type);
+								uniform->setBindingPoint((std::uint32_t)_activeParams.size());
+							}
+							else
+							{
+								uniform->setType(GraphicsUniformType::SamplerImage);
+								uniform->setBindingPoint(_numTextureUnits++);
+							}
+
+							_activeParams.push_back(uniform);
+						}
+					}
+
+					while (n + 1 < tokens.size() && tokens[n + 1] != "," && tokens[n + 1] != ";")
+						n++;
+
+					if (n + 1 < tokens.size() && tokens[n + 1] == ",")
+						n++;
+				}
+
+				i = n;
+				location = -1;
+			}
+		}
+
+		const GraphicsProgramDesc&
+		NullProgram::getProgramDesc() const noexcept
+		{
+			return _programDesc;
+		}
+
+		void
+		NullProgram::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullProgram::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,183 @@
+#ifndef OCTOON_NULL_SHADER_H_
+#define OCTOON_NULL_SHADER_H_
+
+#include "null_types.h"
+
+namespace octoon
+{
+	namespace hal
+	{
+		class NullGraphicsAttribute final : public GraphicsAttribute
+		{
+			OctoonDeclareSubClass(NullGraphicsAttribute, GraphicsAttribute)
+		public:
+			NullGraphicsAttribute() noexcept;
+			~NullGraphicsAttribute() noexcept;
+
+			void setSemantic(std::string_view semantic) noexcept;
+			const std::string& getSemantic() const noexcept;
+
+			void setSemanticIndex(std::uint32_t index) noexcept;
+			std::uint32_t getSemanticIndex() const noexcept;
+
+			void setType(GraphicsFormat type) noexcept;
+			GraphicsFormat getType() const noexcept;
+
+			void setBindingPoint(std::uint32_t bindingPoint) noexcept;
+			std::uint32_t getBindingPoint() const noexcept;
+
+		private:
+			NullGraphicsAttribute(const NullGraphicsAttribute&) noexcept = delete;
+			NullGraphicsAttribute& operator=(const NullGraphicsAttribute&) noexcept = delete;
+
+		private:
+			std::string _semantic;
+			std::uint32_t _semanticIndex;
+			std::uint32_t _bindingPoint;
+			GraphicsFormat _type;
+		};
+
+		class NullGraphicsUniform final : public GraphicsUniform
+		{
+			OctoonDeclareSubClass(NullGraphicsUniform, GraphicsUniform)
+		public:
+			NullGraphicsUniform() noexcept;
+			~NullGraphicsUniform() noexcept;
+
+			void setName(std::string_view name) noexcept;
+			const std::string& getName() const noexcept;
+
+			void setSamplerName(std::string_view name) noexcept;
+			const std::string& getSamplerName() const noexcept;
+
+			void setType(GraphicsUniformType type) noexcept;
+			GraphicsUniformType getType() const noexcept;
+
+			void setOffset(std::uint32_t offset) noexcept;
+			std::uint32_t getOffset() const noexcept;
+
+			void setBindingPoint(std::uint32_t bindingPoint) noexcept;
+			std::uint32_t getBindingPoint() const noexcept;
+
+			void setShaderStageFlags(GraphicsShaderStageFlags flags) noexcept;
+			GraphicsShaderStageFlags getShaderStageFlags() const noexcept;
+
+		private:
+			NullGraphicsUniform(const NullGraphicsUniform&) noexcept = delete;
+			NullGraphicsUniform& operator=(const NullGraphicsUniform&) noexcept = delete;
+
+		private:
+			std::string _name;
+			std::string _samplerName;
+			std::uint32_t _offset;
+			std::uint32_t _bindingPoint;
+			GraphicsUniformType _type;
+			GraphicsShaderStageFlags _stageFlags;
+		};
+
+		class NullGraphicsUniformBlock final : public GraphicsUniformBlock
+		{
+			OctoonDeclareSubClass(NullGraphicsUniformBlock, GraphicsUniformBlock)
+		public:
+			NullGraphicsUniformBlock() noexcept;
+			~NullGraphicsUniformBlock() noexcept;
+
+			void setName(std::string_view name) noexcept;
+			const std::string& getName() const noexcept;
+
+			void setType(GraphicsUniformType type) noexcept;
+			GraphicsUniformType getType() const noexcept;
+
+			void setBlockSize(std::uint32_t size) noexcept;
+			std::uint32_t getBlockSize() const noexcept;
+
+			void setBindingPoint(std::uint32_t bindingPoint) noexcept;
+			std::uint32_t getBindingPoint() const noexcept;
+
+			void setShaderStageFlags(GraphicsShaderStageFlags flags) noexcept;
+			GraphicsShaderStageFlags getShaderStageFlags() const noexcept;
+
+			void addGraphicsUniform(GraphicsUniformPtr uniform) noexcept;
+			void removeGraphicsUniform(GraphicsUniformPtr uniform) noexcept;
+			const GraphicsUniforms& getGraphicsUniforms() const noexcept;
+
+		private:
+			NullGraphicsUniformBlock(const NullGraphicsUniformBlock&) noexcept = delete;
+			NullGraphicsUniformBlock& operator=(const NullGraphicsUniformBlock&) noexcept = delete;
+
+		private:
+			std::string _name;
+			std::uint32_t _size;
+			std::uint32_t _bindingPoint;
+			GraphicsUniforms _uniforms;
+			GraphicsUniformType _type;
+			GraphicsShaderStageFlags _stageFlags;
+		};
+
+		class NullShader final : public GraphicsShader
+		{
+			OctoonDeclareSubClass(NullShader, GraphicsShader)
+		public:
+			NullShader() noexcept;
+			~NullShader() noexcept;
+
+			bool setup(const GraphicsShaderDesc& shader) noexcept;
+			void close() noexcept;
+
+			const GraphicsShaderDesc& getShaderDesc() const noexcept override;
+
+		private:
+			friend class NullDevice;
+			void setDevice(const GraphicsDevicePtr& device) noexcept;
+			GraphicsDevicePtr getDevice() noexcept override;
+
+		private:
+			NullShader(const NullShader&) noexcept = delete;
+			NullShader& operator=(const NullShader&) noexcept = delete;
+
+		private:
+			GraphicsShaderDesc _shaderDesc;
+			GraphicsDeviceWeakPtr _device;
+		};
+
+		// Reflects attributes, uniforms and uniform blocks from the GLSL declarations instead of a linked program.
+		// Names and types follow what the GL 3.3 backend reports, so descriptor sets are laid out the same way.
+		class NullProgram final : public GraphicsProgram
+		{
+			OctoonDeclareSubClass(NullProgram, GraphicsProgram)
+		public:
+			NullProgram() noexcept;
+			~NullProgram() noexcept;
+
+			bool setup(const GraphicsProgramDesc& program) noexcept;
+			void close() noexcept;
+
+			const GraphicsParams& getActiveParams() const noexcept override;
+			const GraphicsAttributes& getActiveAttributes() const noexcept override;
+
+			const GraphicsProgramDesc& getProgramDesc() const noexcept override;
+
+		private:
+			void _initActiveParams(const GraphicsShaderDesc& shaderDesc) noexcept;
+
+		private:
+			friend class NullDevice;
+			void setDevice(const GraphicsDevicePtr& device) noexcept;
+			GraphicsDevicePtr getDevice() noexcept override;
+
+		private:
+			NullProgram(const NullProgram&) noexcept = delete;
+			NullProgram& operator=(const NullProgram&) noexcept = delete;
+
+		private:
+			std::uint32_t _numTextureUnits;
+			std::uint32_t _numUniformBlocks;
+			GraphicsParams _activeParams;
+			GraphicsAttributes  _activeAttributes;
+			GraphicsProgramDesc _programDesc;
+			GraphicsDeviceWeakPtr _device;
+		};
+	}
+}
+
+#endif
\ No newline at end of file
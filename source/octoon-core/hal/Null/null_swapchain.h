@@ -0,0 +1,44 @@
+#ifndef OCTOON_NULL_SWAPCHAIN_H_
+#define OCTOON_NULL_SWAPCHAIN_H_
+
+#include "null_types.h"
+
+namespace octoon
+{
+	namespace hal
+	{
+		class NullSwapchain final : public GraphicsSwapchain
+		{
+			OctoonDeclareSubClass(NullSwapchain, GraphicsSwapchain)
+		public:
+			NullSwapchain() noexcept;
+			~NullSwapchain() noexcept;
+
+			bool setup(const GraphicsSwapchainDesc& desc) noexcept;
+			void close() noexcept;
+
+			void setSwapInterval(GraphicsSwapInterval interval) noexcept override;
+			GraphicsSwapInterval getSwapInterval() const noexcept override;
+
+			void setWindowResolution(std::uint32_t w, std::uint32_t h) noexcept override;
+			void getWindowResolution(std::uint32_t& w, std::uint32_t& h) const noexcept override;
+
+			const GraphicsSwapchainDesc& getGraphicsSwapchainDesc() const noexcept override;
+
+		private:
+			friend class NullDevice;
+			void setDevice(const GraphicsDevicePtr& device) noexcept;
+			GraphicsDevicePtr getDevice() noexcept override;
+
+		private:
+			NullSwapchain(const NullSwapchain&) noexcept = delete;
+			NullSwapchain& operator=(const NullSwapchain&) noexcept = delete;
+
+		private:
+			GraphicsSwapchainDesc _swapchainDesc;
+			GraphicsDeviceWeakPtr _device;
+		};
+	}
+}
+
+#endif
\ No newline at end of file
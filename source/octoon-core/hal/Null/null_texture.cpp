@@ -0,0 +1,103 @@
+#include "null_texture.h"
+
+#include <cstring>
+#include <algorithm>
+
+namespace octoon
+{
+	namespace hal
+	{
+		OctoonImplementSubClass(NullTexture, GraphicsTexture, "NullTexture")
+
+		NullTexture::NullTexture() noexcept
+		{
+		}
+
+		NullTexture::~NullTexture() noexcept
+		{
+			this->close();
+		}
+
+		bool
+		NullTexture::setup(const GraphicsTextureDesc& textureDesc) noexcept
+		{
+			auto pixelSize = NullTypes::getFormatSize(textureDesc.getTexFormat());
+			if (pixelSize == 0)
+				return false;
+
+			// Only the base level is backed by memory, which is all GraphicsTexture::map can address.
+			std::size_t layers = std::max<std::uint32_t>(1, textureDesc.getDepth()) * std::max<std::uint32_t>(1, textureDesc.getLayerNums());
+			if (textureDesc.getTexDim() == GraphicsTextureDim::Cube || textureDesc.getTexDim() == GraphicsTextureDim::CubeArray)
+				layers *= 6;
+
+			_data.resize((std::size_t)textureDesc.getWidth() * textureDesc.getHeight() * layers * pixelSize);
+
+			if (textureDesc.getStream())
+			{
+				std::memcpy(_data.data(), textureDesc.getStream(), std::min(_data.size(), textureDesc.getStreamSize()));
+				_statistics->bytesUploaded += textureDesc.getStreamSize();
+			}
+
+			_textureDesc = textureDesc;
+			return true;
+		}
+
+		void
+		NullTexture::close() noexcept
+		{
+			_data.clear();
+		}
+
+		bool
+		NullTexture::map(std::uint32_t x, std::uint32_t y, std::uint32_t /*w*/, std::uint32_t /*h*/, std::uint32_t mipLevel, void** data) noexcept
+		{
+			assert(data);
+
+			if (mipLevel != 0 || _data.empty())
+				return false;
+
+			auto pixelSize = NullTypes::getFormatSize(_textureDesc.getTexFormat());
+
+			if (_textureDesc.getUsageFlagBits() & GraphicsUsageFlagBits::WriteBit)
+				_statistics->bytesUploaded += (std::uint64_t)_textureDesc.getWidth() * _textureDesc.getHeight() * pixelSize;
+
+			*data = _data.data() + (y * _textureDesc.getWidth() + x) * pixelSize;
+			return true;
+		}
+
+		void
+		NullTexture::unmap() noexcept
+		{
+		}
+
+		std::uint64_t
+		NullTexture::handle() const noexcept
+		{
+			return (std::uint64_t)this;
+		}
+
+		const GraphicsTextureDesc&
+		NullTexture::getTextureDesc() const noexcept
+		{
+			return _textureDesc;
+		}
+
+		void
+		NullTexture::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullTexture::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+
+		void
+		NullTexture::setStatistics(const GraphicsStatisticsPtr& statistics) noexcept
+		{
+			_statistics = statistics;
+		}
+	}
+}
@@ -0,0 +1,62 @@
+#include "null_types.h"
+
+namespace octoon
+{
+	namespace hal
+	{
+		std::uint32_t
+		NullTypes::getFormatSize(GraphicsFormat format) noexcept
+		{
+			auto value = static_cast<std::uint8_t>(format);
+
+			if (value == 0)
+				return 0;
+			else if (value == 1)
+				return 1;
+			else if (value <= static_cast<std::uint8_t>(GraphicsFormat::A1R5G5B5UNormPack16))
+				return 2;
+			else if (value <= static_cast<std::uint8_t>(GraphicsFormat::R8SRGB))
+				return 1;
+			else if (value <= static_cast<std::uint8_t>(GraphicsFormat::R8G8SRGB))
+				return 2;
+			else if (value <= static_cast<std::uint8_t>(GraphicsFormat::B8G8R8SRGB))
+				return 3;
+			else if (value <= static_cast<std::uint8_t>(GraphicsFormat::A2B10G10R10SIntPack32))
+				return 4;
+			else if (value <= static_cast<std::uint8_t>(GraphicsFormat::R16SFloat))
+				return 2;
+			else if (value <= static_cast<std::uint8_t>(GraphicsFormat::R16G16SFloat))
+				return 4;
+			else if (value <= static_cast<std::uint8_t>(GraphicsFormat::R16G16B16SFloat))
+				return 6;
+			else if (value <= static_cast<std::uint8_t>(GraphicsFormat::R16G16B16A16SFloat))
+				return 8;
+			else if (value <= static_cast<std::uint8_t>(GraphicsFormat::R32SFloat))
+				return 4;
+			else if (value <= static_cast<std::uint8_t>(GraphicsFormat::R32G32SFloat))
+				return 8;
+			else if (value <= static_cast<std::uint8_t>(GraphicsFormat::R32G32B32SFloat))
+				return 12;
+			else if (value <= static_cast<std::uint8_t>(GraphicsFormat::R32G32B32A32SFloat))
+				return 16;
+			else if (value <= static_cast<std::uint8_t>(GraphicsFormat::R64SFloat))
+				return 8;
+			else if (value <= static_cast<std::uint8_t>(GraphicsFormat::R64G64SFloat))
+				return 16;
+			else if (value <= static_cast<std::uint8_t>(GraphicsFormat::R64G64B64SFloat))
+				return 24;
+			else if (value <= static_cast<std::uint8_t>(GraphicsFormat::R64G64B64A64SFloat))
+				return 32;
+			else if (format == GraphicsFormat::D16UNorm)
+				return 2;
+			else if (format == GraphicsFormat::S8UInt)
+				return 1;
+			else if (format == GraphicsFormat::D32_SFLOAT_S8UInt)
+				return 8;
+			else if (value <= static_cast<std::uint8_t>(GraphicsFormat::D32_SFLOAT_S8UInt))
+				return 4;
+			else
+				return 1; // block compressed formats, rounded up to a byte per texel
+		}
+	}
+}
@@ -0,0 +1,43 @@
+#ifndef OCTOON_NULL_TYPES_H_
+#define OCTOON_NULL_TYPES_H_
+
+#include <octoon/hal/graphics.h>
+#include <octoon/hal/graphics_sampler.h>
+#include <octoon/hal/graphics_variant.h>
+
+namespace octoon
+{
+	namespace hal
+	{
+		typedef std::shared_ptr<class NullDevice> NullDevicePtr;
+		typedef std::shared_ptr<class NullDeviceProperty> NullDevicePropertyPtr;
+		typedef std::shared_ptr<class NullSwapchain> NullSwapchainPtr;
+		typedef std::shared_ptr<class NullDeviceContext> NullDeviceContextPtr;
+		typedef std::shared_ptr<class NullFramebufferLayout> NullFramebufferLayoutPtr;
+		typedef std::shared_ptr<class NullFramebuffer> NullFramebufferPtr;
+		typedef std::shared_ptr<class NullShader> NullShaderPtr;
+		typedef std::shared_ptr<class NullProgram> NullProgramPtr;
+		typedef std::shared_ptr<class NullGraphicsData> NullGraphicsDataPtr;
+		typedef std::shared_ptr<class NullInputLayout> NullInputLayoutPtr;
+		typedef std::shared_ptr<class NullGraphicsState> NullGraphicsStatePtr;
+		typedef std::shared_ptr<class NullTexture> NullTexturePtr;
+		typedef std::shared_ptr<class NullSampler> NullSamplerPtr;
+		typedef std::shared_ptr<class NullPipeline> NullPipelinePtr;
+		typedef std::shared_ptr<class NullDescriptorPool> NullDescriptorPoolPtr;
+		typedef std::shared_ptr<class NullDescriptorSet> NullDescriptorSetPtr;
+		typedef std::shared_ptr<class NullDescriptorSetLayout> NullDescriptorSetLayoutPtr;
+		typedef std::shared_ptr<class NullGraphicsAttribute> NullGraphicsAttributePtr;
+		typedef std::shared_ptr<class NullGraphicsUniform> NullGraphicsUniformPtr;
+		typedef std::shared_ptr<class NullGraphicsUniformBlock> NullGraphicsUniformBlockPtr;
+
+		typedef std::shared_ptr<GraphicsStatistics> GraphicsStatisticsPtr;
+
+		class NullTypes
+		{
+		public:
+			static std::uint32_t getFormatSize(GraphicsFormat format) noexcept;
+		};
+	}
+}
+
+#endif
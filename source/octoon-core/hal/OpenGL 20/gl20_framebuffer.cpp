@@ -191,7 +191,7 @@ namespace octoon
 			return true;
 		}
 
-		const std::uint64_t
+		std::uint64_t
 		GL20Framebuffer::handle() const noexcept
 		{
 			return this->_fbo;
@@ -32,7 +32,7 @@ namespace octoon
 			assert(pipelineDesc.getInputLayout()->isInstanceOf<GL20InputLayout>());
 			assert(pipelineDesc.getDescriptorSetLayout()->isInstanceOf<GL20DescriptorSetLayout>());
 
-			std::uint16_t offset = 0;
+			std::vector<std::uint16_t> offsets;
 
 			auto& layouts = pipelineDesc.getInputLayout()->getInputLayoutDesc().getVertexLayouts();
 			for (auto& it : layouts)
@@ -50,6 +50,10 @@ namespace octoon
 					}
 				}
 
+				auto slot = it.getVertexSlot();
+				if (slot >= offsets.size())
+					offsets.resize(slot + 1, 0);
+
 				if (attribIndex != GL_INVALID_INDEX)
 				{
 					GLenum type = GL20Types::asVertexFormat(it.getVertexFormat());
@@ -64,17 +68,17 @@ namespace octoon
 					attrib.index = attribIndex;
 					attrib.count = it.getVertexCount();
 					attrib.stride = 0;
-					attrib.offset = offset + it.getVertexOffset();
+					attrib.offset = offsets[slot] + it.getVertexOffset();
 					attrib.normalize = GL20Types::isNormFormat(it.getVertexFormat());
 					attrib.size = pipelineDesc.getInputLayout()->getInputLayoutDesc().getVertexSize((std::uint8_t)it.getVertexSlot());
 
-					if (it.getVertexSlot() <= _attributes.size())
-						_attributes.resize(it.getVertexSlot() + 1);
+					if (slot >= _attributes.size())
+						_attributes.resize(slot + 1);
 
-					_attributes[it.getVertexSlot()].push_back(attrib);
+					_attributes[slot].push_back(attrib);
 				}
 
-				offset += it.getVertexOffset() + it.getVertexSize();
+				offsets[slot] += it.getVertexOffset() + it.getVertexSize();
 			}
 
 			auto& bindings = pipelineDesc.getInputLayout()->getInputLayoutDesc().getVertexBindings();
@@ -86,6 +90,9 @@ namespace octoon
 					return false;
 				}
 
+				if (it.getVertexSlot() >= _attributes.size())
+					continue;
+
 				for (auto& attrib : _attributes[it.getVertexSlot()])
 				{
 					attrib.stride = it.getVertexSize();
@@ -228,7 +228,7 @@ namespace octoon
 			return false;
 		}
 
-		const std::uint64_t
+		std::uint64_t
 		GL20Texture::handle() const noexcept
 		{
 			return _texture;
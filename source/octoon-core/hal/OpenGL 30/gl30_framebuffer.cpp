@@ -212,7 +212,7 @@ namespace octoon
 			return GL30Check::checkError();
 		}
 
-		const std::uint64_t
+		std::uint64_t
 		GL30Framebuffer::handle() const noexcept
 		{
 			return this->_fbo;
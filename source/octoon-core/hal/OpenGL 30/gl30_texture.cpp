@@ -224,7 +224,7 @@ namespace octoon
 			glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
 		}
 
-		const std::uint64_t
+		std::uint64_t
 		GL30Texture::handle() const noexcept
 		{
 			return _texture;
@@ -25,6 +25,13 @@ namespace octoon
 			this->initTextureDimSupports();
 			this->initShaderSupports();
 
+			if (auto vendor = glGetString(GL_VENDOR))
+				_deviceProperties.vendorName = (const char*)vendor;
+			if (auto renderer = glGetString(GL_RENDERER))
+				_deviceProperties.deviceName = (const char*)renderer;
+			if (auto version = glGetString(GL_VERSION))
+				_deviceProperties.driverVersion = (const char*)version;
+
 			glGetIntegerv(GL_MAX_TEXTURE_SIZE, (GLint*)&_deviceProperties.maxImageDimension1D);
 			glGetIntegerv(GL_MAX_TEXTURE_SIZE, (GLint*)&_deviceProperties.maxImageDimension2D);
 			glGetIntegerv(GL_MAX_3D_TEXTURE_SIZE, (GLint*)&_deviceProperties.maxImageDimension3D);
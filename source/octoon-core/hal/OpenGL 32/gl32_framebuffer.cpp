@@ -209,7 +209,7 @@ namespace octoon
 			return GL32Check::checkError();
 		}
 
-		const std::uint64_t
+		std::uint64_t
 		GL32Framebuffer::handle() const noexcept
 		{
 			return this->_fbo;
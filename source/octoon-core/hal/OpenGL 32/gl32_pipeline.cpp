@@ -32,7 +32,7 @@ namespace octoon
 			assert(pipelineDesc.getInputLayout()->isInstanceOf<GL32InputLayout>());
 			assert(pipelineDesc.getDescriptorSetLayout()->isInstanceOf<GL32DescriptorSetLayout>());
 
-			std::uint16_t offset = 0;
+			std::vector<std::uint16_t> offsets;
 
 			auto& layouts = pipelineDesc.getInputLayout()->getInputLayoutDesc().getVertexLayouts();
 			for (auto& it : layouts)
@@ -50,6 +50,10 @@ namespace octoon
 					}
 				}
 
+				auto slot = it.getVertexSlot();
+				if (slot >= offsets.size())
+					offsets.resize(slot + 1, 0);
+
 				if (attribIndex != GL_INVALID_INDEX)
 				{
 					GLenum type = GL32Types::asVertexFormat(it.getVertexFormat());
@@ -64,13 +68,13 @@ namespace octoon
 					attrib.index = attribIndex;
 					attrib.slot = it.getVertexSlot();
 					attrib.count = it.getVertexCount();
-					attrib.offset = offset + it.getVertexOffset();
+					attrib.offset = offsets[slot] + it.getVertexOffset();
 					attrib.normalize = GL32Types::isNormFormat(it.getVertexFormat());
 
 					_attributes.push_back(attrib);
 				}
 
-				offset += it.getVertexOffset() + it.getVertexSize();
+				offsets[slot] += it.getVertexOffset() + it.getVertexSize();
 			}
 
 			auto& bindings = pipelineDesc.getInputLayout()->getInputLayoutDesc().getVertexBindings();
@@ -268,7 +268,7 @@ namespace octoon
 			return false;
 		}
 
-		const std::uint64_t
+		std::uint64_t
 		GL32Texture::handle() const noexcept
 		{
 			return _texture;
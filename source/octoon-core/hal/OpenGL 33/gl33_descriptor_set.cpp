@@ -14,6 +14,7 @@ namespace octoon
 		OctoonImplementSubClass(GL33DescriptorPool, GraphicsDescriptorPool, "GL33DescriptorPool")
 
 		GL33GraphicsUniformSet::GL33GraphicsUniformSet() noexcept
+			: _dirty(true)
 		{
 		}
 
@@ -32,360 +33,420 @@ namespace octoon
 		GL33GraphicsUniformSet::uniform1b(bool value) noexcept
 		{
 			_variant.uniform1b(value);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform1i(std::int32_t i1) noexcept
 		{
 			_variant.uniform1i(i1);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform2i(const int2& value) noexcept
 		{
 			_variant.uniform2i(value);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform2i(std::int32_t i1, std::int32_t i2) noexcept
 		{
 			_variant.uniform2i(i1, i2);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform3i(const int3& value) noexcept
 		{
 			_variant.uniform3i(value);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform3i(std::int32_t i1, std::int32_t i2, std::int32_t i3) noexcept
 		{
 			_variant.uniform3i(i1, i2, i3);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform4i(const int4& value) noexcept
 		{
 			_variant.uniform4i(value);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform4i(std::int32_t i1, std::int32_t i2, std::int32_t i3, std::int32_t i4) noexcept
 		{
 			_variant.uniform4i(i1, i2, i3, i4);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform1ui(std::uint32_t ui1) noexcept
 		{
 			_variant.uniform1ui(ui1);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform2ui(const uint2& value) noexcept
 		{
 			_variant.uniform2ui(value);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform2ui(std::uint32_t ui1, std::uint32_t ui2) noexcept
 		{
 			_variant.uniform2ui(ui1, ui2);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform3ui(const uint3& value) noexcept
 		{
 			_variant.uniform3ui(value);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform3ui(std::uint32_t ui1, std::uint32_t ui2, std::uint32_t ui3) noexcept
 		{
 			_variant.uniform3ui(ui1, ui2, ui3);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform4ui(const uint4& value) noexcept
 		{
 			_variant.uniform4ui(value);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform4ui(std::uint32_t ui1, std::uint32_t ui2, std::uint32_t ui3, std::uint32_t ui4) noexcept
 		{
 			_variant.uniform4ui(ui1, ui2, ui3, ui4);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform1f(float f1) noexcept
 		{
 			_variant.uniform1f(f1);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform2f(const float2& value) noexcept
 		{
 			_variant.uniform2f(value);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform2f(float f1, float f2) noexcept
 		{
 			_variant.uniform2f(f1, f2);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform3f(const float3& value) noexcept
 		{
 			_variant.uniform3f(value);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform3f(float f1, float f2, float f3) noexcept
 		{
 			_variant.uniform3f(f1, f2, f3);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform4f(const float4& value) noexcept
 		{
 			_variant.uniform4f(value);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform4f(float f1, float f2, float f3, float f4) noexcept
 		{
 			_variant.uniform4f(f1, f2, f3, f4);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform2fmat(const float2x2& value) noexcept
 		{
 			_variant.uniform2fmat(value);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform2fmat(const float* mat2) noexcept
 		{
 			_variant.uniform2fmat(mat2);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform3fmat(const float3x3& value) noexcept
 		{
 			_variant.uniform3fmat(value);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform3fmat(const float* mat3) noexcept
 		{
 			_variant.uniform3fmat(mat3);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform4fmat(const float4x4& value) noexcept
 		{
 			_variant.uniform4fmat(value);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform4fmat(const float* mat4) noexcept
 		{
 			_variant.uniform4fmat(mat4);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform1iv(const std::vector<int1>& value) noexcept
 		{
 			_variant.uniform1iv(value);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform1iv(std::size_t num, const std::int32_t* i1v) noexcept
 		{
 			_variant.uniform1iv(num, i1v);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform2iv(const std::vector<int2>& value) noexcept
 		{
 			_variant.uniform2iv(value);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform2iv(std::size_t num, const std::int32_t* i2v) noexcept
 		{
 			_variant.uniform2iv(num, i2v);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform3iv(const std::vector<int3>& value) noexcept
 		{
 			_variant.uniform3iv(value);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform3iv(std::size_t num, const std::int32_t* i3v) noexcept
 		{
 			_variant.uniform3iv(num, i3v);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform4iv(const std::vector<int4>& value) noexcept
 		{
 			_variant.uniform4iv(value);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform4iv(std::size_t num, const std::int32_t* i4v) noexcept
 		{
 			_variant.uniform4iv(num, i4v);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform1uiv(const std::vector<uint1>& value) noexcept
 		{
 			_variant.uniform1uiv(value);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform1uiv(std::size_t num, const std::uint32_t* ui1v) noexcept
 		{
 			_variant.uniform1uiv(num, ui1v);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform2uiv(const std::vector<uint2>& value) noexcept
 		{
 			_variant.uniform2uiv(value);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform2uiv(std::size_t num, const std::uint32_t* ui2v) noexcept
 		{
 			_variant.uniform2uiv(num, ui2v);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform3uiv(const std::vector<uint3>& value) noexcept
 		{
 			_variant.uniform3uiv(value);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform3uiv(std::size_t num, const std::uint32_t* ui3v) noexcept
 		{
 			_variant.uniform3uiv(num, ui3v);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform4uiv(const std::vector<uint4>& value) noexcept
 		{
 			_variant.uniform4uiv(value);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform4uiv(std::size_t num, const std::uint32_t* ui4v) noexcept
 		{
 			_variant.uniform4uiv(num, ui4v);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform1fv(const std::vector<float1>& value) noexcept
 		{
 			_variant.uniform1fv(value);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform1fv(std::size_t num, const float* f1v) noexcept
 		{
 			_variant.uniform1fv(num, f1v);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform2fv(const std::vector<float2>& value) noexcept
 		{
 			_variant.uniform2fv(value);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform2fv(std::size_t num, const float* f2v) noexcept
 		{
 			_variant.uniform2fv(num, f2v);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform3fv(const std::vector<float3>& value) noexcept
 		{
 			_variant.uniform3fv(value);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform3fv(std::size_t num, const float* f3v) noexcept
 		{
 			_variant.uniform3fv(num, f3v);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform4fv(const std::vector<float4>& value) noexcept
 		{
 			_variant.uniform4fv(value);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform4fv(std::size_t num, const float* f4v) noexcept
 		{
 			_variant.uniform4fv(num, f4v);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform2fmatv(const std::vector<float2x2>& value) noexcept
 		{
 			_variant.uniform2fmatv(value);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform2fmatv(std::size_t num, const float* mat2) noexcept
 		{
 			_variant.uniform2fmatv(num, mat2);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform3fmatv(const std::vector<float3x3>& value) noexcept
 		{
 			_variant.uniform3fmatv(value);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform3fmatv(std::size_t num, const float* mat3) noexcept
 		{
 			_variant.uniform3fmatv(num, mat3);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform4fmatv(const std::vector<float4x4>& value) noexcept
 		{
 			_variant.uniform4fmatv(value);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniform4fmatv(std::size_t num, const float* mat4) noexcept
 		{
 			_variant.uniform4fmatv(num, mat4);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniformTexture(GraphicsTexturePtr texture, GraphicsSamplerPtr sampler) noexcept
 		{
 			_variant.uniformTexture(texture, sampler);
+			_dirty = true;
 		}
 
 		void
 		GL33GraphicsUniformSet::uniformBuffer(GraphicsDataPtr ubo) noexcept
 		{
 			_variant.uniformBuffer(ubo);
+			_dirty = true;
 		}
 
 		bool
@@ -600,6 +661,18 @@ namespace octoon
 			_variant.setType(param->getType());
 		}
 
+		void
+		GL33GraphicsUniformSet::setDirty(bool dirty) noexcept
+		{
+			_dirty = dirty;
+		}
+
+		bool
+		GL33GraphicsUniformSet::isDirty() const noexcept
+		{
+			return _dirty;
+		}
+
 		const GraphicsParamPtr&
 		GL33GraphicsUniformSet::getGraphicsParam() const noexcept
 		{
@@ -718,13 +791,25 @@ namespace octoon
 		}
 
 		void
-		GL33DescriptorSet::apply(const GL33Program& shaderObject) noexcept
+		GL33DescriptorSet::apply(GL33Program& shaderObject) noexcept
 		{
+			// Plain uniform values live in the program object, so they only have to be written
+			// again when they changed or when another descriptor set was applied to the program.
+			// Textures, samplers and buffers are bound to context units and are always rebound.
+			bool force = shaderObject.getActiveDescriptorSet() != this;
+
 			auto program = shaderObject.getInstanceID();
 			for (auto& it : _activeUniformSets)
 			{
 				auto type = it->getGraphicsParam()->getType();
 				auto location = it->getGraphicsParam()->getBindingPoint();
+
+				auto uniformSet = it->downcast<GL33GraphicsUniformSet>();
+				if (!force && !uniformSet->isDirty() && type < GraphicsUniformType::Sampler)
+					continue;
+
+				uniformSet->setDirty(false);
+
 				switch (type)
 				{
 				case GraphicsUniformType::Boolean:
@@ -893,6 +978,8 @@ namespace octoon
 					break;
 				}
 			}
+
+			shaderObject.setActiveDescriptorSet(this);
 		}
 
 		void
@@ -115,11 +115,15 @@ namespace octoon
 			void setGraphicsParam(GraphicsParamPtr param) noexcept;
 			const GraphicsParamPtr& getGraphicsParam() const noexcept;
 
+			void setDirty(bool dirty) noexcept;
+			bool isDirty() const noexcept;
+
 		private:
 			GL33GraphicsUniformSet(const GL33GraphicsUniformSet&) = delete;
 			GL33GraphicsUniformSet& operator=(const GL33GraphicsUniformSet&) = delete;
 
 		private:
+			bool _dirty;
 			GraphicsVariant _variant;
 			GraphicsParamPtr _param;
 		};
@@ -186,7 +190,7 @@ namespace octoon
 			bool setup(const GraphicsDescriptorSetDesc& desc) noexcept;
 			void close() noexcept;
 
-			void apply(const GL33Program& program) noexcept;
+			void apply(GL33Program& program) noexcept;
 
 			void copy(std::uint32_t descriptorCopyCount, const GraphicsDescriptorSetPtr descriptorCopies[]) noexcept;
 
@@ -27,6 +27,12 @@ namespace octoon
 			, _descriptorSet(nullptr)
 			, _indexType(GL_UNSIGNED_INT)
 			, _indexOffset(0)
+			, _readbackTicket(0)
+			, _readbackFramebuffer(GL_NONE)
+			, _readbackTexture(GL_NONE)
+			, _readbackWidth(0)
+			, _readbackHeight(0)
+			, _readbackFormat(GraphicsFormat::Undefined)
 			, _state(nullptr)
 			, _glcontext(nullptr)
 			, _needUpdatePipeline(false)
@@ -78,6 +84,34 @@ namespace octoon
 			_indexBuffer.reset();
 			_vertexBuffers.clear();
 
+			for (auto& it : _readbacks)
+			{
+				if (it.mapped)
+				{
+					glBindBuffer(GL_PIXEL_PACK_BUFFER, it.pbo);
+					glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+				}
+
+				if (it.fence)
+					glDeleteSync(it.fence);
+
+				glDeleteBuffers(1, &it.pbo);
+			}
+
+			_readbacks.clear();
+
+			if (_readbackFramebuffer)
+			{
+				glDeleteFramebuffers(1, &_readbackFramebuffer);
+				_readbackFramebuffer = GL_NONE;
+			}
+
+			if (_readbackTexture)
+			{
+				glDeleteTextures(1, &_readbackTexture);
+				_readbackTexture = GL_NONE;
+			}
+
 			if (_inputLayout)
 			{
 				glDeleteVertexArrays(1, &_inputLayout);
@@ -662,6 +696,244 @@ namespace octoon
 			glCopyTexImage2D(texture->downcast<GL33Texture>()->getTarget(), miplevel, internalFormat, x, y, width, height, 0);
 		}
 
+		std::uint64_t
+		GL33DeviceContext::readFramebufferAsync(const GraphicsFramebufferPtr& src, std::uint32_t i, std::uint32_t x, std::uint32_t y, std::uint32_t width, std::uint32_t height) noexcept
+		{
+			assert(src);
+			assert(src->isInstanceOf<GL33Framebuffer>());
+			assert(_glcontext->getActive());
+
+			auto& framebufferDesc = src->getFramebufferDesc();
+			if (i >= framebufferDesc.getColorAttachments().size())
+			{
+				this->getDevice()->downcast<OGLDevice>()->message("Invalid color attachment");
+				return 0;
+			}
+
+			auto texFormat = framebufferDesc.getColorAttachment(i).getBindingTexture()->getTextureDesc().getTexFormat();
+
+			GLenum format = GL33Types::asTextureFormat(texFormat);
+			GLenum type = GL33Types::asTextureType(texFormat);
+			if (format == GL_INVALID_ENUM || type == GL_INVALID_ENUM)
+			{
+				this->getDevice()->downcast<OGLDevice>()->message("Invalid texture format");
+				return 0;
+			}
+
+			GLsizei num = GL33Types::getFormatNum(format, type);
+			if (num == 0)
+				return 0;
+
+			GLsizeiptr size = (GLsizeiptr)width * height * num;
+
+			// glReadPixels can't read a multisampled attachment, so it is resolved into a single sampled copy first
+			auto multisample = framebufferDesc.getColorAttachment(i).getBindingTexture()->getTextureDesc().getTexDim() == GraphicsTextureDim::Texture2DMultisample;
+			if (multisample && !this->resolveReadback(src->downcast<GL33Framebuffer>()->getInstanceID(), i, texFormat, x, y, width, height))
+				return 0;
+
+			// Up to three buffers per size, so a readback can be in flight while the previous ones are read.
+			// Once the ring is full the oldest ticket is recycled and becomes invalid.
+			GL33Readback* readback = nullptr;
+			std::size_t count = 0;
+
+			for (auto& it : _readbacks)
+			{
+				if (it.size != size)
+					continue;
+
+				if (!readback || it.ticket < readback->ticket)
+					readback = &it;
+
+				count++;
+			}
+
+			if (count < 3)
+			{
+				GL33Readback pbo;
+				pbo.mapped = false;
+				pbo.size = size;
+				pbo.fence = nullptr;
+				pbo.ticket = 0;
+
+				glGenBuffers(1, &pbo.pbo);
+				glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo.pbo);
+				glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+
+				_readbacks.push_back(pbo);
+				readback = &_readbacks.back();
+			}
+			else
+			{
+				glBindBuffer(GL_PIXEL_PACK_BUFFER, readback->pbo);
+
+				if (readback->mapped)
+				{
+					glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+					readback->mapped = false;
+				}
+
+				if (readback->fence)
+				{
+					glDeleteSync(readback->fence);
+					readback->fence = nullptr;
+				}
+			}
+
+			if (multisample)
+			{
+				glBindFramebuffer(GL_READ_FRAMEBUFFER, _readbackFramebuffer);
+				glReadBuffer(GL_COLOR_ATTACHMENT0);
+
+				x = y = 0;
+			}
+			else
+			{
+				glBindFramebuffer(GL_READ_FRAMEBUFFER, src->downcast<GL33Framebuffer>()->getInstanceID());
+				glReadBuffer(GL_COLOR_ATTACHMENT0 + i);
+			}
+
+			glPixelStorei(GL_PACK_ALIGNMENT, 1);
+			glReadPixels(x, y, width, height, format, type, 0);
+			glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, GL_NONE);
+			glBindFramebuffer(GL_READ_FRAMEBUFFER, _framebuffer ? _framebuffer->getInstanceID() : GL_NONE);
+
+			readback->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			readback->ticket = ++_readbackTicket;
+
+			return readback->ticket;
+		}
+
+		bool
+		GL33DeviceContext::isReadbackReady(std::uint64_t ticket) noexcept
+		{
+			auto readback = this->findReadback(ticket);
+			if (!readback)
+				return false;
+
+			if (readback->fence)
+			{
+				GLenum result = glClientWaitSync(readback->fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+				if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED)
+					return false;
+
+				glDeleteSync(readback->fence);
+				readback->fence = nullptr;
+			}
+
+			return true;
+		}
+
+		bool
+		GL33DeviceContext::mapReadback(std::uint64_t ticket, void** data, bool wait) noexcept
+		{
+			assert(data);
+
+			auto readback = this->findReadback(ticket);
+			if (!readback)
+				return false;
+
+			if (readback->fence)
+			{
+				if (!wait)
+				{
+					if (!this->isReadbackReady(ticket))
+						return false;
+				}
+				else
+				{
+					GLenum result;
+					do
+					{
+						result = glClientWaitSync(readback->fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+					} while (result == GL_TIMEOUT_EXPIRED);
+
+					if (result == GL_WAIT_FAILED)
+						return false;
+
+					glDeleteSync(readback->fence);
+					readback->fence = nullptr;
+				}
+			}
+
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, readback->pbo);
+			*data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, readback->size, GL_MAP_READ_BIT);
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, GL_NONE);
+
+			readback->mapped = *data ? true : false;
+			return readback->mapped;
+		}
+
+		void
+		GL33DeviceContext::unmapReadback(std::uint64_t ticket) noexcept
+		{
+			auto readback = this->findReadback(ticket);
+			if (readback && readback->mapped)
+			{
+				glBindBuffer(GL_PIXEL_PACK_BUFFER, readback->pbo);
+				glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+				glBindBuffer(GL_PIXEL_PACK_BUFFER, GL_NONE);
+
+				readback->mapped = false;
+			}
+		}
+
+		bool
+		GL33DeviceContext::resolveReadback(GLuint framebuffer, std::uint32_t i, GraphicsFormat texFormat, std::uint32_t x, std::uint32_t y, std::uint32_t width, std::uint32_t height) noexcept
+		{
+			if (_readbackWidth < (GLsizei)width || _readbackHeight < (GLsizei)height || _readbackFormat != texFormat)
+			{
+				GLenum internalFormat = GL33Types::asTextureInternalFormat(texFormat);
+				if (internalFormat == GL_INVALID_ENUM)
+				{
+					this->getDevice()->downcast<OGLDevice>()->message("Invalid texture internal format.");
+					return false;
+				}
+
+				if (!_readbackFramebuffer)
+					glGenFramebuffers(1, &_readbackFramebuffer);
+				if (!_readbackTexture)
+					glGenTextures(1, &_readbackTexture);
+
+				glBindTexture(GL_TEXTURE_2D, _readbackTexture);
+				glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, GL33Types::asTextureFormat(texFormat), GL33Types::asTextureType(texFormat), nullptr);
+				glBindTexture(GL_TEXTURE_2D, GL_NONE);
+
+				glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _readbackFramebuffer);
+				glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, _readbackTexture, 0);
+
+				_readbackWidth = width;
+				_readbackHeight = height;
+				_readbackFormat = texFormat;
+			}
+
+			glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+			glReadBuffer(GL_COLOR_ATTACHMENT0 + i);
+			glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _readbackFramebuffer);
+			glDrawBuffer(GL_COLOR_ATTACHMENT0);
+
+			glBlitFramebuffer(x, y, x + width, y + height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+
+			glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _framebuffer ? _framebuffer->getInstanceID() : GL_NONE);
+			return true;
+		}
+
+		GL33Readback*
+		GL33DeviceContext::findReadback(std::uint64_t ticket) noexcept
+		{
+			if (ticket == 0)
+				return nullptr;
+
+			for (auto& it : _readbacks)
+			{
+				if (it.ticket == ticket)
+					return &it;
+			}
+
+			return nullptr;
+		}
+
 		void
 		GL33DeviceContext::readFramebufferToCube(std::uint32_t i, std::uint32_t face, const GraphicsTexturePtr& texture, std::uint32_t miplevel, std::uint32_t x, std::uint32_t y, std::uint32_t width, std::uint32_t height) noexcept
 		{
@@ -57,6 +57,11 @@ namespace octoon
 			void readFramebufferToCube(std::uint32_t i, std::uint32_t face, const GraphicsTexturePtr& texture, std::uint32_t miplevel, std::uint32_t x, std::uint32_t y, std::uint32_t width, std::uint32_t height) noexcept;
 			GraphicsFramebufferPtr getFramebuffer() const noexcept;
 
+			std::uint64_t readFramebufferAsync(const GraphicsFramebufferPtr& src, std::uint32_t i, std::uint32_t x, std::uint32_t y, std::uint32_t width, std::uint32_t height) noexcept override;
+			bool isReadbackReady(std::uint64_t ticket) noexcept override;
+			bool mapReadback(std::uint64_t ticket, void** data, bool wait) noexcept override;
+			void unmapReadback(std::uint64_t ticket) noexcept override;
+
 			void draw(std::uint32_t numVertices, std::uint32_t numInstances, std::uint32_t startVertice, std::uint32_t startInstances) noexcept override;
 			void drawIndexed(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t startIndice, std::uint32_t startVertice, std::uint32_t startInstances) noexcept;
 			void drawIndirect(const GraphicsDataPtr& data, std::size_t offset, std::uint32_t drawCount, std::uint32_t stride) noexcept;
@@ -71,6 +76,9 @@ namespace octoon
 			bool checkSupport() noexcept;
 			bool initStateSystem() noexcept;
 
+			GL33Readback* findReadback(std::uint64_t ticket) noexcept;
+			bool resolveReadback(GLuint framebuffer, std::uint32_t i, GraphicsFormat format, std::uint32_t x, std::uint32_t y, std::uint32_t width, std::uint32_t height) noexcept;
+
 			static void GLAPIENTRY debugCallBack(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message, const GLvoid* userParam) noexcept;
 
 		private:
@@ -92,6 +100,15 @@ namespace octoon
 			std::vector<uint4> _scissors;
 			std::vector<GLenum> _attachments;
 
+			std::uint64_t _readbackTicket;
+			GL33Readbacks _readbacks;
+
+			GLuint _readbackFramebuffer;
+			GLuint _readbackTexture;
+			GLsizei _readbackWidth;
+			GLsizei _readbackHeight;
+			GraphicsFormat _readbackFormat;
+
 			GLenum  _indexType;
 			GLintptr _indexOffset;
 
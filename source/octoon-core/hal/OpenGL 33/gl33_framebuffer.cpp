@@ -203,7 +203,7 @@ namespace octoon
 			return GL33Check::checkError();
 		}
 
-		const std::uint64_t
+		std::uint64_t
 		GL33Framebuffer::handle() const noexcept
 		{
 			return this->_fbo;
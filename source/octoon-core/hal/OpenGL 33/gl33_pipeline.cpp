@@ -34,7 +34,7 @@ namespace octoon
 			assert(pipelineDesc.getInputLayout()->isInstanceOf<GL33InputLayout>());
 			assert(pipelineDesc.getDescriptorSetLayout()->isInstanceOf<GL33DescriptorSetLayout>());
 
-			std::uint16_t offset = 0;
+			std::vector<std::uint16_t> offsets;
 
 			auto& layouts = pipelineDesc.getInputLayout()->getInputLayoutDesc().getVertexLayouts();
 			for (auto& it : layouts)
@@ -52,6 +52,10 @@ namespace octoon
 					}
 				}
 
+				auto slot = it.getVertexSlot();
+				if (slot >= offsets.size())
+					offsets.resize(slot + 1, 0);
+
 				if (attribIndex != GL_INVALID_INDEX)
 				{
 					GLenum type = GL33Types::asVertexFormat(it.getVertexFormat());
@@ -66,21 +70,24 @@ namespace octoon
 					attrib.index = attribIndex;
 					attrib.count = it.getVertexCount();
 					attrib.stride = 0;
-					attrib.offset = offset + it.getVertexOffset();
+					attrib.offset = offsets[slot] + it.getVertexOffset();
 					attrib.normalize = GL33Types::isNormFormat(it.getVertexFormat());
 
-					if (it.getVertexSlot() <= _attributes.size())
-						_attributes.resize(it.getVertexSlot() + 1);
+					if (slot >= _attributes.size())
+						_attributes.resize(slot + 1);
 
-					_attributes[it.getVertexSlot()].push_back(attrib);
+					_attributes[slot].push_back(attrib);
 				}
 
-				offset += it.getVertexOffset() + it.getVertexSize();
+				offsets[slot] += it.getVertexOffset() + it.getVertexSize();
 			}
 
 			auto& bindings = pipelineDesc.getInputLayout()->getInputLayoutDesc().getVertexBindings();
 			for (auto& it : bindings)
 			{
+				if (it.getVertexSlot() >= _attributes.size())
+					continue;
+
 				for (auto& attrib : _attributes[it.getVertexSlot()])
 				{
 					attrib.stride = it.getVertexSize();
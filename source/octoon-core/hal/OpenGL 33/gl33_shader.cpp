@@ -484,6 +484,7 @@ namespace octoon
 
 		GL33Program::GL33Program() noexcept
 			: _program(GL_NONE)
+			, _activeDescriptorSet(nullptr)
 		{
 		}
 
@@ -497,7 +498,8 @@ namespace octoon
 		{
 			assert(_program == GL_NONE);
 
-			if (programDesc.getShaders().empty())
+			auto& binary = programDesc.getProgramBinary();
+			if (programDesc.getShaders().empty() && binary.empty())
 				return false;
 
 			_program = glCreateProgram();
@@ -507,14 +509,33 @@ namespace octoon
 				return false;
 			}
 
-			for (auto& shader : programDesc.getShaders())
+			if (!binary.empty())
 			{
-				auto glshader = shader->downcast<GL33Shader>();
-				if (glshader)
-					glAttachShader(_program, glshader->getInstanceID());
+				if (!glProgramBinary)
+					return false;
+
+				glProgramBinary(_program, programDesc.getProgramBinaryFormat(), binary.data(), (GLsizei)binary.size());
+
+				// a binary from another driver version is rejected, the caller then links from source
+				GLint status = GL_FALSE;
+				glGetProgramiv(_program, GL_LINK_STATUS, &status);
+				if (!status)
+					return false;
 			}
+			else
+			{
+				for (auto& shader : programDesc.getShaders())
+				{
+					auto glshader = shader->downcast<GL33Shader>();
+					if (glshader)
+						glAttachShader(_program, glshader->getInstanceID());
+				}
+
+				if (glProgramParameteri)
+					glProgramParameteri(_program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 
-			glLinkProgram(_program);
+				glLinkProgram(_program);
+			}
 
 			GLint status = GL_FALSE;
 			glGetProgramiv(_program, GL_LINK_STATUS, &status);
@@ -557,6 +578,38 @@ namespace octoon
 			glUseProgram(_program);
 		}
 
+		bool
+		GL33Program::getProgramBinary(std::uint32_t& format, std::vector<std::uint8_t>& binary) const noexcept
+		{
+			if (_program == GL_NONE || !glGetProgramBinary)
+				return false;
+
+			GLint length = 0;
+			glGetProgramiv(_program, GL_PROGRAM_BINARY_LENGTH, &length);
+			if (length <= 0)
+				return false;
+
+			GLenum binaryFormat = GL_NONE;
+			binary.resize((std::size_t)length);
+			glGetProgramBinary(_program, length, &length, &binaryFormat, binary.data());
+			binary.resize((std::size_t)length);
+
+			format = binaryFormat;
+			return !binary.empty();
+		}
+
+		void
+		GL33Program::setActiveDescriptorSet(const GL33DescriptorSet* descriptorSet) noexcept
+		{
+			_activeDescriptorSet = descriptorSet;
+		}
+
+		const GL33DescriptorSet*
+		GL33Program::getActiveDescriptorSet() const noexcept
+		{
+			return _activeDescriptorSet;
+		}
+
 		GLuint
 		GL33Program::getInstanceID() const noexcept
 		{
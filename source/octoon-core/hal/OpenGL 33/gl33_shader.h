@@ -160,6 +160,9 @@ namespace octoon
 
 			void apply() noexcept;
 
+			void setActiveDescriptorSet(const GL33DescriptorSet* descriptorSet) noexcept;
+			const GL33DescriptorSet* getActiveDescriptorSet() const noexcept;
+
 			GLuint getInstanceID() const noexcept;
 
 			const GraphicsParams& getActiveParams() const noexcept;
@@ -167,6 +170,8 @@ namespace octoon
 
 			const GraphicsProgramDesc& getProgramDesc() const noexcept override;
 
+			bool getProgramBinary(std::uint32_t& format, std::vector<std::uint8_t>& binary) const noexcept override;
+
 		private:
 			void _initActiveAttribute() noexcept;
 			void _initActiveUniform() noexcept;
@@ -187,6 +192,7 @@ namespace octoon
 
 		private:
 			GLuint _program;
+			const GL33DescriptorSet* _activeDescriptorSet;
 			GraphicsParams _activeParams;
 			GraphicsAttributes  _activeAttributes;
 			GraphicsProgramDesc _programDesc;
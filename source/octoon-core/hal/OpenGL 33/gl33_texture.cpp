@@ -242,9 +242,6 @@ namespace octoon
 				return false;
 			}
 
-			if (type == GL_HALF_FLOAT)
-				type = GL_FLOAT;
-
 			GLsizei num = GL33Types::getFormatNum(format, type);
 			if (num == 0)
 				return false;
@@ -416,7 +413,7 @@ namespace octoon
 			return true;
 		}
 
-		const std::uint64_t
+		std::uint64_t
 		GL33Texture::handle() const noexcept
 		{
 			return _texture;
@@ -92,7 +92,17 @@ namespace octoon
 			GL45GraphicsDataPtr vbo;
 		};
 
+		struct GL33Readback
+		{
+			bool mapped;
+			GLuint pbo;
+			GLsizeiptr size;
+			GLsync fence;
+			std::uint64_t ticket;
+		};
+
 		typedef std::vector<GL33VertexBuffer> GL33VertexBuffers;
+		typedef std::vector<GL33Readback> GL33Readbacks;
 		typedef std::vector<GL45VertexBuffer> GL45VertexBuffers;
 
 		class GL33Types
@@ -161,7 +161,7 @@ namespace octoon
 			return GL33Check::checkError();
 		}
 
-		const std::uint64_t
+		std::uint64_t
 		GL45Framebuffer::handle() const noexcept
 		{
 			return this->_fbo;
@@ -19,7 +19,7 @@ namespace octoon
 
 			GLuint getInstanceID() noexcept;
 
-			const std::uint64_t handle() const noexcept override;
+			std::uint64_t handle() const noexcept override;
 			const GraphicsFramebufferDesc& getFramebufferDesc() const noexcept override;
 
 		private:
@@ -340,7 +340,7 @@ namespace octoon
 			return true;
 		}
 
-		const std::uint64_t
+		std::uint64_t
 		GL45Texture::handle() const noexcept
 		{
 			return _texture;
@@ -30,5 +30,40 @@ namespace octoon
 		{
 			return _swapchain;
 		}
+
+		std::uint64_t
+		GraphicsContext::readFramebufferAsync(const GraphicsFramebufferPtr& /*src*/, std::uint32_t /*i*/, std::uint32_t /*x*/, std::uint32_t /*y*/, std::uint32_t /*width*/, std::uint32_t /*height*/) noexcept
+		{
+			return 0;
+		}
+
+		bool
+		GraphicsContext::isReadbackReady(std::uint64_t /*ticket*/) noexcept
+		{
+			return false;
+		}
+
+		bool
+		GraphicsContext::mapReadback(std::uint64_t /*ticket*/, void** /*data*/, bool /*wait*/) noexcept
+		{
+			return false;
+		}
+
+		void
+		GraphicsContext::unmapReadback(std::uint64_t /*ticket*/) noexcept
+		{
+		}
+
+		const GraphicsStatistics&
+		GraphicsContext::getStatistics() const noexcept
+		{
+			static const GraphicsStatistics statistics;
+			return statistics;
+		}
+
+		void
+		GraphicsContext::resetStatistics() noexcept
+		{
+		}
 	}
 }
\ No newline at end of file
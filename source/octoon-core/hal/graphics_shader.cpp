@@ -109,6 +109,11 @@ namespace octoon
 			return _main;
 		}
 
+		GraphicsProgramDesc::GraphicsProgramDesc() noexcept
+			: _binaryFormat(0)
+		{
+		}
+
 		bool
 		GraphicsProgramDesc::addShader(GraphicsShaderPtr shader) noexcept
 		{
@@ -140,5 +145,30 @@ namespace octoon
 		{
 			return _shaders;
 		}
+
+		void
+		GraphicsProgramDesc::setProgramBinary(std::uint32_t format, std::vector<std::uint8_t>&& binary) noexcept
+		{
+			_binaryFormat = format;
+			_binary = std::move(binary);
+		}
+
+		std::uint32_t
+		GraphicsProgramDesc::getProgramBinaryFormat() const noexcept
+		{
+			return _binaryFormat;
+		}
+
+		const std::vector<std::uint8_t>&
+		GraphicsProgramDesc::getProgramBinary() const noexcept
+		{
+			return _binary;
+		}
+
+		bool
+		GraphicsProgram::getProgramBinary(std::uint32_t& /*format*/, std::vector<std::uint8_t>& /*binary*/) const noexcept
+		{
+			return false;
+		}
 	}
 }
\ No newline at end of file
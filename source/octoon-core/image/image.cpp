@@ -211,21 +211,21 @@ namespace octoon
 				if (!this->create(format, image.width(), image.height(), image.depth(), image.mipLevel(), image.layerLevel(), image.mipBase(), image.layerBase()))
 					return false;
 
-				if (format_ == Format::R32G32B32SFloat && format == Format::R8G8B8UInt)
+				if (image.format() == Format::R32G32B32SFloat && format == Format::R8G8B8UInt)
 					rgb32f_to_rgb8uint(image, *this);
-				else if (format_ == Format::R32G32B32A32SFloat && format == Format::R8G8B8A8UInt)
+				else if (image.format() == Format::R32G32B32A32SFloat && format == Format::R8G8B8A8UInt)
 					rgba32f_to_rgba8uint(image, *this);
-				else if (format_ == Format::R64G64B64A64SFloat && format == Format::R8G8B8UInt)
+				else if (image.format() == Format::R64G64B64A64SFloat && format == Format::R8G8B8UInt)
 					rgb64f_to_rgb8uint(image, *this);
-				else if (format_ == Format::R64G64B64A64SFloat && format == Format::R8G8B8A8UInt)
+				else if (image.format() == Format::R64G64B64A64SFloat && format == Format::R8G8B8A8UInt)
 					rgba64f_to_rgba8uint(image, *this);
-				else if (format_ == Format::R32G32B32SFloat && format == Format::R8G8B8SInt)
+				else if (image.format() == Format::R32G32B32SFloat && format == Format::R8G8B8SInt)
 					rgb32f_to_rgb8sint(image, *this);
-				else if (format_ == Format::R32G32B32A32SFloat && format == Format::R8G8B8A8SInt)
+				else if (image.format() == Format::R32G32B32A32SFloat && format == Format::R8G8B8A8SInt)
 					rgba32f_to_rgba8sint(image, *this);
-				else if (format_ == Format::R64G64B64A64SFloat && format == Format::R8G8B8SInt)
+				else if (image.format() == Format::R64G64B64A64SFloat && format == Format::R8G8B8SInt)
 					rgb64f_to_rgb8sint(image, *this);
-				else if (format_ == Format::R64G64B64A64SFloat && format == Format::R8G8B8A8SInt)
+				else if (image.format() == Format::R64G64B64A64SFloat && format == Format::R8G8B8A8SInt)
 					rgba64f_to_rgba8sint(image, *this);
 				else
 					throw runtime::not_implemented::create("not supported yet.");
@@ -47,7 +47,7 @@ namespace octoon
 		void
 		membuf::open(std::vector<std::uint8_t>&& buffer) noexcept
 		{
-			buffer_ = std::move(buffer_);
+			buffer_ = std::move(buffer);
 		}
 
 		void
@@ -103,10 +103,10 @@ namespace octoon
 				base = 0;
 				break;
 			case ios_base::end:
-				base = pos_;
+				base = buffer_.size();
 				break;
 			case ios_base::cur:
-				base = buffer_.size();
+				base = pos_;
 				break;
 			}
 
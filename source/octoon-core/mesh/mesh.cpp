@@ -1,24 +1,120 @@
 #include <octoon/mesh/mesh.h>
+#include <octoon/mesh/mesh_bvh.h>
 #include <octoon/lightmap/lightmap_pack.h>
 
-#include <map>
+#include <cmath>
+#include <limits>
 #include <cstring>
+#include <algorithm>
 
 using namespace octoon::math;
 
 namespace octoon::mesh
 {
+	constexpr std::int32_t ParallelThreshold = 8192;
+
+	// Cell of size epsilon along one axis, or the bits of the value without an epsilon. Both zeros share
+	// a cell, and NaN gets one of its own so the conversion stays defined.
+	static std::int32_t
+	quantize(float value, double invEpsilon) noexcept
+	{
+		if (invEpsilon <= 0.0)
+		{
+			std::int32_t bits;
+			value = value == 0.0f ? 0.0f : value;
+			std::memcpy(&bits, &value, sizeof(bits));
+			return bits;
+		}
+
+		auto cell = std::floor(value * invEpsilon);
+		if (std::isnan(cell))
+			return std::numeric_limits<std::int32_t>::min();
+
+		return static_cast<std::int32_t>(std::clamp(cell, -2147483648.0, 2147483647.0));
+	}
+
+	static std::uint64_t
+	hashKey(const std::int32_t* key, std::size_t length) noexcept
+	{
+		std::uint64_t hash = 0;
+
+		for (std::size_t i = 0; i < length; i++)
+		{
+			hash = (hash ^ static_cast<std::uint32_t>(key[i])) * 0x9E3779B97F4A7C15ull;
+			hash ^= hash >> 29;
+		}
+
+		return hash;
+	}
+
+	template<typename T>
+	static void
+	compactVertices(std::vector<T>& array, const uint1s& vertices, std::size_t numVertices) noexcept
+	{
+		if (array.size() != numVertices)
+			return;
+
+		// the kept vertices are ascending, so every one moves down or stays in place
+		for (std::size_t i = 0; i < vertices.size(); i++)
+			array[i] = array[vertices[i]];
+
+		array.resize(vertices.size());
+	}
+
 	OctoonImplementSubClass(Mesh, runtime::RttiInterface, "Mesh");
 
 	Mesh::Mesh() noexcept
 		: _dirty(true)
+		, _topologyVersion(0)
+		, _texcoordVersion(0)
+		, _bvh(std::make_shared<MeshBVH>())
+		, _adjacencyVersion(0)
 	{
 	}
 
+	Mesh::Mesh(const Mesh& mesh) noexcept
+		: _topologyVersion(0)
+		, _texcoordVersion(0)
+		, _bvh(std::make_shared<MeshBVH>())
+		, _adjacencyVersion(0)
+	{
+		*this = mesh;
+	}
+
 	Mesh::~Mesh() noexcept
 	{
 	}
 
+	Mesh&
+	Mesh::operator=(const Mesh& mesh) noexcept
+	{
+		if (this == &mesh)
+			return *this;
+
+		_name = mesh._name;
+		_dirty = mesh._dirty;
+		_vertices = mesh._vertices;
+		_normals = mesh._normals;
+		_colors = mesh._colors;
+		_tangents = mesh._tangents;
+		_bindposes = mesh._bindposes;
+		_boundingBox = mesh._boundingBox;
+		_bones = mesh._bones;
+		_weights = mesh._weights;
+		_sdefs = mesh._sdefs;
+		_indices = mesh._indices;
+		_boundingBoxs = mesh._boundingBoxs;
+
+		for (std::size_t i = 0; i < TEXTURE_ARRAY_COUNT; i++)
+			_texcoords[i] = mesh._texcoords[i];
+
+		// the hierarchy and the adjacency belong to one mesh, the copy builds its own on demand
+		_bvh->invalidate(true);
+		_topologyVersion++;
+
+		return *this;
+	}
+
 	void
 	Mesh::setName(std::string_view name) noexcept
 	{
@@ -60,6 +156,7 @@ namespace octoon::mesh
 	Mesh::setVertexArray(const float3s& array) noexcept
 	{
 		_vertices = array;
+		_bvh->invalidate(true);
 	}
 
 	void
@@ -85,6 +182,7 @@ namespace octoon::mesh
 	{
 		assert(n < sizeof(_texcoords) / sizeof(float2s));
 		_texcoords[n] = array;
+		_topologyVersion++;
 	}
 
 	void
@@ -93,6 +191,8 @@ namespace octoon::mesh
 		if (_indices.size() <= n)
 			_indices.resize(n + 1);
 		_indices[n] = array;
+		_bvh->invalidate(true);
+		_topologyVersion++;
 	}
 
 	void
@@ -107,10 +207,17 @@ namespace octoon::mesh
 		_weights = array;
 	}
 
+	void
+	Mesh::setSdefArray(const skelecton::VertexSdefs& array) noexcept
+	{
+		_sdefs = array;
+	}
+
 	void
 	Mesh::setVertexArray(float3s&& array) noexcept
 	{
 		_vertices = std::move(array);
+		_bvh->invalidate(true);
 	}
 
 	void
@@ -136,6 +243,7 @@ namespace octoon::mesh
 	{
 		assert(n < sizeof(_texcoords) / sizeof(float2s));
 		_texcoords[n] = std::move(array);
+		_topologyVersion++;
 	}
 
 	void
@@ -144,6 +252,8 @@ namespace octoon::mesh
 		if (_indices.size() <= n)
 			_indices.resize(n + 1);
 		_indices[n] = std::move(array);
+		_bvh->invalidate(true);
+		_topologyVersion++;
 	}
 
 	void
@@ -152,6 +262,12 @@ namespace octoon::mesh
 		_weights = std::move(array);
 	}
 
+	void
+	Mesh::setSdefArray(skelecton::VertexSdefs&& array) noexcept
+	{
+		_sdefs = std::move(array);
+	}
+
 	void
 	Mesh::setBindposes(float4x4s&& array) noexcept
 	{
@@ -195,6 +311,12 @@ namespace octoon::mesh
 		return _weights;
 	}
 
+	skelecton::VertexSdefs&
+	Mesh::getSdefArray() noexcept
+	{
+		return _sdefs;
+	}
+
 	uint1s&
 	Mesh::getIndicesArray(std::size_t n) noexcept
 	{
@@ -244,6 +366,12 @@ namespace octoon::mesh
 		return _weights;
 	}
 
+	const skelecton::VertexSdefs&
+	Mesh::getSdefArray() const noexcept
+	{
+		return _sdefs;
+	}
+
 	const float4x4s&
 	Mesh::getBindposes() const noexcept
 	{
@@ -277,6 +405,14 @@ namespace octoon::mesh
 	void
 	Mesh::setDirty(bool dirty) noexcept
 	{
+		if (dirty)
+		{
+			if (_bvh.use_count() > 1)
+				_bvh = std::make_shared<MeshBVH>();
+			else
+				_bvh->invalidate();
+		}
+
 		this->_dirty = dirty;
 	}
 
@@ -286,32 +422,40 @@ namespace octoon::mesh
 		return this->_dirty;
 	}
 
+	void
+	Mesh::setTopologyDirty() noexcept
+	{
+		_bvh->invalidate(true);
+		_topologyVersion++;
+	}
+
+	std::uint32_t
+	Mesh::getTopologyVersion() const noexcept
+	{
+		return _topologyVersion;
+	}
+
+	void
+	Mesh::setTexcoordDirty() noexcept
+	{
+		_texcoordVersion++;
+	}
+
+	std::uint32_t
+	Mesh::getTexcoordVersion() const noexcept
+	{
+		return _texcoordVersion;
+	}
+
 	bool
 	Mesh::raycast(const math::Raycast& ray, RaycastHit& hit) noexcept
 	{
-		for (std::size_t i = 0; i < this->getNumSubsets(); i++)
-		{
-			if (math::intersect(ray, this->getBoundingBox(i).box()))
-			{
-				auto& indices = this->_indices[i];
-
-				for (std::size_t j = 0; j < indices.size(); j += 3)
-				{
-					auto& v0 = this->_vertices[indices[j]];
-					auto& v1 = this->_vertices[indices[j+1]];
-					auto& v2 = this->_vertices[indices[j+2]];
+		_bvh->update(*this);
 
-					if (math::intersect(ray, math::Triangle(v0, v1, v2), hit.point, hit.distance))
-					{
-						if (hit.distance > 0 && hit.distance < ray.maxDistance)
-						{
-							hit.mesh = i;
-							hit.object = this;
-							return true;
-						}
-					}
-				}
-			}
+		if (_bvh->raycast(*this, ray, hit))
+		{
+			hit.object = this;
+			return true;
 		}
 
 		return false;
@@ -320,41 +464,41 @@ namespace octoon::mesh
 	bool
 	Mesh::raycastAll(const math::Raycast& ray, std::vector<RaycastHit>& hits) noexcept
 	{
-		if (!math::intersect(ray, this->getBoundingBoxAll().box()))
+		_bvh->update(*this);
+
+		auto first = hits.size();
+		if (!_bvh->raycastAll(*this, ray, hits))
 			return false;
 
-		for (std::size_t i = 0; i < this->getNumSubsets(); i++)
-		{
-			if (math::intersect(ray, this->getBoundingBox(i).box()))
-			{
-				auto& indices = _indices[i];
+		for (std::size_t i = first; i < hits.size(); i++)
+			hits[i].object = this;
 
-				for (std::size_t j = 0; j < _indices[i].size(); j += 3)
-				{
-					std::size_t f1 = indices[j];
-					std::size_t f2 = indices[j + 1];
-					std::size_t f3 = indices[j + 2];
+		return true;
+	}
 
-					auto& v0 = _vertices[f1];
-					auto& v1 = _vertices[f2];
-					auto& v2 = _vertices[f3];
+	bool
+	Mesh::raycastAll(const math::Raycast rays[], std::size_t numRays, std::vector<RaycastHit>& hits) noexcept
+	{
+		_bvh->update(*this);
 
-					RaycastHit hit;
-					if (math::intersect(ray, math::Triangle(v0, v1, v2), hit.point, hit.distance))
-					{
-						if (hit.distance > 0 && hit.distance < ray.maxDistance)
-						{
-							hit.mesh = i;
-							hit.object = this;
+		hits.resize(numRays);
 
-							hits.emplace_back(hit);
-						}
-					}
-				}
-			}
+		if (!_bvh->raycastPacket(*this, rays, numRays, hits.data()))
+			return false;
+
+		for (std::size_t i = 0; i < numRays; i++)
+		{
+			if (hits[i].distance < rays[i].maxDistance)
+				hits[i].object = this;
 		}
 
-		return !hits.empty();
+		return true;
+	}
+
+	bool
+	Mesh::raycastAll(const std::vector<math::Raycast>& rays, std::vector<RaycastHit>& hits) noexcept
+	{
+		return this->raycastAll(rays.data(), rays.size(), hits);
 	}
 
 	void
@@ -381,6 +525,7 @@ namespace octoon::mesh
 		mesh->setNormalArray(this->getNormalArray());
 		mesh->setColorArray(this->getColorArray());
 		mesh->setWeightArray(this->getWeightArray());
+		mesh->setSdefArray(this->getSdefArray());
 		mesh->setTangentArray(this->getTangentArray());
 		mesh->setBindposes(this->getBindposes());
 		mesh->_boundingBox = this->_boundingBox;
@@ -408,6 +553,7 @@ namespace octoon::mesh
 			if (_indices.empty() != mesh._indices.empty()) return false;
 			if (_bones.empty() != mesh._bones.empty()) return false;
 			if (_weights.empty() != mesh._weights.empty()) return false;
+			if (_sdefs.empty() != mesh._sdefs.empty()) return false;
 
 			for (std::size_t i = 0; i < TEXTURE_ARRAY_COUNT; i++)
 			{
@@ -424,10 +570,14 @@ namespace octoon::mesh
 		_indices.insert(_indices.end(), mesh._indices.begin(), mesh._indices.end());
 		_bones.insert(_bones.end(), mesh._bones.begin(), mesh._bones.end());
 		_weights.insert(_weights.end(), mesh._weights.begin(), mesh._weights.end());
+		_sdefs.insert(_sdefs.end(), mesh._sdefs.begin(), mesh._sdefs.end());
 
 		for (std::size_t i = 0; i < TEXTURE_ARRAY_COUNT; i++)
 			_texcoords[i].insert(_texcoords[i].end(), mesh._texcoords[i].begin(), mesh._texcoords[i].end());
 
+		_bvh->invalidate(true);
+		_topologyVersion++;
+
 		return true;
 	}
 
@@ -523,6 +673,9 @@ namespace octoon::mesh
 
 		this->computeBoundingBox();
 
+		_bvh->invalidate(true);
+		_topologyVersion++;
+
 		return true;
 	}
 
@@ -535,46 +688,251 @@ namespace octoon::mesh
 	void
 	Mesh::mergeVertices() noexcept
 	{
+		uint1s remap;
+		this->mergeVertices(remap);
+	}
+
+	void
+	Mesh::mergeVertices(uint1s& remap, float epsilon) noexcept
+	{
+		remap.clear();
+
 		if (_vertices.empty())
 			return;
 
 		if (_normals.empty())
 			this->computeVertexNormals();
 
-		std::map<std::pair<float, float>, std::uint32_t> vectorMap;
+		auto numVertices = _vertices.size();
 
-		float3s changeVertex;
-		float3s changeNormal;
+		bool hasNormal = _normals.size() == numVertices;
+		bool hasWeight = _weights.size() == numVertices;
+		bool hasTexcoord[TEXTURE_ARRAY_COUNT];
 
-		for (auto& indices : this->_indices)
+		for (std::size_t i = 0; i < TEXTURE_ARRAY_COUNT; i++)
+			hasTexcoord[i] = _texcoords[i].size() == numVertices;
+
+		epsilon = std::max(epsilon, 0.0f);
+
+		auto near = [epsilon](float a, float b) { return std::fabs(a - b) <= epsilon; };
+
+		// every attribute within epsilon of the kept vertex, bones only count where they carry weight
+		auto matches = [&](std::size_t a, std::size_t b)
 		{
-			for (auto& it : indices)
+			for (std::uint8_t n = 0; n < 3; n++)
+			{
+				if (!near(_vertices[a][n], _vertices[b][n]))
+					return false;
+			}
+
+			if (hasNormal)
 			{
-				const Vector3& v = (_vertices)[it];
-				const Vector3& n = (_normals)[it];
+				for (std::uint8_t n = 0; n < 3; n++)
+				{
+					if (!near(_normals[a][n], _normals[b][n]))
+						return false;
+				}
+			}
 
-				float vkey = math::hash_float(v.x, v.y, v.z);
-				float nkey = math::hash_float(n.z, n.y, n.x);
+			for (std::size_t j = 0; j < TEXTURE_ARRAY_COUNT; j++)
+			{
+				if (hasTexcoord[j] && !(near(_texcoords[j][a].x, _texcoords[j][b].x) && near(_texcoords[j][a].y, _texcoords[j][b].y)))
+					return false;
+			}
 
-				std::uint32_t value = vectorMap[std::make_pair(vkey, nkey)];
-				if (value == 0)
+			if (hasWeight)
+			{
+				auto& wa = _weights[a];
+				auto& wb = _weights[b];
+
+				for (std::size_t j = 0; j < 4; j++)
 				{
-					changeVertex.push_back(v);
-					changeNormal.push_back(n);
+					if (!near(wa.weights[j], wb.weights[j]))
+						return false;
 
-					math::uint1 size = (math::uint1)changeVertex.size();
-					it = size - 1;
-					vectorMap[std::make_pair(vkey, nkey)] = size;
+					auto boneA = wa.weights[j] != 0.0f ? wa.bones[j] : 0;
+					auto boneB = wb.weights[j] != 0.0f ? wb.bones[j] : 0;
+					if (boneA != boneB)
+						return false;
 				}
-				else
+			}
+
+			return true;
+		};
+
+		double invEpsilon = epsilon > 0.0f ? 1.0 / epsilon : 0.0;
+
+		std::vector<std::int32_t> cells(numVertices * 3);
+
+		auto count = static_cast<std::int32_t>(numVertices);
+
+#		pragma omp parallel for if (count >= ParallelThreshold) schedule(static)
+		for (std::int32_t i = 0; i < count; i++)
+		{
+			cells[i * 3 + 0] = quantize(_vertices[i].x, invEpsilon);
+			cells[i * 3 + 1] = quantize(_vertices[i].y, invEpsilon);
+			cells[i * 3 + 2] = quantize(_vertices[i].z, invEpsilon);
+		}
+
+		// Kept vertices are hashed by the cell of their position, with open addressing and linear probing.
+		// A table slot holds the last vertex kept in its cell and next links the others. Two vertices
+		// within epsilon of each other share a cell or sit in adjacent ones, so every neighbouring cell is
+		// searched and the full attributes are compared against each vertex found there.
+		constexpr auto none = std::numeric_limits<std::uint32_t>::max();
+
+		std::size_t capacity = 16;
+		while (capacity < numVertices * 2)
+			capacity <<= 1;
+
+		std::vector<std::uint32_t> table(capacity, none);
+		std::vector<std::uint32_t> next;
+
+		uint1s vertices;
+		vertices.reserve(numVertices);
+		next.reserve(numVertices);
+
+		auto findSlot = [&](const std::int32_t cell[3])
+		{
+			auto slot = hashKey(cell, 3) & (capacity - 1);
+
+			while (table[slot] != none && std::memcmp(cells.data() + vertices[table[slot]] * 3, cell, sizeof(std::int32_t) * 3) != 0)
+				slot = (slot + 1) & (capacity - 1);
+
+			return slot;
+		};
+
+		std::int32_t range = epsilon > 0.0f ? 1 : 0;
+
+		remap.resize(numVertices);
+
+		for (std::size_t i = 0; i < numVertices; i++)
+		{
+			auto cell = cells.data() + i * 3;
+			auto index = none;
+
+			for (std::int32_t z = -range; z <= range && index == none; z++)
+			{
+				for (std::int32_t y = -range; y <= range && index == none; y++)
 				{
-					it = value - 1;
+					for (std::int32_t x = -range; x <= range && index == none; x++)
+					{
+						std::int64_t neighbour[3] = { std::int64_t(cell[0]) + x, std::int64_t(cell[1]) + y, std::int64_t(cell[2]) + z };
+						if (std::any_of(neighbour, neighbour + 3, [](std::int64_t v) { return v < std::numeric_limits<std::int32_t>::min() || v > std::numeric_limits<std::int32_t>::max(); }))
+							continue;
+
+						std::int32_t key[3] = { std::int32_t(neighbour[0]), std::int32_t(neighbour[1]), std::int32_t(neighbour[2]) };
+
+						for (auto it = table[findSlot(key)]; it != none; it = next[it])
+						{
+							if (matches(vertices[it], i))
+							{
+								index = it;
+								break;
+							}
+						}
+					}
 				}
 			}
+
+			if (index == none)
+			{
+				auto slot = findSlot(cell);
+
+				index = static_cast<std::uint32_t>(vertices.size());
+				vertices.push_back(static_cast<std::uint32_t>(i));
+				next.push_back(table[slot]);
+				table[slot] = index;
+			}
+
+			remap[i] = index;
+		}
+
+		if (_indices.empty())
+			_indices.push_back(remap);
+		else
+		{
+			for (auto& indices : _indices)
+			{
+				for (auto& it : indices)
+					it = remap[it];
+			}
+		}
+
+		compactVertices(_vertices, vertices, numVertices);
+		compactVertices(_normals, vertices, numVertices);
+		compactVertices(_colors, vertices, numVertices);
+		compactVertices(_tangents, vertices, numVertices);
+		compactVertices(_weights, vertices, numVertices);
+		compactVertices(_sdefs, vertices, numVertices);
+
+		for (auto& texcoords : _texcoords)
+			compactVertices(texcoords, vertices, numVertices);
+
+		_bvh->invalidate(true);
+		_topologyVersion++;
+	}
+
+	void
+	Mesh::updateAdjacency() noexcept
+	{
+		auto numVertices = _vertices.size();
+
+		bool changed = _adjacencyVersion != _topologyVersion || _adjacencySizes.size() != _indices.size() + 1 || _adjacencySizes[0] != numVertices;
+
+		for (std::size_t i = 0; i < _indices.size() && !changed; i++)
+			changed = _adjacencySizes[i + 1] != _indices[i].size();
+
+		if (!changed)
+			return;
+
+		_adjacencySizes.resize(_indices.size() + 1);
+		_adjacencySizes[0] = numVertices;
+
+		for (std::size_t i = 0; i < _indices.size(); i++)
+			_adjacencySizes[i + 1] = _indices[i].size();
+
+		_adjacencyOffsets.assign(numVertices + 1, 0);
+
+		std::size_t numCorners = 0;
+
+		for (auto& indices : _indices)
+		{
+			auto count = indices.size() / 3 * 3;
+
+			for (std::size_t i = 0; i < count; i++)
+			{
+				assert(indices[i] < numVertices);
+				_adjacencyOffsets[indices[i] + 1]++;
+			}
+
+			numCorners += count;
+		}
+
+		for (std::size_t i = 0; i < numVertices; i++)
+			_adjacencyOffsets[i + 1] += _adjacencyOffsets[i];
+
+		_adjacencyFaces.resize(numCorners);
+
+		// faces are appended in ascending order, the offsets are shifted back by one vertex on the way
+		std::uint32_t face = 0;
+
+		for (auto& indices : _indices)
+		{
+			auto count = indices.size() / 3 * 3;
+
+			for (std::size_t i = 0; i < count; i += 3, face++)
+			{
+				_adjacencyFaces[_adjacencyOffsets[indices[i]]++] = face;
+				_adjacencyFaces[_adjacencyOffsets[indices[i + 1]]++] = face;
+				_adjacencyFaces[_adjacencyOffsets[indices[i + 2]]++] = face;
+			}
 		}
 
-		_vertices.swap(changeVertex);
-		_normals.swap(changeNormal);
+		for (std::size_t i = numVertices; i > 0; i--)
+			_adjacencyOffsets[i] = _adjacencyOffsets[i - 1];
+
+		_adjacencyOffsets[0] = 0;
+		_adjacencyVersion = _topologyVersion;
 	}
 
 	void
@@ -620,51 +978,66 @@ namespace octoon::mesh
 
 		if (_indices.empty())
 		{
-			for (std::size_t i = 0; i < _vertices.size(); i += 3)
+			auto numFaces = static_cast<std::int32_t>(_vertices.size() / 3);
+
+#			pragma omp parallel for if (numFaces >= ParallelThreshold) schedule(static)
+			for (std::int32_t i = 0; i < numFaces; i++)
 			{
-				auto& a = _vertices[i];
-				auto& b = _vertices[i + 1];
-				auto& c = _vertices[i + 2];
+				auto& a = _vertices[i * 3];
+				auto& b = _vertices[i * 3 + 1];
+				auto& c = _vertices[i * 3 + 2];
 
 				auto ab = a - b;
 				auto ac = a - c;
 
 				auto n = math::normalize(math::cross(ac, ab));
 
-				_normals[i + 0] = n;
-				_normals[i + 1] = n;
-				_normals[i + 2] = n;
+				_normals[i * 3 + 0] = n;
+				_normals[i * 3 + 1] = n;
+				_normals[i * 3 + 2] = n;
 			}
 		}
 		else
 		{
-			std::memset(_normals.data(), 0, _normals.size() * sizeof(float3));
+			this->updateAdjacency();
+
+			_faceVectors.resize(_adjacencyFaces.size() / 3);
+
+			auto faceNormals = _faceVectors.data();
 
 			for (auto& indices : _indices)
 			{
-				for (std::size_t i = 0; i < indices.size(); i += 3)
-				{
-					std::uint32_t f1 = indices[i];
-					std::uint32_t f2 = indices[i + 1];
-					std::uint32_t f3 = indices[i + 2];
+				auto numFaces = static_cast<std::int32_t>(indices.size() / 3);
 
-					auto& a = _vertices.at(f1);
-					auto& b = _vertices.at(f2);
-					auto& c = _vertices.at(f3);
+#				pragma omp parallel for if (numFaces >= ParallelThreshold) schedule(static)
+				for (std::int32_t i = 0; i < numFaces; i++)
+				{
+					auto& a = _vertices[indices[i * 3]];
+					auto& b = _vertices[indices[i * 3 + 1]];
+					auto& c = _vertices[indices[i * 3 + 2]];
 
 					auto edge1 = c - b;
 					auto edge2 = a - b;
 
-					auto n(math::normalize(math::cross(edge1, edge2)));
-
-					_normals[f1] += n;
-					_normals[f2] += n;
-					_normals[f3] += n;
+					faceNormals[i] = math::normalize(math::cross(edge1, edge2));
 				}
+
+				faceNormals += numFaces;
 			}
 
-			for (auto& it : _normals)
-				it = math::normalize(it);
+			// every vertex sums its own faces in the same order as a serial pass, so no atomics are needed
+			auto numVertices = static_cast<std::int32_t>(_vertices.size());
+
+#			pragma omp parallel for if (numVertices >= ParallelThreshold) schedule(static)
+			for (std::int32_t i = 0; i < numVertices; i++)
+			{
+				auto normal = float3::Zero;
+
+				for (auto j = _adjacencyOffsets[i]; j < _adjacencyOffsets[i + 1]; j++)
+					normal += _faceVectors[_adjacencyFaces[j]];
+
+				_normals[i] = math::normalize(normal);
+			}
 		}
 	}
 
@@ -801,25 +1174,34 @@ namespace octoon::mesh
 	Mesh::computeTangents(std::uint8_t n) noexcept
 	{
 		assert(!_texcoords[n].empty());
+		assert(_normals.size() <= _vertices.size());
+
+		this->updateAdjacency();
 
-		float3s tan1(_vertices.size(), float3::Zero);
-		float3s tan2(_vertices.size(), float3::Zero);
+		auto& texcoords = _texcoords[n];
+
+		_faceVectors.resize(_adjacencyFaces.size() / 3 * 2);
+
+		auto faceTangents = _faceVectors.data();
 
 		for (auto& indices : _indices)
 		{
-			for (std::size_t i = 0; i < indices.size(); i += 3)
+			auto numFaces = static_cast<std::int32_t>(indices.size() / 3);
+
+#			pragma omp parallel for if (numFaces >= ParallelThreshold) schedule(static)
+			for (std::int32_t i = 0; i < numFaces; i++)
 			{
-				std::uint32_t f1 = indices[i];
-				std::uint32_t f2 = indices[i + 1];
-				std::uint32_t f3 = indices[i + 2];
+				std::uint32_t f1 = indices[i * 3];
+				std::uint32_t f2 = indices[i * 3 + 1];
+				std::uint32_t f3 = indices[i * 3 + 2];
 
 				auto& v1 = _vertices[f1];
 				auto& v2 = _vertices[f2];
 				auto& v3 = _vertices[f3];
 
-				auto& w1 = _texcoords[n][f1];
-				auto& w2 = _texcoords[n][f2];
-				auto& w3 = _texcoords[n][f3];
+				auto& w1 = texcoords[f1];
+				auto& w2 = texcoords[f2];
+				auto& w3 = texcoords[f3];
 
 				auto x1 = v2.x - v1.x;
 				auto x2 = v3.x - v1.x;
@@ -836,30 +1218,41 @@ namespace octoon::mesh
 				auto r = 1.0f / (s1 * t2 - s2 * t1);
 				if (!std::isinf(r))
 				{
-					float3 sdir((t2 * x1 - t1 * x2) * r, (t2 * y1 - t1 * y2) * r, (t2 * z1 - t1 * z2) * r);
-					float3 tdir((s1 * x2 - s2 * x1) * r, (s1 * y2 - s2 * y1) * r, (s1 * z2 - s2 * z1) * r);
-
-					tan1[f1] += sdir;
-					tan1[f2] += sdir;
-					tan1[f3] += sdir;
-
-					tan2[f1] += tdir;
-					tan2[f2] += tdir;
-					tan2[f3] += tdir;
+					faceTangents[i * 2] = float3((t2 * x1 - t1 * x2) * r, (t2 * y1 - t1 * y2) * r, (t2 * z1 - t1 * z2) * r);
+					faceTangents[i * 2 + 1] = float3((s1 * x2 - s2 * x1) * r, (s1 * y2 - s2 * y1) * r, (s1 * z2 - s2 * z1) * r);
+				}
+				else
+				{
+					faceTangents[i * 2] = float3::Zero;
+					faceTangents[i * 2 + 1] = float3::Zero;
 				}
 			}
+
+			faceTangents += numFaces * 2;
 		}
 
 		_tangents.resize(_normals.size());
 
-		for (std::size_t i = 0; i < _normals.size(); i++)
+		auto numVertices = static_cast<std::int32_t>(_normals.size());
+
+#		pragma omp parallel for if (numVertices >= ParallelThreshold) schedule(static)
+		for (std::int32_t i = 0; i < numVertices; i++)
 		{
+			auto tan1 = float3::Zero;
+			auto tan2 = float3::Zero;
+
+			for (auto j = _adjacencyOffsets[i]; j < _adjacencyOffsets[i + 1]; j++)
+			{
+				auto face = _adjacencyFaces[j];
+				tan1 += _faceVectors[face * 2];
+				tan2 += _faceVectors[face * 2 + 1];
+			}
+
 			auto& nor = _normals[i];
-			auto& tan = tan1[i];
 
-			float handedness = math::dot(math::cross(nor, tan), tan2[i]) < 0.0f ? 1.0f : -1.0f;
+			float handedness = math::dot(math::cross(nor, tan1), tan2) < 0.0f ? 1.0f : -1.0f;
 
-			_tangents[i] = float4(math::normalize(tan - nor * math::dot(nor, tan)), handedness);
+			_tangents[i] = float4(math::normalize(tan1 - nor * math::dot(nor, tan1)), handedness);
 		}
 	}
 
@@ -900,14 +1293,26 @@ namespace octoon::mesh
 
 		for (std::size_t i = 0; i < _indices.size(); i++)
 		{
-			auto& indices = _indices[i];
-			for (auto& index : indices)
-				_boundingBoxs[i].encapsulate(_vertices[index]);
+			math::AABB aabb;
+			for (auto& index : _indices[i])
+				aabb.encapsulate(_vertices[index]);
 
-			_boundingBox.encapsulate(_boundingBoxs[i]);
+			_boundingBoxs[i].reset();
+			_boundingBoxs[i].encapsulate(aabb);
+			_boundingBox.encapsulate(aabb);
 		}
 	}
 
+	void
+	Mesh::setBoundingBoxes(const std::vector<BoundingBox>& boundingBoxes) noexcept
+	{
+		_boundingBox.reset();
+		_boundingBoxs = boundingBoxes;
+
+		for (auto& it : _boundingBoxs)
+			_boundingBox.encapsulate(it);
+	}
+
 	void
 	Mesh::computeLightMap(std::uint32_t width, std::uint32_t height) noexcept
 	{
@@ -0,0 +1,540 @@
+#include <octoon/mesh/mesh_bvh.h>
+#include <octoon/mesh/mesh.h>
+
+#include <numeric>
+#include <algorithm>
+
+using namespace octoon::math;
+
+namespace octoon::mesh
+{
+	constexpr std::uint32_t NumSplitBins = 16;
+	constexpr std::uint32_t MaxSahDepth = 48;
+
+	static float3
+	computeInverseDirection(const float3& dir) noexcept
+	{
+		auto safe = [](float v) { return std::abs(v) > 1e-8f ? v : (v < 0.0f ? -1e-8f : 1e-8f); };
+		return float3(1.0f / safe(dir.x), 1.0f / safe(dir.y), 1.0f / safe(dir.z));
+	}
+
+	static bool
+	intersectNode(const MeshBVH::Node& node, const float3& origin, const float3& invDir, float maxDistance) noexcept
+	{
+		float tx1 = (node.min.x - origin.x) * invDir.x;
+		float tx2 = (node.max.x - origin.x) * invDir.x;
+		float ty1 = (node.min.y - origin.y) * invDir.y;
+		float ty2 = (node.max.y - origin.y) * invDir.y;
+		float tz1 = (node.min.z - origin.z) * invDir.z;
+		float tz2 = (node.max.z - origin.z) * invDir.z;
+
+		float tnear = std::max(std::max(std::min(tx1, tx2), std::min(ty1, ty2)), std::min(tz1, tz2));
+		float tfar = std::min(std::min(std::max(tx1, tx2), std::max(ty1, ty2)), std::max(tz1, tz2));
+
+		return tfar >= std::max(tnear, 0.0f) && tnear < maxDistance;
+	}
+
+	static bool
+	intersectTriangle(const float3& origin, const float3& dir, const float3& a, const float3& b, const float3& c, float& distance) noexcept
+	{
+		auto e1 = b - a;
+		auto e2 = c - a;
+		auto p = math::cross(dir, e2);
+
+		auto det = math::dot(e1, p);
+		if (std::abs(det) < 1e-12f)
+			return false;
+
+		auto invDet = 1.0f / det;
+		auto s = origin - a;
+
+		auto u = math::dot(s, p) * invDet;
+		if (u < 0.0f || u > 1.0f)
+			return false;
+
+		auto q = math::cross(s, e1);
+		auto v = math::dot(dir, q) * invDet;
+		if (v < 0.0f || u + v > 1.0f)
+			return false;
+
+		distance = math::dot(e2, q) * invDet;
+		return true;
+	}
+
+	MeshBVH::MeshBVH() noexcept
+		: dirty_(true)
+		, rebuild_(true)
+		, numVertices_(0)
+	{
+	}
+
+	MeshBVH::~MeshBVH() noexcept
+	{
+	}
+
+	void
+	MeshBVH::build(const Mesh& mesh) noexcept
+	{
+		nodes_.clear();
+		primitives_.clear();
+
+		auto& vertices = mesh.getVertexArray();
+		numVertices_ = vertices.size();
+
+		std::vector<Primitive> primitives;
+
+		for (std::size_t i = 0; i < mesh.getNumSubsets(); i++)
+		{
+			auto& indices = mesh.getIndicesArray(i);
+			for (std::size_t j = 0; j + 2 < indices.size(); j += 3)
+			{
+				if (indices[j] < numVertices_ && indices[j + 1] < numVertices_ && indices[j + 2] < numVertices_)
+					primitives.push_back(Primitive{ static_cast<std::uint32_t>(i), indices[j], indices[j + 1], indices[j + 2] });
+			}
+		}
+
+		if (primitives.empty())
+			return;
+
+		std::vector<AABB> bounds(primitives.size());
+		float3s centers(primitives.size());
+
+		for (std::size_t i = 0; i < primitives.size(); i++)
+		{
+			auto& it = primitives[i];
+			bounds[i].encapsulate(vertices[it.v0]);
+			bounds[i].encapsulate(vertices[it.v1]);
+			bounds[i].encapsulate(vertices[it.v2]);
+			centers[i] = (bounds[i].min + bounds[i].max) * 0.5f;
+		}
+
+		std::vector<std::uint32_t> order(primitives.size());
+		std::iota(order.begin(), order.end(), 0);
+
+		nodes_.reserve(primitives.size() * 2 / MaxLeafPrimitives + 1);
+
+		this->buildNode(bounds, centers, order, 0, static_cast<std::uint32_t>(primitives.size()), 0);
+
+		primitives_.resize(primitives.size());
+		for (std::size_t i = 0; i < order.size(); i++)
+			primitives_[i] = primitives[order[i]];
+	}
+
+	std::uint32_t
+	MeshBVH::buildNode(const std::vector<AABB>& bounds, const float3s& centers, std::vector<std::uint32_t>& order, std::uint32_t begin, std::uint32_t end, std::uint32_t depth) noexcept
+	{
+		auto index = static_cast<std::uint32_t>(nodes_.size());
+		nodes_.emplace_back();
+
+		AABB aabb;
+		AABB centerBounds;
+
+		for (std::uint32_t i = begin; i < end; i++)
+		{
+			aabb.encapsulate(bounds[order[i]]);
+			centerBounds.encapsulate(centers[order[i]]);
+		}
+
+		auto count = end - begin;
+		auto mid = begin;
+
+		if (count > MaxLeafPrimitives)
+		{
+			auto extent = centerBounds.max - centerBounds.min;
+			auto axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+
+			if (extent[axis] > 0.0f && depth < MaxSahDepth)
+			{
+				// binned surface area heuristic along the widest centroid axis
+				auto scale = NumSplitBins * (1.0f - 1e-5f) / extent[axis];
+				auto binIndex = [&](std::uint32_t prim)
+				{
+					auto bin = static_cast<std::uint32_t>((centers[prim][axis] - centerBounds.min[axis]) * scale);
+					return std::min(bin, NumSplitBins - 1);
+				};
+
+				AABB binBounds[NumSplitBins];
+				std::uint32_t binCounts[NumSplitBins] = { 0 };
+
+				for (std::uint32_t i = begin; i < end; i++)
+				{
+					auto bin = binIndex(order[i]);
+					binCounts[bin]++;
+					binBounds[bin].encapsulate(bounds[order[i]]);
+				}
+
+				float rightArea[NumSplitBins] = { 0 };
+				std::uint32_t rightCount[NumSplitBins] = { 0 };
+
+				AABB accum;
+				std::uint32_t accumCount = 0;
+
+				for (std::uint32_t i = NumSplitBins - 1; i > 0; i--)
+				{
+					accumCount += binCounts[i];
+					if (binCounts[i] > 0)
+						accum.encapsulate(binBounds[i]);
+					rightCount[i] = accumCount;
+					rightArea[i] = accumCount > 0 ? math::surfaceArea(accum) : 0.0f;
+				}
+
+				accum.reset();
+				accumCount = 0;
+
+				std::uint32_t split = 0;
+				float bestCost = std::numeric_limits<float>::max();
+
+				for (std::uint32_t i = 0; i < NumSplitBins - 1; i++)
+				{
+					accumCount += binCounts[i];
+					if (binCounts[i] > 0)
+						accum.encapsulate(binBounds[i]);
+
+					if (accumCount == 0 || rightCount[i + 1] == 0)
+						continue;
+
+					auto cost = accumCount * math::surfaceArea(accum) + rightCount[i + 1] * rightArea[i + 1];
+					if (cost < bestCost)
+					{
+						bestCost = cost;
+						split = i + 1;
+					}
+				}
+
+				if (split > 0)
+				{
+					auto it = std::partition(order.begin() + begin, order.begin() + end, [&](std::uint32_t prim) { return binIndex(prim) < split; });
+					mid = static_cast<std::uint32_t>(it - order.begin());
+				}
+			}
+
+			if (mid == begin || mid == end)
+			{
+				mid = begin + count / 2;
+
+				if (extent[axis] > 0.0f)
+				{
+					std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end, [&](std::uint32_t a, std::uint32_t b)
+					{
+						return centers[a][axis] < centers[b][axis];
+					});
+				}
+			}
+		}
+
+		std::uint32_t first = begin;
+
+		if (mid != begin)
+		{
+			this->buildNode(bounds, centers, order, begin, mid, depth + 1);
+			first = this->buildNode(bounds, centers, order, mid, end, depth + 1);
+			count = 0;
+		}
+
+		auto& node = nodes_[index];
+		node.min = aabb.min;
+		node.max = aabb.max;
+		node.first = first;
+		node.count = count;
+		node.escape = static_cast<std::uint32_t>(nodes_.size());
+
+		return index;
+	}
+
+	void
+	MeshBVH::refit(const Mesh& mesh) noexcept
+	{
+		auto& vertices = mesh.getVertexArray();
+
+		for (std::size_t i = nodes_.size(); i-- > 0;)
+		{
+			auto& node = nodes_[i];
+
+			AABB aabb;
+
+			if (node.count > 0)
+			{
+				for (std::uint32_t j = node.first; j < node.first + node.count; j++)
+				{
+					auto& prim = primitives_[j];
+					aabb.encapsulate(vertices[prim.v0]);
+					aabb.encapsulate(vertices[prim.v1]);
+					aabb.encapsulate(vertices[prim.v2]);
+				}
+			}
+			else
+			{
+				auto& left = nodes_[i + 1];
+				auto& right = nodes_[node.first];
+				aabb.min = math::min(left.min, right.min);
+				aabb.max = math::max(left.max, right.max);
+			}
+
+			node.min = aabb.min;
+			node.max = aabb.max;
+		}
+	}
+
+	void
+	MeshBVH::invalidate(bool rebuild) noexcept
+	{
+		if (rebuild)
+			rebuild_.store(true, std::memory_order_relaxed);
+		dirty_.store(true, std::memory_order_release);
+	}
+
+	void
+	MeshBVH::update(const Mesh& mesh) noexcept
+	{
+		if (!dirty_.load(std::memory_order_acquire))
+			return;
+
+		std::lock_guard<std::mutex> guard(mutex_);
+
+		if (dirty_.load(std::memory_order_relaxed))
+		{
+			std::size_t numTriangles = 0;
+			for (std::size_t i = 0; i < mesh.getNumSubsets(); i++)
+				numTriangles += mesh.getIndicesArray(i).size() / 3;
+
+			if (rebuild_ || nodes_.empty() || numTriangles != primitives_.size() || numVertices_ != mesh.getNumVertices())
+				this->build(mesh);
+			else
+				this->refit(mesh);
+
+			rebuild_.store(false, std::memory_order_relaxed);
+			dirty_.store(false, std::memory_order_release);
+		}
+	}
+
+	bool
+	MeshBVH::empty() const noexcept
+	{
+		return nodes_.empty();
+	}
+
+	const std::vector<MeshBVH::Node>&
+	MeshBVH::getNodes() const noexcept
+	{
+		return nodes_;
+	}
+
+	const std::vector<MeshBVH::Primitive>&
+	MeshBVH::getPrimitives() const noexcept
+	{
+		return primitives_;
+	}
+
+	bool
+	MeshBVH::raycast(const Mesh& mesh, const Raycast& ray, RaycastHit& hit) const noexcept
+	{
+		auto& vertices = mesh.getVertexArray();
+		auto invDir = computeInverseDirection(ray.normal);
+		auto maxDistance = ray.maxDistance;
+
+		const Primitive* closest = nullptr;
+
+		std::uint32_t i = 0;
+		auto numNodes = static_cast<std::uint32_t>(nodes_.size());
+
+		while (i < numNodes)
+		{
+			auto& node = nodes_[i];
+
+			if (!intersectNode(node, ray.origin, invDir, maxDistance))
+			{
+				i = node.escape;
+				continue;
+			}
+
+			if (node.count > 0)
+			{
+				for (std::uint32_t j = node.first; j < node.first + node.count; j++)
+				{
+					auto& prim = primitives_[j];
+
+					float distance;
+					if (intersectTriangle(ray.origin, ray.normal, vertices[prim.v0], vertices[prim.v1], vertices[prim.v2], distance))
+					{
+						if (distance > 0.0f && distance < maxDistance)
+						{
+							maxDistance = distance;
+							closest = &prim;
+						}
+					}
+				}
+
+				i = node.escape;
+			}
+			else
+			{
+				i++;
+			}
+		}
+
+		if (closest)
+		{
+			hit.mesh = closest->subset;
+			hit.distance = maxDistance;
+			hit.point = ray.origin + ray.normal * maxDistance;
+			return true;
+		}
+
+		return false;
+	}
+
+	bool
+	MeshBVH::raycastAll(const Mesh& mesh, const Raycast& ray, std::vector<RaycastHit>& hits) const noexcept
+	{
+		auto& vertices = mesh.getVertexArray();
+		auto invDir = computeInverseDirection(ray.normal);
+		auto numHits = hits.size();
+
+		std::uint32_t i = 0;
+		auto numNodes = static_cast<std::uint32_t>(nodes_.size());
+
+		while (i < numNodes)
+		{
+			auto& node = nodes_[i];
+
+			if (!intersectNode(node, ray.origin, invDir, ray.maxDistance))
+			{
+				i = node.escape;
+				continue;
+			}
+
+			if (node.count > 0)
+			{
+				for (std::uint32_t j = node.first; j < node.first + node.count; j++)
+				{
+					auto& prim = primitives_[j];
+
+					float distance;
+					if (intersectTriangle(ray.origin, ray.normal, vertices[prim.v0], vertices[prim.v1], vertices[prim.v2], distance))
+					{
+						if (distance > 0.0f && distance < ray.maxDistance)
+						{
+							RaycastHit hit;
+							hit.object = nullptr;
+							hit.mesh = prim.subset;
+							hit.distance = distance;
+							hit.point = ray.origin + ray.normal * distance;
+
+							hits.emplace_back(hit);
+						}
+					}
+				}
+
+				i = node.escape;
+			}
+			else
+			{
+				i++;
+			}
+		}
+
+		return hits.size() > numHits;
+	}
+
+	std::size_t
+	MeshBVH::raycastPacket(const Mesh& mesh, const Raycast rays[], std::size_t numRays, RaycastHit hits[]) const noexcept
+	{
+		auto& vertices = mesh.getVertexArray();
+		auto numNodes = static_cast<std::uint32_t>(nodes_.size());
+
+		std::size_t numHits = 0;
+
+		for (std::size_t offset = 0; offset < numRays; offset += PacketSize)
+		{
+			auto packetSize = static_cast<std::uint32_t>(std::min<std::size_t>(PacketSize, numRays - offset));
+
+			float3 invDirs[PacketSize];
+			float maxDistances[PacketSize];
+			const Primitive* closest[PacketSize];
+
+			for (std::uint32_t r = 0; r < packetSize; r++)
+			{
+				invDirs[r] = computeInverseDirection(rays[offset + r].normal);
+				maxDistances[r] = rays[offset + r].maxDistance;
+				closest[r] = nullptr;
+			}
+
+			std::uint32_t i = 0;
+
+			while (i < numNodes)
+			{
+				auto& node = nodes_[i];
+
+				std::uint32_t mask = 0;
+				for (std::uint32_t r = 0; r < packetSize; r++)
+				{
+					if (intersectNode(node, rays[offset + r].origin, invDirs[r], maxDistances[r]))
+						mask |= 1u << r;
+				}
+
+				if (!mask)
+				{
+					i = node.escape;
+					continue;
+				}
+
+				if (node.count > 0)
+				{
+					for (std::uint32_t j = node.first; j < node.first + node.count; j++)
+					{
+						auto& prim = primitives_[j];
+						auto& v0 = vertices[prim.v0];
+						auto& v1 = vertices[prim.v1];
+						auto& v2 = vertices[prim.v2];
+
+						for (std::uint32_t r = 0; r < packetSize; r++)
+						{
+							if (!(mask & (1u << r)))
+								continue;
+
+							float distance;
+							if (intersectTriangle(rays[offset + r].origin, rays[offset + r].normal, v0, v1, v2, distance))
+							{
+								if (distance > 0.0f && distance < maxDistances[r])
+								{
+									maxDistances[r] = distance;
+									closest[r] = &prim;
+								}
+							}
+						}
+					}
+
+					i = node.escape;
+				}
+				else
+				{
+					i++;
+				}
+			}
+
+			for (std::uint32_t r = 0; r < packetSize; r++)
+			{
+				auto& ray = rays[offset + r];
+				auto& hit = hits[offset + r];
+
+				hit.object = nullptr;
+
+				if (closest[r])
+				{
+					hit.mesh = closest[r]->subset;
+					hit.distance = maxDistances[r];
+					hit.point = ray.origin + ray.normal * maxDistances[r];
+					numHits++;
+				}
+				else
+				{
+					hit.mesh = 0;
+					hit.distance = std::numeric_limits<float>::infinity();
+					hit.point = float3::Zero;
+				}
+			}
+		}
+
+		return numHits;
+	}
+}
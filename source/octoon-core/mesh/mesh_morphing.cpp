@@ -0,0 +1,418 @@
+#include <octoon/mesh/mesh_morphing.h>
+#include <octoon/runtime/profiler.h>
+
+#include <algorithm>
+#include <numeric>
+#include <thread>
+
+#if defined(OCTOON_BUILD_AVX) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#	define OCTOON_MORPHING_SIMD 1
+#	include <immintrin.h>
+#	if defined(__GNUC__) || defined(__clang__)
+#		define OCTOON_TARGET_SSE __attribute__((target("sse2")))
+#		define OCTOON_TARGET_AVX __attribute__((target("avx")))
+#	elif defined _MSC_VER
+#		define OCTOON_TARGET_SSE
+#		define OCTOON_TARGET_AVX
+#	endif
+#endif
+
+namespace octoon::mesh
+{
+	constexpr std::size_t MorphBlockSize = 256;
+	constexpr std::size_t MorphParallelThreshold = 16384;
+
+	using MorphKernel = void(*)(const std::uint32_t* runs, std::size_t numRuns, const float* const deltas[3], float weight, float* const totals[3]) noexcept;
+
+	static void
+	blendScalar(const std::uint32_t* runs, std::size_t numRuns, const float* const deltas[3], float weight, float* const totals[3]) noexcept
+	{
+		std::size_t offset = 0;
+
+		for (std::size_t r = 0; r < numRuns; r++)
+		{
+			auto begin = runs[r * 2];
+			auto count = runs[r * 2 + 1];
+
+			for (std::uint8_t k = 0; k < 3; k++)
+			{
+				auto delta = deltas[k] + offset;
+				auto total = totals[k] + begin;
+
+				for (std::size_t i = 0; i < count; i++)
+					total[i] += delta[i] * weight;
+			}
+
+			offset += count;
+		}
+	}
+
+#if OCTOON_MORPHING_SIMD
+	OCTOON_TARGET_SSE static void
+	blendSSE(const std::uint32_t* runs, std::size_t numRuns, const float* const deltas[3], float weight, float* const totals[3]) noexcept
+	{
+		auto w = _mm_set1_ps(weight);
+
+		std::size_t offset = 0;
+
+		for (std::size_t r = 0; r < numRuns; r++)
+		{
+			auto begin = runs[r * 2];
+			auto count = runs[r * 2 + 1];
+
+			for (std::uint8_t k = 0; k < 3; k++)
+			{
+				auto delta = deltas[k] + offset;
+				auto total = totals[k] + begin;
+
+				std::size_t i = 0;
+
+				for (; i + 4 <= count; i += 4)
+					_mm_storeu_ps(total + i, _mm_add_ps(_mm_loadu_ps(total + i), _mm_mul_ps(_mm_loadu_ps(delta + i), w)));
+
+				for (; i < count; i++)
+					total[i] += delta[i] * weight;
+			}
+
+			offset += count;
+		}
+	}
+
+	OCTOON_TARGET_AVX static void
+	blendAVX(const std::uint32_t* runs, std::size_t numRuns, const float* const deltas[3], float weight, float* const totals[3]) noexcept
+	{
+		auto w = _mm256_set1_ps(weight);
+
+		std::size_t offset = 0;
+
+		for (std::size_t r = 0; r < numRuns; r++)
+		{
+			auto begin = runs[r * 2];
+			auto count = runs[r * 2 + 1];
+
+			for (std::uint8_t k = 0; k < 3; k++)
+			{
+				auto delta = deltas[k] + offset;
+				auto total = totals[k] + begin;
+
+				std::size_t i = 0;
+
+				for (; i + 8 <= count; i += 8)
+					_mm256_storeu_ps(total + i, _mm256_add_ps(_mm256_loadu_ps(total + i), _mm256_mul_ps(_mm256_loadu_ps(delta + i), w)));
+
+				for (; i < count; i++)
+					total[i] += delta[i] * weight;
+			}
+
+			offset += count;
+		}
+	}
+#endif
+
+	MeshMorphing::MeshMorphing() noexcept
+		: invalidated_(false)
+		, numVertices_(0)
+		, numThreads_(std::max(1u, std::thread::hardware_concurrency()))
+		, instructionSet_(MeshSkinning::getSupportedInstructionSet())
+	{
+	}
+
+	MeshMorphing::~MeshMorphing() noexcept
+	{
+	}
+
+	void
+	MeshMorphing::setNumVertices(std::size_t numVertices) noexcept
+	{
+		auto numBlocks = (numVertices + MorphBlockSize - 1) / MorphBlockSize;
+
+		numVertices_ = numVertices;
+
+		for (std::uint8_t i = 0; i < 3; i++)
+			totals_[i].assign(numVertices, 0.0f);
+
+		morphs_.clear();
+		accumulators_.clear();
+		dirtyBlocks_.assign(numBlocks, 0);
+		morphBlocks_.assign(numBlocks, 0);
+
+		invalidated_ = true;
+	}
+
+	std::size_t
+	MeshMorphing::getNumVertices() const noexcept
+	{
+		return numVertices_;
+	}
+
+	std::size_t
+	MeshMorphing::addMorph(const math::uint1s& indices, const math::float3s& offsets) noexcept
+	{
+		auto numIndices = std::min(indices.size(), offsets.size());
+
+		std::vector<std::uint32_t> order(numIndices);
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b) { return indices[a] < indices[b]; });
+
+		Morph morph;
+		morph.weight = 0.0f;
+		morph.applied = 0.0f;
+
+		for (std::uint8_t k = 0; k < 3; k++)
+			morph.deltas[k].reserve(numIndices);
+
+		std::uint32_t last = 0;
+
+		for (auto& it : order)
+		{
+			auto index = indices[it];
+			if (index >= numVertices_)
+				continue;
+
+			auto& offset = offsets[it];
+
+			// a vertex listed twice receives both offsets, as it did when the morphs were added one by one
+			if (!morph.runs.empty() && index == last)
+			{
+				morph.deltas[0].back() += offset.x;
+				morph.deltas[1].back() += offset.y;
+				morph.deltas[2].back() += offset.z;
+				continue;
+			}
+
+			if (!morph.runs.empty() && index == last + 1)
+				morph.runs.back()++;
+			else
+				morph.runs.insert(morph.runs.end(), { index, 1 });
+
+			morph.deltas[0].push_back(offset.x);
+			morph.deltas[1].push_back(offset.y);
+			morph.deltas[2].push_back(offset.z);
+
+			auto block = static_cast<std::uint32_t>(index / MorphBlockSize);
+			if (morph.blocks.empty() || morph.blocks.back() != block)
+			{
+				morph.blocks.push_back(block);
+				morphBlocks_[block] = 1;
+			}
+
+			last = index;
+		}
+
+		morphs_.push_back(std::move(morph));
+
+		return morphs_.size() - 1;
+	}
+
+	std::size_t
+	MeshMorphing::getNumMorphs() const noexcept
+	{
+		return morphs_.size();
+	}
+
+	void
+	MeshMorphing::setWeight(std::size_t n, float weight) noexcept
+	{
+		assert(n < morphs_.size());
+		morphs_[n].weight = weight;
+	}
+
+	float
+	MeshMorphing::getWeight(std::size_t n) const noexcept
+	{
+		assert(n < morphs_.size());
+		return morphs_[n].weight;
+	}
+
+	void
+	MeshMorphing::setInstructionSet(SkinningInstructionSet instructionSet) noexcept
+	{
+		instructionSet_ = std::min(instructionSet, MeshSkinning::getSupportedInstructionSet());
+	}
+
+	SkinningInstructionSet
+	MeshMorphing::getInstructionSet() const noexcept
+	{
+		return instructionSet_;
+	}
+
+	void
+	MeshMorphing::setNumThreads(std::uint32_t numThreads) noexcept
+	{
+		numThreads_ = numThreads > 0 ? numThreads : std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	std::uint32_t
+	MeshMorphing::getNumThreads() const noexcept
+	{
+		return numThreads_;
+	}
+
+	bool
+	MeshMorphing::update(MeshSkinning& skinning) noexcept
+	{
+		if (numVertices_ == 0 || skinning.getNumVertices() != numVertices_)
+			return false;
+
+		std::size_t numDeltas = 0;
+		bool hasWeights = false;
+
+		changed_.clear();
+
+		for (std::size_t i = 0; i < morphs_.size(); i++)
+		{
+			auto& morph = morphs_[i];
+			if (morph.weight != morph.applied)
+			{
+				changed_.push_back(i);
+				numDeltas += morph.deltas[0].size();
+			}
+
+			if (morph.weight != 0.0f)
+				hasWeights = true;
+		}
+
+		if (changed_.empty() && !invalidated_)
+			return false;
+
+		OCTOON_PROFILE_CATEGORY("MeshMorphing::update", "animation");
+
+		MorphKernel kernel = blendScalar;
+#if OCTOON_MORPHING_SIMD
+		if (instructionSet_ == SkinningInstructionSet::AVX)
+			kernel = blendAVX;
+		else if (instructionSet_ == SkinningInstructionSet::SSE)
+			kernel = blendSSE;
+#endif
+
+		auto numBlocks = dirtyBlocks_.size();
+
+		if (!hasWeights)
+		{
+			// every morph is off, so the totals are cleared exactly instead of accumulating the rounding of the deltas
+			for (std::size_t block = 0; block < numBlocks; block++)
+			{
+				if (morphBlocks_[block])
+				{
+					auto begin = block * MorphBlockSize;
+					auto end = std::min(begin + MorphBlockSize, numVertices_);
+
+					for (std::uint8_t k = 0; k < 3; k++)
+						std::fill(totals_[k].begin() + begin, totals_[k].begin() + end, 0.0f);
+
+					dirtyBlocks_[block] = 1;
+				}
+			}
+		}
+		else if (numThreads_ > 1 && changed_.size() > 1 && numDeltas >= MorphParallelThreshold)
+		{
+			auto numTasks = std::min<std::size_t>(numThreads_, changed_.size());
+
+			if (accumulators_.size() < numTasks)
+				accumulators_.resize(numTasks);
+
+			for (std::size_t t = 0; t < numTasks; t++)
+			{
+				auto& accumulator = accumulators_[t];
+				if (accumulator.blocks.size() != numBlocks)
+				{
+					for (std::uint8_t k = 0; k < 3; k++)
+						accumulator.totals[k].assign(numVertices_, 0.0f);
+					accumulator.blocks.assign(numBlocks, 0);
+				}
+			}
+
+#			pragma omp parallel for num_threads(static_cast<std::int32_t>(numTasks)) schedule(static, 1)
+			for (std::int32_t t = 0; t < static_cast<std::int32_t>(numTasks); t++)
+			{
+				auto& accumulator = accumulators_[t];
+
+				float* totals[3] = { accumulator.totals[0].data(), accumulator.totals[1].data(), accumulator.totals[2].data() };
+
+				for (auto i = static_cast<std::size_t>(t); i < changed_.size(); i += numTasks)
+				{
+					auto& morph = morphs_[changed_[i]];
+
+					const float* deltas[3] = { morph.deltas[0].data(), morph.deltas[1].data(), morph.deltas[2].data() };
+					kernel(morph.runs.data(), morph.runs.size() / 2, deltas, morph.weight - morph.applied, totals);
+
+					for (auto& block : morph.blocks)
+						accumulator.blocks[block] = 1;
+				}
+			}
+
+#			pragma omp parallel for num_threads(static_cast<std::int32_t>(numThreads_)) schedule(dynamic, 16)
+			for (std::int32_t block = 0; block < static_cast<std::int32_t>(numBlocks); block++)
+			{
+				auto begin = block * MorphBlockSize;
+				auto end = std::min(begin + MorphBlockSize, numVertices_);
+
+				for (std::size_t t = 0; t < numTasks; t++)
+				{
+					auto& accumulator = accumulators_[t];
+					if (!accumulator.blocks[block])
+						continue;
+
+					for (std::uint8_t k = 0; k < 3; k++)
+					{
+						auto total = totals_[k].data();
+						auto partial = accumulator.totals[k].data();
+
+						for (std::size_t n = begin; n < end; n++)
+						{
+							total[n] += partial[n];
+							partial[n] = 0.0f;
+						}
+					}
+
+					accumulator.blocks[block] = 0;
+					dirtyBlocks_[block] = 1;
+				}
+			}
+		}
+		else
+		{
+			float* totals[3] = { totals_[0].data(), totals_[1].data(), totals_[2].data() };
+
+			for (auto& i : changed_)
+			{
+				auto& morph = morphs_[i];
+
+				const float* deltas[3] = { morph.deltas[0].data(), morph.deltas[1].data(), morph.deltas[2].data() };
+				kernel(morph.runs.data(), morph.runs.size() / 2, deltas, morph.weight - morph.applied, totals);
+
+				for (auto& block : morph.blocks)
+					dirtyBlocks_[block] = 1;
+			}
+		}
+
+		for (auto& morph : morphs_)
+			morph.applied = morph.weight;
+
+		if (invalidated_)
+		{
+			std::fill(dirtyBlocks_.begin(), dirtyBlocks_.end(), 1);
+			invalidated_ = false;
+		}
+
+		for (std::size_t block = 0; block < numBlocks;)
+		{
+			if (!dirtyBlocks_[block])
+			{
+				block++;
+				continue;
+			}
+
+			auto begin = block * MorphBlockSize;
+
+			while (block < numBlocks && dirtyBlocks_[block])
+				dirtyBlocks_[block++] = 0;
+
+			auto end = std::min(block * MorphBlockSize, numVertices_);
+
+			skinning.setVertexOffsets(begin, end, totals_[0].data() + begin, totals_[1].data() + begin, totals_[2].data() + begin);
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,1138 @@
+#include <octoon/mesh/mesh_skinning.h>
+#include <octoon/runtime/profiler.h>
+
+#include <cmath>
+#include <thread>
+#include <cstring>
+
+#if defined(OCTOON_BUILD_AVX) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#	define OCTOON_SKINNING_SIMD 1
+#	include <immintrin.h>
+#	if defined(__GNUC__) || defined(__clang__)
+#		define OCTOON_TARGET_SSE __attribute__((target("sse2")))
+#		define OCTOON_TARGET_AVX __attribute__((target("avx")))
+#	elif defined _MSC_VER
+#		include <intrin.h>
+#		define OCTOON_TARGET_SSE
+#		define OCTOON_TARGET_AVX
+#	endif
+#endif
+
+namespace octoon::mesh
+{
+	constexpr std::size_t SkinningLanes = 8;
+	constexpr std::size_t SkinningParallelThreshold = 4096;
+	constexpr std::size_t SkinningClusterSize = 256;
+
+	// deform types, in the order the slots of a cluster are sorted by
+	constexpr std::uint8_t SkinningBdef1 = 0;
+	constexpr std::uint8_t SkinningBdef2 = 1;
+	constexpr std::uint8_t SkinningBdef4 = 2;
+	constexpr std::uint8_t SkinningSdef = 3;
+
+	struct SkinningStreams
+	{
+		const float* positions[3];
+		const float* normals[3];
+		const float* weights[4];
+		const std::int32_t* bones[4];
+		const float* palette;
+		const float* dualQuats;
+		const float* sdef[9];
+		const std::uint32_t* order;
+
+		math::float3* outVertices;
+		math::float3* outNormals;
+	};
+
+	using SkinningKernel = void(*)(const SkinningStreams& s, std::size_t begin, std::size_t end) noexcept;
+
+	// Kernel for meshes without weights, the morphed positions and the source normals pass through.
+	static void
+	skinningCopy(const SkinningStreams& s, std::size_t begin, std::size_t end) noexcept
+	{
+		for (std::size_t i = begin; i < end; i++)
+		{
+			s.outVertices[s.order[i]].set(s.positions[0][i], s.positions[1][i], s.positions[2][i]);
+
+			if (s.outNormals)
+				s.outNormals[s.order[i]].set(s.normals[0][i], s.normals[1][i], s.normals[2][i]);
+		}
+	}
+
+	// Reference kernel, matching (joint * v) * w and ((float3x3)joint * n) * w of float4x4/float3x3.
+	// The influences past NumBones have zero weights, so leaving them out does not change the result.
+	template<std::uint8_t NumBones>
+	static void
+	skinningScalar(const SkinningStreams& s, std::size_t begin, std::size_t end) noexcept
+	{
+		for (std::size_t i = begin; i < end; i++)
+		{
+			float x = s.positions[0][i];
+			float y = s.positions[1][i];
+			float z = s.positions[2][i];
+
+			float nx = s.normals[0][i];
+			float ny = s.normals[1][i];
+			float nz = s.normals[2][i];
+
+			float vx = 0.0f, vy = 0.0f, vz = 0.0f;
+			float ox = 0.0f, oy = 0.0f, oz = 0.0f;
+
+			for (std::uint8_t j = 0; j < NumBones; j++)
+			{
+				auto w = s.weights[j][i];
+				auto m = s.palette + s.bones[j][i];
+
+				vx += (x * m[0] + y * m[1] + z * m[2] + m[3]) * w;
+				vy += (x * m[4] + y * m[5] + z * m[6] + m[7]) * w;
+				vz += (x * m[8] + y * m[9] + z * m[10] + m[11]) * w;
+
+				ox += (m[0] * nx + m[1] * ny + m[2] * nz) * w;
+				oy += (m[4] * nx + m[5] * ny + m[6] * nz) * w;
+				oz += (m[8] * nx + m[9] * ny + m[10] * nz) * w;
+			}
+
+			s.outVertices[s.order[i]].set(vx, vy, vz);
+
+			if (s.outNormals)
+				s.outNormals[s.order[i]].set(ox, oy, oz);
+		}
+	}
+
+	// Blends the joints as dual quaternions, each flipped into the hemisphere of the first one, and
+	// applies the normalized result as a rotation followed by a translation.
+	static void
+	skinningDualQuaternion(const SkinningStreams& s, std::size_t begin, std::size_t end) noexcept
+	{
+		for (std::size_t i = begin; i < end; i++)
+		{
+			auto q0 = s.dualQuats + s.bones[0][i] / 12 * 8;
+
+			float r[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+			float d[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+			for (std::uint8_t j = 0; j < 4; j++)
+			{
+				auto q = s.dualQuats + s.bones[j][i] / 12 * 8;
+				auto w = std::copysign(s.weights[j][i], q0[0] * q[0] + q0[1] * q[1] + q0[2] * q[2] + q0[3] * q[3]);
+
+				for (std::uint8_t k = 0; k < 4; k++)
+				{
+					r[k] += q[k] * w;
+					d[k] += q[k + 4] * w;
+				}
+			}
+
+			auto length = 1.0f / std::sqrt(std::max(r[0] * r[0] + r[1] * r[1] + r[2] * r[2] + r[3] * r[3], 1e-20f));
+
+			for (std::uint8_t k = 0; k < 4; k++)
+			{
+				r[k] *= length;
+				d[k] *= length;
+			}
+
+			// translation = 2 * (w * d.xyz - d.w * r.xyz + r.xyz x d.xyz)
+			auto tx = 2.0f * (r[3] * d[0] - d[3] * r[0] + r[1] * d[2] - r[2] * d[1]);
+			auto ty = 2.0f * (r[3] * d[1] - d[3] * r[1] + r[2] * d[0] - r[0] * d[2]);
+			auto tz = 2.0f * (r[3] * d[2] - d[3] * r[2] + r[0] * d[1] - r[1] * d[0]);
+
+			auto xx = r[0] * r[0], yy = r[1] * r[1], zz = r[2] * r[2];
+			auto xy = r[0] * r[1], xz = r[0] * r[2], yz = r[1] * r[2];
+			auto wx = r[3] * r[0], wy = r[3] * r[1], wz = r[3] * r[2];
+
+			float m[9] =
+			{
+				1.0f - 2.0f * (yy + zz), 2.0f * (xy - wz), 2.0f * (xz + wy),
+				2.0f * (xy + wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz - wx),
+				2.0f * (xz - wy), 2.0f * (yz + wx), 1.0f - 2.0f * (xx + yy)
+			};
+
+			float x = s.positions[0][i];
+			float y = s.positions[1][i];
+			float z = s.positions[2][i];
+
+			s.outVertices[s.order[i]].set(
+				m[0] * x + m[1] * y + m[2] * z + tx,
+				m[3] * x + m[4] * y + m[5] * z + ty,
+				m[6] * x + m[7] * y + m[8] * z + tz);
+
+			if (s.outNormals)
+			{
+				float nx = s.normals[0][i];
+				float ny = s.normals[1][i];
+				float nz = s.normals[2][i];
+
+				s.outNormals[s.order[i]].set(
+					m[0] * nx + m[1] * ny + m[2] * nz,
+					m[3] * nx + m[4] * ny + m[5] * nz,
+					m[6] * nx + m[7] * ny + m[8] * nz);
+			}
+		}
+	}
+
+	// Spherical deformation of a two bone vertex: the offset from the center C is rotated by the
+	// normalized blend of both joint rotations, and the center follows the blend of both joints applied
+	// to their rotation centers. The rotations are interpolated linearly instead of by slerp.
+	static void
+	skinningSdef(const SkinningStreams& s, std::size_t begin, std::size_t end) noexcept
+	{
+		for (std::size_t i = begin; i < end; i++)
+		{
+			auto w0 = s.weights[0][i];
+			auto w1 = s.weights[1][i];
+
+			auto m0 = s.palette + s.bones[0][i];
+			auto m1 = s.palette + s.bones[1][i];
+
+			auto q0 = s.dualQuats + s.bones[0][i] / 12 * 8;
+			auto q1 = s.dualQuats + s.bones[1][i] / 12 * 8;
+
+			auto w = std::copysign(w1, q0[0] * q1[0] + q0[1] * q1[1] + q0[2] * q1[2] + q0[3] * q1[3]);
+
+			float r[4];
+			for (std::uint8_t k = 0; k < 4; k++)
+				r[k] = q0[k] * w0 + q1[k] * w;
+
+			auto length = 1.0f / std::sqrt(std::max(r[0] * r[0] + r[1] * r[1] + r[2] * r[2] + r[3] * r[3], 1e-20f));
+
+			for (std::uint8_t k = 0; k < 4; k++)
+				r[k] *= length;
+
+			auto xx = r[0] * r[0], yy = r[1] * r[1], zz = r[2] * r[2];
+			auto xy = r[0] * r[1], xz = r[0] * r[2], yz = r[1] * r[2];
+			auto wx = r[3] * r[0], wy = r[3] * r[1], wz = r[3] * r[2];
+
+			float m[9] =
+			{
+				1.0f - 2.0f * (yy + zz), 2.0f * (xy - wz), 2.0f * (xz + wy),
+				2.0f * (xy + wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz - wx),
+				2.0f * (xz - wy), 2.0f * (yz + wx), 1.0f - 2.0f * (xx + yy)
+			};
+
+			float x = s.positions[0][i] - s.sdef[0][i];
+			float y = s.positions[1][i] - s.sdef[1][i];
+			float z = s.positions[2][i] - s.sdef[2][i];
+
+			float ax = s.sdef[3][i], ay = s.sdef[4][i], az = s.sdef[5][i];
+			float bx = s.sdef[6][i], by = s.sdef[7][i], bz = s.sdef[8][i];
+
+			s.outVertices[s.order[i]].set(
+				m[0] * x + m[1] * y + m[2] * z + (ax * m0[0] + ay * m0[1] + az * m0[2] + m0[3]) * w0 + (bx * m1[0] + by * m1[1] + bz * m1[2] + m1[3]) * w1,
+				m[3] * x + m[4] * y + m[5] * z + (ax * m0[4] + ay * m0[5] + az * m0[6] + m0[7]) * w0 + (bx * m1[4] + by * m1[5] + bz * m1[6] + m1[7]) * w1,
+				m[6] * x + m[7] * y + m[8] * z + (ax * m0[8] + ay * m0[9] + az * m0[10] + m0[11]) * w0 + (bx * m1[8] + by * m1[9] + bz * m1[10] + m1[11]) * w1);
+
+			if (s.outNormals)
+			{
+				float nx = s.normals[0][i];
+				float ny = s.normals[1][i];
+				float nz = s.normals[2][i];
+
+				s.outNormals[s.order[i]].set(
+					m[0] * nx + m[1] * ny + m[2] * nz,
+					m[3] * nx + m[4] * ny + m[5] * nz,
+					m[6] * nx + m[7] * ny + m[8] * nz);
+			}
+		}
+	}
+
+#if OCTOON_SKINNING_SIMD
+	template<std::uint8_t NumBones>
+	OCTOON_TARGET_SSE static void
+	skinningSSE(const SkinningStreams& s, std::size_t begin, std::size_t end) noexcept
+	{
+		alignas(16) float result[6][4];
+
+		for (std::size_t i = begin; i < end; i += 4)
+		{
+			auto x = _mm_loadu_ps(s.positions[0] + i);
+			auto y = _mm_loadu_ps(s.positions[1] + i);
+			auto z = _mm_loadu_ps(s.positions[2] + i);
+
+			auto nx = _mm_loadu_ps(s.normals[0] + i);
+			auto ny = _mm_loadu_ps(s.normals[1] + i);
+			auto nz = _mm_loadu_ps(s.normals[2] + i);
+
+			__m128 v[3] = { _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps() };
+			__m128 n[3] = { _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps() };
+
+			for (std::uint8_t j = 0; j < NumBones; j++)
+			{
+				auto w = _mm_loadu_ps(s.weights[j] + i);
+				auto bones = s.bones[j] + i;
+
+				for (std::uint8_t k = 0; k < 3; k++)
+				{
+					auto r0 = _mm_loadu_ps(s.palette + bones[0] + k * 4);
+					auto r1 = _mm_loadu_ps(s.palette + bones[1] + k * 4);
+					auto r2 = _mm_loadu_ps(s.palette + bones[2] + k * 4);
+					auto r3 = _mm_loadu_ps(s.palette + bones[3] + k * 4);
+					_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+					auto p = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, r0), _mm_mul_ps(y, r1)), _mm_mul_ps(z, r2)), r3);
+					auto q = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, nx), _mm_mul_ps(r1, ny)), _mm_mul_ps(r2, nz));
+
+					v[k] = _mm_add_ps(v[k], _mm_mul_ps(p, w));
+					n[k] = _mm_add_ps(n[k], _mm_mul_ps(q, w));
+				}
+			}
+
+			for (std::uint8_t k = 0; k < 3; k++)
+			{
+				_mm_store_ps(result[k], v[k]);
+				_mm_store_ps(result[k + 3], n[k]);
+			}
+
+			auto count = std::min<std::size_t>(4, end - i);
+
+			for (std::size_t lane = 0; lane < count; lane++)
+				s.outVertices[s.order[i + lane]].set(result[0][lane], result[1][lane], result[2][lane]);
+
+			if (s.outNormals)
+			{
+				for (std::size_t lane = 0; lane < count; lane++)
+					s.outNormals[s.order[i + lane]].set(result[3][lane], result[4][lane], result[5][lane]);
+			}
+		}
+	}
+
+	template<std::uint8_t NumBones>
+	OCTOON_TARGET_AVX static void
+	skinningAVX(const SkinningStreams& s, std::size_t begin, std::size_t end) noexcept
+	{
+		alignas(32) float result[6][8];
+
+		for (std::size_t i = begin; i < end; i += 8)
+		{
+			auto x = _mm256_loadu_ps(s.positions[0] + i);
+			auto y = _mm256_loadu_ps(s.positions[1] + i);
+			auto z = _mm256_loadu_ps(s.positions[2] + i);
+
+			auto nx = _mm256_loadu_ps(s.normals[0] + i);
+			auto ny = _mm256_loadu_ps(s.normals[1] + i);
+			auto nz = _mm256_loadu_ps(s.normals[2] + i);
+
+			__m256 v[3] = { _mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps() };
+			__m256 n[3] = { _mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps() };
+
+			for (std::uint8_t j = 0; j < NumBones; j++)
+			{
+				auto w = _mm256_loadu_ps(s.weights[j] + i);
+				auto bones = s.bones[j] + i;
+
+				for (std::uint8_t k = 0; k < 3; k++)
+				{
+					// rows of lanes 0-3 in the low half and lanes 4-7 in the high half, then a 4x4 transpose per half
+					auto r0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(s.palette + bones[0] + k * 4)), _mm_loadu_ps(s.palette + bones[4] + k * 4), 1);
+					auto r1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(s.palette + bones[1] + k * 4)), _mm_loadu_ps(s.palette + bones[5] + k * 4), 1);
+					auto r2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(s.palette + bones[2] + k * 4)), _mm_loadu_ps(s.palette + bones[6] + k * 4), 1);
+					auto r3 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(s.palette + bones[3] + k * 4)), _mm_loadu_ps(s.palette + bones[7] + k * 4), 1);
+
+					auto t0 = _mm256_unpacklo_ps(r0, r1);
+					auto t1 = _mm256_unpackhi_ps(r0, r1);
+					auto t2 = _mm256_unpacklo_ps(r2, r3);
+					auto t3 = _mm256_unpackhi_ps(r2, r3);
+
+					auto c0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+					auto c1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+					auto c2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+					auto c3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+
+					auto p = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, c0), _mm256_mul_ps(y, c1)), _mm256_mul_ps(z, c2)), c3);
+					auto q = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(c0, nx), _mm256_mul_ps(c1, ny)), _mm256_mul_ps(c2, nz));
+
+					v[k] = _mm256_add_ps(v[k], _mm256_mul_ps(p, w));
+					n[k] = _mm256_add_ps(n[k], _mm256_mul_ps(q, w));
+				}
+			}
+
+			for (std::uint8_t k = 0; k < 3; k++)
+			{
+				_mm256_store_ps(result[k], v[k]);
+				_mm256_store_ps(result[k + 3], n[k]);
+			}
+
+			auto count = std::min<std::size_t>(8, end - i);
+
+			for (std::size_t lane = 0; lane < count; lane++)
+				s.outVertices[s.order[i + lane]].set(result[0][lane], result[1][lane], result[2][lane]);
+
+			if (s.outNormals)
+			{
+				for (std::size_t lane = 0; lane < count; lane++)
+					s.outNormals[s.order[i + lane]].set(result[3][lane], result[4][lane], result[5][lane]);
+			}
+		}
+	}
+#endif
+
+	static void
+	selectKernels(SkinningInstructionSet instructionSet, SkinningMode mode, bool hasWeights, SkinningKernel kernels[4]) noexcept
+	{
+		if (!hasWeights)
+		{
+			std::fill(kernels, kernels + 4, skinningCopy);
+			return;
+		}
+
+		// outside of Sdef mode the SDEF vertices are blended as two bone vertices
+		kernels[SkinningBdef1] = skinningScalar<1>;
+		kernels[SkinningBdef2] = skinningScalar<2>;
+		kernels[SkinningBdef4] = skinningScalar<4>;
+		kernels[SkinningSdef] = skinningScalar<2>;
+
+#if OCTOON_SKINNING_SIMD
+		if (instructionSet == SkinningInstructionSet::AVX)
+		{
+			kernels[SkinningBdef1] = skinningAVX<1>;
+			kernels[SkinningBdef2] = kernels[SkinningSdef] = skinningAVX<2>;
+			kernels[SkinningBdef4] = skinningAVX<4>;
+		}
+		else if (instructionSet == SkinningInstructionSet::SSE)
+		{
+			kernels[SkinningBdef1] = skinningSSE<1>;
+			kernels[SkinningBdef2] = kernels[SkinningSdef] = skinningSSE<2>;
+			kernels[SkinningBdef4] = skinningSSE<4>;
+		}
+#endif
+
+		// a single bone is a rigid transform, for which the linear blend is already exact
+		if (mode == SkinningMode::DualQuaternion)
+			kernels[SkinningBdef2] = kernels[SkinningBdef4] = kernels[SkinningSdef] = skinningDualQuaternion;
+		else if (mode == SkinningMode::Sdef)
+			kernels[SkinningSdef] = skinningSdef;
+	}
+
+	static void
+	skinningCluster(const SkinningKernel kernels[4], const SkinningStreams& s, std::size_t begin, std::size_t end, const std::uint32_t* buckets) noexcept
+	{
+		kernels[SkinningBdef1](s, begin, buckets[0]);
+		kernels[SkinningBdef2](s, buckets[0], buckets[1]);
+		kernels[SkinningBdef4](s, buckets[1], buckets[2]);
+		kernels[SkinningSdef](s, buckets[2], end);
+	}
+
+	// Rotation of a 3x4 palette as a quaternion (x, y, z, w) followed by the dual part 0.5 * t * q.
+	static void
+	toDualQuaternion(const float* m, float* dq) noexcept
+	{
+		float x, y, z, w;
+
+		auto trace = m[0] + m[5] + m[10];
+		if (trace > 0.0f)
+		{
+			auto s = std::sqrt(trace + 1.0f) * 2.0f;
+			w = 0.25f * s;
+			x = (m[9] - m[6]) / s;
+			y = (m[2] - m[8]) / s;
+			z = (m[4] - m[1]) / s;
+		}
+		else if (m[0] > m[5] && m[0] > m[10])
+		{
+			auto s = std::sqrt(1.0f + m[0] - m[5] - m[10]) * 2.0f;
+			w = (m[9] - m[6]) / s;
+			x = 0.25f * s;
+			y = (m[1] + m[4]) / s;
+			z = (m[2] + m[8]) / s;
+		}
+		else if (m[5] > m[10])
+		{
+			auto s = std::sqrt(1.0f + m[5] - m[0] - m[10]) * 2.0f;
+			w = (m[2] - m[8]) / s;
+			x = (m[1] + m[4]) / s;
+			y = 0.25f * s;
+			z = (m[6] + m[9]) / s;
+		}
+		else
+		{
+			auto s = std::sqrt(1.0f + m[10] - m[0] - m[5]) * 2.0f;
+			w = (m[4] - m[1]) / s;
+			x = (m[2] + m[8]) / s;
+			y = (m[6] + m[9]) / s;
+			z = 0.25f * s;
+		}
+
+		auto length = 1.0f / std::sqrt(x * x + y * y + z * z + w * w);
+		x *= length;
+		y *= length;
+		z *= length;
+		w *= length;
+
+		auto tx = m[3];
+		auto ty = m[7];
+		auto tz = m[11];
+
+		dq[0] = x;
+		dq[1] = y;
+		dq[2] = z;
+		dq[3] = w;
+		dq[4] = 0.5f * (tx * w + ty * z - tz * y);
+		dq[5] = 0.5f * (ty * w + tz * x - tx * z);
+		dq[6] = 0.5f * (tz * w + tx * y - ty * x);
+		dq[7] = -0.5f * (tx * x + ty * y + tz * z);
+	}
+
+	// Bounds of a bind space box moved by a 3x4 palette, from its center and the absolute matrix applied to its half extent.
+	static math::AABB
+	transformBounds(const math::AABB& aabb, const float* m) noexcept
+	{
+		auto center = (aabb.min + aabb.max) * 0.5f;
+		auto extent = (aabb.max - aabb.min) * 0.5f;
+
+		math::float3 c(
+			center.x * m[0] + center.y * m[1] + center.z * m[2] + m[3],
+			center.x * m[4] + center.y * m[5] + center.z * m[6] + m[7],
+			center.x * m[8] + center.y * m[9] + center.z * m[10] + m[11]);
+
+		math::float3 e(
+			extent.x * std::abs(m[0]) + extent.y * std::abs(m[1]) + extent.z * std::abs(m[2]),
+			extent.x * std::abs(m[4]) + extent.y * std::abs(m[5]) + extent.z * std::abs(m[6]),
+			extent.x * std::abs(m[8]) + extent.y * std::abs(m[9]) + extent.z * std::abs(m[10]));
+
+		return math::AABB(c - e, c + e);
+	}
+
+	MeshSkinning::MeshSkinning() noexcept
+		: hasWeights_(false)
+		, invalidated_(true)
+		, numVertices_(0)
+		, numJoints_(0)
+		, numThreads_(std::max(1u, std::thread::hardware_concurrency()))
+		, mode_(SkinningMode::Linear)
+		, instructionSet_(getSupportedInstructionSet())
+		, frame_(1)
+	{
+	}
+
+	MeshSkinning::~MeshSkinning() noexcept
+	{
+	}
+
+	void
+	MeshSkinning::setMesh(const Mesh& mesh) noexcept
+	{
+		auto& vertices = mesh.getVertexArray();
+		auto& normals = mesh.getNormalArray();
+		auto& weights = mesh.getWeightArray();
+
+		hasWeights_ = !vertices.empty() && weights.size() == vertices.size();
+		numVertices_ = vertices.size();
+		numJoints_ = std::max<std::size_t>(1, mesh.getBindposes().size());
+
+		auto& sdefs = mesh.getSdefArray();
+		auto hasSdef = hasWeights_ && sdefs.size() == numVertices_;
+
+		// streams are padded to a whole number of SIMD lanes plus one, so the kernels never branch on the
+		// tail of a bucket and may read past it into the next one
+		auto numPadded = (numVertices_ + SkinningLanes - 1) / SkinningLanes * SkinningLanes + SkinningLanes;
+
+		for (std::uint8_t i = 0; i < 3; i++)
+		{
+			sources_[i].assign(numPadded, 0.0f);
+			offsets_[i].assign(numPadded, 0.0f);
+			normals_[i].assign(numPadded, 0.0f);
+		}
+
+		for (std::uint8_t i = 0; i < 4; i++)
+		{
+			weights_[i].assign(numPadded, 0.0f);
+			bones_[i].assign(numPadded, 0);
+		}
+
+		for (std::uint8_t i = 0; i < 9; i++)
+		{
+			if (hasSdef)
+				sdef_[i].assign(numPadded, 0.0f);
+			else
+				sdef_[i].clear();
+		}
+
+		for (std::size_t i = 0; i < numVertices_; i++)
+		{
+			sources_[0][i] = vertices[i].x;
+			sources_[1][i] = vertices[i].y;
+			sources_[2][i] = vertices[i].z;
+		}
+
+		if (normals.size() == numVertices_)
+		{
+			for (std::size_t i = 0; i < numVertices_; i++)
+			{
+				normals_[0][i] = normals[i].x;
+				normals_[1][i] = normals[i].y;
+				normals_[2][i] = normals[i].z;
+			}
+		}
+
+		std::vector<std::uint8_t> types(numVertices_, SkinningBdef1);
+
+		if (hasWeights_)
+		{
+			for (std::size_t i = 0; i < numVertices_; i++)
+			{
+				auto& blend = weights[i];
+
+				// influences after the first zero weight are ignored, as they always have been
+				for (std::uint8_t j = 0; j < 4; j++)
+				{
+					if (blend.weights[j] == 0.0f)
+						break;
+
+					auto bone = blend.bones[j] < numJoints_ ? blend.bones[j] : 0;
+
+					weights_[j][i] = blend.weights[j];
+					bones_[j][i] = static_cast<std::int32_t>(bone * 12);
+				}
+
+				if (weights_[2][i] != 0.0f)
+					types[i] = SkinningBdef4;
+				else if (weights_[1][i] != 0.0f)
+					types[i] = SkinningBdef2;
+
+				if (hasSdef && sdefs[i].enable && types[i] != SkinningBdef4)
+				{
+					auto& sdef = sdefs[i];
+
+					auto w0 = weights_[0][i];
+					auto w1 = weights_[1][i];
+
+					for (std::uint8_t k = 0; k < 3; k++)
+					{
+						auto rw = sdef.r0[k] * w0 + sdef.r1[k] * w1;
+						auto r0 = sdef.c[k] + sdef.r0[k] - rw;
+						auto r1 = sdef.c[k] + sdef.r1[k] - rw;
+
+						sdef_[k][i] = sdef.c[k];
+						sdef_[k + 3][i] = (sdef.c[k] + r0) * 0.5f;
+						sdef_[k + 6][i] = (sdef.c[k] + r1) * 0.5f;
+					}
+
+					types[i] = SkinningSdef;
+				}
+			}
+		}
+
+		auto numClusters = (numVertices_ + SkinningClusterSize - 1) / SkinningClusterSize;
+
+		order_.resize(numPadded);
+		slots_.resize(numVertices_);
+		clusterBuckets_.resize(numClusters * 3);
+
+		for (std::size_t cluster = 0; cluster < numClusters; cluster++)
+		{
+			auto begin = cluster * SkinningClusterSize;
+			auto end = std::min(begin + SkinningClusterSize, numVertices_);
+			auto slot = begin;
+
+			for (std::uint8_t type = 0; type < 4; type++)
+			{
+				for (std::size_t i = begin; i < end; i++)
+				{
+					if (types[i] == type)
+					{
+						order_[slot] = static_cast<std::uint32_t>(i);
+						slots_[i] = static_cast<std::uint32_t>(slot++);
+					}
+				}
+
+				if (type < 3)
+					clusterBuckets_[cluster * 3 + type] = static_cast<std::uint32_t>(slot);
+			}
+		}
+
+		for (std::size_t i = numVertices_; i < numPadded; i++)
+			order_[i] = static_cast<std::uint32_t>(i);
+
+		auto permute = [this](auto& stream)
+		{
+			auto copy = stream;
+			for (std::size_t i = 0; i < numVertices_; i++)
+				stream[i] = copy[order_[i]];
+		};
+
+		for (std::uint8_t i = 0; i < 3; i++)
+		{
+			permute(sources_[i]);
+			permute(normals_[i]);
+		}
+
+		for (std::uint8_t i = 0; i < 4; i++)
+		{
+			permute(weights_[i]);
+			permute(bones_[i]);
+		}
+
+		for (std::uint8_t i = 0; i < 9; i++)
+		{
+			if (hasSdef)
+				permute(sdef_[i]);
+		}
+
+		palette_.assign(numJoints_ * 12, 0.0f);
+		dualQuats_.assign(numJoints_ * 8, 0.0f);
+
+		for (std::size_t i = 0; i < numJoints_; i++)
+		{
+			palette_[i * 12 + 0] = 1.0f;
+			palette_[i * 12 + 5] = 1.0f;
+			palette_[i * 12 + 10] = 1.0f;
+			dualQuats_[i * 8 + 3] = 1.0f;
+		}
+
+		for (std::uint8_t i = 0; i < 3; i++)
+			positions_[i] = sources_[i];
+
+		frame_ = 1;
+		invalidated_ = true;
+		jointStamps_.assign(numJoints_, 0);
+
+		clusterStamps_.assign(numClusters, 0);
+		clusterModified_.assign(numClusters, 0);
+		clusterTouched_.assign(numClusters, 0);
+		clusterExact_.assign(numClusters, hasWeights_);
+		clusterBounds_.assign(numClusters, math::AABB());
+
+		clusterJoints_.clear();
+		clusterJointOffsets_.assign(1, 0);
+
+		std::vector<std::uint8_t> influenced(numJoints_, 0);
+
+		for (std::size_t cluster = 0; cluster < numClusters; cluster++)
+		{
+			auto first = clusterJoints_.size();
+			auto begin = cluster * SkinningClusterSize;
+			auto end = std::min(begin + SkinningClusterSize, numVertices_);
+
+			for (std::size_t i = begin; i < end && hasWeights_; i++)
+			{
+				float sum = 0.0f;
+
+				for (std::uint8_t j = 0; j < 4; j++)
+				{
+					sum += weights_[j][i];
+
+					auto joint = bones_[j][i] / 12;
+					if (weights_[j][i] > 0.0f && !influenced[joint])
+					{
+						influenced[joint] = 1;
+						clusterJoints_.push_back(joint);
+					}
+				}
+
+				// the per joint bounds only enclose convex blends, other vertices are bounded by their result
+				if (std::abs(sum - 1.0f) > 1e-3f || weights_[0][i] < 0.0f || weights_[1][i] < 0.0f || weights_[2][i] < 0.0f || weights_[3][i] < 0.0f)
+					clusterExact_[cluster] = 0;
+			}
+
+			for (auto k = first; k < clusterJoints_.size(); k++)
+				influenced[clusterJoints_[k]] = 0;
+
+			clusterJointOffsets_.push_back(static_cast<std::uint32_t>(clusterJoints_.size()));
+		}
+
+		clusterJointBounds_.assign(clusterJoints_.size(), math::AABB());
+
+		subsetClusters_.clear();
+		subsetClusterOffsets_.assign(1, 0);
+
+		std::vector<std::uint8_t> referenced(numClusters, 0);
+
+		for (std::size_t subset = 0; subset < mesh.getNumSubsets(); subset++)
+		{
+			for (auto& index : mesh.getIndicesArray(subset))
+			{
+				if (index < numVertices_)
+					referenced[index / SkinningClusterSize] = 1;
+			}
+
+			for (std::size_t cluster = 0; cluster < numClusters; cluster++)
+			{
+				if (referenced[cluster])
+				{
+					referenced[cluster] = 0;
+					subsetClusters_.push_back(static_cast<std::uint32_t>(cluster));
+				}
+			}
+
+			subsetClusterOffsets_.push_back(static_cast<std::uint32_t>(subsetClusters_.size()));
+		}
+	}
+
+	void
+	MeshSkinning::setJoints(const math::float4x4s& joints) noexcept
+	{
+		auto numJoints = std::min(joints.size(), numJoints_);
+
+		for (std::size_t i = 0; i < numJoints; i++)
+		{
+			auto& m = joints[i];
+
+			float rows[12] =
+			{
+				m.a1, m.b1, m.c1, m.d1,
+				m.a2, m.b2, m.c2, m.d2,
+				m.a3, m.b3, m.c3, m.d3
+			};
+
+			auto palette = palette_.data() + i * 12;
+			if (std::memcmp(palette, rows, sizeof(rows)) != 0)
+			{
+				std::memcpy(palette, rows, sizeof(rows));
+				toDualQuaternion(palette, dualQuats_.data() + i * 8);
+				jointStamps_[i] = frame_;
+			}
+		}
+	}
+
+	void
+	MeshSkinning::setMode(SkinningMode mode) noexcept
+	{
+		if (mode_ != mode)
+		{
+			mode_ = mode;
+			invalidated_ = true;
+		}
+	}
+
+	SkinningMode
+	MeshSkinning::getMode() const noexcept
+	{
+		return mode_;
+	}
+
+	void
+	MeshSkinning::setInstructionSet(SkinningInstructionSet instructionSet) noexcept
+	{
+		instructionSet_ = std::min(instructionSet, getSupportedInstructionSet());
+	}
+
+	SkinningInstructionSet
+	MeshSkinning::getInstructionSet() const noexcept
+	{
+		return instructionSet_;
+	}
+
+	void
+	MeshSkinning::setNumThreads(std::uint32_t numThreads) noexcept
+	{
+		numThreads_ = numThreads > 0 ? numThreads : std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	std::uint32_t
+	MeshSkinning::getNumThreads() const noexcept
+	{
+		return numThreads_;
+	}
+
+	std::size_t
+	MeshSkinning::getNumVertices() const noexcept
+	{
+		return numVertices_;
+	}
+
+	void
+	MeshSkinning::setVertex(std::size_t n, const math::float3& vertex) noexcept
+	{
+		assert(n < numVertices_);
+		auto slot = slots_[n];
+		positions_[0][slot] = vertex.x;
+		positions_[1][slot] = vertex.y;
+		positions_[2][slot] = vertex.z;
+
+		clusterModified_[n / SkinningClusterSize] = 1;
+		clusterTouched_[n / SkinningClusterSize] = 1;
+	}
+
+	math::float3
+	MeshSkinning::getVertex(std::size_t n) const noexcept
+	{
+		assert(n < numVertices_);
+		auto slot = slots_[n];
+		return math::float3(positions_[0][slot], positions_[1][slot], positions_[2][slot]);
+	}
+
+	void
+	MeshSkinning::resetVertices() noexcept
+	{
+		for (std::size_t cluster = 0; cluster < clusterModified_.size(); cluster++)
+		{
+			if (clusterModified_[cluster])
+			{
+				auto begin = cluster * SkinningClusterSize;
+				auto end = std::min(begin + SkinningClusterSize, numVertices_);
+
+				for (std::uint8_t i = 0; i < 3; i++)
+				{
+					auto source = sources_[i].data();
+					auto offset = offsets_[i].data();
+					auto position = positions_[i].data();
+
+					for (std::size_t n = begin; n < end; n++)
+						position[n] = source[n] + offset[n];
+				}
+
+				clusterModified_[cluster] = 0;
+				clusterTouched_[cluster] = 1;
+			}
+		}
+	}
+
+	void
+	MeshSkinning::setVertexOffsets(std::size_t begin, std::size_t end, const float* x, const float* y, const float* z) noexcept
+	{
+		assert(begin <= end && end <= numVertices_);
+
+		const float* offsets[3] = { x, y, z };
+
+		for (std::uint8_t i = 0; i < 3; i++)
+		{
+			auto source = sources_[i].data();
+			auto offset = offsets_[i].data();
+			auto position = positions_[i].data();
+
+			for (std::size_t n = begin; n < end; n++)
+			{
+				auto slot = slots_[n];
+				offset[slot] = offsets[i][n - begin];
+				position[slot] = source[slot] + offset[slot];
+			}
+		}
+
+		for (std::size_t cluster = begin / SkinningClusterSize; cluster * SkinningClusterSize < end; cluster++)
+			clusterTouched_[cluster] = 1;
+	}
+
+	void
+	MeshSkinning::skinning(math::float3s& vertices, math::float3s& normals) const noexcept
+	{
+		if (numVertices_ == 0)
+			return;
+
+		OCTOON_PROFILE_CATEGORY("MeshSkinning::skinning", "animation");
+
+		vertices.resize(numVertices_);
+
+		bool hasNormal = !normals.empty();
+		if (hasNormal)
+			normals.resize(numVertices_);
+
+		SkinningStreams streams;
+		this->initStreams(streams, vertices, normals);
+
+		SkinningKernel kernels[4];
+		selectKernels(instructionSet_, mode_, hasWeights_, kernels);
+
+		auto numClusters = static_cast<std::int32_t>(clusterStamps_.size());
+		auto numThreads = numVertices_ >= SkinningParallelThreshold ? static_cast<std::int32_t>(numThreads_) : 1;
+
+#		pragma omp parallel for num_threads(numThreads) schedule(static)
+		for (std::int32_t i = 0; i < numClusters; i++)
+		{
+			auto begin = i * SkinningClusterSize;
+			auto end = std::min(begin + SkinningClusterSize, numVertices_);
+			skinningCluster(kernels, streams, begin, end, clusterBuckets_.data() + i * 3);
+		}
+	}
+
+	bool
+	MeshSkinning::update(math::float3s& vertices, math::float3s& normals) noexcept
+	{
+		if (numVertices_ == 0)
+			return false;
+
+		OCTOON_PROFILE_CATEGORY("MeshSkinning::update", "animation");
+
+		bool hasNormal = !normals.empty();
+		if (vertices.size() != numVertices_ || (hasNormal && normals.size() != numVertices_))
+			invalidated_ = true;
+
+		vertices.resize(numVertices_);
+		if (hasNormal)
+			normals.resize(numVertices_);
+
+		dirtyClusters_.clear();
+
+		for (std::size_t cluster = 0; cluster < clusterStamps_.size(); cluster++)
+		{
+			bool dirty = invalidated_ || clusterTouched_[cluster];
+
+			for (auto k = clusterJointOffsets_[cluster]; k < clusterJointOffsets_[cluster + 1] && !dirty; k++)
+				dirty = jointStamps_[clusterJoints_[k]] > clusterStamps_[cluster];
+
+			if (dirty)
+				dirtyClusters_.push_back(cluster);
+		}
+
+		if (dirtyClusters_.empty())
+			return false;
+
+		SkinningStreams streams;
+		this->initStreams(streams, vertices, normals);
+
+		SkinningKernel kernels[4];
+		selectKernels(instructionSet_, mode_, hasWeights_, kernels);
+
+		auto numDirty = static_cast<std::int32_t>(dirtyClusters_.size());
+		auto numThreads = dirtyClusters_.size() * SkinningClusterSize >= SkinningParallelThreshold ? static_cast<std::int32_t>(numThreads_) : 1;
+
+#		pragma omp parallel for num_threads(numThreads) schedule(static)
+		for (std::int32_t i = 0; i < numDirty; i++)
+		{
+			auto cluster = dirtyClusters_[i];
+			auto begin = cluster * SkinningClusterSize;
+			auto end = std::min(begin + SkinningClusterSize, numVertices_);
+
+			skinningCluster(kernels, streams, begin, end, clusterBuckets_.data() + cluster * 3);
+
+			this->updateClusterBounds(cluster, invalidated_ || clusterTouched_[cluster], vertices.data());
+
+			clusterStamps_[cluster] = frame_;
+			clusterTouched_[cluster] = 0;
+		}
+
+		invalidated_ = false;
+		frame_++;
+
+		return true;
+	}
+
+	void
+	MeshSkinning::invalidate() noexcept
+	{
+		invalidated_ = true;
+	}
+
+	void
+	MeshSkinning::computeBoundingBoxes(std::vector<math::BoundingBox>& boundingBoxes) const noexcept
+	{
+		auto numSubsets = subsetClusterOffsets_.size() - 1;
+
+		boundingBoxes.resize(numSubsets);
+
+		for (std::size_t subset = 0; subset < numSubsets; subset++)
+		{
+			math::AABB aabb;
+			for (auto k = subsetClusterOffsets_[subset]; k < subsetClusterOffsets_[subset + 1]; k++)
+				aabb.encapsulate(clusterBounds_[subsetClusters_[k]]);
+
+			if (aabb.empty())
+				boundingBoxes[subset].reset();
+			else
+				boundingBoxes[subset].set(aabb);
+		}
+	}
+
+	void
+	MeshSkinning::initStreams(SkinningStreams& streams, math::float3s& vertices, math::float3s& normals) const noexcept
+	{
+		streams.palette = palette_.data();
+		streams.dualQuats = dualQuats_.data();
+		streams.order = order_.data();
+		streams.outVertices = vertices.data();
+		streams.outNormals = normals.empty() ? nullptr : normals.data();
+
+		for (std::uint8_t i = 0; i < 3; i++)
+		{
+			streams.positions[i] = positions_[i].data();
+			streams.normals[i] = normals_[i].data();
+		}
+
+		for (std::uint8_t i = 0; i < 4; i++)
+		{
+			streams.weights[i] = weights_[i].data();
+			streams.bones[i] = bones_[i].data();
+		}
+
+		for (std::uint8_t i = 0; i < 9; i++)
+			streams.sdef[i] = sdef_[i].data();
+	}
+
+	void
+	MeshSkinning::updateClusterBounds(std::size_t cluster, bool refresh, const math::float3* vertices) noexcept
+	{
+		auto begin = cluster * SkinningClusterSize;
+		auto end = std::min(begin + SkinningClusterSize, numVertices_);
+
+		auto& bounds = clusterBounds_[cluster];
+		bounds.reset();
+
+		// only the linear blends stay inside the joint bounds, dual quaternion and SDEF vertices do not
+		bool exact = clusterExact_[cluster];
+		if (mode_ == SkinningMode::DualQuaternion)
+			exact = exact && clusterBuckets_[cluster * 3] == end;
+		else if (mode_ == SkinningMode::Sdef)
+			exact = exact && clusterBuckets_[cluster * 3 + 2] == end;
+
+		if (!exact)
+		{
+			for (std::size_t i = begin; i < end; i++)
+				bounds.encapsulate(vertices[i]);
+			return;
+		}
+
+		auto first = clusterJointOffsets_[cluster];
+		auto last = clusterJointOffsets_[cluster + 1];
+
+		// the bind space bounds only change with the source positions, which morphs and cloth overwrite
+		if (refresh)
+		{
+			for (auto k = first; k < last; k++)
+				clusterJointBounds_[k].reset();
+
+			for (std::size_t i = begin; i < end; i++)
+			{
+				math::float3 v(positions_[0][i], positions_[1][i], positions_[2][i]);
+
+				for (std::uint8_t j = 0; j < 4; j++)
+				{
+					if (weights_[j][i] > 0.0f)
+					{
+						auto joint = static_cast<std::uint32_t>(bones_[j][i] / 12);
+						for (auto k = first; k < last; k++)
+						{
+							if (clusterJoints_[k] == joint)
+							{
+								clusterJointBounds_[k].encapsulate(v);
+								break;
+							}
+						}
+					}
+				}
+			}
+		}
+
+		for (auto k = first; k < last; k++)
+		{
+			if (!clusterJointBounds_[k].empty())
+				bounds.encapsulate(transformBounds(clusterJointBounds_[k], palette_.data() + clusterJoints_[k] * 12));
+		}
+	}
+
+	SkinningInstructionSet
+	MeshSkinning::getSupportedInstructionSet() noexcept
+	{
+#if OCTOON_SKINNING_SIMD
+#	if defined(__GNUC__) || defined(__clang__)
+		static const auto instructionSet = __builtin_cpu_supports("avx") ? SkinningInstructionSet::AVX : (__builtin_cpu_supports("sse2") ? SkinningInstructionSet::SSE : SkinningInstructionSet::Scalar);
+#	elif defined _MSC_VER
+		static const auto instructionSet = []()
+		{
+			int data[4];
+			__cpuid(data, 1);
+
+			bool osxsave = (data[2] & (1 << 27)) != 0;
+			bool avx = (data[2] & (1 << 28)) != 0;
+			bool sse2 = (data[3] & (1 << 26)) != 0;
+
+			if (osxsave && avx && (_xgetbv(0) & 0x6) == 0x6)
+				return SkinningInstructionSet::AVX;
+
+			return sse2 ? SkinningInstructionSet::SSE : SkinningInstructionSet::Scalar;
+		}();
+#	endif
+		return instructionSet;
+#else
+		return SkinningInstructionSet::Scalar;
+#endif
+	}
+}
@@ -3,6 +3,7 @@
 #include "physx_context.h"
 
 #include <PxPhysicsAPI.h>
+#include <octoon/runtime/profiler.h>
 
 namespace octoon
 {
@@ -119,12 +120,14 @@ namespace octoon
 
 		void PhysxScene::simulate(float time)
 		{
+			OCTOON_PROFILE_CATEGORY("PhysxScene::simulate", "physics");
 			px_scene->simulate(time);
 		}
 
 		void
 		PhysxScene::fetchResults()
 		{
+			OCTOON_PROFILE_CATEGORY("PhysxScene::fetchResults", "physics");
 			px_scene->fetchResults(true);
 		}
 
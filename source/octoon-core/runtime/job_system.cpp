@@ -0,0 +1,299 @@
+#include <octoon/runtime/job_system.h>
+
+#include <algorithm>
+
+namespace octoon
+{
+	namespace runtime
+	{
+		namespace
+		{
+			thread_local const JobSystem* current_system_ = nullptr;
+			thread_local std::size_t current_queue_ = 0;
+		}
+
+		Job::Job(std::function<void()>&& task) noexcept
+			: task_(std::move(task))
+			, dependencies_(0)
+			, done_(false)
+		{
+		}
+
+		Job::~Job() noexcept
+		{
+		}
+
+		bool
+		Job::done() const noexcept
+		{
+			return done_.load(std::memory_order_acquire);
+		}
+
+		const std::exception_ptr&
+		Job::exception() const noexcept
+		{
+			return exception_;
+		}
+
+		JobSystem::JobSystem() noexcept
+			: stop_(false)
+			, pending_(0)
+		{
+			queues_.push_back(std::make_unique<Queue>());
+		}
+
+		JobSystem::JobSystem(std::uint32_t num_threads) noexcept
+			: JobSystem()
+		{
+			this->start(num_threads);
+		}
+
+		JobSystem::~JobSystem() noexcept
+		{
+			this->stop();
+		}
+
+		void
+		JobSystem::set_num_threads(std::uint32_t num_threads) noexcept
+		{
+			if (num_threads != this->num_threads())
+			{
+				this->stop();
+				this->start(num_threads);
+			}
+		}
+
+		std::uint32_t
+		JobSystem::num_threads() const noexcept
+		{
+			return static_cast<std::uint32_t>(threads_.size());
+		}
+
+		std::uint32_t
+		JobSystem::hardware_threads() noexcept
+		{
+			return std::max(1u, std::thread::hardware_concurrency());
+		}
+
+		JobHandle
+		JobSystem::schedule(std::function<void()> task, const JobHandles& dependencies) noexcept
+		{
+			auto job = std::make_shared<Job>(std::move(task));
+			job->dependencies_ = 1;
+
+			for (auto& it : dependencies)
+			{
+				if (!it)
+					continue;
+
+				std::lock_guard<std::mutex> guard(it->mutex_);
+				if (!it->done())
+				{
+					it->continuations_.push_back(job);
+					job->dependencies_++;
+				}
+			}
+
+			if (--job->dependencies_ == 0)
+				this->submit(job);
+
+			return job;
+		}
+
+		void
+		JobSystem::wait(const JobHandle& job) noexcept
+		{
+			auto index = this->queue_index();
+
+			while (job && !job->done())
+			{
+				if (!this->run_one(index))
+					std::this_thread::yield();
+			}
+		}
+
+		void
+		JobSystem::wait(const JobHandles& jobs) noexcept
+		{
+			for (auto& it : jobs)
+				this->wait(it);
+		}
+
+		void
+		JobSystem::parallel_for(std::size_t count, std::size_t grain, const std::function<void(std::size_t begin, std::size_t end)>& func) noexcept(false)
+		{
+			grain = std::max<std::size_t>(grain, 1);
+
+			if (threads_.empty() || count <= grain)
+			{
+				for (std::size_t begin = 0; begin < count; begin += grain)
+					func(begin, std::min(begin + grain, count));
+			}
+			else
+			{
+				JobHandles jobs;
+				jobs.reserve((count + grain - 1) / grain);
+
+				for (std::size_t begin = 0; begin < count; begin += grain)
+				{
+					auto end = std::min(begin + grain, count);
+					jobs.push_back(this->schedule([&func, begin, end]() { func(begin, end); }));
+				}
+
+				this->wait(jobs);
+
+				for (auto& it : jobs)
+				{
+					if (it->exception())
+						std::rethrow_exception(it->exception());
+				}
+			}
+		}
+
+		void
+		JobSystem::start(std::uint32_t num_threads) noexcept
+		{
+			stop_ = false;
+
+			while (queues_.size() < num_threads + 1)
+				queues_.push_back(std::make_unique<Queue>());
+
+			for (std::size_t i = 1; i <= num_threads; i++)
+				threads_.emplace_back(&JobSystem::worker, this, i);
+		}
+
+		void
+		JobSystem::stop() noexcept
+		{
+			{
+				std::lock_guard<std::mutex> guard(sleep_mutex_);
+				stop_ = true;
+			}
+
+			sleep_.notify_all();
+
+			for (auto& it : threads_)
+				it.join();
+
+			threads_.clear();
+			queues_.resize(1);
+		}
+
+		void
+		JobSystem::submit(const JobHandle& job) noexcept
+		{
+			pending_++;
+
+			{
+				auto& queue = *queues_[this->queue_index()];
+				std::lock_guard<std::mutex> guard(queue.mutex);
+				queue.jobs.push_back(job);
+			}
+
+			{
+				std::lock_guard<std::mutex> guard(sleep_mutex_);
+			}
+
+			sleep_.notify_one();
+		}
+
+		void
+		JobSystem::execute(const JobHandle& job) noexcept
+		{
+			try
+			{
+				job->task_();
+			}
+			catch (...)
+			{
+				job->exception_ = std::current_exception();
+			}
+
+			job->task_ = nullptr;
+
+			JobHandles continuations;
+
+			{
+				std::lock_guard<std::mutex> guard(job->mutex_);
+				job->done_.store(true, std::memory_order_release);
+				continuations.swap(job->continuations_);
+			}
+
+			for (auto& it : continuations)
+			{
+				if (--it->dependencies_ == 0)
+					this->submit(it);
+			}
+		}
+
+		bool
+		JobSystem::run_one(std::size_t index) noexcept
+		{
+			auto job = this->pop(index);
+			if (job)
+			{
+				this->execute(job);
+				return true;
+			}
+
+			return false;
+		}
+
+		JobHandle
+		JobSystem::pop(std::size_t index) noexcept
+		{
+			JobHandle job;
+
+			{
+				auto& queue = *queues_[index];
+				std::lock_guard<std::mutex> guard(queue.mutex);
+				if (!queue.jobs.empty())
+				{
+					job = std::move(queue.jobs.back());
+					queue.jobs.pop_back();
+				}
+			}
+
+			for (std::size_t i = 1; i < queues_.size() && !job; i++)
+			{
+				auto& queue = *queues_[(index + i) % queues_.size()];
+				std::lock_guard<std::mutex> guard(queue.mutex);
+				if (!queue.jobs.empty())
+				{
+					job = std::move(queue.jobs.front());
+					queue.jobs.pop_front();
+				}
+			}
+
+			if (job)
+				pending_--;
+
+			return job;
+		}
+
+		void
+		JobSystem::worker(std::size_t index) noexcept
+		{
+			current_system_ = this;
+			current_queue_ = index;
+
+			for (;;)
+			{
+				if (this->run_one(index))
+					continue;
+
+				std::unique_lock<std::mutex> guard(sleep_mutex_);
+				sleep_.wait(guard, [this]() { return stop_ || pending_ > 0; });
+
+				if (stop_ && pending_ == 0)
+					break;
+			}
+		}
+
+		std::size_t
+		JobSystem::queue_index() const noexcept
+		{
+			return current_system_ == this ? current_queue_ : 0;
+		}
+	}
+}
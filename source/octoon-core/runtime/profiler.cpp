@@ -0,0 +1,240 @@
+#include <octoon/runtime/profiler.h>
+
+#include <cstdio>
+#include <fstream>
+
+namespace octoon
+{
+	namespace runtime
+	{
+		namespace
+		{
+			void write_json_string(std::ostream& stream, const char* str) noexcept
+			{
+				stream << '"';
+
+				for (auto it = str; it && *it; ++it)
+				{
+					auto ch = static_cast<unsigned char>(*it);
+					switch (ch)
+					{
+					case '"': stream << "\\\""; break;
+					case '\\': stream << "\\\\"; break;
+					case '\n': stream << "\\n"; break;
+					case '\r': stream << "\\r"; break;
+					case '\t': stream << "\\t"; break;
+					default:
+						if (ch < 0x20)
+						{
+							char escape[8];
+							std::snprintf(escape, sizeof(escape), "\\u%04x", ch);
+							stream << escape;
+						}
+						else
+						{
+							stream << *it;
+						}
+					}
+				}
+
+				stream << '"';
+			}
+
+			void write_microseconds(std::ostream& stream, std::int64_t nanoseconds) noexcept
+			{
+				char buffer[32];
+				std::snprintf(buffer, sizeof(buffer), "%lld.%03lld", static_cast<long long>(nanoseconds / 1000), static_cast<long long>(nanoseconds % 1000));
+				stream << buffer;
+			}
+		}
+
+		Profiler::Profiler() noexcept
+			: enable_(false)
+			, epoch_(std::chrono::steady_clock::now())
+		{
+		}
+
+		Profiler::~Profiler() noexcept
+		{
+		}
+
+		Profiler*
+		Profiler::instance() noexcept
+		{
+			static Profiler profiler;
+			return &profiler;
+		}
+
+		void
+		Profiler::set_enable(bool enable) noexcept
+		{
+			enable_.store(enable, std::memory_order_relaxed);
+		}
+
+		bool
+		Profiler::enable() const noexcept
+		{
+			return enable_.load(std::memory_order_relaxed);
+		}
+
+		void
+		Profiler::begin(const char* name, const char* category) noexcept
+		{
+			auto& buffer = this->local();
+			std::lock_guard<std::mutex> guard(buffer.mutex);
+
+			Zone zone;
+			zone.name = name;
+			zone.category = category;
+			zone.start = this->now();
+			zone.duration = -1;
+			zone.depth = static_cast<std::uint32_t>(buffer.stack.size());
+
+			buffer.stack.push_back(buffer.zones.size());
+			buffer.zones.push_back(zone);
+		}
+
+		void
+		Profiler::end() noexcept
+		{
+			auto time = this->now();
+			auto& buffer = this->local();
+			std::lock_guard<std::mutex> guard(buffer.mutex);
+
+			if (buffer.stack.empty())
+				return;
+
+			auto index = buffer.stack.back();
+			buffer.stack.pop_back();
+
+			if (index < buffer.zones.size())
+				buffer.zones[index].duration = time - buffer.zones[index].start;
+		}
+
+		void
+		Profiler::set_thread_name(std::string_view name) noexcept
+		{
+			auto& buffer = this->local();
+			std::lock_guard<std::mutex> guard(buffer.mutex);
+			buffer.name = name;
+		}
+
+		void
+		Profiler::clear() noexcept
+		{
+			std::lock_guard<std::mutex> guard(mutex_);
+
+			for (auto& it : threads_)
+			{
+				std::lock_guard<std::mutex> lock(it->mutex);
+
+				// Open zones keep their slot so the matching end() still finds them; their indices are rebased.
+				std::vector<Zone> zones;
+				for (auto& index : it->stack)
+				{
+					auto zone = it->zones[index];
+					index = zones.size();
+					zones.push_back(zone);
+				}
+
+				it->zones = std::move(zones);
+			}
+		}
+
+		std::size_t
+		Profiler::num_zones() const noexcept
+		{
+			std::lock_guard<std::mutex> guard(mutex_);
+
+			std::size_t count = 0;
+			for (auto& it : threads_)
+			{
+				std::lock_guard<std::mutex> lock(it->mutex);
+				count += it->zones.size() - it->stack.size();
+			}
+
+			return count;
+		}
+
+		bool
+		Profiler::save_chrome_trace(std::ostream& stream) const noexcept
+		{
+			std::lock_guard<std::mutex> guard(mutex_);
+
+			bool first = true;
+			auto separator = [&]()
+			{
+				stream << (first ? "\n" : ",\n");
+				first = false;
+			};
+
+			stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+			for (auto& it : threads_)
+			{
+				std::lock_guard<std::mutex> lock(it->mutex);
+
+				if (!it->name.empty())
+				{
+					separator();
+					stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << it->id << ",\"args\":{\"name\":";
+					write_json_string(stream, it->name.c_str());
+					stream << "}}";
+				}
+
+				for (auto& zone : it->zones)
+				{
+					if (zone.duration < 0)
+						continue;
+
+					separator();
+					stream << "{\"name\":";
+					write_json_string(stream, zone.name);
+					stream << ",\"cat\":";
+					write_json_string(stream, zone.category);
+					stream << ",\"ph\":\"X\",\"ts\":";
+					write_microseconds(stream, zone.start);
+					stream << ",\"dur\":";
+					write_microseconds(stream, zone.duration);
+					stream << ",\"pid\":0,\"tid\":" << it->id << "}";
+				}
+			}
+
+			stream << "\n]}\n";
+
+			return stream.good();
+		}
+
+		bool
+		Profiler::save_chrome_trace(const std::string& path) const noexcept
+		{
+			std::ofstream stream(path, std::ios::out | std::ios::trunc);
+			if (!stream)
+				return false;
+
+			return this->save_chrome_trace(stream);
+		}
+
+		Profiler::ThreadBuffer&
+		Profiler::local() noexcept
+		{
+			thread_local std::shared_ptr<ThreadBuffer> buffer;
+			if (!buffer)
+			{
+				buffer = std::make_shared<ThreadBuffer>();
+
+				std::lock_guard<std::mutex> guard(mutex_);
+				buffer->id = static_cast<std::uint32_t>(threads_.size());
+				threads_.push_back(buffer);
+			}
+
+			return *buffer;
+		}
+
+		std::int64_t
+		Profiler::now() const noexcept
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch_).count();
+		}
+	}
+}
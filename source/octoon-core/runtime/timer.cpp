@@ -27,22 +27,24 @@ namespace octoon
 		{
 		}
 
+		// Wall-clock time from a monotonic source. std::clock() measures CPU time of the process, which stalls
+		// while the thread waits on the GPU or vsync and runs ahead when several threads are busy.
 		float
 		Timer::elapsed() const noexcept
 		{
-			return float(std::clock()) / CLOCKS_PER_SEC - startTime_;
+			return std::chrono::duration<float>(std::chrono::steady_clock::now() - start_).count();
 		}
 
 		float
 		Timer::elapsed_max() const noexcept
 		{
-			return float(std::numeric_limits<std::clock_t>::max()) / float(CLOCKS_PER_SEC) - startTime_;
+			return std::chrono::duration<float>(std::chrono::steady_clock::duration::max()).count();
 		}
 
 		float
 		Timer::elapsed_min() const noexcept
 		{
-			return 1.0f / float(CLOCKS_PER_SEC);
+			return std::chrono::duration<float>(std::chrono::steady_clock::duration(1)).count();
 		}
 
 		float
@@ -84,20 +86,22 @@ namespace octoon
 		void
 		Timer::reset() noexcept
 		{
-			startTime_ = (float)std::clock() / (float)CLOCKS_PER_SEC;
+			start_ = std::chrono::steady_clock::now();
+			startTime_ = std::chrono::duration<float>(start_.time_since_epoch()).count();
+			last_time_ = 0;
 		}
 
 		void
 		Timer::sleep_for_fps(float fps) const noexcept
 		{
-			double first = CLOCKS_PER_SEC / fps;
-			double second = this->delta() * CLOCKS_PER_SEC;
+			double first = 1e6 / fps;
+			double second = this->delta() * 1e6;
 			if (first > second)
 			{
-				int sleep = (int)std::round(first - second);
+				auto sleep = static_cast<std::int64_t>(std::round(first - second));
 				if (sleep > 0)
 				{
-					std::this_thread::sleep_for(std::chrono::milliseconds(sleep));
+					std::this_thread::sleep_for(std::chrono::microseconds(sleep));
 				}
 			}
 		}
@@ -105,7 +109,10 @@ namespace octoon
 		void
 		Timer::update() noexcept
 		{
-			frame_time_ = this->elapsed() - last_time_;
+			auto now = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+
+			frame_time_ = static_cast<float>(now - last_time_);
+			last_time_ = now;
 
 			num_frames_++;
 			accumulate_time_ += frame_time_;
@@ -134,8 +141,6 @@ namespace octoon
 					current_fps_index_ = 0;
 				}
 			}
-
-			last_time_ = (float)std::clock() / (float)CLOCKS_PER_SEC - startTime_;
 		}
 	}
 }
\ No newline at end of file
@@ -1,13 +1,20 @@
 #include <octoon/video/forward_buffer.h>
 #include <octoon/video/renderer.h>
+#include <cstring>
 
 namespace octoon::video
 {
 	ForwardBuffer::ForwardBuffer() noexcept
+		: numVertices_(0)
+		, numIndices_(0)
+		, numTexcoords_{ 0, 0 }
+		, topologyVersion_(0)
+		, dynamicIndex_(0)
 	{
 	}
 
 	ForwardBuffer::ForwardBuffer(const std::shared_ptr<mesh::Mesh>& mesh) noexcept(false)
+		: ForwardBuffer()
 	{
 		this->setMesh(mesh);
 	}
@@ -32,6 +39,24 @@ namespace octoon::video
 		return this->mesh_;
 	}
 
+	void
+	ForwardBuffer::update() noexcept(false)
+	{
+		if (this->mesh_)
+		{
+			if (this->isLayoutChanged(*this->mesh_))
+				this->updateData(this->mesh_);
+			else
+				this->updateVertices(*this->mesh_);
+		}
+	}
+
+	bool
+	ForwardBuffer::isDynamic() const noexcept
+	{
+		return !this->dynamicBuffers_.empty();
+	}
+
 	const hal::GraphicsDataPtr&
 	ForwardBuffer::getVertexBuffer() const noexcept
 	{
@@ -62,75 +87,225 @@ namespace octoon::video
 		return this->startIndice_[n];
 	}
 
+	bool
+	ForwardBuffer::isLayoutChanged(const mesh::Mesh& mesh) const noexcept
+	{
+		// replaced indices or texture coordinates keep their sizes more often than not
+		if (this->topologyVersion_ != mesh.getTopologyVersion())
+			return true;
+
+		if (this->numVertices_ != mesh.getVertexArray().size())
+			return true;
+
+		if (this->numTexcoords_[0] != mesh.getTexcoordArray(0).size() || this->numTexcoords_[1] != mesh.getTexcoordArray(1).size())
+			return true;
+
+		if (this->startIndice_.size() != mesh.getNumSubsets())
+			return true;
+
+		std::size_t streamOffset = 0;
+		for (std::size_t i = 0; i < mesh.getNumSubsets(); i++)
+		{
+			if (this->startIndice_[i] != streamOffset)
+				return true;
+			streamOffset += mesh.getIndicesArray(i).size();
+		}
+
+		return this->numIndices_ != streamOffset;
+	}
+
+	std::vector<float>
+	ForwardBuffer::createVertexData(const mesh::Mesh& mesh) const noexcept
+	{
+		auto& vertices = mesh.getVertexArray();
+		auto& texcoord = mesh.getTexcoordArray();
+		auto& texcoord1 = mesh.getTexcoordArray(1);
+		auto& normals = mesh.getNormalArray();
+
+		hal::GraphicsInputLayoutDesc inputLayout;
+		inputLayout.addVertexLayout(hal::GraphicsVertexLayout(0, "POSITION", 0, hal::GraphicsFormat::R32G32B32SFloat));
+		inputLayout.addVertexLayout(hal::GraphicsVertexLayout(0, "NORMAL", 0, hal::GraphicsFormat::R32G32B32SFloat));
+		inputLayout.addVertexLayout(hal::GraphicsVertexLayout(0, "TEXCOORD", 0, hal::GraphicsFormat::R32G32SFloat));
+		inputLayout.addVertexLayout(hal::GraphicsVertexLayout(0, "TEXCOORD", 1, hal::GraphicsFormat::R32G32SFloat));
+
+		inputLayout.addVertexBinding(hal::GraphicsVertexBinding(0, inputLayout.getVertexSize()));
+
+		auto vertexSize = inputLayout.getVertexSize() / sizeof(float);
+
+		std::vector<float> vertexBuffer(vertices.size() * vertexSize);
+
+		auto dst = vertexBuffer.data();
+		auto numVertices = vertices.size();
+
+		for (std::size_t i = 0; i < numVertices; i++, dst += vertexSize)
+		{
+			if (!vertices.empty())
+			{
+				auto& v = vertices[i];
+				dst[0] = v.x;
+				dst[1] = v.y;
+				dst[2] = v.z;
+			}
+
+			if (!normals.empty())
+			{
+				auto& n = normals[i];
+				dst[3] = n.x;
+				dst[4] = n.y;
+				dst[5] = n.z;
+			}
+
+			if (!texcoord.empty())
+			{
+				auto& uv = texcoord[i];
+				dst[6] = uv.x;
+				dst[7] = uv.y;
+			}
+
+			if (!texcoord1.empty())
+			{
+				auto& uv = texcoord1[i];
+				dst[8] = uv.x;
+				dst[9] = uv.y;
+			}
+		}
+
+		return vertexBuffer;
+	}
+
 	void
-	ForwardBuffer::updateData(const std::shared_ptr<mesh::Mesh>& mesh) noexcept(false)
+	ForwardBuffer::updateVertices(const mesh::Mesh& mesh) noexcept(false)
 	{
-		if (mesh)
+		auto& vertices = mesh.getVertexArray();
+		auto& normals = mesh.getNormalArray();
+		auto& texcoord = mesh.getTexcoordArray();
+		auto& texcoord1 = mesh.getTexcoordArray(1);
+
+		auto numVertices = vertices.size();
+		if (numVertices == 0)
+			return;
+
+		// The first rewrite turns the static buffer into a ring, every slot starts with a full copy
+		// so later frames only have to touch the positions and normals, and the texture coordinates
+		// of a slot that has not seen their latest in place edit.
+		if (this->dynamicBuffers_.empty())
 		{
-			auto& vertices = mesh->getVertexArray();
-			auto& texcoord = mesh->getTexcoordArray();
-			auto& texcoord1 = mesh->getTexcoordArray(1);
-			auto& normals = mesh->getNormalArray();
+			auto vertexBuffer = this->createVertexData(mesh);
+
+			hal::GraphicsDataDesc dataDesc;
+			dataDesc.setType(hal::GraphicsDataType::StorageVertexBuffer);
+			dataDesc.setStream((std::uint8_t*)vertexBuffer.data());
+			dataDesc.setStreamSize(vertexBuffer.size() * sizeof(float));
+			dataDesc.setUsage(hal::GraphicsUsageFlagBits::WriteBit);
+
+			for (std::size_t i = 0; i < NumDynamicBuffers; i++)
+				this->dynamicBuffers_.push_back(video::Renderer::instance()->createGraphicsData(dataDesc));
+
+			this->dynamicTexcoordVersions_.assign(NumDynamicBuffers, mesh.getTexcoordVersion());
+
+			this->dynamicIndex_ = 0;
+			this->vertices_ = this->dynamicBuffers_.front();
+			return;
+		}
 
-			hal::GraphicsInputLayoutDesc inputLayout;
-			inputLayout.addVertexLayout(hal::GraphicsVertexLayout(0, "POSITION", 0, hal::GraphicsFormat::R32G32B32SFloat));
-			inputLayout.addVertexLayout(hal::GraphicsVertexLayout(0, "NORMAL", 0, hal::GraphicsFormat::R32G32B32SFloat));
-			inputLayout.addVertexLayout(hal::GraphicsVertexLayout(0, "TEXCOORD", 0, hal::GraphicsFormat::R32G32SFloat));
-			inputLayout.addVertexLayout(hal::GraphicsVertexLayout(0, "TEXCOORD", 1, hal::GraphicsFormat::R32G32SFloat));
+		this->dynamicIndex_ = (this->dynamicIndex_ + 1) % this->dynamicBuffers_.size();
 
-			inputLayout.addVertexBinding(hal::GraphicsVertexBinding(0, inputLayout.getVertexSize()));
+		auto& buffer = this->dynamicBuffers_[this->dynamicIndex_];
+		auto streamSize = buffer->getDataDesc().getStreamSize();
+		auto vertexSize = streamSize / (numVertices * sizeof(float));
 
-			auto vertexSize = inputLayout.getVertexSize() / sizeof(float);
+		float* data = nullptr;
+		if (!buffer->map(0, streamSize, (void**)&data))
+			return;
+
+		auto dst = data;
+
+		for (std::size_t i = 0; i < numVertices; i++, dst += vertexSize)
+		{
+			auto& v = vertices[i];
+			dst[0] = v.x;
+			dst[1] = v.y;
+			dst[2] = v.z;
+		}
+
+		if (!normals.empty())
+		{
+			dst = data;
 
-			auto vertexCount = vertices.size() * vertexSize;
-			if (vertexCount > 0)
+			for (std::size_t i = 0; i < numVertices; i++, dst += vertexSize)
 			{
-				auto vertexBuffer = std::make_unique<float[]>(vertices.size() * vertexSize);
+				auto& n = normals[i];
+				dst[3] = n.x;
+				dst[4] = n.y;
+				dst[5] = n.z;
+			}
+		}
 
-				auto dst = vertexBuffer.get();
-				auto numVertices = vertices.size();
+		auto& texcoordVersion = this->dynamicTexcoordVersions_[this->dynamicIndex_];
+		if (texcoordVersion != mesh.getTexcoordVersion())
+		{
+			dst = data;
 
-				for (std::size_t i = 0; i < numVertices; i++, dst += vertexSize)
+			for (std::size_t i = 0; i < numVertices; i++, dst += vertexSize)
+			{
+				if (!texcoord.empty())
 				{
-					if (!vertices.empty())
-					{
-						auto& v = vertices[i];
-						dst[0] = v.x;
-						dst[1] = v.y;
-						dst[2] = v.z;
-					}
+					auto& uv = texcoord[i];
+					dst[6] = uv.x;
+					dst[7] = uv.y;
+				}
 
-					if (!normals.empty())
-					{
-						auto& n = normals[i];
-						dst[3] = n.x;
-						dst[4] = n.y;
-						dst[5] = n.z;
-					}
+				if (!texcoord1.empty())
+				{
+					auto& uv = texcoord1[i];
+					dst[8] = uv.x;
+					dst[9] = uv.y;
+				}
+			}
 
-					if (!texcoord.empty())
-					{
-						auto& uv = texcoord[i];
-						dst[6] = uv.x;
-						dst[7] = uv.y;
-					}
+			texcoordVersion = mesh.getTexcoordVersion();
+		}
 
-					if (!texcoord1.empty())
-					{
-						auto& uv = texcoord1[i];
-						dst[8] = uv.x;
-						dst[9] = uv.y;
-					}
-				}
+		buffer->unmap();
+
+		this->vertices_ = buffer;
+	}
 
+	void
+	ForwardBuffer::updateData(const std::shared_ptr<mesh::Mesh>& mesh) noexcept(false)
+	{
+		this->numVertices_ = 0;
+		this->numIndices_ = 0;
+		this->topologyVersion_ = 0;
+		this->numTexcoords_[0] = 0;
+		this->numTexcoords_[1] = 0;
+		this->startIndice_.clear();
+		this->dynamicIndex_ = 0;
+		this->dynamicBuffers_.clear();
+		this->dynamicTexcoordVersions_.clear();
+
+		if (mesh)
+		{
+			auto vertexBuffer = this->createVertexData(*mesh);
+			if (!vertexBuffer.empty())
+			{
 				hal::GraphicsDataDesc dataDesc;
 				dataDesc.setType(hal::GraphicsDataType::StorageVertexBuffer);
-				dataDesc.setStream((std::uint8_t*)vertexBuffer.get());
-				dataDesc.setStreamSize(vertexCount * sizeof(float));
+				dataDesc.setStream((std::uint8_t*)vertexBuffer.data());
+				dataDesc.setStreamSize(vertexBuffer.size() * sizeof(float));
 				dataDesc.setUsage(hal::GraphicsUsageFlagBits::ReadBit);
 
 				this->vertices_ = video::Renderer::instance()->createGraphicsData(dataDesc);
 			}
+			else
+			{
+				this->vertices_.reset();
+			}
+
+			this->numVertices_ = mesh->getVertexArray().size();
+			this->topologyVersion_ = mesh->getTopologyVersion();
+			this->numTexcoords_[0] = mesh->getTexcoordArray(0).size();
+			this->numTexcoords_[1] = mesh->getTexcoordArray(1).size();
 
 			if (mesh->getNumSubsets() == 1)
 			{
@@ -142,6 +317,7 @@ namespace octoon::video
 				indiceDesc.setStreamSize(indices.size() * sizeof(std::uint32_t));
 				indiceDesc.setUsage(hal::GraphicsUsageFlagBits::ReadBit);
 
+				this->numIndices_ = indices.size();
 				this->startIndice_.push_back(0);
 				this->indices_ = video::Renderer::instance()->createGraphicsData(indiceDesc);
 			}
@@ -155,6 +331,8 @@ namespace octoon::video
 						streamsize += indices.size();
 				}
 
+				this->numIndices_ = streamsize;
+
 				if (streamsize > 0)
 				{
 					auto indicesBuffer = std::make_unique<std::uint32_t[]>(streamsize);
@@ -182,6 +360,11 @@ namespace octoon::video
 
 					this->indices_ = video::Renderer::instance()->createGraphicsData(indiceDesc);
 				}
+				else
+				{
+					this->startIndice_.assign(mesh->getNumSubsets(), 0);
+					this->indices_.reset();
+				}
 			}
 		}
 		else
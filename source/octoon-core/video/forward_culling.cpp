@@ -0,0 +1,107 @@
+#include <octoon/video/forward_culling.h>
+
+namespace octoon::video
+{
+	constexpr std::int32_t ParallelThreshold = 512;
+
+	ForwardCulling::ForwardCulling() noexcept
+		: statistics_{ 0, 0, 0 }
+	{
+	}
+
+	ForwardCulling::~ForwardCulling() noexcept
+	{
+	}
+
+	void
+	ForwardCulling::cull(const std::vector<geometry::Geometry*>& geometries, const camera::Camera& camera, std::vector<geometry::Geometry*>& visible) noexcept
+	{
+		math::Frustum frustum(camera.getViewProjection());
+		this->cull(geometries, camera.getLayer(), &frustum, 1, &visible);
+	}
+
+	void
+	ForwardCulling::cull(const std::vector<geometry::Geometry*>& geometries, std::uint8_t layer, const math::Frustum frustums[], std::size_t numFrustums, std::vector<geometry::Geometry*> visible[]) noexcept
+	{
+		assert(numFrustums <= MaxFrustums);
+
+		for (std::size_t i = 0; i < numFrustums; i++)
+			visible[i].clear();
+
+		auto numGeometries = static_cast<std::int32_t>(geometries.size());
+
+		this->masks_.resize(geometries.size());
+
+#		pragma omp parallel for if (numGeometries >= ParallelThreshold)
+		for (std::int32_t i = 0; i < numGeometries; i++)
+		{
+			auto geometry = geometries[i];
+			auto& mask = this->masks_[i];
+
+			mask = 0;
+
+			if (!geometry->getVisible() || geometry->getLayer() != layer)
+				continue;
+
+			auto& mesh = geometry->getMesh();
+			if (!mesh)
+				continue;
+
+			// a mesh without bounds can't be tested, so it stays in every list
+			auto& bound = mesh->getBoundingBoxAll();
+			if (bound.box().empty())
+			{
+				mask = (1 << numFrustums) - 1;
+				continue;
+			}
+
+			auto aabb = math::transform(bound.box(), geometry->getTransform());
+
+			for (std::size_t j = 0; j < numFrustums; j++)
+			{
+				if (frustums[j].intersects(aabb))
+					mask |= 1 << j;
+			}
+		}
+
+		std::size_t numTested = 0;
+
+		for (std::size_t i = 0; i < geometries.size(); i++)
+		{
+			auto geometry = geometries[i];
+			if (!geometry->getVisible() || geometry->getLayer() != layer || !geometry->getMesh())
+				continue;
+
+			numTested += numFrustums;
+
+			auto mask = this->masks_[i];
+			for (std::size_t j = 0; j < numFrustums; j++)
+			{
+				if (mask & (1 << j))
+					visible[j].push_back(geometry);
+			}
+		}
+
+		std::size_t numVisible = 0;
+		for (std::size_t i = 0; i < numFrustums; i++)
+			numVisible += visible[i].size();
+
+		this->statistics_.numTested += numTested;
+		this->statistics_.numVisible += numVisible;
+		this->statistics_.numCulled += numTested - numVisible;
+	}
+
+	void
+	ForwardCulling::resetStatistics() noexcept
+	{
+		this->statistics_.numTested = 0;
+		this->statistics_.numVisible = 0;
+		this->statistics_.numCulled = 0;
+	}
+
+	const CullingStatistics&
+	ForwardCulling::getStatistics() const noexcept
+	{
+		return this->statistics_;
+	}
+}
@@ -3,7 +3,6 @@
 #include <octoon/video/renderer.h>
 #include <octoon/material/mesh_standard_material.h>
 #include <octoon/hal/graphics.h>
-#include <regex>
 
 static char* common = R"(
 #define PI 3.14159265359
@@ -331,17 +330,34 @@ vec4 textureLatlongUV(sampler2D texture, vec3 reflectedDirection, float roughnes
 	return LinearToLinear(textureLod(texture, uv, roughness * 7));
 }
 
+)";
+static char* camera_pars = R"(
+layout(std140) uniform Camera {
+	mat4 viewMatrix;
+	mat4 projectionMatrix;
+	mat4 viewProjMatrix;
+	vec3 cameraPosition;
+	vec3 ambientLightColor;
+};
 )";
 static char* begin_vertex = R"(
 vec3 transformed = vec3( POSITION0 );
 )";
 static char* worldpos_vertex = R"(
 #if defined ( USE_SHADOWMAP )
+#ifdef USE_INSTANCING
+	vec4 worldPosition = instanceMatrix * vec4( transformed, 1.0 );
+#else
 	vec4 worldPosition = modelMatrix * vec4( transformed, 1.0 );
 #endif
+#endif
 )";
 static char* project_vertex = R"(
+#ifdef USE_INSTANCING
+vec4 mvPosition = viewMatrix * ( instanceMatrix * vec4( transformed, 1.0 ) );
+#else
 vec4 mvPosition = modelViewMatrix * vec4( transformed, 1.0 );
+#endif
 gl_Position = projectionMatrix * mvPosition;
 )";
 static char* beginnormal_vertex = R"(
@@ -409,7 +425,11 @@ static char* normalmap_pars_fragment = R"(
 #endif
 )";
 static char* defaultnormal_vertex = R"(
+#ifdef USE_INSTANCING
+vec3 transformedNormal = mat3( viewMatrix ) * ( mat3( instanceMatrix ) * objectNormal );
+#else
 vec3 transformedNormal = normalMatrix * objectNormal;
+#endif
 #ifdef FLIP_SIDED
 	transformedNormal = - transformedNormal;
 #endif
@@ -1034,8 +1054,6 @@ float BlinnExponentToGGXRoughness( const in float blinnExponent ) {
 }
 )";
 static char* lights_pars = R"(
-uniform vec3 ambientLightColor;
-
 vec3 getAmbientLightIrradiance( const in vec3 ambientLightColor ) {
 
 	vec3 irradiance = ambientLightColor;
@@ -2065,6 +2083,7 @@ static char* shadowmap_pars_fragment = R"(
 static std::unordered_map<std::string, std::string_view> ShaderChunk = {
 	{"common", common },
 	{"packing", packing },
+	{"camera_pars", camera_pars },
 	{"cube_uv_reflection_fragment", cube_uv_reflection_fragment},
 	{"encodings_pars_fragment", encodings_pars_fragment },
 	{"color_vertex", color_vertex },
@@ -2130,13 +2149,86 @@ static std::unordered_map<std::string, std::string_view> ShaderChunk = {
 	{"shadowmap_pars_fragment", shadowmap_pars_fragment},
 };
 
+// Appends source to out with every "#include <name>" replaced by the chunk of that name,
+// unknown chunks expand to nothing.
+static void
+expandIncludes(std::string_view source, const std::unordered_map<std::string, std::string>& chunks, std::string& out)
+{
+	constexpr std::string_view directive = "#include";
+
+	std::size_t pos = 0;
+
+	for (auto begin = source.find(directive); begin != std::string_view::npos; begin = source.find(directive, pos))
+	{
+		auto it = begin + directive.size();
+		auto spaces = it;
+		while (it < source.size() && source[it] == ' ')
+			it++;
+
+		auto close = it < source.size() && it != spaces && source[it] == '<' ? source.find_first_of("<>", it + 1) : std::string_view::npos;
+		if (close == std::string_view::npos || source[close] != '>')
+		{
+			out.append(source.substr(pos, it - pos));
+			pos = it;
+			continue;
+		}
+
+		out.append(source.substr(pos, begin - pos));
+
+		auto chunk = chunks.find(std::string(source.substr(it + 1, close - it - 1)));
+		if (chunk != chunks.end())
+			out.append(chunk->second);
+
+		pos = close + 1;
+	}
+
+	out.append(source.substr(pos));
+}
+
+// Chunks with their own includes already expanded, built once for all materials.
+static const std::unordered_map<std::string, std::string>&
+getExpandedChunks()
+{
+	static const std::unordered_map<std::string, std::string> expanded = []()
+	{
+		std::unordered_map<std::string, std::string> chunks;
+		for (auto& it : ShaderChunk)
+			chunks.emplace(it.first, std::string(it.second));
+
+		for (std::size_t depth = 0; depth < 8; depth++)
+		{
+			bool nested = false;
+
+			for (auto& it : chunks)
+			{
+				if (it.second.find("#include") == std::string::npos)
+					continue;
+
+				std::string out;
+				expandIncludes(it.second, chunks, out);
+				it.second = std::move(out);
+				nested = true;
+			}
+
+			if (!nested)
+				break;
+		}
+
+		return chunks;
+	}();
+
+	return expanded;
+}
+
 namespace octoon::video
 {
 	ForwardMaterial::ForwardMaterial() noexcept
+		: instancing_(false)
 	{
 	}
 
 	ForwardMaterial::ForwardMaterial(const material::MaterialPtr& material, const ForwardScene& context) noexcept
+		: instancing_(false)
 	{
 		this->setMaterial(material, context);
 	}
@@ -2145,7 +2237,7 @@ namespace octoon::video
 	{
 		material_.reset();
 
-		ambientLightColor_.reset();
+		camera_.reset();
 		directionalLights_.reset();
 		pointLights_.reset();
 		spotLights_.reset();
@@ -2155,11 +2247,9 @@ namespace octoon::video
 		envMap_.reset();
 		envMapIntensity_.reset();
 
-		viewMatrix_.reset();
 		normalMatrix_.reset();
 		modelMatrix_.reset();
 		modelViewMatrix_.reset();
-		projectionMatrix_.reset();
 
 		program_.reset();
 		renderState_.reset();
@@ -2195,31 +2285,41 @@ namespace octoon::video
 		return descriptorSet_;
 	}
 
-	void
-	ForwardMaterial::update(const ForwardScene& context, const camera::Camera& camera, const geometry::Geometry& geometry) noexcept
+	bool
+	ForwardMaterial::isInstancing() const noexcept
+	{
+		return this->instancing_;
+	}
+
+	bool
+	ForwardMaterial::isTransparent() const noexcept
 	{
 		if (this->material_)
 		{
-			if (this->modelMatrix_)
-				this->modelMatrix_->uniform4fmat(geometry.getTransform());
-			
-			if (this->viewMatrix_)
-				this->viewMatrix_->uniform4fmat(camera.getView());
+			for (auto& blend : this->material_->getColorBlends())
+			{
+				if (blend.getBlendEnable())
+					return true;
+			}
+		}
 
-			if (this->viewProjMatrix_)
-				this->viewProjMatrix_->uniform4fmat(camera.getViewProjection());
+		return false;
+	}
 
-			if (this->modelViewMatrix_)
-				this->modelViewMatrix_->uniform4fmat(camera.getView() * geometry.getTransform());
-			
-			if (this->projectionMatrix_)
-				this->projectionMatrix_->uniform4fmat(camera.getProjection());
-			
-			if (this->normalMatrix_)
-				this->normalMatrix_->uniform3fmat((math::float3x3)camera.getView() * (math::float3x3)geometry.getTransform());
+	void
+	ForwardMaterial::update(const ForwardScene& context, const camera::Camera& camera, const geometry::Geometry& geometry, const hal::GraphicsDataPtr& cameraBuffer) noexcept
+	{
+		this->updateCamera(context, cameraBuffer);
+		this->updateTransform(camera, geometry);
+	}
 
-			if (this->ambientLightColor_)
-				this->ambientLightColor_->uniform3f(context.ambientLightColors);
+	void
+	ForwardMaterial::updateCamera(const ForwardScene& context, const hal::GraphicsDataPtr& cameraBuffer) noexcept
+	{
+		if (this->material_)
+		{
+			if (this->camera_)
+				this->camera_->uniformBuffer(cameraBuffer);
 
 			if (this->spotLights_)
 				this->spotLights_->uniformBuffer(context.spotLightBuffer);
@@ -2256,32 +2356,35 @@ namespace octoon::video
 				}
 			}
 
-			this->updateParameters(true);
+			this->updateParameters();
 		}
 	}
 
 	void
-	ForwardMaterial::parseIncludes(std::string& str)
+	ForwardMaterial::updateTransform(const camera::Camera& camera, const geometry::Geometry& geometry) noexcept
 	{
-		std::regex pattern("#include +<([^<>]*)>");
-		std::smatch m;
-
-		std::size_t pos = 0;
+		if (this->material_)
+		{
+			if (this->modelMatrix_)
+				this->modelMatrix_->uniform4fmat(geometry.getTransform());
 
-		std::string::const_iterator start = str.begin();
-		std::string::const_iterator end = str.end();
+			if (this->modelViewMatrix_)
+				this->modelViewMatrix_->uniform4fmat(camera.getView() * geometry.getTransform());
 
-		while (std::regex_search(start, end, m, pattern))
-		{
-			auto position = m.position() + ShaderChunk[m[1]].length();
+			if (this->normalMatrix_)
+				this->normalMatrix_->uniform3fmat((math::float3x3)camera.getView() * (math::float3x3)geometry.getTransform());
+		}
+	}
 
-			str.replace(pos + m.position(), m[0].length(), ShaderChunk[m[1]]);
+	void
+	ForwardMaterial::parseIncludes(std::string& str)
+	{
+		std::string out;
+		out.reserve(str.size() * 4);
 
-			pos += position;
+		expandIncludes(str, getExpandedChunks(), out);
 
-			start = str.begin() + pos;
-			end = str.end();
-		}
+		str = std::move(out);
 	}
 
 	void
@@ -2316,13 +2419,20 @@ namespace octoon::video
 				layout(location = 2) in vec3 NORMAL0;
 				layout(location = 3) in vec2 TEXCOORD1;
 
+				#define USE_INSTANCING
+				#ifdef USE_INSTANCING
+					layout(location = 4) in vec4 INSTANCE0;
+					layout(location = 5) in vec4 INSTANCE1;
+					layout(location = 6) in vec4 INSTANCE2;
+					layout(location = 7) in vec4 INSTANCE3;
+					#define instanceMatrix mat4(INSTANCE0, INSTANCE1, INSTANCE2, INSTANCE3)
+				#endif
+
 				uniform mat4 modelMatrix;
 				uniform mat4 modelViewMatrix;
-				uniform mat4 projectionMatrix;
-				uniform mat4 viewMatrix;
-				uniform mat4 viewProjMatrix;
 				uniform mat3 normalMatrix;
-				uniform vec3 cameraPosition;
+
+				#include <camera_pars>
 
 				#ifdef USE_COLOR
 					attribute vec3 color;
@@ -2334,7 +2444,7 @@ namespace octoon::video
 
 		std::string fragmentShader = "#version 330\n\t";
 		fragmentShader += "layout(location  = 0) out vec4 fragColor;\n";
-		fragmentShader += "uniform mat4 viewMatrix;\n";
+		fragmentShader += "#include <camera_pars>\n";
 		//fragmentShader += "#define TONE_MAPPING\n";
 		fragmentShader += "#define ENVMAP_TYPE_LATLONG_UV\n";
 		fragmentShader += "#define ENVMAP_MODE_REFLECTION\n";
@@ -2386,10 +2496,7 @@ namespace octoon::video
 		this->replaceLightNums(vertexShader, context);
 		this->replaceLightNums(fragmentShader, context);
 
-		hal::GraphicsProgramDesc programDesc;
-		programDesc.addShader(Renderer::instance()->createShader(hal::GraphicsShaderDesc(hal::GraphicsShaderStageFlagBits::VertexBit, vertexShader, "main", hal::GraphicsShaderLang::GLSL)));
-		programDesc.addShader(Renderer::instance()->createShader(hal::GraphicsShaderDesc(hal::GraphicsShaderStageFlagBits::FragmentBit, fragmentShader, "main", hal::GraphicsShaderLang::GLSL)));
-		this->program_ = Renderer::instance()->createProgram(programDesc);
+		this->program_ = Renderer::instance()->createProgram(vertexShader, fragmentShader);
 	}
 
 	void
@@ -2476,6 +2583,18 @@ namespace octoon::video
 
 			layoutDesc.addVertexBinding(hal::GraphicsVertexBinding(0, layoutDesc.getVertexSize()));
 
+			// Shaders built from the common chunks read the model matrix from a per-instance stream,
+			// custom shaders that don't declare it keep using the per-object uniforms.
+			auto& attributes = this->program_->getActiveAttributes();
+			this->instancing_ = std::any_of(attributes.begin(), attributes.end(), [](const hal::GraphicsAttributePtr& attrib) { return attrib->getSemantic() == "INSTANCE"; });
+			if (this->instancing_)
+			{
+				for (std::uint8_t i = 0; i < 4; i++)
+					layoutDesc.addVertexLayout(hal::GraphicsVertexLayout(1, "INSTANCE", i, hal::GraphicsFormat::R32G32B32A32SFloat));
+
+				layoutDesc.addVertexBinding(hal::GraphicsVertexBinding(1, layoutDesc.getVertexSize(1), hal::GraphicsVertexDivisor::Instance));
+			}
+
 			hal::GraphicsDescriptorSetLayoutDesc descriptor_set_layout;
 			descriptor_set_layout.setUniformComponents(this->program_->getActiveParams());
 
@@ -2501,14 +2620,6 @@ namespace octoon::video
 				if (modelMatrix != end)
 					modelMatrix_ = *modelMatrix;
 
-				auto viewMatrix = std::find_if(begin, end, [](const hal::GraphicsUniformSetPtr& set) { return set->getName() == "viewMatrix"; });
-				if (viewMatrix != end)
-					viewMatrix_ = *viewMatrix;
-
-				auto viewProjMatrix = std::find_if(begin, end, [](const hal::GraphicsUniformSetPtr& set) { return set->getName() == "viewProjMatrix"; });
-				if (viewProjMatrix != end)
-					viewProjMatrix_ = *viewProjMatrix;
-
 				auto normalMatrix = std::find_if(begin, end, [](const hal::GraphicsUniformSetPtr& set) { return set->getName() == "normalMatrix"; });
 				if (normalMatrix != end)
 					normalMatrix_ = *normalMatrix;
@@ -2517,13 +2628,9 @@ namespace octoon::video
 				if (modelViewMatrix != end)
 					modelViewMatrix_ = *modelViewMatrix;
 
-				auto projectionMatrix = std::find_if(begin, end, [](const hal::GraphicsUniformSetPtr& set) { return set->getName() == "projectionMatrix"; });
-				if (projectionMatrix != end)
-					projectionMatrix_ = *projectionMatrix;
-
-				auto ambientLightColor = std::find_if(begin, end, [](const hal::GraphicsUniformSetPtr& set) { return set->getName() == "ambientLightColor"; });
-				if (ambientLightColor != end)
-					ambientLightColor_ = *ambientLightColor;
+				auto camera = std::find_if(begin, end, [](const hal::GraphicsUniformSetPtr& set) { return set->getName() == "Camera"; });
+				if (camera != end)
+					camera_ = *camera;
 
 				auto directionalLights = std::find_if(begin, end, [](const hal::GraphicsUniformSetPtr& set) { return set->getName() == "DirectionalLights"; });
 				if (directionalLights != end)
@@ -2,10 +2,12 @@
 #include <octoon/video/forward_scene.h>
 
 #include <octoon/runtime/except.h>
+#include <octoon/runtime/profiler.h>
 
 #include <octoon/hal/graphics_device.h>
 #include <octoon/hal/graphics_texture.h>
 #include <octoon/hal/graphics_framebuffer.h>
+#include <octoon/hal/graphics_data.h>
 
 #include <octoon/camera/ortho_camera.h>
 #include <octoon/camera/perspective_camera.h>
@@ -25,10 +27,13 @@
 #include <octoon/material/mesh_depth_material.h>
 #include <octoon/material/mesh_standard_material.h>
 
+#include <cstring>
+
 namespace octoon::video
 {
 	ForwardPipeline::ForwardPipeline(const hal::GraphicsContextPtr& context) noexcept
 		: context_(context)
+		, passIndex_(0)
 	{
 		screenGeometry_ = std::make_shared<geometry::Geometry>();
 		screenGeometry_->setMesh(octoon::mesh::PlaneMesh::create(2.0f, 2.0f));
@@ -150,54 +155,191 @@ namespace octoon::video
 	}
 
 	void
-	ForwardPipeline::setMaterial(const ForwardScene& scene, const std::shared_ptr<material::Material>& material, const camera::Camera& camera, const geometry::Geometry& geometry)
+	ForwardPipeline::resetCullingStatistics() noexcept
 	{
-		assert(material);
-		
-		auto& pipeline = scene.materials_.at(material.get());
-		pipeline->update(scene, camera, geometry);
+		this->culling_.resetStatistics();
+	}
 
-		this->context_->setRenderPipeline(pipeline->getPipeline());
-		this->context_->setDescriptorSet(pipeline->getDescriptorSet());
+	const CullingStatistics&
+	ForwardPipeline::getCullingStatistics() const noexcept
+	{
+		return this->culling_.getStatistics();
 	}
 
 	void
-	ForwardPipeline::renderObject(const ForwardScene& scene, const geometry::Geometry& geometry, const camera::Camera& camera, const std::shared_ptr<material::Material>& overrideMaterial) noexcept
+	ForwardPipeline::renderItems(const ForwardScene& scene, const std::vector<ForwardRenderItem>& items, const camera::Camera& camera, const hal::GraphicsDataPtr& cameraBuffer, const hal::GraphicsDataPtr& instances) noexcept
 	{
-		if (camera.getLayer() != geometry.getLayer())
-			return;
+		ForwardMaterial* activeMaterial = nullptr;
+		ForwardBuffer* activeBuffer = nullptr;
+		const geometry::Geometry* activeGeometry = nullptr;
 
-		if (geometry.getVisible())
+		for (std::size_t i = 0; i < items.size();)
 		{
-			for (std::size_t i = 0; i < geometry.getMaterials().size(); i++)
+			auto& item = items[i];
+
+			// per-camera uniforms and the pipeline only change at the start of a material run,
+			// the object transforms only when the geometry changes inside the run
+			if (item.material != activeMaterial)
 			{
-				auto mesh = geometry.getMesh();
-				auto material = geometry.getMaterials()[i];
-				if (material && overrideMaterial)
+				item.material->updateCamera(scene, cameraBuffer);
+				item.material->updateTransform(camera, *item.geometry);
+
+				this->context_->setRenderPipeline(item.material->getPipeline());
+				this->context_->setDescriptorSet(item.material->getDescriptorSet());
+
+				activeMaterial = item.material;
+				activeGeometry = item.geometry;
+			}
+			else if (!item.material->isInstancing() && item.geometry != activeGeometry)
+			{
+				item.material->updateTransform(camera, *item.geometry);
+				this->context_->setDescriptorSet(item.material->getDescriptorSet());
+
+				activeGeometry = item.geometry;
+			}
+
+			if (item.buffer != activeBuffer)
+			{
+				this->context_->setVertexBufferData(0, item.buffer->getVertexBuffer(), 0);
+				this->context_->setIndexBufferData(item.buffer->getIndexBuffer(), 0, hal::GraphicsIndexType::UInt32);
+
+				activeBuffer = item.buffer;
+			}
+
+			// instanced materials read the model matrix from the instance stream, so every following
+			// item that draws the same subset of the same buffer joins this draw
+			std::uint32_t numInstances = 1;
+
+			if (item.material->isInstancing())
+			{
+				for (auto it = items.begin() + i + numInstances; it != items.end(); ++it, ++numInstances)
 				{
-					if (material->getPrimitiveType() == overrideMaterial->getPrimitiveType())
-						material = overrideMaterial;
+					if (it->material != item.material || it->buffer != item.buffer || it->subset != item.subset)
+						break;
 				}
 
-				if (mesh && material)
+				if (!instances)
 				{
-					this->setMaterial(scene, overrideMaterial ? overrideMaterial : material, camera, geometry);
-					this->renderBuffer(scene, mesh, i);
+					i += numInstances;
+					continue;
 				}
+
+				this->context_->setVertexBufferData(1, instances, item.instance * sizeof(math::float4x4));
 			}
+
+			this->renderBuffer(*item.buffer, item.subset, numInstances);
+
+			i += numInstances;
 		}
 	}
 
 	void
 	ForwardPipeline::renderObjects(const ForwardScene& scene, const std::vector<geometry::Geometry*>& geometries, const camera::Camera& camera, const std::shared_ptr<material::Material>& overrideMaterial) noexcept
 	{
-		for (auto& geometry : geometries)
-			this->renderObject(scene , *geometry, camera, overrideMaterial);
+		OCTOON_PROFILE_CATEGORY("ForwardPipeline::renderObjects", "render");
+
+		this->renderQueue_.build(scene, geometries, camera, overrideMaterial);
+
+		auto& transforms = this->renderQueue_.getTransforms();
+		if (transforms.empty())
+			return;
+
+		// every pass writes into the next buffers of the rings, so the mapping doesn't have to wait
+		// for the draws of the passes that were just submitted
+		this->passIndex_ = (this->passIndex_ + 1) % NumPassBuffers;
+
+		// a pass whose camera constants cannot be mapped is skipped
+		auto cameraBuffer = this->updateCamera(scene, camera);
+		if (!cameraBuffer)
+			return;
+
+		// without an instance stream only the instanced draws are dropped, the rest still render
+		auto instances = this->updateInstances(transforms);
+
+		this->renderItems(scene, this->renderQueue_.getOpaques(), camera, cameraBuffer, instances);
+		this->renderItems(scene, this->renderQueue_.getTransparents(), camera, cameraBuffer, instances);
+	}
+
+	hal::GraphicsDataPtr
+	ForwardPipeline::updateCamera(const ForwardScene& scene, const camera::Camera& camera) noexcept
+	{
+		ForwardScene::CameraConstants constants;
+		constants.viewMatrix = camera.getView();
+		constants.projectionMatrix = camera.getProjection();
+		constants.viewProjMatrix = camera.getViewProjection();
+		constants.cameraPosition = math::float4(camera.getTranslate(), 1.0f);
+		constants.ambientLightColor = math::float4(scene.ambientLightColors, 0.0f);
+
+		auto& buffer = this->cameraBuffers_[this->passIndex_];
+		if (buffer)
+		{
+			void* data = nullptr;
+			if (buffer->map(0, sizeof(ForwardScene::CameraConstants), &data))
+			{
+				std::memcpy(data, &constants, sizeof(ForwardScene::CameraConstants));
+				buffer->unmap();
+				return buffer;
+			}
+		}
+
+		// first use of the slot, or the mapping failed: a new buffer takes the constants as its initial data
+		buffer = this->context_->getDevice()->createGraphicsData(hal::GraphicsDataDesc(
+			hal::GraphicsDataType::UniformBuffer,
+			hal::GraphicsUsageFlagBits::ReadBit | hal::GraphicsUsageFlagBits::WriteBit,
+			&constants,
+			sizeof(ForwardScene::CameraConstants)
+		));
+
+		return buffer;
+	}
+
+	hal::GraphicsDataPtr
+	ForwardPipeline::updateInstances(const std::vector<math::float4x4>& transforms) noexcept
+	{
+		auto& buffer = this->instanceBuffers_[this->passIndex_];
+		auto streamSize = transforms.size() * sizeof(math::float4x4);
+
+		if (!buffer || buffer->getDataDesc().getStreamSize() < streamSize)
+		{
+			std::size_t capacity = sizeof(math::float4x4) * 64;
+			while (capacity < streamSize)
+				capacity *= 2;
+
+			hal::GraphicsDataDesc dataDesc;
+			dataDesc.setType(hal::GraphicsDataType::StorageVertexBuffer);
+			dataDesc.setStream(nullptr);
+			dataDesc.setStreamSize(capacity);
+			dataDesc.setUsage(hal::GraphicsUsageFlagBits::WriteBit);
+
+			buffer = this->context_->getDevice()->createGraphicsData(dataDesc);
+			if (!buffer)
+				return nullptr;
+		}
+
+		void* data = nullptr;
+		if (buffer->map(0, streamSize, &data))
+		{
+			std::memcpy(data, transforms.data(), streamSize);
+			buffer->unmap();
+			return buffer;
+		}
+
+		// the mapping failed, so upload through a new buffer that takes the transforms as its initial data
+		hal::GraphicsDataDesc dataDesc;
+		dataDesc.setType(hal::GraphicsDataType::StorageVertexBuffer);
+		dataDesc.setStream((std::uint8_t*)transforms.data());
+		dataDesc.setStreamSize(streamSize);
+		dataDesc.setUsage(hal::GraphicsUsageFlagBits::WriteBit);
+
+		buffer = this->context_->getDevice()->createGraphicsData(dataDesc);
+		return buffer;
 	}
 
 	void
 	ForwardPipeline::renderShadowMaps(const ForwardScene& scene, const std::vector<light::Light*>& lights, const std::vector<geometry::Geometry*>& geometries) noexcept
 	{
+		OCTOON_PROFILE_CATEGORY("ForwardPipeline::renderShadowMaps", "render");
+
 		for (auto& light : lights)
 		{
 			if (!light->getVisible())
@@ -234,6 +376,13 @@ namespace octoon::video
 				}
 			}
 
+			if (faceCount == 0)
+				continue;
+
+			// Every face is drawn through the shadow camera itself, so the list is culled once against
+			// the frustum of that camera and shared by all of them.
+			this->culling_.cull(geometries, *camera, shadowGeometries_);
+
 			for (std::uint32_t face = 0; face < faceCount; face++)
 			{
 				auto framebuffer = camera->getFramebuffer() ? camera->getFramebuffer() : fbo_;
@@ -242,8 +391,7 @@ namespace octoon::video
 				this->context_->clearFramebuffer(0, camera->getClearFlags(), camera->getClearColor(), 1.0f, 0);
 				this->context_->setViewport(0, camera->getPixelViewport());
 
-				for (auto& geometry : geometries)
-					this->renderObject(scene, *geometry, *camera, scene.depthMaterial);
+				this->renderObjects(scene, shadowGeometries_, *camera, scene.depthMaterial);
 
 				if (camera->getRenderToScreen())
 				{
@@ -289,7 +437,12 @@ namespace octoon::video
 		this->context_->setViewport(0, viewport);
 		this->context_->clearFramebuffer(0, camera->getClearFlags(), camera->getClearColor(), 1.0f, 0);
 
-		this->renderObjects(*compiled, compiled->geometries, *camera, this->overrideMaterial_);
+		{
+			OCTOON_PROFILE_CATEGORY("ForwardPipeline::cull", "render");
+			this->culling_.cull(compiled->geometries, *camera, visibleGeometries_);
+		}
+
+		this->renderObjects(*compiled, visibleGeometries_, *camera, this->overrideMaterial_);
 
 		if (framebuffer && swapFramebuffer)
 		{
@@ -331,16 +484,12 @@ namespace octoon::video
 	}
 
 	void
-	ForwardPipeline::renderBuffer(const ForwardScene& scene, const std::shared_ptr<mesh::Mesh>& mesh, std::size_t subset)
+	ForwardPipeline::renderBuffer(const ForwardBuffer& buffer, std::size_t subset, std::uint32_t numInstances) noexcept
 	{
-		auto& buffer = scene.buffers_.at(mesh.get());
-		this->context_->setVertexBufferData(0, buffer->getVertexBuffer(), 0);
-		this->context_->setIndexBufferData(buffer->getIndexBuffer(), 0, hal::GraphicsIndexType::UInt32);
-
-		auto indices = buffer->getNumIndices(subset);
+		auto indices = buffer.getNumIndices(subset);
 		if (indices > 0)
-			this->context_->drawIndexed((std::uint32_t)indices, 1, (std::uint32_t)buffer->getStartIndices(subset), 0, 0);
+			this->context_->drawIndexed((std::uint32_t)indices, numInstances, (std::uint32_t)buffer.getStartIndices(subset), 0, 0);
 		else
-			this->context_->draw((std::uint32_t)buffer->getNumVertices(), 1, 0, 0);
+			this->context_->draw((std::uint32_t)buffer.getNumVertices(), numInstances, 0, 0);
 	}
 }
\ No newline at end of file
@@ -0,0 +1,229 @@
+#include <octoon/video/forward_program_cache.h>
+#include <octoon/hal/graphics_device_property.h>
+
+#include <cstdio>
+#include <fstream>
+#include <filesystem>
+
+namespace octoon::video
+{
+	namespace
+	{
+		constexpr std::uint32_t ProgramBinaryMagic = 0x4250434F; // "OCPB"
+		constexpr std::uint32_t ProgramBinaryVersion = 2;
+
+		struct ProgramBinaryHeader
+		{
+			std::uint32_t magic;
+			std::uint32_t version;
+			std::uint32_t format;
+			std::uint32_t size;
+			std::uint64_t hash;
+			std::uint64_t driver;
+			std::uint64_t vertexLength;
+			std::uint64_t fragmentLength;
+		};
+
+		std::uint64_t fnv1a(std::uint64_t hash, std::string_view str) noexcept
+		{
+			for (auto ch : str)
+			{
+				hash ^= static_cast<std::uint8_t>(ch);
+				hash *= 0x100000001B3ull;
+			}
+
+			return hash;
+		}
+
+		std::uint64_t hashSources(const std::string& vertex, const std::string& fragment) noexcept
+		{
+			auto hash = fnv1a(0xCBF29CE484222325ull, vertex);
+			hash = fnv1a(hash, std::string_view("\0", 1));
+			return fnv1a(hash, fragment);
+		}
+	}
+
+	ForwardProgramCache::ForwardProgramCache() noexcept
+		: capacity_(256)
+		, driverHash_(0)
+	{
+	}
+
+	ForwardProgramCache::~ForwardProgramCache() noexcept
+	{
+		this->clear();
+	}
+
+	void
+	ForwardProgramCache::setDevice(const hal::GraphicsDevicePtr& device) noexcept
+	{
+		if (this->device_ != device)
+		{
+			this->clear();
+			this->device_ = device;
+			this->driverHash_ = 0;
+
+			if (device)
+			{
+				auto& properties = device->getDeviceProperty().getDeviceProperties();
+				auto hash = fnv1a(0xCBF29CE484222325ull, properties.vendorName);
+				hash = fnv1a(hash, std::string_view("\0", 1));
+				hash = fnv1a(hash, properties.deviceName);
+				hash = fnv1a(hash, std::string_view("\0", 1));
+				this->driverHash_ = fnv1a(hash, properties.driverVersion);
+			}
+		}
+	}
+
+	const hal::GraphicsDevicePtr&
+	ForwardProgramCache::getDevice() const noexcept
+	{
+		return this->device_;
+	}
+
+	void
+	ForwardProgramCache::setCachePath(std::string_view path) noexcept
+	{
+		this->cachePath_ = path;
+	}
+
+	const std::string&
+	ForwardProgramCache::getCachePath() const noexcept
+	{
+		return this->cachePath_;
+	}
+
+	void
+	ForwardProgramCache::setCapacity(std::size_t capacity) noexcept
+	{
+		this->capacity_ = capacity;
+		this->evict();
+	}
+
+	std::size_t
+	ForwardProgramCache::getCapacity() const noexcept
+	{
+		return this->capacity_;
+	}
+
+	void
+	ForwardProgramCache::clear() noexcept
+	{
+		this->programs_.clear();
+	}
+
+	void
+	ForwardProgramCache::evict() noexcept
+	{
+		if (this->programs_.size() <= this->capacity_)
+			return;
+
+		for (auto it = this->programs_.begin(); it != this->programs_.end();)
+		{
+			if (it->second.program.use_count() == 1)
+				it = this->programs_.erase(it);
+			else
+				++it;
+		}
+	}
+
+	hal::GraphicsProgramPtr
+	ForwardProgramCache::createProgram(const std::string& vertex, const std::string& fragment) noexcept
+	{
+		if (!this->device_)
+			return nullptr;
+
+		auto hash = hashSources(vertex, fragment);
+
+		auto range = this->programs_.equal_range(hash);
+		for (auto it = range.first; it != range.second; ++it)
+		{
+			if (it->second.vertex == vertex && it->second.fragment == fragment)
+				return it->second.program;
+		}
+
+		std::string path;
+		if (!this->cachePath_.empty())
+		{
+			char name[48];
+			std::snprintf(name, sizeof(name), "%016llx-%016llx.bin", static_cast<unsigned long long>(this->driverHash_), static_cast<unsigned long long>(hash));
+			path = this->cachePath_ + "/" + name;
+		}
+
+		hal::GraphicsProgramPtr program;
+		if (!path.empty())
+		{
+			std::ifstream stream(path, std::ios::in | std::ios::binary);
+			if (stream)
+			{
+				ProgramBinaryHeader header;
+				if (stream.read((char*)&header, sizeof(header)) &&
+					header.magic == ProgramBinaryMagic &&
+					header.version == ProgramBinaryVersion &&
+					header.hash == hash &&
+					header.driver == this->driverHash_ &&
+					header.vertexLength == vertex.size() &&
+					header.fragmentLength == fragment.size())
+				{
+					std::vector<std::uint8_t> binary(header.size);
+					if (stream.read((char*)binary.data(), binary.size()))
+					{
+						hal::GraphicsProgramDesc programDesc;
+						programDesc.setProgramBinary(header.format, std::move(binary));
+						program = this->device_->createProgram(programDesc);
+					}
+				}
+			}
+		}
+
+		if (!program)
+		{
+			auto vertexShader = this->device_->createShader(hal::GraphicsShaderDesc(hal::GraphicsShaderStageFlagBits::VertexBit, vertex, "main", hal::GraphicsShaderLang::GLSL));
+			auto fragmentShader = this->device_->createShader(hal::GraphicsShaderDesc(hal::GraphicsShaderStageFlagBits::FragmentBit, fragment, "main", hal::GraphicsShaderLang::GLSL));
+			if (!vertexShader || !fragmentShader)
+				return nullptr;
+
+			hal::GraphicsProgramDesc programDesc;
+			programDesc.addShader(vertexShader);
+			programDesc.addShader(fragmentShader);
+
+			program = this->device_->createProgram(programDesc);
+			if (!program)
+				return nullptr;
+
+			std::uint32_t format = 0;
+			std::vector<std::uint8_t> binary;
+			if (!path.empty() && program->getProgramBinary(format, binary))
+			{
+				std::error_code ec;
+				std::filesystem::create_directories(this->cachePath_, ec);
+
+				std::ofstream stream(path, std::ios::out | std::ios::binary | std::ios::trunc);
+				if (stream)
+				{
+					ProgramBinaryHeader header;
+					header.magic = ProgramBinaryMagic;
+					header.version = ProgramBinaryVersion;
+					header.format = format;
+					header.size = static_cast<std::uint32_t>(binary.size());
+					header.hash = hash;
+					header.driver = this->driverHash_;
+					header.vertexLength = vertex.size();
+					header.fragmentLength = fragment.size();
+
+					stream.write((const char*)&header, sizeof(header));
+					stream.write((const char*)binary.data(), binary.size());
+				}
+			}
+		}
+
+		Entry entry;
+		entry.vertex = vertex;
+		entry.fragment = fragment;
+		entry.program = program;
+		this->programs_.emplace(hash, std::move(entry));
+		this->evict();
+
+		return program;
+	}
+}
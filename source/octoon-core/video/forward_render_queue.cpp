@@ -0,0 +1,158 @@
+#include <octoon/video/forward_render_queue.h>
+#include <octoon/video/forward_scene.h>
+#include <algorithm>
+#include <cstring>
+
+namespace octoon::video
+{
+	namespace
+	{
+		// positive floats keep their order when compared as integers
+		std::uint32_t depthBits(float depth) noexcept
+		{
+			std::uint32_t bits;
+			depth = std::max(depth, 0.0f);
+			std::memcpy(&bits, &depth, sizeof(bits));
+			return bits;
+		}
+	}
+
+	ForwardRenderQueue::ForwardRenderQueue() noexcept
+	{
+	}
+
+	ForwardRenderQueue::~ForwardRenderQueue() noexcept
+	{
+	}
+
+	void
+	ForwardRenderQueue::clear() noexcept
+	{
+		this->opaques_.clear();
+		this->transparents_.clear();
+		this->transforms_.clear();
+		this->resourceIds_.clear();
+	}
+
+	std::uint32_t
+	ForwardRenderQueue::getResourceId(const void* resource) noexcept
+	{
+		auto it = this->resourceIds_.find(resource);
+		if (it != this->resourceIds_.end())
+			return it->second;
+
+		auto id = static_cast<std::uint32_t>(this->resourceIds_.size());
+		this->resourceIds_[resource] = id;
+		return id;
+	}
+
+	void
+	ForwardRenderQueue::build(const ForwardScene& scene, const std::vector<geometry::Geometry*>& geometries, const camera::Camera& camera, const std::shared_ptr<material::Material>& overrideMaterial) noexcept
+	{
+		this->clear();
+
+		this->renderOrders_.clear();
+		for (auto& geometry : geometries)
+			this->renderOrders_.push_back(geometry->getRenderOrder());
+
+		std::sort(this->renderOrders_.begin(), this->renderOrders_.end());
+		this->renderOrders_.erase(std::unique(this->renderOrders_.begin(), this->renderOrders_.end()), this->renderOrders_.end());
+
+		auto& eye = camera.getTranslate();
+
+		std::uint32_t sequence = 0;
+
+		for (auto& geometry : geometries)
+		{
+			if (camera.getLayer() != geometry->getLayer() || !geometry->getVisible())
+				continue;
+
+			auto& mesh = geometry->getMesh();
+			if (!mesh)
+				continue;
+
+			auto buffer = scene.buffers_.find(mesh.get());
+			if (buffer == scene.buffers_.end())
+				continue;
+
+			auto rank = std::lower_bound(this->renderOrders_.begin(), this->renderOrders_.end(), geometry->getRenderOrder()) - this->renderOrders_.begin();
+			auto order = static_cast<std::uint64_t>(std::min<std::ptrdiff_t>(rank, 0xFF));
+
+			auto& bound = mesh->getBoundingBoxAll();
+			auto center = bound.box().empty() ? geometry->getTranslate() : geometry->getTransform() * bound.center();
+			auto depth = depthBits(math::length(center - eye));
+
+			auto& materials = geometry->getMaterials();
+			for (std::size_t i = 0; i < materials.size(); i++)
+			{
+				auto& material = materials[i];
+				if (!material)
+					continue;
+
+				auto it = scene.materials_.find(overrideMaterial ? overrideMaterial.get() : material.get());
+				if (it == scene.materials_.end() || !it->second->getPipeline())
+					continue;
+
+				ForwardRenderItem item;
+				item.subset = static_cast<std::uint32_t>(i);
+				item.instance = 0;
+				item.geometry = geometry;
+				item.material = it->second.get();
+				item.buffer = buffer->second.get();
+
+				if (item.material->isTransparent())
+				{
+					item.key = order << 56;
+					item.key |= static_cast<std::uint64_t>(~depth >> 8) << 32;
+					item.key |= sequence++;
+					this->transparents_.push_back(item);
+				}
+				else
+				{
+					item.key = order << 56;
+					item.key |= static_cast<std::uint64_t>(this->getResourceId(item.material->getPipeline().get()) & 0xFFF) << 44;
+					item.key |= static_cast<std::uint64_t>(this->getResourceId(item.buffer) & 0xFFF) << 32;
+					item.key |= static_cast<std::uint64_t>(std::min<std::size_t>(i, 0xFF)) << 24;
+					item.key |= depth >> 8;
+					this->opaques_.push_back(item);
+				}
+			}
+		}
+
+		auto compare = [](const ForwardRenderItem& a, const ForwardRenderItem& b) { return a.key < b.key; };
+		std::stable_sort(this->opaques_.begin(), this->opaques_.end(), compare);
+		std::stable_sort(this->transparents_.begin(), this->transparents_.end(), compare);
+
+		this->transforms_.reserve(this->opaques_.size() + this->transparents_.size());
+
+		for (auto& item : this->opaques_)
+		{
+			item.instance = static_cast<std::uint32_t>(this->transforms_.size());
+			this->transforms_.push_back(item.geometry->getTransform());
+		}
+
+		for (auto& item : this->transparents_)
+		{
+			item.instance = static_cast<std::uint32_t>(this->transforms_.size());
+			this->transforms_.push_back(item.geometry->getTransform());
+		}
+	}
+
+	const std::vector<ForwardRenderItem>&
+	ForwardRenderQueue::getOpaques() const noexcept
+	{
+		return this->opaques_;
+	}
+
+	const std::vector<ForwardRenderItem>&
+	ForwardRenderQueue::getTransparents() const noexcept
+	{
+		return this->transparents_;
+	}
+
+	const std::vector<math::float4x4>&
+	ForwardRenderQueue::getTransforms() const noexcept
+	{
+		return this->transforms_;
+	}
+}
@@ -41,6 +41,18 @@ namespace octoon::video
 		return this->pipeline_->getFramebuffer();
 	}
 
+	void
+	ForwardRenderer::resetCullingStatistics() noexcept
+	{
+		this->pipeline_->resetCullingStatistics();
+	}
+
+	const CullingStatistics&
+	ForwardRenderer::getCullingStatistics() const noexcept
+	{
+		return this->pipeline_->getCullingStatistics();
+	}
+
 	void
 	ForwardRenderer::prepareScene(const std::shared_ptr<RenderScene>& scene) noexcept
 	{
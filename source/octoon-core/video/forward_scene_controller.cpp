@@ -14,6 +14,8 @@
 #include <octoon/hal/graphics_framebuffer.h>
 #include <octoon/hal/graphics_data.h>
 
+#include <unordered_set>
+
 namespace octoon::video
 {
 	ForwardSceneController::ForwardSceneController(const hal::GraphicsContextPtr& context)
@@ -423,6 +425,8 @@ namespace octoon::video
     {
 		out.geometries = scene->getGeometries();
 
+		std::unordered_set<const mesh::Mesh*> updated;
+
 		for (auto& geometry : scene->getGeometries())
 		{
 			if (!geometry->getVisible())
@@ -430,8 +434,17 @@ namespace octoon::video
 
 			if (geometry->isDirty() || force)
 			{
-				auto mesh = geometry->getMesh();
-				out.buffers_[mesh.get()] = std::make_shared<ForwardBuffer>(mesh);
+				auto& mesh = geometry->getMesh();
+
+				// a mesh shared by several geometries is uploaded once per frame
+				if (!updated.insert(mesh.get()).second)
+					continue;
+
+				auto it = out.buffers_.find(mesh.get());
+				if (it == out.buffers_.end() || it->second->getMesh() != mesh || force)
+					out.buffers_[mesh.get()] = std::make_shared<ForwardBuffer>(mesh);
+				else if (mesh && mesh->isDirty())
+					it->second->update();
 			}
 		}
     }
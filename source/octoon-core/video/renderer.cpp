@@ -5,11 +5,61 @@
 #include <octoon/video/forward_renderer.h>
 
 #include <octoon/runtime/except.h>
+#include <octoon/runtime/profiler.h>
 
 #include "rtx_manager.h"
 
+#include <cstring>
+
 namespace octoon::video
 {
+	namespace
+	{
+		float halfToFloat(std::uint16_t value) noexcept
+		{
+			std::uint32_t sign = (value & 0x8000u) << 16;
+			std::uint32_t exponent = (value >> 10) & 0x1Fu;
+			std::uint32_t mantissa = value & 0x3FFu;
+
+			std::uint32_t bits;
+			if (exponent == 0x1F)
+				bits = sign | 0x7F800000u | (mantissa << 13);
+			else if (exponent != 0)
+				bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+			else if (mantissa != 0)
+			{
+				exponent = 113;
+				while (!(mantissa & 0x400u))
+				{
+					mantissa <<= 1;
+					exponent--;
+				}
+
+				bits = sign | (exponent << 23) | ((mantissa & 0x3FFu) << 13);
+			}
+			else
+				bits = sign;
+
+			float result;
+			std::memcpy(&result, &bits, sizeof(float));
+			return result;
+		}
+
+		bool isReadbackFormat(hal::GraphicsFormat format) noexcept
+		{
+			switch (format)
+			{
+			case hal::GraphicsFormat::R32G32B32A32SFloat:
+			case hal::GraphicsFormat::R32G32B32SFloat:
+			case hal::GraphicsFormat::R16G16B16A16SFloat:
+			case hal::GraphicsFormat::R16G16B16SFloat:
+				return true;
+			default:
+				return false;
+			}
+		}
+	}
+
 	OctoonImplementSingleton(Renderer)
 
 	Renderer::Renderer() noexcept
@@ -17,6 +67,10 @@ namespace octoon::video
 		, height_(0)
 		, sortObjects_(true)
 		, enableGlobalIllumination_(false)
+		, readbackTicket_(0)
+		, readbackWidth_(0)
+		, readbackHeight_(0)
+		, readbackFormat_(hal::GraphicsFormat::Undefined)
 	{
 	}
 
@@ -29,6 +83,7 @@ namespace octoon::video
 	Renderer::setup(const hal::GraphicsContextPtr& context, std::uint32_t w, std::uint32_t h) except
 	{
 		context_ = context;
+		programCache_.setDevice(context->getDevice());
 		forwardRenderer_ = std::make_unique<ForwardRenderer>(context);
 
 		this->setFramebufferSize(w, h);
@@ -39,6 +94,7 @@ namespace octoon::video
 	{
 		this->rtxManager_.reset();
 		this->forwardRenderer_.reset();
+		this->programCache_.setDevice(nullptr);
 		this->context_.reset();
 	}
 
@@ -66,6 +122,71 @@ namespace octoon::video
 		return this->rtxManager_->readColorBuffer(data);
 	}
 
+	ReadbackStatus
+	Renderer::readColorBuffer(std::uint64_t ticket, math::float3 data[], bool wait)
+	{
+		if (ticket == 0 || ticket != this->readbackTicket_ || !isReadbackFormat(this->readbackFormat_))
+			return ReadbackStatus::ReadbackStatusFailed;
+
+		if (!wait && !this->context_->isReadbackReady(ticket))
+			return ReadbackStatus::ReadbackStatusPending;
+
+		void* pixels = nullptr;
+		if (!this->context_->mapReadback(ticket, &pixels, wait))
+			return ReadbackStatus::ReadbackStatusFailed;
+
+		// the pixels keep the format of the attachment, half floats are promoted here rather than by the driver
+		auto count = static_cast<std::size_t>(this->readbackWidth_) * this->readbackHeight_;
+
+		switch (this->readbackFormat_)
+		{
+		case hal::GraphicsFormat::R32G32B32A32SFloat:
+			for (std::size_t i = 0; i < count; ++i)
+				data[i] = (((math::float4*)pixels) + i)->xyz();
+			break;
+		case hal::GraphicsFormat::R32G32B32SFloat:
+			std::memcpy(data, pixels, count * sizeof(math::float3));
+			break;
+		case hal::GraphicsFormat::R16G16B16A16SFloat:
+		case hal::GraphicsFormat::R16G16B16SFloat:
+		{
+			auto stride = this->readbackFormat_ == hal::GraphicsFormat::R16G16B16A16SFloat ? 4 : 3;
+			auto halfs = (const std::uint16_t*)pixels;
+			for (std::size_t i = 0; i < count; ++i, halfs += stride)
+				data[i].set(halfToFloat(halfs[0]), halfToFloat(halfs[1]), halfToFloat(halfs[2]));
+		}
+		break;
+		default:
+			break;
+		}
+
+		this->context_->unmapReadback(ticket);
+		this->readbackTicket_ = 0;
+
+		return ReadbackStatus::ReadbackStatusReady;
+	}
+
+	std::uint64_t
+	Renderer::readColorBufferAsync()
+	{
+		auto& framebuffer = this->getFramebuffer();
+		if (!framebuffer || framebuffer->getFramebufferDesc().getColorAttachments().empty())
+			return 0;
+
+		auto& framebufferDesc = framebuffer->getFramebufferDesc();
+
+		auto format = framebufferDesc.getColorAttachment(0).getBindingTexture()->getTextureDesc().getTexFormat();
+		if (!isReadbackFormat(format))
+			return 0;
+
+		this->readbackWidth_ = framebufferDesc.getWidth();
+		this->readbackHeight_ = framebufferDesc.getHeight();
+		this->readbackFormat_ = format;
+		this->readbackTicket_ = this->context_->readFramebufferAsync(framebuffer, 0, 0, 0, this->readbackWidth_, this->readbackHeight_);
+
+		return this->readbackTicket_;
+	}
+
 	void
 	Renderer::readAlbedoBuffer(math::float3 data[])
 	{
@@ -89,6 +210,13 @@ namespace octoon::video
 			return this->forwardRenderer_->getFramebuffer();
 	}
 
+	const CullingStatistics&
+	Renderer::getCullingStatistics() const noexcept
+	{
+		assert(this->forwardRenderer_);
+		return this->forwardRenderer_->getCullingStatistics();
+	}
+
 	void
 	Renderer::setSortObjects(bool sortObject) noexcept
 	{
@@ -113,6 +241,18 @@ namespace octoon::video
 		return this->overrideMaterial_;
 	}
 
+	void
+	Renderer::setProgramCachePath(std::string_view path) noexcept
+	{
+		this->programCache_.setCachePath(path);
+	}
+
+	const std::string&
+	Renderer::getProgramCachePath() const noexcept
+	{
+		return this->programCache_.getCachePath();
+	}
+
 	hal::GraphicsInputLayoutPtr
 	Renderer::createInputLayout(const hal::GraphicsInputLayoutDesc& desc) noexcept
 	{
@@ -161,6 +301,12 @@ namespace octoon::video
 		return this->context_->getDevice()->createProgram(desc);
 	}
 
+	hal::GraphicsProgramPtr
+	Renderer::createProgram(const std::string& vertex, const std::string& fragment) noexcept
+	{
+		return this->programCache_.createProgram(vertex, fragment);
+	}
+
 	hal::GraphicsStatePtr
 	Renderer::createRenderState(const hal::GraphicsStateDesc& desc) noexcept
 	{
@@ -200,25 +346,34 @@ namespace octoon::video
 	void
 	Renderer::render(const std::shared_ptr<RenderScene>& scene) noexcept(false)
 	{
+		OCTOON_PROFILE_CATEGORY("Renderer::render", "render");
+
 		if (this->sortObjects_)
 		{
 			scene->sortCameras();
 			scene->sortGeometries();
 		}
 
+		if (this->forwardRenderer_)
+			this->forwardRenderer_->resetCullingStatistics();
+
 		for (auto& camera : scene->getCameras())
 		{
 			scene->setMainCamera(camera);
 
 			camera->onRenderBefore(*camera);
 
-			for (auto& it : scene->getGeometries())
 			{
-				if (!it->getVisible())
-					continue;
+				OCTOON_PROFILE_CATEGORY("Renderer::renderBefore", "render");
 
-				if (camera->getLayer() == it->getLayer())
-					it->onRenderBefore(*camera);
+				for (auto& it : scene->getGeometries())
+				{
+					if (!it->getVisible())
+						continue;
+
+					if (camera->getLayer() == it->getLayer())
+						it->onRenderBefore(*camera);
+				}
 			}
 
 			if (this->sortObjects_)
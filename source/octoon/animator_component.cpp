@@ -4,6 +4,8 @@
 #include <octoon/timer_feature.h>
 #include <octoon/rigidbody_component.h>
 
+#include <limits>
+
 namespace octoon
 {
 	OctoonImplementSubClass(AnimatorComponent, AnimationComponent, "Animator")
@@ -11,6 +13,9 @@ namespace octoon
 	AnimatorComponent::AnimatorComponent() noexcept
 		: enableAnimation_(true)
 		, enableAnimOnVisableOnly_(false)
+		, clipBindings_(1, 0)
+		, drivesRigidbodies_(false)
+		, footprintVersion_(std::numeric_limits<std::size_t>::max())
 	{
 	}
 
@@ -45,13 +50,13 @@ namespace octoon
 	AnimatorComponent::AnimatorComponent(animation::Animation<float>&& animation) noexcept
 		: AnimatorComponent()
 	{
-		animation_ = std::move(animation);
+		this->setAnimation(std::move(animation));
 	}
 
 	AnimatorComponent::AnimatorComponent(const animation::Animation<float>& animation) noexcept
 		: AnimatorComponent()
 	{
-		animation_ = animation;
+		this->setAnimation(animation);
 	}
 
 	AnimatorComponent::AnimatorComponent(GameObjects&& avatar) noexcept
@@ -97,7 +102,13 @@ namespace octoon
 	void
 	AnimatorComponent::setTime(float time) noexcept
 	{
-		animation_.setTime(time);
+		if (baked_.empty())
+			animation_.setTime(time);
+		else
+		{
+			animation_.state.time = time;
+			animation_.state.finish = time >= animation_.state.timeLength;
+		}
 	}
 
 	float
@@ -110,7 +121,7 @@ namespace octoon
 	AnimatorComponent::sample(float delta) noexcept
 	{
 		if (delta != 0.0f)
-			animation_.evaluate(delta);
+			this->advance(delta);
 
 		if (!avatar_.empty())
 		{
@@ -140,7 +151,7 @@ namespace octoon
 	AnimatorComponent::evaluate(float delta) noexcept
 	{
 		if (delta != 0.0f)
-			animation_.evaluate(delta);
+			this->advance(delta);
 
 		if (!avatar_.empty())
 			this->updateAvatar();
@@ -152,12 +163,18 @@ namespace octoon
 	AnimatorComponent::setAnimation(animation::Animation<float>&& clips) noexcept
 	{
 		animation_ = std::move(clips);
+		baked_.clear();
+		bakedValues_.clear();
+		this->onAttachAnimation();
 	}
 
 	void
 	AnimatorComponent::setAnimation(const animation::Animation<float>& clips) noexcept
 	{
 		animation_ = clips;
+		baked_.clear();
+		bakedValues_.clear();
+		this->onAttachAnimation();
 	}
 
 	const animation::Animation<float>&
@@ -166,6 +183,53 @@ namespace octoon
 		return animation_;
 	}
 
+	void
+	AnimatorComponent::setBakedAnimation(animation::BakedAnimationClips&& clips) noexcept
+	{
+		animation_ = animation::Animation<float>();
+		baked_ = std::move(clips);
+
+		std::size_t numValues = 0;
+		for (auto& clip : baked_)
+		{
+			numValues += clip.getNumValues();
+			animation_.state.timeLength = std::max(animation_.state.timeLength, clip.timeLength);
+		}
+
+		bakedValues_.assign(numValues, 0.0f);
+
+		this->onAttachAnimation();
+	}
+
+	void
+	AnimatorComponent::setBakedAnimation(const animation::BakedAnimationClips& clips) noexcept
+	{
+		this->setBakedAnimation(animation::BakedAnimationClips(clips));
+	}
+
+	const animation::BakedAnimationClips&
+	AnimatorComponent::getBakedAnimation() const noexcept
+	{
+		return baked_;
+	}
+
+	void
+	AnimatorComponent::bakeAnimation(float rate, float tolerance) noexcept
+	{
+		if (animation_.clips.empty())
+			return;
+
+		animation::BakedAnimationClips clips;
+		clips.reserve(animation_.clips.size());
+
+		for (auto& clip : animation_.clips)
+			clips.emplace_back(clip, rate, tolerance);
+
+		auto time = animation_.getTime();
+		this->setBakedAnimation(std::move(clips));
+		this->setTime(time);
+	}
+
 	void
 	AnimatorComponent::setAvatar(GameObjects&& avatar) noexcept
 	{
@@ -200,9 +264,36 @@ namespace octoon
 		instance->setAvatar(this->getAvatar());
 		instance->setAnimation(this->getAnimation());
 
+		if (!baked_.empty())
+			instance->setBakedAnimation(baked_);
+
 		return instance;
 	}
 
+	bool
+	AnimatorComponent::getUpdateFootprint(GameUpdateFootprint& footprint) const noexcept
+	{
+		// Moving a bone moves every rigidbody below it through RigidbodyComponent::onMoveAfter and sample()
+		// moves them directly, all of them sharing one physics scene, so those animators stay serial.
+		auto version = GameObject::getHierarchyVersion();
+		if (footprintVersion_ != version)
+		{
+			drivesRigidbodies_ = this->hasRigidbodies();
+			footprintVersion_ = version;
+		}
+
+		if (drivesRigidbodies_)
+			return false;
+
+		// Otherwise the animator only moves its own avatar, messages go to listeners on its own game object.
+		footprint.writes.push_back(this->getGameObject());
+
+		for (auto& it : avatar_)
+			footprint.writes.push_back(it.get());
+
+		return true;
+	}
+
 	void 
 	AnimatorComponent::onActivate() except
 	{
@@ -224,7 +315,7 @@ namespace octoon
 			{
 				auto delta = timeFeature->getTimeInterval();
 				if (delta != 0.0f)
-					animation_.evaluate(delta);
+					this->advance(delta);
 
 				if (!avatar_.empty())
 					this->updateAvatar();
@@ -238,9 +329,126 @@ namespace octoon
 	AnimatorComponent::onAttachAvatar(const GameObjects& avatar) noexcept
 	{
 		bindpose_.resize(avatar.size());
+		transforms_.resize(avatar.size());
 
 		for (std::size_t i = 0; i < avatar.size(); i++)
-			bindpose_[i] = avatar[i]->getComponent<TransformComponent>()->getLocalTranslate();
+		{
+			transforms_[i] = avatar[i]->getComponent<TransformComponent>();
+			bindpose_[i] = transforms_[i]->getLocalTranslate();
+		}
+
+		hierarchy_.build(avatar);
+
+		footprintVersion_ = std::numeric_limits<std::size_t>::max();
+	}
+
+	bool
+	AnimatorComponent::hasRigidbodies() const noexcept
+	{
+		if (avatar_.empty())
+		{
+			auto object = this->getGameObject();
+			return object && (object->getComponent<RigidbodyComponent>() || object->getComponentInChildren<RigidbodyComponent>());
+		}
+
+		for (auto& bone : avatar_)
+		{
+			if (bone->getComponent<RigidbodyComponent>() || bone->getComponentInChildren<RigidbodyComponent>())
+				return true;
+		}
+
+		return false;
+	}
+
+	void
+	AnimatorComponent::onAttachAnimation() noexcept
+	{
+		bindings_.clear();
+
+		if (baked_.empty())
+		{
+			clipBindings_.resize(animation_.clips.size() + 1);
+
+			for (std::size_t i = 0; i < animation_.clips.size(); i++)
+			{
+				clipBindings_[i] = bindings_.size();
+
+				for (auto& curve : animation_.clips[i].curves)
+					this->onAttachBinding(curve.first, &curve.second.value);
+			}
+		}
+		else
+		{
+			clipBindings_.resize(baked_.size() + 1);
+
+			for (std::size_t i = 0, offset = 0; i < baked_.size(); offset += baked_[i++].getNumValues())
+			{
+				clipBindings_[i] = bindings_.size();
+
+				for (std::size_t n = 0; n < baked_[i].curveNames.size(); n++)
+					this->onAttachBinding(baked_[i].curveNames[n], bakedValues_.data() + offset + n);
+			}
+		}
+
+		clipBindings_.back() = bindings_.size();
+	}
+
+	void
+	AnimatorComponent::onAttachBinding(const std::string& name, const float* value) noexcept
+	{
+		static const std::unordered_map<std::string_view, CurveChannel> channels = {
+			{ "LocalPosition.x", CurveChannel::LocalPositionX },
+			{ "LocalPosition.y", CurveChannel::LocalPositionY },
+			{ "LocalPosition.z", CurveChannel::LocalPositionZ },
+			{ "LocalScale.x", CurveChannel::LocalScaleX },
+			{ "LocalScale.y", CurveChannel::LocalScaleY },
+			{ "LocalScale.z", CurveChannel::LocalScaleZ },
+			{ "LocalRotation.x", CurveChannel::LocalRotationX },
+			{ "LocalRotation.y", CurveChannel::LocalRotationY },
+			{ "LocalRotation.z", CurveChannel::LocalRotationZ },
+			{ "LocalRotation.w", CurveChannel::LocalRotationW },
+			{ "LocalEulerAnglesRaw.x", CurveChannel::LocalEulerAnglesRawX },
+			{ "LocalEulerAnglesRaw.y", CurveChannel::LocalEulerAnglesRawY },
+			{ "LocalEulerAnglesRaw.z", CurveChannel::LocalEulerAnglesRawZ },
+			{ "Transform:move", CurveChannel::TransformMove },
+		};
+
+		auto it = channels.find(name);
+
+		CurveBinding binding;
+		binding.channel = it != channels.end() ? it->second : CurveChannel::Message;
+		binding.value = value;
+		binding.name = &name;
+
+		bindings_.push_back(binding);
+	}
+
+	void
+	AnimatorComponent::advance(float delta) noexcept
+	{
+		if (baked_.empty())
+			animation_.evaluate(delta);
+		else
+		{
+			animation_.state.time += delta;
+			animation_.state.finish = animation_.state.time >= animation_.state.timeLength;
+		}
+	}
+
+	bool
+	AnimatorComponent::isClipFinished(std::size_t index) const noexcept
+	{
+		if (baked_.empty())
+			return animation_.clips[index].finish;
+		else
+			return animation_.state.time >= baked_[index].timeLength;
+	}
+
+	void
+	AnimatorComponent::updateBakedAnimation() noexcept
+	{
+		for (std::size_t i = 0, offset = 0; i < baked_.size(); offset += baked_[i++].getNumValues())
+			baked_[i].evaluate(animation_.state.time, bakedValues_.data() + offset);
 	}
 
 	void
@@ -249,43 +457,42 @@ namespace octoon
 		if (this->getCurrentAnimatorStateInfo().finish)
 			return;
 
-		for (std::size_t i = 0; i < animation_.clips.size(); i++)
+		this->updateBakedAnimation();
+
+		auto numClips = std::min(clipBindings_.size() - 1, transforms_.size());
+
+		for (std::size_t i = 0; i < numClips; i++)
 		{
-			auto transform = avatar_[i]->getComponent<TransformComponent>();
+			auto& transform = transforms_[i];
 
 			auto scale = transform->getLocalScale();
 			auto quat = transform->getLocalQuaternion();
 			auto translate = transform->getLocalTranslate();
 			auto euler = math::eulerAngles(quat);
 
-			for (auto& curve : animation_.clips[i].curves)
+			for (auto n = clipBindings_[i]; n < clipBindings_[i + 1]; n++)
 			{
-				if (curve.first == "LocalPosition.x")
-					translate.x = curve.second.value + bindpose_[i].x;
-				else if (curve.first == "LocalPosition.y")
-					translate.y = curve.second.value + bindpose_[i].y;
-				else if (curve.first == "LocalPosition.z")
-					translate.z = curve.second.value + bindpose_[i].z;
-				else if (curve.first == "LocalScale.x")
-					scale.x = curve.second.value;
-				else if (curve.first == "LocalScale.y")
-					scale.y = curve.second.value;
-				else if (curve.first == "LocalScale.z")
-					scale.z = curve.second.value;
-				else if (curve.first == "LocalRotation.x")
-					quat.x = curve.second.value;
-				else if (curve.first == "LocalRotation.y")
-					quat.y = curve.second.value;
-				else if (curve.first == "LocalRotation.z")
-					quat.z = curve.second.value;
-				else if (curve.first == "LocalRotation.w")
-					quat.w = curve.second.value;
-				else if (curve.first == "LocalEulerAnglesRaw.x")
-					euler.x = curve.second.value;
-				else if (curve.first == "LocalEulerAnglesRaw.y")
-					euler.y = curve.second.value;
-				else if (curve.first == "LocalEulerAnglesRaw.z")
-					euler.z = curve.second.value;
+				auto& binding = bindings_[n];
+				auto value = *binding.value;
+
+				switch (binding.channel)
+				{
+				case CurveChannel::LocalPositionX: translate.x = value + bindpose_[i].x; break;
+				case CurveChannel::LocalPositionY: translate.y = value + bindpose_[i].y; break;
+				case CurveChannel::LocalPositionZ: translate.z = value + bindpose_[i].z; break;
+				case CurveChannel::LocalScaleX: scale.x = value; break;
+				case CurveChannel::LocalScaleY: scale.y = value; break;
+				case CurveChannel::LocalScaleZ: scale.z = value; break;
+				case CurveChannel::LocalRotationX: quat.x = value; break;
+				case CurveChannel::LocalRotationY: quat.y = value; break;
+				case CurveChannel::LocalRotationZ: quat.z = value; break;
+				case CurveChannel::LocalRotationW: quat.w = value; break;
+				case CurveChannel::LocalEulerAnglesRawX: euler.x = value; break;
+				case CurveChannel::LocalEulerAnglesRawY: euler.y = value; break;
+				case CurveChannel::LocalEulerAnglesRawZ: euler.z = value; break;
+				default:
+					break;
+				}
 			}
 
 			transform->setLocalScale(scale);
@@ -293,56 +500,53 @@ namespace octoon
 			transform->setLocalQuaternion(math::Quaternion(euler));
 		}
 
-		this->sendMessage("octoon:animation:update");
+		hierarchy_.update();
+
+		static const GameMessageId updateEvent = GameMessage::id("octoon:animation:update");
+		this->sendMessage(updateEvent);
 	}
 
 	void
 	AnimatorComponent::updateAnimation(float delta) noexcept
 	{
-		for (auto& clip : animation_.clips)
+		auto transform = this->getComponent<TransformComponent>();
+
+		this->updateBakedAnimation();
+
+		for (std::size_t i = 0; i + 1 < clipBindings_.size(); i++)
 		{
-			if (clip.finish)
+			if (this->isClipFinished(i))
 				continue;
 
-			auto transform = this->getComponent<TransformComponent>();
 			auto scale = transform->getLocalScale();
 			auto quat = transform->getLocalQuaternion();
 			auto translate = transform->getLocalTranslate();
 			auto euler = transform->getLocalEulerAngles();
 			auto move = 0.0f;
 
-			for (auto& curve : clip.curves)
+			for (auto n = clipBindings_[i]; n < clipBindings_[i + 1]; n++)
 			{
-				if (curve.first == "LocalScale.x")
-					scale.x = curve.second.value;
-				else if (curve.first == "LocalScale.y")
-					scale.y = curve.second.value;
-				else if (curve.first == "LocalScale.z")
-					scale.z = curve.second.value;
-				else if (curve.first == "LocalPosition.x")
-					translate.x = curve.second.value;
-				else if (curve.first == "LocalPosition.y")
-					translate.y = curve.second.value;
-				else if (curve.first == "LocalPosition.z")
-					translate.z = curve.second.value;
-				else if (curve.first == "LocalRotation.x")
-					quat.x = curve.second.value;
-				else if (curve.first == "LocalRotation.y")
-					quat.y = curve.second.value;
-				else if (curve.first == "LocalRotation.z")
-					quat.z = curve.second.value;
-				else if (curve.first == "LocalRotation.w")
-					quat.w = curve.second.value;
-				else if (curve.first == "LocalEulerAnglesRaw.x")
-					euler.x = curve.second.value;
-				else if (curve.first == "LocalEulerAnglesRaw.y")
-					euler.y = curve.second.value;
-				else if (curve.first == "LocalEulerAnglesRaw.z")
-					euler.z = curve.second.value;
-				else if (curve.first == "Transform:move")
-					move = curve.second.value;
-				else
-					this->sendMessage(curve.first, curve.second.value);
+				auto& binding = bindings_[n];
+				auto value = *binding.value;
+
+				switch (binding.channel)
+				{
+				case CurveChannel::LocalPositionX: translate.x = value; break;
+				case CurveChannel::LocalPositionY: translate.y = value; break;
+				case CurveChannel::LocalPositionZ: translate.z = value; break;
+				case CurveChannel::LocalScaleX: scale.x = value; break;
+				case CurveChannel::LocalScaleY: scale.y = value; break;
+				case CurveChannel::LocalScaleZ: scale.z = value; break;
+				case CurveChannel::LocalRotationX: quat.x = value; break;
+				case CurveChannel::LocalRotationY: quat.y = value; break;
+				case CurveChannel::LocalRotationZ: quat.z = value; break;
+				case CurveChannel::LocalRotationW: quat.w = value; break;
+				case CurveChannel::LocalEulerAnglesRawX: euler.x = value; break;
+				case CurveChannel::LocalEulerAnglesRawY: euler.y = value; break;
+				case CurveChannel::LocalEulerAnglesRawZ: euler.z = value; break;
+				case CurveChannel::TransformMove: move = value; break;
+				case CurveChannel::Message: this->sendMessage(*binding.name, value); break;
+				}
 			}
 
 			if (move != 0.0f)
@@ -359,6 +563,7 @@ namespace octoon
 			}
 		}
 
-		this->sendMessage("octoon:animation:update");
+		static const GameMessageId updateEvent = GameMessage::id("octoon:animation:update");
+		this->sendMessage(updateEvent);
 	}
 }
\ No newline at end of file
@@ -0,0 +1,225 @@
+#include <octoon/baked_clip_loader.h>
+#include <octoon/runtime/profiler.h>
+#include <octoon/runtime/except.h>
+
+#include <cmath>
+
+namespace octoon
+{
+	constexpr std::uint32_t BakedClipVersion = 2;
+	constexpr std::uint32_t BakedClipAlignment = 64;
+
+	// Every block starts at an offset from the header aligned to BakedClipAlignment, so a mapped
+	// file can hand out the track table and the sample words in place.
+	struct BakedClipHeader
+	{
+		char magic[4];
+		std::uint32_t version;
+		float sampleRate;
+		float timeLength;
+		float maxError;
+		std::uint32_t numFrames;
+		std::uint32_t frameStride;
+		std::uint32_t numTracks;
+		std::uint32_t numCurves;
+		std::uint32_t nameOffset;
+		std::uint32_t nameLength;
+		std::uint32_t tracksOffset;
+		std::uint32_t curveNamesOffset;
+		std::uint32_t curveNamesSize;
+		std::uint64_t samplesOffset;
+	};
+
+	static_assert(sizeof(BakedClipHeader) == 64, "");
+	static_assert(sizeof(animation::BakedTrack) == 32, "");
+
+	static std::uint64_t align(std::uint64_t offset) noexcept
+	{
+		return (offset + BakedClipAlignment - 1) & ~static_cast<std::uint64_t>(BakedClipAlignment - 1);
+	}
+
+	static std::uint8_t getTrackStride(animation::BakedTrackType type) noexcept
+	{
+		switch (type)
+		{
+		case animation::BakedTrackType::Quantized: return 1;
+		case animation::BakedTrackType::Float: return 2;
+		case animation::BakedTrackType::Quaternion: return 3;
+		default:
+			return 0;
+		}
+	}
+
+	BakedClipLoader::BakedClipLoader() noexcept
+	{
+	}
+
+	BakedClipLoader::~BakedClipLoader() noexcept
+	{
+	}
+
+	bool
+	BakedClipLoader::doCanRead(io::istream& stream) noexcept
+	{
+		BakedClipHeader hdr;
+
+		if (stream.read((char*)&hdr, sizeof(hdr)))
+		{
+			if (std::strncmp(hdr.magic, "OBAC", 4) == 0 && hdr.version == BakedClipVersion)
+				return true;
+		}
+
+		return false;
+	}
+
+	bool
+	BakedClipLoader::doCanRead(const char* type) noexcept
+	{
+		return std::strncmp(type, "obac", 4) == 0;
+	}
+
+	animation::BakedAnimationClip
+	BakedClipLoader::load(io::istream& stream) noexcept(false)
+	{
+		OCTOON_PROFILE_CATEGORY("BakedClipLoader::load", "io");
+
+		auto base = stream.tellg();
+
+		BakedClipHeader hdr;
+		if (!stream.read((char*)&hdr, sizeof(hdr))) {
+			throw runtime::runtime_error::create(R"(Cannot read property "Header" from stream)");
+		}
+
+		if (std::strncmp(hdr.magic, "OBAC", 4) != 0 || hdr.version != BakedClipVersion) {
+			throw runtime::runtime_error::create(R"(Invalid baked clip header)");
+		}
+
+		if (!(hdr.sampleRate > 0.0f) || !std::isfinite(hdr.sampleRate) || !std::isfinite(hdr.timeLength) || hdr.numFrames == 0) {
+			throw runtime::runtime_error::create(R"(Invalid baked clip header)");
+		}
+
+		auto samplesSize = static_cast<std::uint64_t>(hdr.numFrames) * hdr.frameStride * sizeof(std::uint16_t);
+
+		if (hdr.nameOffset < sizeof(hdr) || hdr.nameOffset % BakedClipAlignment ||
+			hdr.tracksOffset < hdr.nameOffset + static_cast<std::uint64_t>(hdr.nameLength) || hdr.tracksOffset % BakedClipAlignment ||
+			hdr.curveNamesOffset < hdr.tracksOffset + static_cast<std::uint64_t>(hdr.numTracks) * sizeof(animation::BakedTrack) || hdr.curveNamesOffset % BakedClipAlignment ||
+			hdr.samplesOffset < hdr.curveNamesOffset + static_cast<std::uint64_t>(hdr.curveNamesSize) || hdr.samplesOffset % BakedClipAlignment ||
+			hdr.curveNamesSize < static_cast<std::uint64_t>(hdr.numCurves) * sizeof(std::uint32_t)) {
+			throw runtime::runtime_error::create(R"(Invalid baked clip layout)");
+		}
+
+		animation::BakedAnimationClip clip;
+		clip.sampleRate = hdr.sampleRate;
+		clip.timeLength = hdr.timeLength;
+		clip.maxError = hdr.maxError;
+		clip.numFrames = hdr.numFrames;
+		clip.frameStride = hdr.frameStride;
+
+		clip.name.resize(hdr.nameLength);
+		if (hdr.nameLength > 0 && !stream.seekg(static_cast<io::ios_base::off_type>(base + hdr.nameOffset)).read(clip.name.data(), hdr.nameLength)) {
+			throw runtime::runtime_error::create(R"(Cannot read property "Name" from stream)");
+		}
+
+		clip.tracks.resize(hdr.numTracks);
+		if (hdr.numTracks > 0 && !stream.seekg(static_cast<io::ios_base::off_type>(base + hdr.tracksOffset)).read((char*)clip.tracks.data(), sizeof(animation::BakedTrack) * hdr.numTracks)) {
+			throw runtime::runtime_error::create(R"(Cannot read property "Tracks" from stream)");
+		}
+
+		std::vector<char> curveNames(hdr.curveNamesSize);
+		if (!curveNames.empty() && !stream.seekg(static_cast<io::ios_base::off_type>(base + hdr.curveNamesOffset)).read(curveNames.data(), curveNames.size())) {
+			throw runtime::runtime_error::create(R"(Cannot read property "CurveNames" from stream)");
+		}
+
+		// The curve name block holds every name length first and then the characters back to back.
+		std::size_t position = static_cast<std::size_t>(hdr.numCurves) * sizeof(std::uint32_t);
+
+		clip.curveNames.resize(hdr.numCurves);
+		for (std::size_t i = 0; i < clip.curveNames.size(); i++)
+		{
+			std::uint32_t length = 0;
+			std::memcpy(&length, curveNames.data() + i * sizeof(std::uint32_t), sizeof(length));
+
+			if (length > curveNames.size() - position) {
+				throw runtime::runtime_error::create(R"(Cannot read property "CurveName" from stream)");
+			}
+
+			clip.curveNames[i].assign(curveNames.data() + position, length);
+			position += length;
+		}
+
+		for (auto& track : clip.tracks)
+		{
+			if (track.type > animation::BakedTrackType::ConstantQuaternion || track.stride != getTrackStride(track.type)) {
+				throw runtime::runtime_error::create(R"(Invalid baked clip track)");
+			}
+
+			auto numValues = track.type == animation::BakedTrackType::Quaternion || track.type == animation::BakedTrackType::ConstantQuaternion ? 4 : 1;
+			if (track.value + static_cast<std::uint64_t>(numValues) > hdr.numCurves || track.offset + track.stride > hdr.frameStride) {
+				throw runtime::runtime_error::create(R"(Invalid baked clip track)");
+			}
+
+			if (track.type == animation::BakedTrackType::Quantized && !(std::isfinite(track.minimum) && std::isfinite(track.extent) && track.extent > 0.0f)) {
+				throw runtime::runtime_error::create(R"(Invalid baked clip track)");
+			}
+		}
+
+		clip.samples.resize(static_cast<std::size_t>(samplesSize / sizeof(std::uint16_t)));
+		if (!clip.samples.empty() && !stream.seekg(static_cast<io::ios_base::off_type>(base + hdr.samplesOffset)).read((char*)clip.samples.data(), samplesSize)) {
+			throw runtime::runtime_error::create(R"(Cannot read property "Samples" from stream)");
+		}
+
+		return clip;
+	}
+
+	void
+	BakedClipLoader::save(io::ostream& stream, const animation::BakedAnimationClip& clip) noexcept(false)
+	{
+		std::vector<char> curveNames(clip.curveNames.size() * sizeof(std::uint32_t));
+		for (std::size_t i = 0; i < clip.curveNames.size(); i++)
+		{
+			auto length = static_cast<std::uint32_t>(clip.curveNames[i].size());
+			std::memcpy(curveNames.data() + i * sizeof(std::uint32_t), &length, sizeof(length));
+			curveNames.insert(curveNames.end(), clip.curveNames[i].begin(), clip.curveNames[i].end());
+		}
+
+		BakedClipHeader hdr;
+		std::memcpy(hdr.magic, "OBAC", 4);
+		hdr.version = BakedClipVersion;
+		hdr.sampleRate = clip.sampleRate;
+		hdr.timeLength = clip.timeLength;
+		hdr.maxError = clip.maxError;
+		hdr.numFrames = clip.numFrames;
+		hdr.frameStride = clip.frameStride;
+		hdr.numTracks = static_cast<std::uint32_t>(clip.tracks.size());
+		hdr.numCurves = static_cast<std::uint32_t>(clip.curveNames.size());
+		hdr.nameOffset = static_cast<std::uint32_t>(align(sizeof(hdr)));
+		hdr.nameLength = static_cast<std::uint32_t>(clip.name.size());
+		hdr.tracksOffset = static_cast<std::uint32_t>(align(hdr.nameOffset + hdr.nameLength));
+		hdr.curveNamesOffset = static_cast<std::uint32_t>(align(hdr.tracksOffset + sizeof(animation::BakedTrack) * clip.tracks.size()));
+		hdr.curveNamesSize = static_cast<std::uint32_t>(curveNames.size());
+		hdr.samplesOffset = align(hdr.curveNamesOffset + curveNames.size());
+
+		const char padding[BakedClipAlignment] = {};
+
+		std::uint64_t position = sizeof(hdr);
+		auto write = [&](std::uint64_t offset, const char* data, std::size_t size)
+		{
+			stream.write(padding, static_cast<std::streamsize>(offset - position));
+			stream.write(data, static_cast<std::streamsize>(size));
+			position = offset + size;
+		};
+
+		if (!stream.write((char*)&hdr, sizeof(hdr))) {
+			throw runtime::runtime_error::create(R"(Cannot write property "Header" to stream)");
+		}
+
+		write(hdr.nameOffset, clip.name.data(), clip.name.size());
+		write(hdr.tracksOffset, (char*)clip.tracks.data(), sizeof(animation::BakedTrack) * clip.tracks.size());
+		write(hdr.curveNamesOffset, curveNames.data(), curveNames.size());
+		write(hdr.samplesOffset, (char*)clip.samples.data(), clip.samples.size() * sizeof(std::uint16_t));
+
+		if (!stream) {
+			throw runtime::runtime_error::create(R"(Cannot write property "Samples" to stream)");
+		}
+	}
+}
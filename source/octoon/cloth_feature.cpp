@@ -49,7 +49,7 @@ namespace octoon
     void
 	ClothFeature::onActivate() except
     {
-		this->addMessageListener("feature:timer:fixed", std::bind(&ClothFeature::onFixedUpdate, this, std::placeholders::_1));
+		this->addMessageListener<float>(GameMessage::id("feature:timer:fixed"), std::bind(&ClothFeature::onFixedUpdate, this, std::placeholders::_1));
 
 		nv::cloth::InitializeNvCloth(defaultAllocatorCallback.get(), defaultErrorCallback.get(), nv::cloth::GetNvClothAssertHandler(), profileCallback_.get());
 
@@ -104,14 +104,11 @@ namespace octoon
     }
 
 	void
-	ClothFeature::onFixedUpdate(const std::any& data) noexcept
+	ClothFeature::onFixedUpdate(const float& delta) noexcept
 	{
-		if (data.type() == typeid(float))
-		{
-			timeInterval_ = std::any_cast<float>(data);
-			if (timeInterval_ > 0.0f)
-				needUpdate_ = true;
-		}
+		timeInterval_ = delta;
+		if (timeInterval_ > 0.0f)
+			needUpdate_ = true;
 	}
 
 	nv::cloth::Factory*
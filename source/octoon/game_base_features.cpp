@@ -32,7 +32,7 @@ namespace octoon
 	GameBaseFeature::onActivate() noexcept
     {
 		this->addMessageListener("feature:input:event", std::bind(&GameBaseFeature::onInputEvent, this, std::placeholders::_1));
-		this->addMessageListener("feature:timer:fixed", std::bind(&GameBaseFeature::onFixedUpdate, this, std::placeholders::_1));
+		this->addMessageListener<float>(GameMessage::id("feature:timer:fixed"), std::bind(&GameBaseFeature::onFixedUpdate, this, std::placeholders::_1));
     }
 
 	void
@@ -107,7 +107,7 @@ namespace octoon
 	}
 
 	void
-	GameBaseFeature::onFixedUpdate(const std::any& data) noexcept
+	GameBaseFeature::onFixedUpdate(const float& delta) noexcept
 	{
 		GameObjectManager::instance()->onFixedUpdate();
 	}
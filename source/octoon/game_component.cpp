@@ -231,6 +231,34 @@ namespace octoon
 		gameObject_->removeMessageListener(event, listener);
 	}
 
+	void
+	GameComponent::sendMessage(GameMessageId event, const std::any& data) noexcept
+	{
+		assert(gameObject_);
+		gameObject_->sendMessage(event, data);
+	}
+
+	void
+	GameComponent::sendMessageUpwards(GameMessageId event, const std::any& data) noexcept
+	{
+		assert(gameObject_);
+		gameObject_->sendMessageUpwards(event, data);
+	}
+
+	void
+	GameComponent::sendMessageDownwards(GameMessageId event, const std::any& data) noexcept
+	{
+		assert(gameObject_);
+		gameObject_->sendMessageDownwards(event, data);
+	}
+
+	void
+	GameComponent::removeMessageListener(GameMessageId event) noexcept
+	{
+		assert(gameObject_);
+		gameObject_->removeMessageListener(event, this);
+	}
+
 	GameFeature*
 	GameComponent::tryGetFeature(const runtime::Rtti* rtti) const noexcept
 	{
@@ -401,4 +429,10 @@ namespace octoon
 	GameComponent::onGui() except
 	{
 	}
+
+	bool
+	GameComponent::getUpdateFootprint(GameUpdateFootprint& footprint) const noexcept
+	{
+		return false;
+	}
 }
\ No newline at end of file
@@ -87,6 +87,41 @@ namespace octoon
 		server_->removeMessageListener(event, listener);
 	}
 
+	void
+	GameFeature::sendMessage(GameMessageId event, const std::any& data) noexcept
+	{
+		assert(server_);
+		server_->sendMessage(event, data);
+	}
+
+	void
+	GameFeature::addMessageListener(GameMessageId event, std::function<void(const std::any&)> listener) noexcept
+	{
+		assert(server_);
+		server_->addMessageListener(event, listener);
+	}
+
+	void
+	GameFeature::removeMessageListener(GameMessageId event, std::function<void(const std::any&)> listener) noexcept
+	{
+		assert(server_);
+		server_->removeMessageListener(event, listener);
+	}
+
+	void
+	GameFeature::removeMessageListener(GameMessageId event) noexcept
+	{
+		assert(server_);
+		server_->removeMessageListener(event, this);
+	}
+
+	GameMessageDispatcher&
+	GameFeature::getMessageDispatcher() const noexcept
+	{
+		assert(server_);
+		return server_->dispatchEvents_;
+	}
+
 	void
 	GameFeature::_setGameServer(GameServer* server) noexcept
 	{
@@ -0,0 +1,166 @@
+#include <octoon/game_message.h>
+
+#include <deque>
+#include <cassert>
+#include <algorithm>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace octoon
+{
+	namespace
+	{
+		struct MessageRegistry
+		{
+			std::shared_mutex mutex;
+			std::deque<std::string> names;
+			std::unordered_map<std::string_view, GameMessageId> ids;
+		};
+
+		MessageRegistry& registry() noexcept
+		{
+			static MessageRegistry instance;
+			return instance;
+		}
+	}
+
+	GameMessageId
+	GameMessage::id(std::string_view name) noexcept
+	{
+		auto id = GameMessage::find(name);
+		if (id != InvalidId)
+			return id;
+
+		auto& messages = registry();
+		std::unique_lock<std::shared_mutex> guard(messages.mutex);
+
+		auto it = messages.ids.find(name);
+		if (it != messages.ids.end())
+			return it->second;
+
+		id = static_cast<GameMessageId>(messages.names.size());
+		messages.names.emplace_back(name);
+		messages.ids.emplace(messages.names.back(), id);
+
+		return id;
+	}
+
+	GameMessageId
+	GameMessage::find(std::string_view name) noexcept
+	{
+		auto& messages = registry();
+		std::shared_lock<std::shared_mutex> guard(messages.mutex);
+
+		auto it = messages.ids.find(name);
+		if (it != messages.ids.end())
+			return it->second;
+
+		return InvalidId;
+	}
+
+	const std::string&
+	GameMessage::name(GameMessageId id) noexcept
+	{
+		static const std::string empty;
+
+		auto& messages = registry();
+		std::shared_lock<std::shared_mutex> guard(messages.mutex);
+
+		return id < messages.names.size() ? messages.names[id] : empty;
+	}
+
+	GameMessageDispatcher::GameMessageDispatcher() noexcept
+	{
+	}
+
+	GameMessageDispatcher::~GameMessageDispatcher() noexcept
+	{
+	}
+
+	void
+	GameMessageDispatcher::send(GameMessageId id, const std::any& data) noexcept
+	{
+		auto channel = this->getChannel(id);
+		if (channel)
+		{
+			if (data.has_value())
+				this->invoke(*channel, data.type(), nullptr, &data);
+
+			channel->listeners.call_all_slots(data);
+		}
+	}
+
+	void
+	GameMessageDispatcher::connect(GameMessageId id, std::function<void(const std::any&)> listener) noexcept
+	{
+		auto& channel = this->createChannel(id);
+		channel.listeners.connect(listener);
+		channel.boxed = true;
+	}
+
+	void
+	GameMessageDispatcher::disconnect(GameMessageId id, std::function<void(const std::any&)> listener) noexcept
+	{
+		auto channel = this->getChannel(id);
+		if (channel)
+			channel->listeners.disconnect(listener);
+	}
+
+	void
+	GameMessageDispatcher::connect(GameMessageId id, std::shared_ptr<Slot>&& slot) noexcept
+	{
+		this->createChannel(id).slots.push_back(std::move(slot));
+	}
+
+	void
+	GameMessageDispatcher::disconnect(GameMessageId id, const void* owner) noexcept
+	{
+		auto channel = this->getChannel(id);
+		if (channel)
+		{
+			auto& slots = channel->slots;
+			slots.erase(std::remove_if(slots.begin(), slots.end(), [owner](const std::shared_ptr<Slot>& it) { return it->owner == owner; }), slots.end());
+		}
+	}
+
+	void
+	GameMessageDispatcher::clear() noexcept
+	{
+		channels_.clear();
+	}
+
+	void
+	GameMessageDispatcher::invoke(Channel& channel, const std::type_info& type, const void* data, const std::any* boxed) noexcept
+	{
+		// Indexed and reference counted, so a listener may connect or disconnect while it is being called.
+		for (std::size_t i = 0; i < channel.slots.size(); i++)
+		{
+			auto slot = channel.slots[i];
+			if (*slot->type == type)
+				slot->invoke(data, boxed);
+		}
+	}
+
+	GameMessageDispatcher::Channel*
+	GameMessageDispatcher::getChannel(GameMessageId id) const noexcept
+	{
+		return id < channels_.size() ? channels_[id].get() : nullptr;
+	}
+
+	GameMessageDispatcher::Channel&
+	GameMessageDispatcher::createChannel(GameMessageId id) noexcept
+	{
+		assert(id != GameMessage::InvalidId);
+
+		if (id >= channels_.size())
+			channels_.resize(id + 1);
+
+		if (!channels_[id])
+		{
+			channels_[id] = std::make_unique<Channel>();
+			channels_[id]->boxed = false;
+		}
+
+		return *channels_[id];
+	}
+}
@@ -4,10 +4,14 @@
 #include <octoon/game_scene_manager.h>
 #include <octoon/transform_component.h>
 
+#include <atomic>
+
 namespace octoon
 {
 	OctoonImplementSubClass(GameObject, runtime::RttiInterface, "Object")
 
+	static std::atomic<std::size_t> hierarchyVersion = 0;
+
 	GameObject::GameObject() noexcept
 		: active_(true)
 		, layer_(0)
@@ -35,6 +39,8 @@ namespace octoon
 		this->cleanupComponents();
 
 		GameObjectManager::instance()->_unsetObject(this);
+
+		hierarchyVersion++;
 	}
 
 	void
@@ -158,6 +164,8 @@ namespace octoon
 			if (parent)
 				parent->children_.push_back(this->downcast_pointer<GameObject>());
 
+			hierarchyVersion++;
+
 			this->getComponent<TransformComponent>()->updateLocalChildren();
 			this->onMoveAfter();
 		}
@@ -240,10 +248,14 @@ namespace octoon
 	void
 	GameObject::cleanupChildren() noexcept
 	{
+		if (children_.empty())
+			return;
+
 		for (auto& it : children_)
 			it.reset();
 
 		children_.clear();
+		hierarchyVersion++;
 	}
 
 	GameObjectPtr
@@ -278,6 +290,12 @@ namespace octoon
 		return children_.size();
 	}
 
+	std::size_t
+	GameObject::getHierarchyVersion() noexcept
+	{
+		return hierarchyVersion;
+	}
+
 	GameObjects&
 	GameObject::getChildren() noexcept
 	{
@@ -313,6 +331,11 @@ namespace octoon
 				component->onAttachComponent(gameComponent);
 
 			components_.push_back(gameComponent);
+			this->updateComponentLookup();
+
+			hierarchyVersion++;
+
+			GameObjectManager::instance()->_addComponent(gameComponent.get());
 		}
 	}
 
@@ -336,21 +359,7 @@ namespace octoon
 
 		auto it = std::find_if(components_.begin(), components_.end(), [type](const GameComponentPtr& it) { return it->isA(type); });
 		if (it != components_.end())
-		{
-			components_.erase(it);
-
-			for (auto& compoent : components_)
-				compoent->onDetachComponent(*it);
-
-			for (auto& component : components_)
-				(*it)->onDetachComponent(component);
-
-			if (this->getActive() && (*it)->getActive())
-				(*it)->onDeactivate();
-
-			(*it)->onDetach();
-			(*it)->_setGameObject(nullptr);
-		}
+			this->removeComponent(GameComponentPtr(*it));
 	}
 
 	void
@@ -369,6 +378,11 @@ namespace octoon
 		if (it != components_.end())
 		{
 			components_.erase(it);
+			this->updateComponentLookup();
+
+			hierarchyVersion++;
+
+			GameObjectManager::instance()->_removeComponent(gameComponent.get());
 
 			for (auto& compoent : components_)
 				compoent->onDetachComponent(gameComponent);
@@ -394,6 +408,10 @@ namespace octoon
 			auto gameComponent = *it;
 			auto nextComponent = components_.erase(it);
 
+			hierarchyVersion++;
+
+			GameObjectManager::instance()->_removeComponent(gameComponent.get());
+
 			for (auto& compoent : components_)
 				compoent->onDetachComponent(gameComponent);
 
@@ -410,6 +428,8 @@ namespace octoon
 
 			it = nextComponent;
 		}
+
+		this->updateComponentLookup();
 	}
 
 	GameComponentPtr
@@ -417,11 +437,9 @@ namespace octoon
 	{
 		assert(type);
 
-		for (auto& it : components_)
-		{
-			if (it->isA(type))
-				return it;
-		}
+		auto it = componentLookup_.find(type);
+		if (it != componentLookup_.end())
+			return it->second;
 
 		return nullptr;
 	}
@@ -432,6 +450,20 @@ namespace octoon
 		return this->getComponent(&type);
 	}
 
+	void
+	GameObject::updateComponentLookup() noexcept
+	{
+		// Every type a component derives from maps to the first component of that type, so lookups
+		// are a single hash probe and never write, even when called from parallel updates.
+		componentLookup_.clear();
+
+		for (auto& it : components_)
+		{
+			for (const runtime::Rtti* type = it->rtti(); type; type = type->getParent())
+				componentLookup_.emplace(type, it);
+		}
+	}
+
 	void
 	GameObject::getComponents(const runtime::Rtti* type, GameComponents& components) const noexcept
 	{
@@ -593,13 +625,49 @@ namespace octoon
 	void
 	GameObject::sendMessage(std::string_view event, const std::any& data) noexcept
 	{
-		auto it = dispatchEvents_.find(event);
-		if (it != dispatchEvents_.end())
-			(*it).second.call_all_slots(data);
+		auto id = GameMessage::find(event);
+		if (id != GameMessage::InvalidId)
+			this->sendMessage(id, data);
 	}
 
 	void
 	GameObject::sendMessageUpwards(std::string_view event, const std::any& data) noexcept
+	{
+		auto id = GameMessage::find(event);
+		if (id != GameMessage::InvalidId)
+			this->sendMessageUpwards(id, data);
+	}
+
+	void
+	GameObject::sendMessageDownwards(std::string_view event, const std::any& data) noexcept
+	{
+		auto id = GameMessage::find(event);
+		if (id != GameMessage::InvalidId)
+			this->sendMessageDownwards(id, data);
+	}
+
+	void
+	GameObject::addMessageListener(std::string_view event, std::function<void(const std::any&)> listener) noexcept
+	{
+		dispatchEvents_.connect(GameMessage::id(event), std::move(listener));
+	}
+
+	void
+	GameObject::removeMessageListener(std::string_view event, std::function<void(const std::any&)> listener) noexcept
+	{
+		auto id = GameMessage::find(event);
+		if (id != GameMessage::InvalidId)
+			dispatchEvents_.disconnect(id, std::move(listener));
+	}
+
+	void
+	GameObject::sendMessage(GameMessageId event, const std::any& data) noexcept
+	{
+		dispatchEvents_.send(event, data);
+	}
+
+	void
+	GameObject::sendMessageUpwards(GameMessageId event, const std::any& data) noexcept
 	{
 		this->sendMessage(event, data);
 
@@ -609,7 +677,7 @@ namespace octoon
 	}
 
 	void
-	GameObject::sendMessageDownwards(std::string_view event, const std::any& data) noexcept
+	GameObject::sendMessageDownwards(GameMessageId event, const std::any& data) noexcept
 	{
 		this->sendMessage(event, data);
 
@@ -618,21 +686,21 @@ namespace octoon
 	}
 
 	void
-	GameObject::addMessageListener(std::string_view event, std::function<void(const std::any&)> listener) noexcept
+	GameObject::addMessageListener(GameMessageId event, std::function<void(const std::any&)> listener) noexcept
 	{
-		auto it = dispatchEvents_.find(event);
-		if (it != dispatchEvents_.end())
-			(*it).second.connect(listener);
-		else
-			dispatchEvents_[std::string(event)].connect(listener);
+		dispatchEvents_.connect(event, std::move(listener));
 	}
 
 	void
-	GameObject::removeMessageListener(std::string_view event, std::function<void(const std::any&)> listener) noexcept
+	GameObject::removeMessageListener(GameMessageId event, std::function<void(const std::any&)> listener) noexcept
+	{
+		dispatchEvents_.disconnect(event, std::move(listener));
+	}
+
+	void
+	GameObject::removeMessageListener(GameMessageId event, const void* owner) noexcept
 	{
-		auto it = dispatchEvents_.find(event);
-		if (it != dispatchEvents_.end())
-			(*it).second.disconnect(listener);
+		dispatchEvents_.disconnect(event, owner);
 	}
 
 	void
@@ -1,4 +1,5 @@
 #include <octoon/game_object_manager.h>
+#include <octoon/game_component.h>
 #include <octoon/mesh_filter_component.h>
 #include <octoon/transform_component.h>
 
@@ -64,6 +65,31 @@ namespace octoon
 		}
 	}
 
+	void
+	GameObjectManager::_addComponent(GameComponent* component) noexcept
+	{
+		assert(component);
+
+		std::unique_lock<std::shared_mutex> guard_lock(lock_);
+		componentTypes_[component->rtti()].push_back(component);
+	}
+
+	void
+	GameObjectManager::_removeComponent(GameComponent* component) noexcept
+	{
+		assert(component);
+
+		std::unique_lock<std::shared_mutex> guard_lock(lock_);
+
+		auto& components = componentTypes_[component->rtti()];
+		auto it = std::find(components.rbegin(), components.rend(), component);
+		if (it != components.rend())
+		{
+			*it = components.back();
+			components.pop_back();
+		}
+	}
+
 	GameObjectPtr
 	GameObjectManager::find(std::string_view name) noexcept
 	{
@@ -87,35 +113,91 @@ namespace octoon
 		return instanceLists_;
 	}
 
+	const GameComponentRaws&
+	GameObjectManager::getComponentsOfType(const runtime::Rtti* type) const noexcept
+	{
+		static const GameComponentRaws empty;
+
+		auto it = componentTypes_.find(type);
+		if (it != componentTypes_.end())
+			return it->second;
+
+		return empty;
+	}
+
+	const GameComponentRaws&
+	GameObjectManager::getComponentsOfType(const runtime::Rtti& type) const noexcept
+	{
+		return this->getComponentsOfType(&type);
+	}
+
 	void
 	GameObjectManager::sendMessage(std::string_view event, const std::any& data) noexcept
 	{
-		auto it = dispatchEvents_.find(event);
-		if (it != dispatchEvents_.end())
-			(*it).second.call_all_slots(data);
+		auto id = GameMessage::find(event);
+		if (id != GameMessage::InvalidId)
+			dispatchEvents_.send(id, data);
 	}
 
 	void
 	GameObjectManager::addMessageListener(std::string_view event, std::function<void(const std::any&)> listener) noexcept
 	{
-		auto it = dispatchEvents_.find(event);
-		if (it != dispatchEvents_.end())
-			(*it).second.connect(listener);
-		else
-			dispatchEvents_[std::string(event)].connect(listener);
+		dispatchEvents_.connect(GameMessage::id(event), std::move(listener));
 	}
 
 	void
 	GameObjectManager::removeMessageListener(std::string_view event, std::function<void(const std::any&)> listener) noexcept
 	{
-		auto it = dispatchEvents_.find(event);
-		if (it != dispatchEvents_.end())
-			(*it).second.disconnect(listener);
+		auto id = GameMessage::find(event);
+		if (id != GameMessage::InvalidId)
+			dispatchEvents_.disconnect(id, std::move(listener));
+	}
+
+	void
+	GameObjectManager::sendMessage(GameMessageId event, const std::any& data) noexcept
+	{
+		dispatchEvents_.send(event, data);
+	}
+
+	void
+	GameObjectManager::addMessageListener(GameMessageId event, std::function<void(const std::any&)> listener) noexcept
+	{
+		dispatchEvents_.connect(event, std::move(listener));
+	}
+
+	void
+	GameObjectManager::removeMessageListener(GameMessageId event, std::function<void(const std::any&)> listener) noexcept
+	{
+		dispatchEvents_.disconnect(event, std::move(listener));
+	}
+
+	void
+	GameObjectManager::setNumThreads(std::uint32_t numThreads) noexcept
+	{
+		jobSystem_.set_num_threads(numThreads);
+	}
+
+	std::uint32_t
+	GameObjectManager::getNumThreads() const noexcept
+	{
+		return jobSystem_.num_threads();
+	}
+
+	runtime::JobSystem&
+	GameObjectManager::getJobSystem() noexcept
+	{
+		return jobSystem_;
 	}
 
 	void
 	GameObjectManager::onFixedUpdate() except
 	{
+		if (jobSystem_.num_threads() > 0)
+		{
+			this->dispatchParallel(GameDispatchType::FixedUpdate);
+			return;
+		}
+
 		for (std::size_t i = 0; i < activeActors_.size(); i++)
 		{
 			if (activeActors_[i])
@@ -126,6 +208,12 @@ namespace octoon
 	void
 	GameObjectManager::onUpdate() except
 	{
+		if (jobSystem_.num_threads() > 0)
+		{
+			this->dispatchParallel(GameDispatchType::Frame);
+			return;
+		}
+
 		for (std::size_t i = 0; i < activeActors_.size(); i++)
 		{
 			if (activeActors_[i])
@@ -136,10 +224,17 @@ namespace octoon
 	void
 	GameObjectManager::onLateUpdate() except
 	{
-		for (std::size_t i = 0; i < activeActors_.size(); i++)
+		if (jobSystem_.num_threads() > 0)
 		{
-			if (activeActors_[i])
-				activeActors_[i]->onLateUpdate();
+			this->dispatchParallel(GameDispatchType::LateUpdate);
+		}
+		else
+		{
+			for (std::size_t i = 0; i < activeActors_.size(); i++)
+			{
+				if (activeActors_[i])
+					activeActors_[i]->onLateUpdate();
+			}
 		}
 
 		if (hasEmptyActors_)
@@ -165,4 +260,104 @@ namespace octoon
 				activeActors_[i]->onGui();
 		}
 	}
+
+	void
+	GameObjectManager::dispatchParallel(GameDispatchTypes type) except
+	{
+		parallelComponents_.clear();
+		footprints_.clear();
+
+		// Components keep their serial order. Opted-in components between two serial ones are collected,
+		// each going to the earliest wave after the last one that wrote what it reads or touched what it
+		// writes, and the waves are run before the next serial component.
+		for (std::size_t i = 0; i < activeActors_.size(); i++)
+		{
+			auto actor = activeActors_[i];
+			if (!actor || actor->dispatchComponents_.empty())
+				continue;
+
+			for (auto& component : actor->dispatchComponents_[type])
+			{
+				footprint_.reads.clear();
+				footprint_.writes.clear();
+
+				if (!component->getUpdateFootprint(footprint_))
+				{
+					this->dispatchWaves(type);
+					dispatchComponent(component, type);
+					continue;
+				}
+
+				std::uint32_t wave = 0;
+
+				for (auto& it : footprint_.reads)
+					wave = std::max(wave, footprints_[it].second);
+
+				for (auto& it : footprint_.writes)
+				{
+					auto& access = footprints_[it];
+					wave = std::max(wave, std::max(access.first, access.second));
+				}
+
+				for (auto& it : footprint_.reads)
+				{
+					auto& access = footprints_[it];
+					access.first = std::max(access.first, wave + 1);
+				}
+
+				for (auto& it : footprint_.writes)
+					footprints_[it].second = wave + 1;
+
+				parallelComponents_.emplace_back(wave, component);
+			}
+		}
+
+		this->dispatchWaves(type);
+	}
+
+	void
+	GameObjectManager::dispatchWaves(GameDispatchTypes type) except
+	{
+		if (parallelComponents_.empty())
+			return;
+
+		std::stable_sort(parallelComponents_.begin(), parallelComponents_.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+		for (std::size_t begin = 0, end = 0; begin < parallelComponents_.size(); begin = end)
+		{
+			end = begin + 1;
+			while (end < parallelComponents_.size() && parallelComponents_[end].first == parallelComponents_[begin].first)
+				end++;
+
+			// an exception thrown by a component comes back here once its wave has finished and
+			// ends the phase, as it would in the serial loop
+			jobSystem_.parallel_for(end - begin, 1, [this, begin, type](std::size_t first, std::size_t last)
+			{
+				for (auto n = begin + first; n < begin + last; n++)
+					dispatchComponent(parallelComponents_[n].second, type);
+			});
+		}
+
+		parallelComponents_.clear();
+		footprints_.clear();
+	}
+
+	void
+	GameObjectManager::dispatchComponent(GameComponent* component, GameDispatchTypes type) except
+	{
+		switch (type)
+		{
+		case GameDispatchType::FixedUpdate:
+			component->onFixedUpdate();
+			break;
+		case GameDispatchType::Frame:
+			component->onUpdate();
+			break;
+		case GameDispatchType::LateUpdate:
+			component->onLateUpdate();
+			break;
+		default:
+			break;
+		}
+	}
 }
\ No newline at end of file
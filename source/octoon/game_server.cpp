@@ -3,6 +3,7 @@
 #include <octoon/game_feature.h>
 #include <octoon/game_listener.h>
 #include <octoon/io/json_reader.h>
+#include <octoon/runtime/profiler.h>
 
 namespace octoon
 {
@@ -371,19 +372,47 @@ namespace octoon
 	void
 	GameServer::sendMessage(std::string_view event, const std::any& data) noexcept
 	{
-		dispatchEvents_[std::string(event)].call_all_slots(data);
+		auto id = GameMessage::find(event);
+		if (id != GameMessage::InvalidId)
+			dispatchEvents_.send(id, data);
 	}
 
 	void 
 	GameServer::addMessageListener(std::string_view event, std::function<void(const std::any&)> listener) noexcept
 	{
-		dispatchEvents_[std::string(event)].connect(listener);
+		dispatchEvents_.connect(GameMessage::id(event), std::move(listener));
 	}
 
 	void 
 	GameServer::removeMessageListener(std::string_view event, std::function<void(const std::any&)> listener) noexcept
 	{
-		dispatchEvents_[std::string(event)].disconnect(listener);
+		auto id = GameMessage::find(event);
+		if (id != GameMessage::InvalidId)
+			dispatchEvents_.disconnect(id, std::move(listener));
+	}
+
+	void
+	GameServer::sendMessage(GameMessageId event, const std::any& data) noexcept
+	{
+		dispatchEvents_.send(event, data);
+	}
+
+	void
+	GameServer::addMessageListener(GameMessageId event, std::function<void(const std::any&)> listener) noexcept
+	{
+		dispatchEvents_.connect(event, std::move(listener));
+	}
+
+	void
+	GameServer::removeMessageListener(GameMessageId event, std::function<void(const std::any&)> listener) noexcept
+	{
+		dispatchEvents_.disconnect(event, std::move(listener));
+	}
+
+	void
+	GameServer::removeMessageListener(GameMessageId event, const void* owner) noexcept
+	{
+		dispatchEvents_.disconnect(event, owner);
 	}
 
 	void
@@ -404,18 +433,29 @@ namespace octoon
 		if (this->isQuitRequest() || !this->getActive())
 			return;
 
+		OCTOON_PROFILE_CATEGORY("GameServer::update", "frame");
+
 		try
 		{
 			if (!isQuitRequest_)
 			{
 				for (auto& it : features_)
+				{
+					OCTOON_PROFILE_CATEGORY(it->type_name(), "feature");
 					it->onFrameBegin();
+				}
 
 				for (auto& it : features_)
+				{
+					OCTOON_PROFILE_CATEGORY(it->type_name(), "feature");
 					it->onFrame();
+				}
 
 				for (auto& it : features_)
+				{
+					OCTOON_PROFILE_CATEGORY(it->type_name(), "feature");
 					it->onFrameEnd();
+				}
 			}
 		}
 		catch (const std::exception& e)
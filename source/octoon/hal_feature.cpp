@@ -8,10 +8,17 @@ namespace octoon
 {
 	OctoonImplementSubClass(GraphicsFeature, GameFeature, "GraphicsFeature")
 
+#if defined(OCTOON_BUILD_PLATFORM_EMSCRIPTEN)
+	constexpr hal::GraphicsDeviceType DefaultDeviceType = hal::GraphicsDeviceType::OpenGL20;
+#else
+	constexpr hal::GraphicsDeviceType DefaultDeviceType = hal::GraphicsDeviceType::OpenGL33;
+#endif
+
 	GraphicsFeature::GraphicsFeature() noexcept
 		: window_(0)
 		, framebuffer_w_(0)
 		, framebuffer_h_(0)
+		, deviceType_(DefaultDeviceType)
 	{
 	}
 
@@ -19,6 +26,7 @@ namespace octoon
 		: window_(window)
 		, framebuffer_w_(framebuffer_w)
 		, framebuffer_h_(framebuffer_h)
+		, deviceType_(DefaultDeviceType)
 	{
 	}
 
@@ -46,6 +54,19 @@ namespace octoon
 		h = framebuffer_h_;
 	}
 
+	void
+	GraphicsFeature::setDeviceType(hal::GraphicsDeviceType type) noexcept
+	{
+		assert(!device_);
+		deviceType_ = type;
+	}
+
+	hal::GraphicsDeviceType
+	GraphicsFeature::getDeviceType() const noexcept
+	{
+		return deviceType_;
+	}
+
 	const hal::GraphicsDevicePtr&
 	GraphicsFeature::getDevice() const noexcept
 	{
@@ -70,11 +91,7 @@ namespace octoon
 		this->addMessageListener("feature:input:event", std::bind(&GraphicsFeature::onInputEvent, this, std::placeholders::_1));
 
 		hal::GraphicsDeviceDesc deviceDesc;
-#if defined(OCTOON_BUILD_PLATFORM_EMSCRIPTEN)
-		deviceDesc.setDeviceType(hal::GraphicsDeviceType::OpenGL20);
-#else
-		deviceDesc.setDeviceType(hal::GraphicsDeviceType::OpenGL33);
-#endif
+		deviceDesc.setDeviceType(deviceType_);
 
 #if defined(__DEBUG__)
 		deviceDesc.setDebugControl(true);
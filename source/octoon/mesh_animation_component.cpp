@@ -519,16 +519,22 @@ namespace octoon
 					auto sampleSelector = Alembic::Abc::ISampleSelector(animationState_.time, ISampleSelector::kNearIndex);
 					schema.get(sample, sampleSelector);
 
-					if (!mesh_)
+					// homogeneous samples share the first topology, which keeps the cached normal adjacency valid
+					if (!mesh_ || schema.getTopologyVariance() == kHeterogenousTopology)
 					{
-						mesh_ = std::make_shared<mesh::Mesh>();
-						mesh_->setIndicesArray(math::uint1s());
+						math::uint1s indices;
+						read_indices(schema, sample, indices);
 
-						read_uvs(schema, sample, this->mesh_->getTexcoordArray());
+						if (!mesh_)
+						{
+							mesh_ = std::make_shared<mesh::Mesh>();
+							read_uvs(schema, sample, this->mesh_->getTexcoordArray());
+						}
+
+						this->mesh_->setIndicesArray(std::move(indices));
 					}
 
 					read_position(schema, sample, this->mesh_->getVertexArray());
-					read_indices(schema, sample, this->mesh_->getIndicesArray());
 
 					this->mesh_->computeBoundingBox();
 					this->mesh_->computeVertexNormals();
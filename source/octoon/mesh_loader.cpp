@@ -1,4 +1,5 @@
 #include <octoon/mesh_loader.h>
+#include <octoon/runtime/profiler.h>
 #include <octoon/model/model.h>
 #include <octoon/runtime/string.h>
 
@@ -332,6 +333,8 @@ namespace octoon
 	GameObjectPtr
 	MeshLoader::load(std::string_view filepath, GameObjects& rigidbody, bool cache) noexcept(false)
 	{
+		OCTOON_PROFILE_CATEGORY("MeshLoader::load", "io");
+
 		model::Model model;
 
 		PmxLoader load;
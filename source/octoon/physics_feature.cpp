@@ -35,7 +35,7 @@ namespace octoon
     void
 	PhysicsFeature::onActivate() except
     {
-		this->addMessageListener("feature:timer:fixed", std::bind(&PhysicsFeature::onFixedUpdate, this, std::placeholders::_1));
+		this->addMessageListener<float>(GameMessage::id("feature:timer:fixed"), std::bind(&PhysicsFeature::onFixedUpdate, this, std::placeholders::_1));
 
 		physics::PhysicsSceneDesc physicsSceneDesc;
 		physicsSceneDesc.gravity = gravity_;
@@ -47,7 +47,7 @@ namespace octoon
     void
 	PhysicsFeature::onDeactivate() noexcept
     {
-		this->removeMessageListener("feature:timer:fixed", std::bind(&PhysicsFeature::onFixedUpdate, this, std::placeholders::_1));
+		this->removeMessageListener(GameMessage::id("feature:timer:fixed"));
 
 		physics_scene.reset();
 		physics_context.reset();
@@ -82,14 +82,11 @@ namespace octoon
     }
 
 	void
-	PhysicsFeature::onFixedUpdate(const std::any& data) noexcept
+	PhysicsFeature::onFixedUpdate(const float& delta) noexcept
 	{
-		if (data.type() == typeid(float))
-		{
-			timeInterval_ = std::any_cast<float>(data);
-			if (timeInterval_ > 0.0f)
-				needUpdate_ = true;
-		}
+		timeInterval_ = delta;
+		if (timeInterval_ > 0.0f)
+			needUpdate_ = true;
 	}
 
 	std::shared_ptr<physics::PhysicsContext>
@@ -8,6 +8,7 @@
 #include <octoon/math/mathfwd.h>
 #include <octoon/math/mathutil.h>
 #include <octoon/runtime/string.h>
+#include <octoon/runtime/profiler.h>
 
 #include <map>
 #include <cstring>
@@ -43,6 +44,8 @@ namespace octoon
 
 	bool PmxLoader::doLoad(std::string_view filepath, PMX& pmx) noexcept
 	{
+		OCTOON_PROFILE_CATEGORY("PmxLoader::load", "io");
+
 		io::ifstream stream;
 		if (!stream.open(std::string(filepath))) return false;
 
@@ -650,6 +653,11 @@ namespace octoon
 		if (pmx.numBones)
 			weights.resize(pmx.numVertices);
 
+		skelecton::VertexSdefs sdefs;
+
+		if (pmx.numBones && std::any_of(pmx.vertices.begin(), pmx.vertices.end(), [](const PmxVertex& v) { return v.type == PMX_SDEF; }))
+			sdefs.resize(pmx.numVertices);
+
 		for (std::size_t i = 0; i < pmx.numVertices; i++)
 		{
 			auto& v = pmx.vertices[i];
@@ -671,6 +679,15 @@ namespace octoon
 				weight.bone4 = v.weight.bone4 < pmx.numBones ? v.weight.bone4 : 0;
 
 				weights[i] = weight;
+
+				if (!sdefs.empty())
+				{
+					auto& sdef = sdefs[i];
+					sdef.enable = v.type == PMX_SDEF;
+					sdef.c[0] = v.weight.SDEF_C.x; sdef.c[1] = v.weight.SDEF_C.y; sdef.c[2] = v.weight.SDEF_C.z;
+					sdef.r0[0] = v.weight.SDEF_R0.x; sdef.r0[1] = v.weight.SDEF_R0.y; sdef.r0[2] = v.weight.SDEF_R0.z;
+					sdef.r1[0] = v.weight.SDEF_R1.x; sdef.r1[1] = v.weight.SDEF_R1.y; sdef.r1[2] = v.weight.SDEF_R1.z;
+				}
 			}
 		}
 
@@ -680,6 +697,7 @@ namespace octoon
 		mesh->setNormalArray(std::move(normals_));
 		mesh->setTexcoordArray(std::move(texcoords_));
 		mesh->setWeightArray(std::move(weights));
+		mesh->setSdefArray(std::move(sdefs));
 
 		PmxUInt32 startIndices = 0;
 
@@ -32,9 +32,11 @@ namespace octoon
 	void
 	SkinnedComponent::setControl(float control) noexcept
 	{
+		static const GameMessageId updateEvent = GameMessage::id("octoon:animation:update");
+
 		if (control_ != control)
 		{
-			this->sendMessage("octoon:animation:update");
+			this->sendMessage(updateEvent);
 			control_ = control;
 		}
 	}
@@ -9,10 +9,13 @@ namespace octoon
 
 	SkinnedMeshRendererComponent::SkinnedMeshRendererComponent() noexcept
 		: needUpdate_(true)
+		, needUpdateMorph_(true)
 		, clothEnable_(true)
 		, morphEnable_(true)
 		, textureEnable_(true)
+		, textureBlended_(false)
 	{
+		skinning_.setMode(mesh::SkinningMode::Sdef);
 	}
 
 	SkinnedMeshRendererComponent::SkinnedMeshRendererComponent(material::Materials&& materials, GameObjects&& transforms) noexcept
@@ -58,7 +61,7 @@ namespace octoon
 	SkinnedMeshRendererComponent::setTransforms(GameObjects&& transforms) noexcept
 	{
 		transforms_ = std::move(transforms);
-		quaternions_.resize(transforms.size());
+		quaternions_.resize(transforms_.size());
 	}
 
 	const GameObjects&
@@ -103,6 +106,22 @@ namespace octoon
 		return textureEnable_;
 	}
 
+	void
+	SkinnedMeshRendererComponent::setSkinningMode(mesh::SkinningMode mode) noexcept
+	{
+		if (skinning_.getMode() != mode)
+		{
+			skinning_.setMode(mode);
+			needUpdate_ = true;
+		}
+	}
+
+	mesh::SkinningMode
+	SkinnedMeshRendererComponent::getSkinningMode() const noexcept
+	{
+		return skinning_.getMode();
+	}
+
 	const mesh::MeshPtr&
 	SkinnedMeshRendererComponent::getSkinnedMesh() const noexcept
 	{
@@ -114,6 +133,12 @@ namespace octoon
 	{
 		mesh_ = mesh;
 		needUpdate_ = false;
+		needUpdateMorph_ = true;
+		textureControls_.clear();
+
+		if (mesh_)
+			skinning_.setMesh(*mesh_);
+
 		this->updateMeshData();
 	}
 
@@ -122,26 +147,28 @@ namespace octoon
 	{
 		if (mesh_)
 		{
-			if (this->skinnedMesh_)
-			{
-				this->skinnedMesh_->setVertexArray(mesh_->getVertexArray());
-				this->skinnedMesh_->setNormalArray(mesh_->getNormalArray());
-			}
-			else
+			if (!this->skinnedMesh_)
 			{
 				skinnedMesh_ = mesh_->clone();
+				skinning_.invalidate();
+				textureControls_.clear();
+				textureBlended_ = false;
 			}
 
+			skinning_.resetVertices();
+
 			this->updateJointData();
-			this->updateClothBlendData();
 			this->updateMorphBlendData();
-			this->updateTextureBlendData();
-			this->updateBoneData();
+			this->updateClothBlendData();
 
-			skinnedMesh_->computeBoundingBox();
-			skinnedMesh_->setDirty(true);
+			auto texcoordChanged = this->updateTextureBlendData();
 
-			MeshRendererComponent::uploadMeshData(skinnedMesh_);
+			// the skinned mesh is left untouched when neither the joints, the blended vertices nor the blended texcoords changed
+			if (this->updateBoneData() || texcoordChanged)
+			{
+				skinnedMesh_->setDirty(true);
+				MeshRendererComponent::uploadMeshData(skinnedMesh_);
+			}
 		}
 		else
 		{
@@ -155,6 +182,7 @@ namespace octoon
 		auto instance = std::make_shared<SkinnedMeshRendererComponent>();
 		instance->setName(this->getName());
 		instance->setTransforms(this->getTransforms());
+		instance->setSkinningMode(this->getSkinningMode());
 		instance->setMaterial(this->getMaterial() ? (this->isSharedMaterial() ? this->getMaterial() : this->getMaterial()->clone()) : nullptr, this->isSharedMaterial());
 
 		return instance;
@@ -207,9 +235,15 @@ namespace octoon
 	SkinnedMeshRendererComponent::onAttachComponent(const GameComponentPtr& component) noexcept
 	{
 		if (component->isInstanceOf<SkinnedMorphComponent>())
+		{
 			morphComponents_.push_back(component.get()->downcast<SkinnedMorphComponent>());
+			needUpdateMorph_ = true;
+		}
 		else if (component->isInstanceOf<SkinnedTextureComponent>())
+		{
 			textureComponents_.push_back(component.get()->downcast<SkinnedTextureComponent>());
+			textureControls_.clear();
+		}
 		else if (component->isInstanceOf<ClothComponent>())
 			clothComponents_.push_back(component.get()->downcast<ClothComponent>());		
 	}
@@ -221,13 +255,19 @@ namespace octoon
 		{
 			auto it = std::find(morphComponents_.begin(), morphComponents_.end(), component.get());
 			if (it != morphComponents_.end())
+			{
 				morphComponents_.erase(it);
+				needUpdateMorph_ = true;
+			}
 		}
 		else if (component->isInstanceOf<SkinnedTextureComponent>())
 		{
 			auto it = std::find(textureComponents_.begin(), textureComponents_.end(), component.get());
 			if (it != textureComponents_.end())
+			{
 				textureComponents_.erase(it);
+				textureControls_.clear();
+			}
 		}
 		else if (component->isInstanceOf<ClothComponent>())
 		{
@@ -274,6 +314,8 @@ namespace octoon
 			joints_[i].makeIdentity();
 		}
 
+		skinning_.setJoints(joints_);
+
 		/*if (!jointData_)
 		{
 			hal::GraphicsDataDesc jointDesc;
@@ -285,35 +327,17 @@ namespace octoon
 		}*/
 	}
 
-	void
+	bool
 	SkinnedMeshRendererComponent::updateBoneData() noexcept
 	{
-		auto& vertices = skinnedMesh_->getVertexArray();
-		auto& normals = skinnedMesh_->getNormalArray();
-		auto& weights = skinnedMesh_->getWeightArray();
-
-		auto numVertices = skinnedMesh_->getNumVertices();
-
-#		pragma omp parallel for num_threads(4)
-		for (std::int32_t i = 0; i < numVertices; i++)
+		if (skinning_.update(skinnedMesh_->getVertexArray(), skinnedMesh_->getNormalArray()))
 		{
-			auto& blend = weights[i];
-
-			math::float3 v = math::float3::Zero;
-			math::float3 n = math::float3::Zero;
-
-			for (std::uint8_t j = 0; j < 4; j++)
-			{
-				auto w = blend.weights[j];
-				if (w == 0.0f)
-					break;
-				v += (joints_[blend.bones[j]] * vertices[i]) * w;
-				n += ((math::float3x3)joints_[blend.bones[j]] * normals[i]) * w;
-			}
-
-			vertices[i] = v;
-			normals[i] = n;
+			skinning_.computeBoundingBoxes(boundingBoxes_);
+			skinnedMesh_->setBoundingBoxes(boundingBoxes_);
+			return true;
 		}
+
+		return false;
 	}
 
 	void
@@ -321,8 +345,6 @@ namespace octoon
 	{
 		if (clothEnable_)
 		{
-			auto& dstVertices = skinnedMesh_->getVertexArray();
-
 			for (auto& it : clothComponents_)
 			{
 				auto& indices = it->getIndices();
@@ -330,7 +352,7 @@ namespace octoon
 
 				std::size_t numIndices = indices.size();
 				for (std::size_t i = 0; i < numIndices; i++)
-					dstVertices[indices[i]] = partices[i].xyz();
+					skinning_.setVertex(indices[i], partices[i].xyz());
 			}
 		}
 	}
@@ -338,48 +360,75 @@ namespace octoon
 	void
 	SkinnedMeshRendererComponent::updateMorphBlendData() noexcept
 	{
-		if (morphEnable_)
+		if (needUpdateMorph_)
 		{
-			auto& dstVertices = skinnedMesh_->getVertexArray();
+			morphing_.setNumVertices(skinning_.getNumVertices());
 
 			for (auto& it : morphComponents_)
-			{
-				auto control = it->getControl();
-				if (control > 0.0f)
-				{
-					auto& indices = it->getIndices();
-					auto& offsets = it->getOffsets();
+				morphing_.addMorph(it->getIndices(), it->getOffsets());
 
-					auto numIndices = indices.size();
-
-					for (std::size_t i = 0; i < numIndices; i++)
-						dstVertices[indices[i]] += offsets[i] * control;
-				}
-			}
+			needUpdateMorph_ = false;
 		}
+
+		for (std::size_t i = 0; i < morphComponents_.size(); i++)
+			morphing_.setWeight(i, morphEnable_ ? std::max(0.0f, morphComponents_[i]->getControl()) : 0.0f);
+
+		morphing_.update(skinning_);
 	}
 
-	void
+	bool
 	SkinnedMeshRendererComponent::updateTextureBlendData() noexcept
 	{
-		if (textureEnable_)
+		auto numTextures = textureComponents_.size();
+		auto changed = textureControls_.size() != numTextures;
+
+		textureControls_.resize(numTextures, 0.0f);
+
+		auto blended = false;
+
+		for (std::size_t i = 0; i < numTextures; i++)
 		{
-			auto& dstTextures = skinnedMesh_->getTexcoordArray();
+			auto control = textureEnable_ ? std::max(0.0f, textureComponents_[i]->getControl()) : 0.0f;
+			if (textureControls_[i] != control)
+			{
+				textureControls_[i] = control;
+				changed = true;
+			}
+
+			blended |= control > 0.0f;
+		}
 
-			for (auto& it : textureComponents_)
+		// the blended coordinates stay in the skinned mesh until a control moves, and a mesh that never
+		// had a texture morph applied is not touched at all
+		if (!changed || (!blended && !textureBlended_))
+			return false;
+
+		auto& srcTextures = mesh_->getTexcoordArray();
+		auto& dstTextures = skinnedMesh_->getTexcoordArray();
+
+		dstTextures = srcTextures;
+
+		for (std::size_t i = 0; i < numTextures; i++)
+		{
+			auto control = textureControls_[i];
+			if (control > 0.0f)
 			{
-				auto control = it->getControl();
-				if (control > 0.0f)
-				{
-					auto& indices = it->getIndices();
-					auto& offsets = it->getOffsets();
+				auto& indices = textureComponents_[i]->getIndices();
+				auto& offsets = textureComponents_[i]->getOffsets();
 
-					auto numIndices = indices.size();
+				auto numIndices = std::min(indices.size(), offsets.size());
 
-					for (std::size_t i = 0; i < numIndices; i++)
-						dstTextures[indices[i]] += offsets[i] * control;
+				for (std::size_t j = 0; j < numIndices; j++)
+				{
+					if (indices[j] < dstTextures.size())
+						dstTextures[indices[j]] += offsets[j] * control;
 				}
 			}
 		}
+
+		textureBlended_ = blended;
+		skinnedMesh_->setTexcoordDirty();
+
+		return true;
 	}
 }
\ No newline at end of file
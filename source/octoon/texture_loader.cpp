@@ -1,4 +1,5 @@
 #include <octoon/texture_loader.h>
+#include <octoon/runtime/profiler.h>
 #include <octoon/image/image.h>
 #include <octoon/runtime/except.h>
 #include <octoon/hal/graphics_texture.h>
@@ -13,6 +14,8 @@ namespace octoon
 	hal::GraphicsTexturePtr
 	TextureLoader::load(std::string_view filepath, bool generateMipmap, bool cache) noexcept(false)
 	{
+		OCTOON_PROFILE_CATEGORY("TextureLoader::load", "io");
+
 		assert(!filepath.empty());
 
 		auto it = textureCaches_.find(filepath);
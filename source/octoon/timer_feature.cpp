@@ -120,9 +120,11 @@ namespace octoon
 
 		time_ += timer_->delta();
 
+		static const GameMessageId fixedEvent = GameMessage::id("feature:timer:fixed");
+
 		while (time_ > timeStep_)
 		{
-			this->sendMessage("feature:timer:fixed", timeInterval_);
+			this->sendMessage(fixedEvent, timeInterval_);
 			time_  -= timeStep_;
 		}
 	}
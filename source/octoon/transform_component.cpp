@@ -467,6 +467,11 @@ namespace octoon
 	void
 	TransformComponent::updateLocalChildren() const noexcept
 	{
+		// A dirty node always has a dirty subtree, because a world transform is only resolved after its parent's.
+		// Stopping here keeps repeated setters on the same bone from walking the subtree again every time.
+		if (world_need_updates_)
+			return;
+
 		world_need_updates_ = true;
 
 		for (auto& it : this->getGameObject()->getChildren())
@@ -501,11 +506,7 @@ namespace octoon
 			auto parent = this->getGameObject()->getParent();
 			if (parent)
 			{
-				auto& baseTransform = parent->getComponent<TransformComponent>()->getTransform();
-				transform_ = math::transformMultiply(baseTransform, this->getLocalTransform());
-				transform_.getTransform(translate_, rotation_, scaling_);
-				transform_inverse_ = math::transformInverse(transform_);
-				euler_angles_ = math::eulerAngles(rotation_);
+				this->updateWorldTransform(parent->getComponent<TransformComponent>()->getTransform());
 			}
 			else
 			{
@@ -522,6 +523,17 @@ namespace octoon
 		}
 	}
 
+	void
+	TransformComponent::updateWorldTransform(const math::float4x4& baseTransform) const noexcept
+	{
+		transform_ = math::transformMultiply(baseTransform, this->getLocalTransform());
+		transform_.getTransform(translate_, rotation_, scaling_);
+		transform_inverse_ = math::transformInverse(transform_);
+		euler_angles_ = math::eulerAngles(rotation_);
+
+		world_need_updates_ = false;
+	}
+
 	void
 	TransformComponent::updateParentTransform() const noexcept
 	{
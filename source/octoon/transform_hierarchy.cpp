@@ -0,0 +1,186 @@
+#include <octoon/transform_hierarchy.h>
+#include <octoon/transform_component.h>
+
+#include <unordered_set>
+
+namespace octoon
+{
+	TransformHierarchy::TransformHierarchy() noexcept
+		: parallel_(false)
+		, version_(0)
+	{
+	}
+
+	TransformHierarchy::TransformHierarchy(const GameObjects& objects) noexcept
+		: TransformHierarchy()
+	{
+		this->build(objects);
+	}
+
+	TransformHierarchy::~TransformHierarchy() noexcept
+	{
+	}
+
+	void
+	TransformHierarchy::build(const GameObjects& objects) noexcept
+	{
+		this->clear();
+
+		for (auto& object : objects)
+		{
+			if (object)
+				objects_.push_back(object);
+		}
+
+		this->rebuild();
+	}
+
+	void
+	TransformHierarchy::rebuild() noexcept
+	{
+		GameObjects objects;
+		objects.reserve(objects_.size());
+
+		for (auto& object : objects_)
+		{
+			auto locked = object.lock();
+			if (locked)
+				objects.push_back(std::move(locked));
+		}
+
+		transforms_.clear();
+		parents_.clear();
+		roots_.clear();
+
+		version_ = GameObject::getHierarchyVersion();
+
+		std::unordered_set<const GameObject*> selected;
+		for (auto& object : objects)
+			selected.insert(object.get());
+
+		// Objects below another selected object are reached through their ancestor,
+		// so every remaining object starts an independent subtree.
+		for (auto& object : objects)
+		{
+			auto parent = object->getParent();
+			while (parent && !selected.count(parent))
+				parent = parent->getParent();
+
+			if (parent)
+				continue;
+
+			roots_.push_back(transforms_.size());
+			this->flatten(object.get(), -1);
+		}
+
+		roots_.push_back(transforms_.size());
+		dirty_.resize(transforms_.size());
+	}
+
+	void
+	TransformHierarchy::clear() noexcept
+	{
+		objects_.clear();
+		transforms_.clear();
+		parents_.clear();
+		dirty_.clear();
+		roots_.clear();
+	}
+
+	bool
+	TransformHierarchy::empty() const noexcept
+	{
+		return transforms_.empty();
+	}
+
+	std::size_t
+	TransformHierarchy::size() const noexcept
+	{
+		return transforms_.size();
+	}
+
+	std::size_t
+	TransformHierarchy::getNumRoots() const noexcept
+	{
+		return roots_.empty() ? 0 : roots_.size() - 1;
+	}
+
+	void
+	TransformHierarchy::setParallel(bool enable) noexcept
+	{
+		parallel_ = enable;
+	}
+
+	bool
+	TransformHierarchy::getParallel() const noexcept
+	{
+		return parallel_;
+	}
+
+	std::size_t
+	TransformHierarchy::update() noexcept
+	{
+		if (version_ != GameObject::getHierarchyVersion())
+			this->rebuild();
+
+		std::size_t count = 0;
+
+		for (std::size_t i = 0; i < transforms_.size(); i++)
+		{
+			dirty_[i] = transforms_[i]->world_need_updates_;
+			count += dirty_[i];
+		}
+
+		if (count == 0)
+			return 0;
+
+		auto numRoots = static_cast<std::int32_t>(this->getNumRoots());
+
+		// Roots may hang below objects outside of the hierarchy that share ancestors,
+		// so they are resolved through the regular lazy path before the subtrees split up.
+		for (std::int32_t i = 0; i < numRoots; i++)
+		{
+			if (dirty_[roots_[i]])
+				transforms_[roots_[i]]->updateWorldTransform();
+		}
+
+		if (parallel_ && numRoots > 1)
+		{
+#			pragma omp parallel for schedule(dynamic)
+			for (std::int32_t i = 0; i < numRoots; i++)
+				this->updateRange(roots_[i], roots_[i + 1]);
+		}
+		else
+		{
+			this->updateRange(0, transforms_.size());
+		}
+
+		return count;
+	}
+
+	void
+	TransformHierarchy::flatten(const GameObject* object, std::int32_t parent) noexcept
+	{
+		auto transform = object->getComponent<TransformComponent>();
+		if (!transform)
+			return;
+
+		auto index = static_cast<std::int32_t>(transforms_.size());
+
+		transforms_.push_back(transform.get());
+		parents_.push_back(parent);
+
+		for (auto& child : object->getChildren())
+			this->flatten(child.get(), index);
+	}
+
+	void
+	TransformHierarchy::updateRange(std::size_t begin, std::size_t end) noexcept
+	{
+		for (std::size_t i = begin; i < end; i++)
+		{
+			if (dirty_[i] && parents_[i] >= 0)
+				transforms_[i]->updateWorldTransform(transforms_[parents_[i]]->transform_);
+		}
+	}
+}
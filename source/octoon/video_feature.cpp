@@ -147,6 +147,18 @@ namespace octoon
 		return video::Renderer::instance()->readColorBuffer(data);
 	}
 
+	video::ReadbackStatus
+	VideoFeature::readColorBuffer(std::uint64_t ticket, math::float3 data[], bool wait)
+	{
+		return video::Renderer::instance()->readColorBuffer(ticket, data, wait);
+	}
+
+	std::uint64_t
+	VideoFeature::readColorBufferAsync()
+	{
+		return video::Renderer::instance()->readColorBufferAsync();
+	}
+
 	void
 	VideoFeature::readAlbedoBuffer(math::float3 data[])
 	{
@@ -1,9 +1,11 @@
 #include <octoon/vmd_loader.h>
+#include <octoon/runtime/profiler.h>
 #include <octoon/math/vector2.h>
 #include <octoon/math/vector3.h>
 #include <octoon/math/vector4.h>
 #include <octoon/math/quat.h>
 #include <octoon/runtime/except.h>
+#include <octoon/animation/path_interpolator.h>
 #include <iconv.h>
 #include <map>
 
@@ -143,6 +145,19 @@ namespace octoon
 		return std::string(outbuf.get());
 	}
 
+	std::shared_ptr<animation::Interpolator<float>> makeInterpolator(const VMD_uint8_t interpolation[64], std::size_t channel)
+	{
+		auto x1 = interpolation[channel];
+		auto y1 = interpolation[channel + 4];
+		auto x2 = interpolation[channel + 8];
+		auto y2 = interpolation[channel + 12];
+
+		if (x1 == y1 && x2 == y2)
+			return nullptr;
+
+		return animation::PathInterpolator<float>::create(x1 / 127.0f, x2 / 127.0f, y1 / 127.0f, y2 / 127.0f);
+	}
+
 	VMDLoader::VMDLoader() noexcept
 	{
 	}
@@ -180,6 +195,8 @@ namespace octoon
 	animation::Animation<float>
 	VMDLoader::load(io::istream& stream) noexcept(false)
 	{
+		OCTOON_PROFILE_CATEGORY("VMDLoader::load", "io");
+
 		VMD vmd;
 		if (!stream.read((char*)&vmd.Header, sizeof(vmd.Header))) {
 			throw runtime::runtime_error::create(R"(Cannot read property "Header" from stream)");
@@ -250,27 +267,46 @@ namespace octoon
 			}
 		}
 
-		std::map<std::string, animation::AnimationClip<float>> motions;
+		std::map<std::string, std::vector<const VMDMotion*>> motions;
 
 		for (auto& it : vmd.MotionLists)
-		{
-			if (motions.find(it.name) == motions.end())
-				motions[it.name].setName(sjis2utf8(vmd.Header.name));
-
-			auto& clip = motions[it.name];
-			clip.getCurve("Position.X").insert(animation::Keyframe<float, float>((float)it.frame, it.location.x));
-			clip.getCurve("Position.Y").insert(animation::Keyframe<float, float>((float)it.frame, it.location.y));
-			clip.getCurve("Position.Z").insert(animation::Keyframe<float, float>((float)it.frame, it.location.z));
-			clip.getCurve("Rotation.X").insert(animation::Keyframe<float, float>((float)it.frame, it.rotate.x));
-			clip.getCurve("Rotation.Y").insert(animation::Keyframe<float, float>((float)it.frame, it.rotate.y));
-			clip.getCurve("Rotation.Z").insert(animation::Keyframe<float, float>((float)it.frame, it.rotate.z));
-			clip.getCurve("Rotation.W").insert(animation::Keyframe<float, float>((float)it.frame, it.rotate.w));
-		}
+			motions[it.name].push_back(&it);
 
 		animation::Animation animation;
 		animation.setName(sjis2utf8(vmd.Header.name));
+
 		for (auto& it : motions)
-			animation.addClip(it.second);
+		{
+			animation::AnimationCurve<float>::Keyframes keyframes[7];
+			for (auto& frames : keyframes)
+				frames.reserve(it.second.size());
+
+			for (auto motion : it.second)
+			{
+				auto frame = (float)motion->frame;
+				auto rotation = makeInterpolator(motion->interpolation, 3);
+
+				keyframes[0].emplace_back(frame, motion->location.x, makeInterpolator(motion->interpolation, 0));
+				keyframes[1].emplace_back(frame, motion->location.y, makeInterpolator(motion->interpolation, 1));
+				keyframes[2].emplace_back(frame, motion->location.z, makeInterpolator(motion->interpolation, 2));
+				keyframes[3].emplace_back(frame, motion->rotate.x, std::shared_ptr<animation::Interpolator<float>>(rotation));
+				keyframes[4].emplace_back(frame, motion->rotate.y, std::shared_ptr<animation::Interpolator<float>>(rotation));
+				keyframes[5].emplace_back(frame, motion->rotate.z, std::shared_ptr<animation::Interpolator<float>>(rotation));
+				keyframes[6].emplace_back(frame, motion->rotate.w, std::move(rotation));
+			}
+
+			animation::AnimationClip<float> clip(sjis2utf8(vmd.Header.name));
+			clip.insert("Position.X", std::move(keyframes[0]));
+			clip.insert("Position.Y", std::move(keyframes[1]));
+			clip.insert("Position.Z", std::move(keyframes[2]));
+			clip.insert("Rotation.X", std::move(keyframes[3]));
+			clip.insert("Rotation.Y", std::move(keyframes[4]));
+			clip.insert("Rotation.Z", std::move(keyframes[5]));
+			clip.insert("Rotation.W", std::move(keyframes[6]));
+
+			animation.addClip(std::move(clip));
+		}
+
 		return animation;
 	}
 